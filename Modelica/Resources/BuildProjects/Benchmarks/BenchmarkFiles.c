@@ -0,0 +1,108 @@
+/* BenchmarkFiles.c - Benchmark of the file system functions of ModelicaInternal.c
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Usage: BenchmarkFiles [directory [sizeMB ...]]
+
+   Measures the throughput of ModelicaInternal_copyFile for files of the
+   given sizes (default: 1, 16 and 256 MB) in the given directory (default:
+   current working directory), once with warm and once with cold page cache
+   of the source file. As reference, the former getc/putc copy loop is
+   measured for the smallest file size.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "BenchmarkUtilities.h"
+
+void ModelicaInternal_copyFile(const char* oldFile, const char* newFile);
+void ModelicaInternal_removeFile(const char* file);
+
+static void copyFileGetcPutc(const char* oldFile, const char* newFile) {
+    /* Reference implementation (MSL v3.2.2) */
+    int c;
+    FILE* fpOld = fopen(oldFile, "r");
+    FILE* fpNew = fopen(newFile, "w");
+    if (fpOld == NULL || fpNew == NULL) {
+        fprintf(stderr, "Not possible to open \"%s\" or \"%s\"\n", oldFile, newFile);
+        exit(EXIT_FAILURE);
+    }
+    while ((c = getc(fpOld)) != EOF) {
+        putc(c, fpNew);
+    }
+    fclose(fpOld);
+    fclose(fpNew);
+}
+
+static void benchmarkCopy(const char* caseName, const char* oldFile,
+                          const char* newFile, size_t size, int cold,
+                          void (*copy)(const char*, const char*)) {
+    const char* keys[] = {"bytes", "cold", "seconds", "MBps"};
+    double values[4];
+    double t;
+
+    if (cold) {
+        benchmarkDropCache(oldFile);
+    }
+    t = benchmarkTime();
+    copy(oldFile, newFile);
+    t = benchmarkTime() - t;
+    ModelicaInternal_removeFile(newFile);
+
+    values[0] = (double)size;
+    values[1] = cold;
+    values[2] = t;
+    values[3] = t > 0 ? (double)size/(1024.0*1024.0)/t : 0;
+    benchmarkReport("copyFile", caseName, 4, keys, values);
+}
+
+int main(int argc, char* argv[]) {
+    static const size_t defaultSizes[] = {1, 16, 256};
+    const char* dir = argc > 1 ? argv[1] : ".";
+    char oldFile[1024];
+    char newFile[1024];
+    int i;
+    int nSizes = argc > 2 ? argc - 2 : (int)(sizeof(defaultSizes)/sizeof(defaultSizes[0]));
+
+    sprintf(oldFile, "%.1000s/BenchmarkFiles_src.bin", dir);
+    sprintf(newFile, "%.1000s/BenchmarkFiles_dst.bin", dir);
+
+    for (i = 0; i < nSizes; i++) {
+        size_t size = (argc > 2 ? (size_t)atol(argv[i + 2]) : defaultSizes[i])*1024*1024;
+        char caseName[64];
+        benchmarkWriteFile(oldFile, size);
+        sprintf(caseName, "%luMB", (unsigned long)(size/(1024*1024)));
+        benchmarkCopy(caseName, oldFile, newFile, size, 0, ModelicaInternal_copyFile);
+        benchmarkCopy(caseName, oldFile, newFile, size, 1, ModelicaInternal_copyFile);
+        if (i == 0) {
+            sprintf(caseName, "%luMB_getc_putc", (unsigned long)(size/(1024*1024)));
+            benchmarkCopy(caseName, oldFile, newFile, size, 0, copyFileGetcPutc);
+        }
+        ModelicaInternal_removeFile(oldFile);
+    }
+    return EXIT_SUCCESS;
+}
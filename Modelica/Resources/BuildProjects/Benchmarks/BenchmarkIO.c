@@ -0,0 +1,574 @@
+/* BenchmarkIO.c - Benchmark of the array I/O functions of ModelicaIO
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Usage: BenchmarkIO [directory [rows ...]]
+
+   Measures the throughput of ModelicaIO for matrices with 8 columns and the
+   given numbers of rows (default: 1000, 100000 and 1000000) in files of the
+   given directory (default: current working directory):
+   - ModelicaIO_writeRealMatrix for MAT-file versions 4, 6, 7 and 7.3 (if
+     ModelicaMatIO is built with HDF5), as new file and appended to a file
+   - ModelicaIO_readMatrixSizes, ModelicaIO_readRealMatrix and
+     ModelicaIO_readRealTable for MAT-files of versions 4, 6 and 7 with
+     classes double, single and int32 in native and swapped byte order and
+     ModelicaIO_readRealTable for text files ("#1" format), with warm and
+     cold (posix_fadvise) page cache
+   - ModelicaIO_readRealTableColumns for the same files, reading the first,
+     third and last column only
+   - ModelicaIO_readRealTableUpdate for a text file to which 1 % of the rows
+     were appended since the previous read (only the appended rows are
+     parsed) and ModelicaIO_isTableFileUnchanged for an unchanged file
+   The MAT-files to be read are written by this benchmark itself, such that
+   all classes and byte orders are covered. The values read are checked.
+   Each case is reported as JSON line with the throughput in MB/s of double
+   values and the peak resident set size of the process.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "zlib.h"
+#include "ModelicaUtilities.h"
+#include "ModelicaIO.h"
+#include "BenchmarkUtilities.h"
+
+#define N_COLUMNS (8)
+/* Repeat each case until this number of values is processed */
+#define N_VALUES (2000000)
+
+enum Class { CLASS_DOUBLE, CLASS_SINGLE, CLASS_INT32 };
+
+static const char* classNames[] = {"double", "single", "int32"};
+static const size_t classSizes[] = {8, 4, 4};
+
+static double value(size_t i, size_t j) {
+    return 1000.0*sin(1e-3*(double)i + (double)j);
+}
+
+static double storedValue(enum Class cls, double v) {
+    /* Value after conversion to the class */
+    switch (cls) {
+        case CLASS_SINGLE:
+            return (double)(float)v;
+        case CLASS_INT32:
+            return (double)(int)v;
+        default:
+            return v;
+    }
+}
+
+static int isBigEndian(void) {
+    const unsigned int one = 1;
+    return *(const unsigned char*)&one == 0;
+}
+
+/* ----- MAT-file writer for all classes and byte orders ----- */
+
+typedef struct {
+    unsigned char* data;
+    size_t size;
+    size_t capacity;
+    int swap;
+} Buffer;
+
+static void put(Buffer* buf, const void* data, size_t size, int swap) {
+    /* Append a value (in swapped byte order if swap) or raw bytes */
+    size_t i;
+    if (buf->size + size > buf->capacity) {
+        buf->capacity = 2*(buf->size + size);
+        buf->data = (unsigned char*)realloc(buf->data, buf->capacity);
+        if (buf->data == NULL) {
+            ModelicaError("Not enough memory");
+        }
+    }
+    for (i = 0; i < size; i++) {
+        buf->data[buf->size + i] = ((const unsigned char*)data)[swap ? size - 1 - i : i];
+    }
+    buf->size += size;
+}
+
+static void put32(Buffer* buf, unsigned int v) {
+    put(buf, &v, 4, buf->swap);
+}
+
+static void pad8(Buffer* buf) {
+    static const unsigned char zeros[8] = {0};
+    put(buf, zeros, (8 - buf->size % 8) % 8, 0);
+}
+
+static void putValues(Buffer* buf, const double* a, size_t m, size_t n,
+                      enum Class cls) {
+    /* Column-wise storage */
+    size_t i, j;
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < m; i++) {
+            const double v = a[i*n + j];
+            if (cls == CLASS_SINGLE) {
+                const float f = (float)v;
+                put(buf, &f, 4, buf->swap);
+            }
+            else if (cls == CLASS_INT32) {
+                const int k = (int)v;
+                put(buf, &k, 4, buf->swap);
+            }
+            else {
+                put(buf, &v, 8, buf->swap);
+            }
+        }
+    }
+}
+
+static void writeBuffer(const char* fileName, const Buffer* buf) {
+    FILE* fp = fopen(fileName, "wb");
+    if (fp == NULL) {
+        ModelicaFormatError("Not possible to open file \"%s\" for writing", fileName);
+    }
+    if (fwrite(buf->data, 1, buf->size, fp) != buf->size) {
+        fclose(fp);
+        ModelicaFormatError("Not possible to write to file \"%s\"", fileName);
+    }
+    fclose(fp);
+}
+
+static void writeMat(const char* fileName, const char* name, const double* a,
+                     size_t m, size_t n, int version, enum Class cls,
+                     int swap) {
+    /* MAT-file of version 4, 6 (level 5) or 7 (level 5, compressed) */
+    Buffer buf = {NULL, 0, 0, 0};
+    const size_t len = strlen(name);
+    buf.swap = swap;
+
+    if (version == 4) {
+        /* Type MOPT: M = 0 (little) / 1 (big endian), P = 0 (double),
+           1 (single), 2 (int32) */
+        static const unsigned int precision[] = {0, 10, 20};
+        const int bigEndian = isBigEndian() ? !swap : swap;
+        put32(&buf, (bigEndian ? 1000 : 0) + precision[cls]);
+        put32(&buf, (unsigned int)m);
+        put32(&buf, (unsigned int)n);
+        put32(&buf, 0);
+        put32(&buf, (unsigned int)len + 1);
+        put(&buf, name, len + 1, 0);
+        putValues(&buf, a, m, n, cls);
+    }
+    else {
+        /* Data types: miINT8 = 1, miINT32 = 5, miUINT32 = 6, miSINGLE = 7,
+           miDOUBLE = 9, miMATRIX = 14, miCOMPRESSED = 15;
+           array classes: mxDOUBLE = 6, mxSINGLE = 7, mxINT32 = 12 */
+        static const unsigned int dataType[] = {9, 7, 5};
+        static const unsigned int arrayClass[] = {6, 7, 12};
+        const unsigned int nData = (unsigned int)(m*n*classSizes[cls]);
+        const unsigned int nName = (unsigned int)((len + 7)/8*8);
+        Buffer matrix = {NULL, 0, 0, 0};
+        char text[116];
+        unsigned short v;
+
+        memset(text, ' ', sizeof(text));
+        memcpy(text, "MATLAB 5.0 MAT-file, created by BenchmarkIO", 44);
+        put(&buf, text, sizeof(text), 0);
+        put(&buf, "\0\0\0\0\0\0\0\0", 8, 0);
+        v = 0x0100;
+        put(&buf, &v, 2, swap);
+        v = ('M' << 8) | 'I';
+        put(&buf, &v, 2, swap);
+
+        matrix.swap = swap;
+        put32(&matrix, 14);
+        put32(&matrix, 16 + 16 + 8 + nName + 8 + ((nData + 7)/8*8));
+        put32(&matrix, 6);
+        put32(&matrix, 8);
+        put32(&matrix, arrayClass[cls]);
+        put32(&matrix, 0);
+        put32(&matrix, 5);
+        put32(&matrix, 8);
+        put32(&matrix, (unsigned int)m);
+        put32(&matrix, (unsigned int)n);
+        put32(&matrix, 1);
+        put32(&matrix, (unsigned int)len);
+        put(&matrix, name, len, 0);
+        pad8(&matrix);
+        put32(&matrix, dataType[cls]);
+        put32(&matrix, nData);
+        putValues(&matrix, a, m, n, cls);
+        pad8(&matrix);
+
+        if (version == 7) {
+            uLongf size = compressBound((uLong)matrix.size);
+            unsigned char* compressed = (unsigned char*)malloc(size);
+            if (compressed == NULL) {
+                ModelicaError("Not enough memory");
+            }
+            if (compress2(compressed, &size, matrix.data, (uLong)matrix.size,
+                Z_DEFAULT_COMPRESSION) != Z_OK) {
+                ModelicaError("Compression failed");
+            }
+            put32(&buf, 15);
+            put32(&buf, (unsigned int)size);
+            put(&buf, compressed, size, 0);
+            free(compressed);
+        }
+        else {
+            put(&buf, matrix.data, matrix.size, 0);
+        }
+        free(matrix.data);
+    }
+    writeBuffer(fileName, &buf);
+    free(buf.data);
+}
+
+static void writeTxt(const char* fileName, const char* name, const double* a,
+                     size_t m, size_t n) {
+    FILE* fp = fopen(fileName, "w");
+    size_t i, j;
+    if (fp == NULL) {
+        ModelicaFormatError("Not possible to open file \"%s\" for writing", fileName);
+    }
+    fprintf(fp, "#1\ndouble %s(%lu,%lu)\n", name, (unsigned long)m, (unsigned long)n);
+    for (i = 0; i < m; i++) {
+        for (j = 0; j < n; j++) {
+            fprintf(fp, j == 0 ? "%.17g" : " %.17g", a[i*n + j]);
+        }
+        fputc('\n', fp);
+    }
+    fclose(fp);
+}
+
+/* ----- Benchmarks ----- */
+
+static size_t fileSize(const char* fileName) {
+    long size = 0;
+    FILE* fp = fopen(fileName, "rb");
+    if (fp != NULL) {
+        fseek(fp, 0, SEEK_END);
+        size = ftell(fp);
+        fclose(fp);
+    }
+    return size > 0 ? (size_t)size : 0;
+}
+
+static void report(const char* caseName, size_t m, size_t fileBytes,
+                   size_t nRepeat, double t) {
+    const char* keys[] = {"rows", "columns", "fileBytes", "repeat", "seconds",
+        "MBPerSecond", "peakRSS"};
+    double values[7];
+    values[0] = (double)m;
+    values[1] = N_COLUMNS;
+    values[2] = (double)fileBytes;
+    values[3] = (double)nRepeat;
+    values[4] = t;
+    values[5] = 1e-6*(double)(m*N_COLUMNS*sizeof(double))*(double)nRepeat/t;
+    values[6] = (double)benchmarkPeakRSS();
+    benchmarkReport("io", caseName, 7, keys, values);
+}
+
+static const size_t columns[] = {1, 3, N_COLUMNS};
+#define N_SELECTED (sizeof(columns)/sizeof(columns[0]))
+
+static void check(const char* what, const char* fileName, const double* a,
+                  const double* b, size_t m, size_t n, enum Class cls) {
+    size_t i;
+    for (i = 0; i < m*n; i++) {
+        if (b[i] != storedValue(cls, a[i])) {
+            ModelicaFormatError("%s: Wrong value %g instead of %g at %lu in "
+                "file \"%s\"", what, b[i], storedValue(cls, a[i]),
+                (unsigned long)i, fileName);
+        }
+    }
+}
+
+typedef struct {
+    const char* fileName;
+    const char* version;
+} WriteProbe;
+
+static void writeProbe(void* data) {
+    const WriteProbe* probe = (const WriteProbe*)data;
+    double a[1] = {0.0};
+    ModelicaIO_writeRealMatrix(probe->fileName, "A", a, 1, 1, 0, probe->version);
+}
+
+static void benchmarkWrite(const char* dir, const double* a, size_t m,
+                           size_t nRepeat) {
+    static const char* versions[] = {"4", "6", "7", "7.3"};
+    char fileName[1024];
+    char caseName[64];
+    char msg[256];
+    int i;
+
+    sprintf(fileName, "%.1000s/BenchmarkIO_write.mat", dir);
+    for (i = 0; i < 4; i++) {
+        WriteProbe probe;
+        size_t k;
+        double t = 0.0;
+        double tAppend = 0.0;
+        probe.fileName = fileName;
+        probe.version = versions[i];
+        if (benchmarkCatchError(writeProbe, &probe, msg, sizeof(msg))) {
+            /* Version 7.3 requires HDF5 */
+            fprintf(stderr, "Skipped MAT-file version %s: %s", versions[i], msg);
+            continue;
+        }
+        for (k = 0; k < nRepeat; k++) {
+            double t0;
+            remove(fileName);
+            t0 = benchmarkTime();
+            ModelicaIO_writeRealMatrix(fileName, "A", (double*)a, m, N_COLUMNS,
+                0, versions[i]);
+            t += benchmarkTime() - t0;
+            t0 = benchmarkTime();
+            ModelicaIO_writeRealMatrix(fileName, "B", (double*)a, m, N_COLUMNS,
+                1, versions[i]);
+            tAppend += benchmarkTime() - t0;
+        }
+        sprintf(caseName, "write_v%s_%lux%d", versions[i], (unsigned long)m,
+            N_COLUMNS);
+        report(caseName, m, fileSize(fileName)/2, nRepeat, t);
+        sprintf(caseName, "append_v%s_%lux%d", versions[i], (unsigned long)m,
+            N_COLUMNS);
+        report(caseName, m, fileSize(fileName)/2, nRepeat, tAppend);
+    }
+    remove(fileName);
+}
+
+static void benchmarkRead(const char* fileName, const char* format,
+                          const double* a, size_t m, size_t nRepeat,
+                          enum Class cls) {
+    double* b = (double*)malloc(m*N_COLUMNS*sizeof(double));
+    const size_t fileBytes = fileSize(fileName);
+    const int isMat = strcmp(format, "txt") != 0;
+    char caseName[128];
+    int cold;
+
+    if (b == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (cold = 0; cold <= 1; cold++) {
+        const char* cache = cold ? "cold" : "warm";
+        size_t k;
+        double tSizes = 0.0;
+        double tMatrix = 0.0;
+        double tTable = 0.0;
+        double tColumns = 0.0;
+        for (k = 0; k < nRepeat; k++) {
+            ModelicaIOLoadEvent event;
+            int dim[2];
+            size_t mTable, nTable;
+            double* table;
+            double t0;
+
+            if (isMat) {
+                if (cold) {
+                    benchmarkDropCache(fileName);
+                }
+                t0 = benchmarkTime();
+                ModelicaIO_readMatrixSizes(fileName, "A", dim);
+                tSizes += benchmarkTime() - t0;
+                if ((size_t)dim[0] != m || dim[1] != N_COLUMNS) {
+                    ModelicaFormatError("readMatrixSizes: Wrong size (%d,%d) "
+                        "of file \"%s\"", dim[0], dim[1], fileName);
+                }
+
+                if (cold) {
+                    benchmarkDropCache(fileName);
+                }
+                t0 = benchmarkTime();
+                ModelicaIO_readRealMatrix(fileName, "A", b, m, N_COLUMNS, 0);
+                tMatrix += benchmarkTime() - t0;
+                check("readRealMatrix", fileName, a, b, m, N_COLUMNS, cls);
+            }
+
+            if (cold) {
+                benchmarkDropCache(fileName);
+            }
+            t0 = benchmarkTime();
+            table = ModelicaIO_readRealTable(fileName, "A", &mTable, &nTable, 0);
+            tTable += benchmarkTime() - t0;
+            if (mTable != m || nTable != N_COLUMNS) {
+                ModelicaFormatError("readRealTable: Wrong size (%lu,%lu) of "
+                    "file \"%s\"", (unsigned long)mTable,
+                    (unsigned long)nTable, fileName);
+            }
+            check("readRealTable", fileName, a, table, m, N_COLUMNS, cls);
+            free(table);
+
+            if (cold) {
+                benchmarkDropCache(fileName);
+            }
+            memset(&event, 0, sizeof(ModelicaIOLoadEvent));
+            t0 = benchmarkTime();
+            table = ModelicaIO_readRealTableColumns(fileName, "A", &mTable,
+                &nTable, columns, N_SELECTED, 0, &event);
+            tColumns += benchmarkTime() - t0;
+            if (mTable != m || nTable != N_SELECTED) {
+                ModelicaFormatError("readRealTableColumns: Wrong size "
+                    "(%lu,%lu) of file \"%s\"", (unsigned long)mTable,
+                    (unsigned long)nTable, fileName);
+            }
+            {
+                size_t i, j;
+                for (i = 0; i < m; i++) {
+                    for (j = 0; j < N_SELECTED; j++) {
+                        check("readRealTableColumns", fileName,
+                            &a[i*N_COLUMNS + columns[j] - 1],
+                            &table[i*N_SELECTED + j], 1, 1, cls);
+                    }
+                }
+            }
+            free(table);
+        }
+        if (isMat) {
+            sprintf(caseName, "readMatrixSizes_%s_%lux%d_%s", format,
+                (unsigned long)m, N_COLUMNS, cache);
+            report(caseName, m, fileBytes, nRepeat, tSizes);
+            sprintf(caseName, "readRealMatrix_%s_%lux%d_%s", format,
+                (unsigned long)m, N_COLUMNS, cache);
+            report(caseName, m, fileBytes, nRepeat, tMatrix);
+        }
+        sprintf(caseName, "readRealTable_%s_%lux%d_%s", format,
+            (unsigned long)m, N_COLUMNS, cache);
+        report(caseName, m, fileBytes, nRepeat, tTable);
+        sprintf(caseName, "readRealTableColumns_%s_%lux%d_%s", format,
+            (unsigned long)m, N_COLUMNS, cache);
+        report(caseName, m, fileBytes, nRepeat, tColumns);
+    }
+    free(b);
+}
+
+static void benchmarkUpdate(const char* fileName, const double* a, size_t m,
+                            size_t nRepeat) {
+    const size_t mKept = m > 100 ? m - m/100 : m - 1;
+    ModelicaIOTableState state0;
+    ModelicaIOLoadEvent event;
+    size_t mTable, nTable, k;
+    double* table0;
+    double tUpdate = 0.0;
+    double tUnchanged = 0.0;
+    char caseName[128];
+
+    /* Previous read of the table without the appended rows */
+    writeTxt(fileName, "A", a, mKept, N_COLUMNS);
+    memset(&state0, 0, sizeof(ModelicaIOTableState));
+    memset(&event, 0, sizeof(ModelicaIOLoadEvent));
+    table0 = ModelicaIO_readRealTableUpdate(fileName, "A", &mTable, &nTable,
+        NULL, 0, NULL, 0, &state0, &event);
+    writeTxt(fileName, "A", a, m, N_COLUMNS);
+    for (k = 0; k < nRepeat; k++) {
+        ModelicaIOTableState state = state0;
+        double* table;
+        double t0;
+
+        memset(&event, 0, sizeof(ModelicaIOLoadEvent));
+        t0 = benchmarkTime();
+        table = ModelicaIO_readRealTableUpdate(fileName, "A", &mTable,
+            &nTable, NULL, 0, table0, 0, &state, &event);
+        tUpdate += benchmarkTime() - t0;
+        if (mTable != m || nTable != N_COLUMNS || state.nRowKept != mKept) {
+            ModelicaFormatError("readRealTableUpdate: Wrong size (%lu,%lu) "
+                "or number of kept rows %lu of file \"%s\"",
+                (unsigned long)mTable, (unsigned long)nTable,
+                (unsigned long)state.nRowKept, fileName);
+        }
+        check("readRealTableUpdate", fileName, a, table, m, N_COLUMNS,
+            CLASS_DOUBLE);
+        free(table);
+
+        t0 = benchmarkTime();
+        if (!ModelicaIO_isTableFileUnchanged(fileName, &state)) {
+            ModelicaFormatError("isTableFileUnchanged: File \"%s\" is "
+                "reported as changed", fileName);
+        }
+        tUnchanged += benchmarkTime() - t0;
+    }
+    free(table0);
+    sprintf(caseName, "readRealTableUpdate_txt_%lux%d_append",
+        (unsigned long)m, N_COLUMNS);
+    report(caseName, m, fileSize(fileName), nRepeat, tUpdate);
+    sprintf(caseName, "isTableFileUnchanged_txt_%lux%d", (unsigned long)m,
+        N_COLUMNS);
+    report(caseName, m, fileSize(fileName), nRepeat, tUnchanged);
+}
+
+static void benchmarkSize(const char* dir, size_t m) {
+    static const int versions[] = {4, 6, 7};
+    const size_t nRepeat = N_VALUES/(m*N_COLUMNS) > 0 ? N_VALUES/(m*N_COLUMNS) : 1;
+    double* a = (double*)malloc(m*N_COLUMNS*sizeof(double));
+    char fileName[1024];
+    char format[32];
+    size_t i, j;
+    int v, swap;
+    enum Class cls;
+
+    if (a == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < m; i++) {
+        for (j = 0; j < N_COLUMNS; j++) {
+            a[i*N_COLUMNS + j] = value(i, j);
+        }
+    }
+
+    benchmarkWrite(dir, a, m, nRepeat);
+
+    sprintf(fileName, "%.1000s/BenchmarkIO.txt", dir);
+    writeTxt(fileName, "A", a, m, N_COLUMNS);
+    benchmarkRead(fileName, "txt", a, m, nRepeat, CLASS_DOUBLE);
+    benchmarkUpdate(fileName, a, m, nRepeat);
+    remove(fileName);
+
+    sprintf(fileName, "%.1000s/BenchmarkIO.mat", dir);
+    for (v = 0; v < 3; v++) {
+        for (cls = CLASS_DOUBLE; cls <= CLASS_INT32; cls++) {
+            for (swap = 0; swap <= 1; swap++) {
+                writeMat(fileName, "A", a, m, N_COLUMNS, versions[v], cls, swap);
+                sprintf(format, "v%d_%s_%s", versions[v], classNames[cls],
+                    swap ? "swapped" : "native");
+                benchmarkRead(fileName, format, a, m, nRepeat, cls);
+            }
+        }
+    }
+    remove(fileName);
+    free(a);
+}
+
+int main(int argc, char* argv[]) {
+    static const size_t rowsDefault[] = {1000, 100000, 1000000};
+    const char* dir = argc > 1 ? argv[1] : ".";
+    int i;
+
+    if (argc > 2) {
+        for (i = 2; i < argc; i++) {
+            benchmarkSize(dir, (size_t)strtoul(argv[i], NULL, 10));
+        }
+    }
+    else {
+        for (i = 0; i < 3; i++) {
+            benchmarkSize(dir, rowsDefault[i]);
+        }
+    }
+    return EXIT_SUCCESS;
+}
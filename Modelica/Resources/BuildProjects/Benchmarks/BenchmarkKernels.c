@@ -0,0 +1,475 @@
+/* BenchmarkKernels.c - Benchmark of the run-time selected SIMD kernels
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Usage: BenchmarkKernels [-hash | -check] [directory]
+
+   Exercises the kernels selected by ModelicaCPUDispatch.h through the
+   exported functions:
+   - ModelicaFFT_kiss_fftr (radix-2 and radix-4 butterflies)
+   - ModelicaIO_readRealMatrix of a byte-swapped (big endian) MAT v4 file
+     (byte swapping of double arrays in ModelicaMatIO)
+   - ModelicaStandardTables_*_init (check of strictly/monotonically
+     increasing abscissa values)
+   - ModelicaStandardTables_CombiTable1D/2D_getValue at random inputs
+     (counting of the last candidates of the index search)
+   The level is selected by the CPU or the environment variable
+   MODELICA_CPU_LEVEL. Without option, the run times are measured.
+   With -hash, a hash of the results (and of the error messages for invalid
+   tables) is printed for each case. With -check, the benchmark executes
+   itself with -hash for each level and reports whether all levels yield
+   bit-identical results. Temporary files are written to the directory
+   (default: current working directory).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ModelicaUtilities.h"
+#include "ModelicaIO.h"
+#include "ModelicaStandardTables.h"
+#include "BenchmarkUtilities.h"
+
+int ModelicaFFT_kiss_fftr(double* u, size_t nu, double* work, size_t nwork,
+                          double *amplitudes, double *phases);
+
+static unsigned long hashBytes(unsigned long hash, const void* data, size_t size) {
+    /* FNV-1a (32 bit) */
+    const unsigned char* p = (const unsigned char*)data;
+    size_t i;
+    for (i = 0; i < size; i++) {
+        hash = ((hash ^ p[i])*16777619UL) & 0xffffffffUL;
+    }
+    return hash;
+}
+
+static void reportHash(const char* name, const char* caseName, unsigned long hash) {
+    const char* keys[] = {"hash"};
+    double values[1];
+    values[0] = (double)hash;
+    benchmarkReport(name, caseName, 1, keys, values);
+}
+
+static void reportTime(const char* name, const char* caseName, size_t n,
+                       size_t nRepeat, double t) {
+    const char* keys[] = {"n", "repeat", "seconds", "nsPerElement"};
+    double values[4];
+    values[0] = (double)n;
+    values[1] = (double)nRepeat;
+    values[2] = t;
+    values[3] = 1e9*t/((double)n*(double)nRepeat);
+    benchmarkReport(name, caseName, 4, keys, values);
+}
+
+/* ----- FFT ----- */
+
+static void fft(size_t nu, size_t nRepeat, int hash) {
+    const size_t nf = nu/2 + 1;
+    const size_t nwork = 3*nu + 2*nf;
+    double* u = (double*)malloc(nu*sizeof(double));
+    double* work = (double*)malloc(nwork*sizeof(double));
+    double* amplitudes = (double*)malloc(nf*sizeof(double));
+    double* phases = (double*)malloc(nf*sizeof(double));
+    char caseName[32];
+    size_t i;
+    double t;
+
+    if (u == NULL || work == NULL || amplitudes == NULL || phases == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < nu; i++) {
+        u[i] = sin(0.1*(double)i) + 0.25*cos(3.7*(double)i) + 1e-3*(double)(i % 7);
+    }
+    sprintf(caseName, "%lu", (unsigned long)nu);
+
+    t = benchmarkTime();
+    for (i = 0; i < nRepeat; i++) {
+        if (ModelicaFFT_kiss_fftr(u, nu, work, nwork, amplitudes, phases) != 0) {
+            ModelicaError("FFT failed");
+        }
+    }
+    t = benchmarkTime() - t;
+
+    if (hash) {
+        unsigned long h = hashBytes(2166136261UL, amplitudes, nf*sizeof(double));
+        reportHash("fft", caseName, hashBytes(h, phases, nf*sizeof(double)));
+    }
+    else {
+        reportTime("fft", caseName, nu, nRepeat, t);
+    }
+    free(u);
+    free(work);
+    free(amplitudes);
+    free(phases);
+}
+
+/* ----- Byte-swapped MAT v4 ----- */
+
+static void putBigEndian(FILE* fp, const void* data, size_t size) {
+    /* Write a little endian value in big endian byte order */
+    unsigned char buf[8];
+    size_t i;
+    for (i = 0; i < size; i++) {
+        buf[i] = ((const unsigned char*)data)[size - 1 - i];
+    }
+    fwrite(buf, 1, size, fp);
+}
+
+static void matSwap(const char* dir, size_t m, size_t n, size_t nRepeat, int hash) {
+    /* MAT v4 matrix with type 1000 (big endian IEEE, double, full matrix) */
+    const int header[5] = {1000, (int)m, (int)n, 0, 2};
+    char fileName[1024];
+    char caseName[32];
+    double* matrix = (double*)malloc(m*n*sizeof(double));
+    FILE* fp;
+    size_t i, j;
+    double t;
+
+    if (matrix == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    sprintf(fileName, "%.1000s/BenchmarkKernels.mat", dir);
+    fp = fopen(fileName, "wb");
+    if (fp == NULL) {
+        ModelicaFormatError("Not possible to open file \"%s\" for writing", fileName);
+    }
+    for (i = 0; i < 5; i++) {
+        putBigEndian(fp, &header[i], sizeof(int));
+    }
+    fwrite("A", 1, 2, fp);
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < m; i++) {
+            const double v = (double)i + 0.001*(double)j - 1.0/3.0;
+            putBigEndian(fp, &v, sizeof(double));
+        }
+    }
+    fclose(fp);
+    sprintf(caseName, "%lux%lu", (unsigned long)m, (unsigned long)n);
+
+    t = benchmarkTime();
+    for (i = 0; i < nRepeat; i++) {
+        ModelicaIO_readRealMatrix(fileName, "A", matrix, m, n, 0);
+    }
+    t = benchmarkTime() - t;
+    remove(fileName);
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < m; i++) {
+            if (matrix[i*n + j] != (double)i + 0.001*(double)j - 1.0/3.0) {
+                ModelicaFormatError("Wrong value A[%lu,%lu] = %g read from "
+                    "byte-swapped file", (unsigned long)i, (unsigned long)j,
+                    matrix[i*n + j]);
+            }
+        }
+    }
+
+    if (hash) {
+        reportHash("matSwap", caseName, hashBytes(2166136261UL, matrix, m*n*sizeof(double)));
+    }
+    else {
+        reportTime("matSwap", caseName, m*n, nRepeat, t);
+    }
+    free(matrix);
+}
+
+/* ----- Table validation ----- */
+
+typedef struct {
+    int kind; /* 0: CombiTimeTable, 1: CombiTable1D, 2: CombiTable2D */
+    double* table;
+    size_t nRow;
+    size_t nCol;
+    int smoothness;
+} TableInit;
+
+static void tableInitClose(void* data) {
+    TableInit* init = (TableInit*)data;
+    int cols[1] = {2};
+    void* tableID;
+    switch (init->kind) {
+        case 0:
+            tableID = ModelicaStandardTables_CombiTimeTable_init("NoName",
+                "NoName", init->table, init->nRow, init->nCol, 0.0, cols, 1,
+                init->smoothness, 1);
+            ModelicaStandardTables_CombiTimeTable_close(tableID);
+            break;
+        case 1:
+            tableID = ModelicaStandardTables_CombiTable1D_init2("NoName",
+                "NoName", init->table, init->nRow, init->nCol, cols, 1,
+                init->smoothness, 1);
+            ModelicaStandardTables_CombiTable1D_close(tableID);
+            break;
+        default:
+            tableID = ModelicaStandardTables_CombiTable2D_init("NoName",
+                "NoName", init->table, init->nRow, init->nCol,
+                init->smoothness);
+            ModelicaStandardTables_CombiTable2D_close(tableID);
+            break;
+    }
+}
+
+static void tableValidation(int kind, size_t nRow, size_t nCol, int smoothness,
+                            size_t nRepeat, int hash) {
+    static const char* names[] = {"CombiTimeTable", "CombiTable1D", "CombiTable2D"};
+    double* table = (double*)malloc(nRow*nCol*sizeof(double));
+    TableInit init;
+    char msg[1024];
+    char caseName[64];
+    size_t i, j;
+    double t;
+
+    if (table == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < nRow; i++) {
+        for (j = 0; j < nCol; j++) {
+            /* Strictly increasing first column and (for 2D) first row */
+            table[i*nCol + j] = i == 0 ? (double)j : (double)i + 0.5*(double)j;
+        }
+    }
+    init.kind = kind;
+    init.table = table;
+    init.nRow = nRow;
+    init.nCol = nCol;
+    init.smoothness = smoothness;
+    sprintf(caseName, "%s_%lux%lu_s%d", names[kind], (unsigned long)nRow,
+        (unsigned long)nCol, smoothness);
+
+    if (hash) {
+        /* Valid table and invalid tables with a violation (equal or lower
+           value) at every position of the first column (and row) */
+        unsigned long h = 2166136261UL;
+        for (i = kind == 2 ? 1 : 0; i < nRow; i++) {
+            const double old = table[i*nCol];
+            if (i > 0) {
+                table[i*nCol] = table[(i - 1)*nCol] - ((i % 3) == 0 ? 0.0 : 0.25);
+            }
+            if (benchmarkCatchError(tableInitClose, &init, msg, sizeof(msg))) {
+                h = hashBytes(h, msg, strlen(msg));
+            }
+            else {
+                h = hashBytes(h, "valid", 5);
+            }
+            table[i*nCol] = old;
+        }
+        for (j = 2; kind == 2 && j < nCol; j++) {
+            const double old = table[j];
+            table[j] = table[j - 1] - ((j % 3) == 0 ? 0.0 : 0.25);
+            if (benchmarkCatchError(tableInitClose, &init, msg, sizeof(msg))) {
+                h = hashBytes(h, msg, strlen(msg));
+            }
+            table[j] = old;
+        }
+        reportHash("tableValidation", caseName, h);
+    }
+    else {
+        t = benchmarkTime();
+        for (i = 0; i < nRepeat; i++) {
+            tableInitClose(&init);
+        }
+        t = benchmarkTime() - t;
+        reportTime("tableValidation", caseName, nRow*nCol, nRepeat, t);
+    }
+    free(table);
+}
+
+/* ----- Table index search ----- */
+
+static void tableSearch(int kind, size_t n, size_t nEval, size_t nRepeat,
+                        int hash) {
+    /* Random inputs (and every tenth input on a grid point) of a
+       CombiTable1D with n rows and 3 columns or a CombiTable2D with n rows
+       and n columns */
+    static const char* names[] = {"CombiTable1D", "CombiTable2D"};
+    const size_t nRow = kind == 1 ? n : n + 1;
+    const size_t nCol = kind == 1 ? 3 : n + 1;
+    double* table = (double*)malloc(nRow*nCol*sizeof(double));
+    double* u = (double*)malloc(nEval*sizeof(double));
+    double* y = (double*)malloc(nEval*sizeof(double));
+    int cols[1] = {2};
+    unsigned long state = 2463534242UL;
+    void* tableID;
+    char caseName[64];
+    size_t i, j;
+    double t;
+
+    if (table == NULL || u == NULL || y == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < nRow; i++) {
+        for (j = 0; j < nCol; j++) {
+            table[i*nCol + j] = sin(0.01*(double)i) + 0.1*(double)j;
+        }
+        table[i*nCol] = kind == 1 ? 0.5*(double)i : 0.5*(double)i - 0.5;
+    }
+    if (kind == 2) {
+        for (j = 1; j < nCol; j++) {
+            table[j] = 0.25*(double)j - 0.25;
+        }
+    }
+    for (i = 0; i < nEval; i++) {
+        state ^= state << 13;
+        state ^= (state & 0xffffffffUL) >> 17;
+        state ^= state << 5;
+        state &= 0xffffffffUL;
+        u[i] = (i % 10) == 0 ? 0.5*(double)(state % n) :
+            0.5*(double)n*(double)state/4294967296.0;
+    }
+    if (kind == 1) {
+        tableID = ModelicaStandardTables_CombiTable1D_init2("NoName",
+            "NoName", table, nRow, nCol, cols, 1, 1, 1);
+    }
+    else {
+        tableID = ModelicaStandardTables_CombiTable2D_init("NoName",
+            "NoName", table, nRow, nCol, 1);
+    }
+    sprintf(caseName, "%s_%lu", names[kind - 1], (unsigned long)n);
+
+    t = benchmarkTime();
+    for (j = 0; j < nRepeat; j++) {
+        if (kind == 1) {
+            for (i = 0; i < nEval; i++) {
+                y[i] = ModelicaStandardTables_CombiTable1D_getValue(tableID,
+                    1, u[i]);
+            }
+        }
+        else {
+            for (i = 0; i < nEval; i++) {
+                y[i] = ModelicaStandardTables_CombiTable2D_getValue(tableID,
+                    u[i], u[nEval - 1 - i]);
+            }
+        }
+    }
+    t = benchmarkTime() - t;
+
+    if (hash) {
+        reportHash("tableSearch", caseName, hashBytes(2166136261UL, y,
+            nEval*sizeof(double)));
+    }
+    else {
+        reportTime("tableSearch", caseName, nEval, nRepeat, t);
+    }
+    if (kind == 1) {
+        ModelicaStandardTables_CombiTable1D_close(tableID);
+    }
+    else {
+        ModelicaStandardTables_CombiTable2D_close(tableID);
+    }
+    free(table);
+    free(u);
+    free(y);
+}
+
+/* ----- Check of all levels ----- */
+
+static int check(const char* self, const char* dir) {
+    static const char* levels[] = {"generic", "sse2", "avx2", "avx512"};
+    char* outputs[4];
+    int i;
+    int nFailures = 0;
+
+    for (i = 0; i < 4; i++) {
+        char cmd[2200];
+        size_t size = 0;
+        size_t capacity = 65536;
+        FILE* fp;
+        sprintf(cmd, "MODELICA_CPU_LEVEL=%s \"%.1000s\" -hash \"%.1000s\"",
+            levels[i], self, dir);
+        outputs[i] = (char*)malloc(capacity);
+        if (outputs[i] == NULL) {
+            ModelicaError("Not enough memory");
+        }
+        fp = popen(cmd, "r");
+        if (fp == NULL) {
+            ModelicaFormatError("Not possible to execute \"%s\"", cmd);
+        }
+        size = fread(outputs[i], 1, capacity - 1, fp);
+        outputs[i][size] = '\0';
+        if (pclose(fp) != 0) {
+            fprintf(stderr, "Level %s failed\n", levels[i]);
+            nFailures++;
+        }
+        else if (i > 0 && strcmp(outputs[0], outputs[i]) != 0) {
+            fprintf(stderr, "Results of level %s differ from level %s\n",
+                levels[i], levels[0]);
+            nFailures++;
+        }
+    }
+    if (nFailures == 0) {
+        fprintf(stderr, "All levels yield bit-identical results\n");
+    }
+    for (i = 0; i < 4; i++) {
+        free(outputs[i]);
+    }
+    return nFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    const int hash = argc > 1 && strcmp(argv[1], "-hash") == 0;
+    const int checkOnly = argc > 1 && strcmp(argv[1], "-check") == 0;
+    const char* dir = argc > 2 ? argv[2] : (argc > 1 && !hash && !checkOnly ? argv[1] : ".");
+
+    if (checkOnly) {
+        return check(argv[0], dir);
+    }
+
+    if (hash) {
+        /* Small sizes, such that all remainder paths are covered */
+        static const size_t nuHash[] = {2, 4, 8, 12, 16, 24, 40, 56, 64,
+            96, 120, 1000, 1024, 4096, 6000};
+        size_t i;
+        for (i = 0; i < sizeof(nuHash)/sizeof(nuHash[0]); i++) {
+            fft(nuHash[i], 1, 1);
+        }
+        for (i = 1; i < 20; i++) {
+            matSwap(dir, i, 3, 1, 1);
+        }
+        matSwap(dir, 1001, 7, 1, 1);
+        for (i = 2; i < 40; i += 3) {
+            tableValidation(0, i, 2, 1, 1, 1);
+            tableValidation(0, i, 3, 2, 1, 1);
+            tableValidation(1, i, 2, 1, 1, 1);
+            tableValidation(2, i, i + 1, 1, 1, 1);
+        }
+        for (i = 2; i < 70; i += 7) {
+            tableSearch(1, i, 1000, 1, 1);
+            tableSearch(2, i, 1000, 1, 1);
+        }
+    }
+    else {
+        fft(1024, 2000, 0);
+        fft(65536, 20, 0);
+        fft(1048576, 2, 0);
+        matSwap(dir, 1000000, 8, 3, 0);
+        tableValidation(0, 4000000, 2, 1, 5, 0);
+        tableValidation(1, 4000000, 4, 1, 5, 0);
+        tableValidation(2, 2000, 2000, 1, 5, 0);
+        tableSearch(1, 1000, 1000000, 5, 0);
+        tableSearch(1, 1000000, 1000000, 5, 0);
+        tableSearch(2, 1000, 1000000, 5, 0);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1471 @@
+/* BenchmarkTables.c - Micro-benchmark of the interpolation tables
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Usage: BenchmarkTables [-quick | -full] [CombiTimeTable | CombiTable1D | CombiTable2D | CombiTableND]
+          BenchmarkTables -periodic
+          BenchmarkTables -derivative
+          BenchmarkTables -inverse
+          BenchmarkTables -akima
+          BenchmarkTables -interpolate
+          BenchmarkTables -sort
+          BenchmarkTables -shared
+
+   Measures ModelicaStandardTables for synthetic tables of increasing size
+   (default: 1e2, 1e4 and 1e6 rows with 1, 10 and 1000 interpolated columns
+   up to 1e7 table values; -quick: up to 1e4 rows and 10 columns; -full: up
+   to 1e8 rows and 2e8 table values) for all smoothness and extrapolation
+   kinds. CombiTable2D uses square grids and all smoothness kinds.
+   CombiTableND uses 3 and 5 dimensional grids with the same number of grid
+   points per axis (1e3, 1e5 and 1e7 values; -quick: up to 1e5 values),
+   linear extrapolation and all supported smoothness kinds.
+   For each table the initialization time and the memory (increase of the
+   resident set size) are measured, followed by the evaluation of all
+   columns for the access patterns
+   - monotone: increasing abscissa values over the table range
+   - backstep: solver-like, two steps forward, one step back
+   - random: uniformly distributed abscissa values within the table range
+   - wrap: increasing abscissa values over three table periods (not for
+     extrapolation = 4, i.e., no extrapolation)
+   For CombiTable2D the second abscissa follows the same pattern in reverse
+   order (per chunk of 1000 values). For CombiTableND the k-th abscissa
+   follows the pattern shifted by k/nDim of its length and the multilinear
+   interpolation is compared with a naive reference implementation (binary
+   search per axis and summation over the 2^nDim corners of the row-major
+   table), reported as time per evaluation and maximum difference.
+   For CombiTimeTable the next time event is requested
+   whenever the time leaves the current event interval (as a simulation
+   tool would after an event or a restart), its cost is included.
+   A case is stopped after 2 s. Each case is reported as JSON line with the
+   number of evaluations, the time per evaluation and a checksum of the
+   results.
+   Run with the environment variable MODELICA_TABLE_FLOAT=1 to measure the
+   tables with single precision storage of the table values and spline
+   coefficients.
+
+   With -periodic, a regression check of the periodic extrapolation is
+   executed instead: For random 1D tables with abscissa values on a dyadic
+   grid, the tables are evaluated at all breakpoints shifted by -300 to 300
+   periods and at their floating-point neighbours. The values and
+   derivatives must be identical to the ones at the abscissa value obtained
+   by repeatedly adding or subtracting the period, i.e., the same table
+   interval must be selected at each period boundary.
+
+   With -derivative, the fused evaluation of value and derivative(s)
+   (getValueAndDer) is compared with the separate calls of getValue and
+   getDerValue for all table kinds, smoothness and extrapolation kinds and
+   access patterns. The results must be identical. Each case is reported as
+   JSON line with the time per evaluation of the separate and the fused
+   calls.
+
+   With -inverse, the inverse interpolation (getInverseValue) of strictly
+   increasing and decreasing 1D tables is checked for all smoothness kinds
+   except constant segments and all extrapolation kinds: The table value at
+   the inverse must equal the ordinate value (up to rounding). It is
+   compared with the solution of the same equation by Newton iteration with
+   getValueAndDer, as a tool would solve it in an algebraic loop, starting
+   at the previous solution. Each case is reported as JSON line with the
+   time per evaluation of both and the mean number of table calls of the
+   Newton iteration.
+
+   With -akima, CombiTable2D with Akima interpolation (1e4 to 1e6 grid
+   values) is evaluated with the spline coefficients calculated at
+   initialization and with the ones calculated on demand and cached with a
+   budget of 256 kB and 16 MB (environment variable
+   MODELICA_TABLE_AKIMA_CACHE) for the monotone, backstep and random access
+   patterns. The results must be identical. Each case is reported as JSON
+   line with the initialization time, the time per evaluation and the
+   memory (increase of the resident set size after the evaluations) of
+   both. For random access, nearly every on-demand evaluation misses the
+   cache: The additional time per evaluation (the miss cost) must not
+   exceed AKIMA_MISS_COST times the initialization time per grid cell.
+
+   With -interpolate, ModelicaMath_Vectors_interpolate (search from the
+   interval of the previous call) and _interpolateVector are compared with
+   the linear search of the former Modelica implementation of
+   Modelica.Math.Vectors.interpolate for vectors of 10, 1e3 and 1e5 values
+   and the monotone, backstep and random access patterns (including
+   extrapolation). The linear search is called through a function pointer,
+   i.e., not inlined, as a tool calls the C code generated for a Modelica
+   function. The results must be identical. Each case is reported as JSON
+   line with the time per evaluation of all three.
+
+   With -sort, ModelicaMath_Vectors_sort (unstable and stable) is
+   compared with the shellsort of the former Modelica implementation of
+   Modelica.Math.Vectors.sort for random vectors of 10, 1e3, 1e5 and 1e6
+   values (with equal values and NaN) in ascending and descending order.
+   The sorted vectors must be identical, the indices must be a permutation
+   with sorted_v = v[indices] and, if stable, increasing for equal values.
+   Each case is reported as JSON line with the time per element of all
+   three.
+
+   With -shared, ModelicaStandardTables_SharedTable2D_getValue and
+   _getValueAndDer are compared with CombiTable2D (Akima interpolation of
+   the values, linear interpolation of the validity) of the same table
+   values for grids of 1e4 to 1e6 values, a validity table with invalid
+   bands and the monotone, backstep and random access patterns (including
+   values outside of the table range). Before the table values are
+   provided by ModelicaStandardTables_SharedTable2D_setTables, the shared
+   table must return -1, the values of a second call must be ignored and
+   table values with a non-increasing first row must not be interpolated
+   at all. The values and derivatives must be identical where the shared
+   table interpolates, which must be exactly where the validity is 1 and
+   the inputs are in range. Each case is reported as JSON line with the
+   time per evaluation of CombiTable2D (value and validity) and of both
+   shared table functions.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ModelicaUtilities.h"
+#include "ModelicaStandardTables.h"
+#include "BenchmarkUtilities.h"
+
+double ModelicaMath_Vectors_interpolate(const double* x, const double* y,
+                                        size_t nx, double xi, int iLast,
+                                        int* iNew);
+int ModelicaMath_Vectors_interpolateVector(const double* x, const double* y,
+                                           size_t nx, const double* xi,
+                                           size_t nxi, int iLast, double* yi);
+void ModelicaMath_Vectors_sort(const double* v, size_t n, int ascending,
+                               int stable, double* sorted_v, int* indices);
+
+/* Number of evaluations per case */
+#define N_EVALUATIONS (100000)
+/* Time limit per case in seconds, checked every CHUNK abscissa values */
+#define TIME_LIMIT (2.0)
+#define CHUNK (1000)
+/* Maximum cost of a miss of the on-demand calculated Akima spline
+   coefficients relative to the calculation of the coefficients of one grid
+   cell at initialization */
+#define AKIMA_MISS_COST (32.0)
+
+enum { TIME_TABLE, TABLE_1D, TABLE_2D };
+
+static const char* tableNames[] = {"CombiTimeTable", "CombiTable1D", "CombiTable2D"};
+static const char* patternNames[] = {"monotone", "backstep", "random", "wrap"};
+
+static double abscissa(size_t i) {
+    /* Strictly increasing, non-equidistant grid */
+    return (double)i + 0.3*sin((double)i);
+}
+
+static double* createTable(int kind, size_t nRow, size_t nCol) {
+    double* table = (double*)malloc(nRow*nCol*sizeof(double));
+    size_t i, j;
+    if (table == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < nRow; i++) {
+        double* row = table + i*nCol;
+        row[0] = abscissa(kind == TABLE_2D && i > 0 ? i - 1 : i);
+        for (j = 1; j < nCol; j++) {
+            row[j] = sin(1e-2*(double)i*(double)j) + 1e-3*(double)j;
+        }
+    }
+    if (kind == TABLE_2D) {
+        table[0] = 0.0;
+        for (j = 1; j < nCol; j++) {
+            table[j] = abscissa(j - 1);
+        }
+    }
+    return table;
+}
+
+static void createPattern(int pattern, double xMin, double xMax,
+                          double* x, size_t n) {
+    const double range = xMax - xMin;
+    unsigned long state = 2463534242UL;
+    size_t k;
+    for (k = 0; k < n; k++) {
+        switch (pattern) {
+            case 0:
+                x[k] = xMin + range*(double)k/(double)n;
+                break;
+            case 1: {
+                /* Steps of size h, every third step is rejected and
+                   repeated with half the step size */
+                static const double offset[3] = {0.0, 2.0, 1.0};
+                const double h = range/(double)n;
+                x[k] = xMin + h*(2.0*(double)(k/3) + offset[k % 3]);
+                if (x[k] > xMax) {
+                    x[k] = xMax;
+                }
+                break;
+            }
+            case 2:
+                /* xorshift */
+                state ^= (state << 13) & 0xffffffffUL;
+                state ^= state >> 17;
+                state ^= (state << 5) & 0xffffffffUL;
+                x[k] = xMin + range*(double)state/4294967296.0;
+                break;
+            default:
+                x[k] = xMin + 3.0*range*(double)k/(double)n;
+                break;
+        }
+    }
+}
+
+static void* initTable(int kind, double* table, size_t nRow, size_t nCol,
+                       int* cols, size_t nCols, int smoothness,
+                       int extrapolation) {
+    switch (kind) {
+        case TIME_TABLE:
+            return ModelicaStandardTables_CombiTimeTable_init("NoName",
+                "NoName", table, nRow, nCol, 0.0, cols, nCols, smoothness,
+                extrapolation);
+        case TABLE_1D:
+            return ModelicaStandardTables_CombiTable1D_init2("NoName",
+                "NoName", table, nRow, nCol, cols, nCols, smoothness,
+                extrapolation);
+        default:
+            return ModelicaStandardTables_CombiTable2D_init("NoName",
+                "NoName", table, nRow, nCol, smoothness);
+    }
+}
+
+static void closeTable(int kind, void* tableID) {
+    switch (kind) {
+        case TIME_TABLE:
+            ModelicaStandardTables_CombiTimeTable_close(tableID);
+            break;
+        case TABLE_1D:
+            ModelicaStandardTables_CombiTable1D_close(tableID);
+            break;
+        default:
+            ModelicaStandardTables_CombiTable2D_close(tableID);
+            break;
+    }
+}
+
+static double evaluate(int kind, void* tableID, const double* x, size_t n,
+                       size_t nCols) {
+    double sum = 0.0;
+    size_t k;
+    int i;
+    if (kind == TIME_TABLE) {
+        double nextTimeEvent = -1.0;
+        double tEvent = 0.0;
+        for (k = 0; k < n; k++) {
+            const double t = x[k];
+            if (t >= nextTimeEvent || t < tEvent) {
+                nextTimeEvent = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(
+                    tableID, t);
+                tEvent = t;
+            }
+            for (i = 1; i <= (int)nCols; i++) {
+                sum += ModelicaStandardTables_CombiTimeTable_getValue(tableID,
+                    i, t, nextTimeEvent, nextTimeEvent);
+            }
+        }
+    }
+    else if (kind == TABLE_1D) {
+        for (k = 0; k < n; k++) {
+            for (i = 1; i <= (int)nCols; i++) {
+                sum += ModelicaStandardTables_CombiTable1D_getValue(tableID,
+                    i, x[k]);
+            }
+        }
+    }
+    else {
+        /* Second abscissa: same pattern in reverse order */
+        for (k = 0; k < n; k++) {
+            sum += ModelicaStandardTables_CombiTable2D_getValue(tableID,
+                x[k], x[n - 1 - k]);
+        }
+    }
+    return sum;
+}
+
+static void benchmarkTable(int kind, size_t nRow, size_t nCols, int smoothness,
+                           int extrapolation) {
+    static const char* keys[] = {"rows", "columns", "smoothness",
+        "extrapolation", "evaluations", "nsPerEvaluation", "initSeconds",
+        "memoryBytes", "checksum"};
+    /* CombiTable2D: Square grid of nRow x nCols values */
+    const size_t nCol = nCols + 1;
+    const size_t nRowTable = kind == TABLE_2D ? nRow + 1 : nRow;
+    const size_t nEvalCols = kind == TABLE_2D ? 1 : nCols;
+    const size_t nPoints = N_EVALUATIONS/nEvalCols > 0 ? N_EVALUATIONS/nEvalCols : 1;
+    double* table = createTable(kind, nRowTable, nCol);
+    const double xMin = abscissa(0);
+    const double xMax = abscissa(nRow - 1);
+    double* x = (double*)malloc(nPoints*sizeof(double));
+    int* cols = (int*)malloc(nCols*sizeof(int));
+    void* tableID;
+    size_t i;
+    size_t rss;
+    double t;
+    int pattern;
+
+    if (x == NULL || cols == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < nCols; i++) {
+        cols[i] = (int)i + 2;
+    }
+
+    rss = benchmarkRSS();
+    t = benchmarkTime();
+    tableID = initTable(kind, table, nRowTable, nCol, cols, nCols, smoothness,
+        extrapolation);
+    t = benchmarkTime() - t;
+    rss = benchmarkRSS() - rss;
+
+    for (pattern = 0; pattern < 4; pattern++) {
+        char caseName[128];
+        double values[9];
+        double tEval;
+        size_t n = 0;
+        if (pattern == 3 && extrapolation == 4) {
+            /* Out of range with no extrapolation */
+            continue;
+        }
+        createPattern(pattern, xMin, xMax, x, nPoints);
+        values[8] = 0.0;
+        tEval = benchmarkTime();
+        while (n < nPoints) {
+            const size_t nChunk = nPoints - n < CHUNK ? nPoints - n : CHUNK;
+            values[8] += evaluate(kind, tableID, x + n, nChunk, nEvalCols);
+            n += nChunk;
+            if (benchmarkTime() - tEval > TIME_LIMIT) {
+                break;
+            }
+        }
+        tEval = benchmarkTime() - tEval;
+        sprintf(caseName, "%s_%lux%lu_s%d_e%d_%s", tableNames[kind],
+            (unsigned long)nRow, (unsigned long)nCols, smoothness,
+            extrapolation, patternNames[pattern]);
+        values[0] = (double)nRow;
+        values[1] = (double)nCols;
+        values[2] = (double)smoothness;
+        values[3] = (double)extrapolation;
+        values[4] = (double)(n*nEvalCols);
+        values[5] = 1e9*tEval/(double)(n*nEvalCols);
+        values[6] = t;
+        values[7] = (double)rss;
+        benchmarkReport("tables", caseName, 9, keys, values);
+    }
+
+    closeTable(kind, tableID);
+    free(table);
+    free(x);
+    free(cols);
+}
+
+static double referenceShift(double u, double uMin, double uMax) {
+    /* Shift into the table range by repeated addition of the period */
+    const double T = uMax - uMin;
+    if (u < uMin) {
+        do {
+            u += T;
+        } while (u < uMin);
+    }
+    else if (u > uMax) {
+        do {
+            u -= T;
+        } while (u > uMax);
+    }
+    return u;
+}
+
+static double neighbour(double x, int direction) {
+    /* Floating-point neighbour of x (x != 0) */
+    int e;
+    (void)frexp(x, &e);
+    return x + direction*ldexp(1.0, e - 53);
+}
+
+static int checkPeriodic(void) {
+    unsigned long state = 88172645UL;
+    unsigned long nChecks = 0;
+    unsigned long nFailures = 0;
+    int trial;
+    for (trial = 0; trial < 200; trial++) {
+        double table[2*8];
+        int cols[1] = {2};
+        const int smoothness = trial % 2 == 0 ? 1 : 3;
+        size_t nRow, i;
+        void* tableID;
+        double uMin, uMax, T;
+        int k, direction;
+
+        state = 1103515245UL*state + 12345UL;
+        nRow = 2 + (size_t)(state >> 16) % 7;
+        for (i = 0; i < nRow; i++) {
+            state = 1103515245UL*state + 12345UL;
+            table[2*i] = i == 0 ? 0.25*(double)((int)((state >> 16) % 9) - 4) :
+                table[2*(i - 1)] + 0.125*(double)(1 + (state >> 16) % 4);
+            table[2*i + 1] = (double)((state >> 8) % 101);
+        }
+        tableID = ModelicaStandardTables_CombiTable1D_init2("NoName", "NoName",
+            table, nRow, 2, cols, 1, smoothness, 3);
+        uMin = table[0];
+        uMax = table[2*(nRow - 1)];
+        T = uMax - uMin;
+        for (k = -300; k <= 300; k++) {
+            for (i = 0; i < nRow; i++) {
+                for (direction = -1; direction <= 1; direction++) {
+                    double u = table[2*i] + k*T;
+                    double uRef;
+                    if (u == 0) {
+                        continue;
+                    }
+                    if (direction != 0) {
+                        u = neighbour(u, direction);
+                    }
+                    uRef = referenceShift(u, uMin, uMax);
+                    nChecks++;
+                    if (ModelicaStandardTables_CombiTable1D_getValue(tableID,
+                        1, u) != ModelicaStandardTables_CombiTable1D_getValue(
+                        tableID, 1, uRef) ||
+                        ModelicaStandardTables_CombiTable1D_getDerValue(
+                        tableID, 1, u, 1.0) !=
+                        ModelicaStandardTables_CombiTable1D_getDerValue(
+                        tableID, 1, uRef, 1.0)) {
+                        if (nFailures < 10) {
+                            printf("Mismatch for u = %.17g (shifted to %.17g), "
+                                "table range [%g, %g]\n", u, uRef, uMin,
+                                uMax);
+                        }
+                        nFailures++;
+                    }
+                }
+            }
+        }
+        ModelicaStandardTables_CombiTable1D_close(tableID);
+    }
+    printf("%lu of %lu periodic evaluations differ\n", nFailures, nChecks);
+    return nFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static double evaluateDerivative(int kind, void* tableID, const double* x,
+                                 size_t n, int fused, double* results) {
+    /* Value and (partial) derivatives at x, stored in results */
+    double nextTimeEvent = -1.0;
+    double tEvent = 0.0;
+    double t = benchmarkTime();
+    size_t k;
+    for (k = 0; k < n; k++) {
+        double* r = results + 3*k;
+        if (kind == TIME_TABLE) {
+            if (x[k] >= nextTimeEvent || x[k] < tEvent) {
+                nextTimeEvent = ModelicaStandardTables_CombiTimeTable_nextTimeEvent(
+                    tableID, x[k]);
+                tEvent = x[k];
+            }
+            if (fused) {
+                r[0] = ModelicaStandardTables_CombiTimeTable_getValueAndDer(
+                    tableID, 1, x[k], nextTimeEvent, nextTimeEvent, &r[1]);
+            }
+            else {
+                r[0] = ModelicaStandardTables_CombiTimeTable_getValue(tableID,
+                    1, x[k], nextTimeEvent, nextTimeEvent);
+                r[1] = ModelicaStandardTables_CombiTimeTable_getDerValue(
+                    tableID, 1, x[k], nextTimeEvent, nextTimeEvent, 1.0);
+            }
+            r[2] = 0.0;
+        }
+        else if (kind == TABLE_1D) {
+            if (fused) {
+                r[0] = ModelicaStandardTables_CombiTable1D_getValueAndDer(
+                    tableID, 1, x[k], &r[1]);
+            }
+            else {
+                r[0] = ModelicaStandardTables_CombiTable1D_getValue(tableID,
+                    1, x[k]);
+                r[1] = ModelicaStandardTables_CombiTable1D_getDerValue(
+                    tableID, 1, x[k], 1.0);
+            }
+            r[2] = 0.0;
+        }
+        else {
+            const double u2 = x[n - 1 - k];
+            if (fused) {
+                r[0] = ModelicaStandardTables_CombiTable2D_getValueAndDer(
+                    tableID, x[k], u2, &r[1], &r[2]);
+            }
+            else {
+                r[0] = ModelicaStandardTables_CombiTable2D_getValue(tableID,
+                    x[k], u2);
+                r[1] = ModelicaStandardTables_CombiTable2D_getDerValue(
+                    tableID, x[k], u2, 1.0, 0.0);
+                r[2] = ModelicaStandardTables_CombiTable2D_getDerValue(
+                    tableID, x[k], u2, 0.0, 1.0);
+            }
+        }
+    }
+    return benchmarkTime() - t;
+}
+
+static unsigned long checkDerivativeTable(int kind, size_t nRow,
+                                          int smoothness, int extrapolation) {
+    static const char* keys[] = {"rows", "smoothness", "extrapolation",
+        "evaluations", "nsSeparate", "nsFused", "mismatches"};
+    const size_t nPoints = 20000;
+    const size_t nCol = kind == TABLE_2D ? nRow + 1 : 2;
+    const size_t nRowTable = kind == TABLE_2D ? nRow + 1 : nRow;
+    double* table = createTable(kind, nRowTable, nCol);
+    double* x = (double*)malloc(nPoints*sizeof(double));
+    double* separate = (double*)malloc(3*nPoints*sizeof(double));
+    double* fused = (double*)malloc(3*nPoints*sizeof(double));
+    int cols[1] = {2};
+    unsigned long nMismatches = 0;
+    int pattern;
+
+    if (x == NULL || separate == NULL || fused == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (pattern = 0; pattern < 4; pattern++) {
+        char caseName[128];
+        double values[7];
+        void* tableSeparate;
+        void* tableFused;
+        size_t k;
+        if (pattern == 3 && extrapolation == 4) {
+            continue;
+        }
+        /* Identical sequences of calls on two instances of the table */
+        tableSeparate = initTable(kind, table, nRowTable, nCol, cols, 1,
+            smoothness, extrapolation);
+        tableFused = initTable(kind, table, nRowTable, nCol, cols, 1,
+            smoothness, extrapolation);
+        createPattern(pattern, abscissa(0), abscissa(nRow - 1), x, nPoints);
+        values[4] = evaluateDerivative(kind, tableSeparate, x, nPoints, 0,
+            separate);
+        values[5] = evaluateDerivative(kind, tableFused, x, nPoints, 1,
+            fused);
+        values[6] = 0.0;
+        for (k = 0; k < 3*nPoints; k++) {
+            if (memcmp(&separate[k], &fused[k], sizeof(double)) != 0) {
+                values[6] += 1.0;
+            }
+        }
+        sprintf(caseName, "%s_%lu_s%d_e%d_%s", tableNames[kind],
+            (unsigned long)nRow, smoothness, extrapolation,
+            patternNames[pattern]);
+        values[0] = (double)nRow;
+        values[1] = (double)smoothness;
+        values[2] = (double)extrapolation;
+        values[3] = (double)nPoints;
+        values[4] *= 1e9/(double)nPoints;
+        values[5] *= 1e9/(double)nPoints;
+        benchmarkReport("tablesDerivative", caseName, 7, keys, values);
+        nMismatches += (unsigned long)values[6];
+        closeTable(kind, tableSeparate);
+        closeTable(kind, tableFused);
+    }
+    free(table);
+    free(x);
+    free(separate);
+    free(fused);
+    return nMismatches;
+}
+
+static double* createTableND(size_t nDim, size_t n, size_t* nTable) {
+    /* Table vector of an N-D table with n grid points per axis */
+    size_t nValue = 1;
+    double* table;
+    size_t i, k;
+    for (k = 0; k < nDim; k++) {
+        nValue *= n;
+    }
+    *nTable = 1 + nDim + nDim*n + nValue;
+    table = (double*)malloc(*nTable*sizeof(double));
+    if (table == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    table[0] = (double)nDim;
+    for (k = 0; k < nDim; k++) {
+        table[1 + k] = (double)n;
+        for (i = 0; i < n; i++) {
+            table[1 + nDim + k*n + i] = abscissa(i);
+        }
+    }
+    for (i = 0; i < nValue; i++) {
+        table[1 + nDim + nDim*n + i] = sin(0.37*(double)i) + 1e-3*(double)i;
+    }
+    return table;
+}
+
+static double referenceND(const double* table, size_t nDim, size_t n,
+                          const double* u) {
+    /* Multilinear interpolation in the table vector by binary search and
+       summation over the 2^nDim corners in row-major order */
+    const double* x = &table[1 + nDim];
+    const double* v = &table[1 + nDim + nDim*n];
+    size_t i0[8];
+    double t[8];
+    size_t stride = 1;
+    size_t pos0 = 0;
+    size_t c, k;
+    double y = 0.0;
+    for (k = nDim; k-- > 0;) {
+        size_t lo = 0;
+        size_t hi = n - 1;
+        while (hi > lo + 1) {
+            const size_t mid = (lo + hi)/2;
+            if (u[k] < x[k*n + mid]) {
+                hi = mid;
+            }
+            else {
+                lo = mid;
+            }
+        }
+        i0[k] = stride;
+        t[k] = (u[k] - x[k*n + lo])/(x[k*n + lo + 1] - x[k*n + lo]);
+        pos0 += lo*stride;
+        stride *= n;
+    }
+    for (c = 0; c < ((size_t)1 << nDim); c++) {
+        double w = 1.0;
+        size_t pos = pos0;
+        for (k = 0; k < nDim; k++) {
+            if ((c >> k) & 1) {
+                w *= t[k];
+                pos += i0[k];
+            }
+            else {
+                w *= 1.0 - t[k];
+            }
+        }
+        y += w*v[pos];
+    }
+    return y;
+}
+
+static void benchmarkTableND(size_t nDim, size_t n, int smoothness) {
+    static const char* keys[] = {"dimensions", "gridPoints", "smoothness",
+        "evaluations", "nsPerEvaluation", "nsReference", "initSeconds",
+        "memoryBytes", "maxDifference", "checksum"};
+    const size_t nPoints = N_EVALUATIONS;
+    const double xMin = abscissa(0);
+    const double xMax = abscissa(n - 1);
+    size_t nTable;
+    double* table = createTableND(nDim, n, &nTable);
+    double* p = (double*)malloc(nPoints*sizeof(double));
+    double* u = (double*)malloc(nPoints*nDim*sizeof(double));
+    void* tableID;
+    size_t rss;
+    double t;
+    int pattern;
+
+    if (p == NULL || u == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    rss = benchmarkRSS();
+    t = benchmarkTime();
+    tableID = ModelicaStandardTables_CombiTableND_init("NoName", "NoName",
+        table, nTable, nDim, smoothness, 2);
+    t = benchmarkTime() - t;
+    rss = benchmarkRSS() - rss;
+
+    /* Patterns within the table range, input k is shifted by k*nPoints/nDim
+       values of the pattern */
+    for (pattern = 0; pattern < 3; pattern++) {
+        char caseName[128];
+        double values[10];
+        double tEval;
+        size_t i, k;
+        createPattern(pattern, xMin, xMax, p, nPoints);
+        for (i = 0; i < nPoints; i++) {
+            for (k = 0; k < nDim; k++) {
+                u[i*nDim + k] = p[(i + k*nPoints/nDim) % nPoints];
+            }
+        }
+        values[9] = 0.0;
+        tEval = benchmarkTime();
+        for (i = 0; i < nPoints; i++) {
+            values[9] += ModelicaStandardTables_CombiTableND_getValue(tableID,
+                &u[i*nDim], nDim);
+        }
+        values[4] = 1e9*(benchmarkTime() - tEval)/(double)nPoints;
+        values[5] = 0.0;
+        values[8] = 0.0;
+        if (smoothness == 1) {
+            tEval = benchmarkTime();
+            for (i = 0; i < nPoints; i++) {
+                p[i] = referenceND(table, nDim, n, &u[i*nDim]);
+            }
+            values[5] = 1e9*(benchmarkTime() - tEval)/(double)nPoints;
+            for (i = 0; i < nPoints; i++) {
+                const double d = fabs(ModelicaStandardTables_CombiTableND_getValue(
+                    tableID, &u[i*nDim], nDim) - p[i]);
+                if (d > values[8]) {
+                    values[8] = d;
+                }
+            }
+        }
+        sprintf(caseName, "CombiTableND_%lux%lu_s%d_%s", (unsigned long)nDim,
+            (unsigned long)n, smoothness, patternNames[pattern]);
+        values[0] = (double)nDim;
+        values[1] = (double)n;
+        values[2] = (double)smoothness;
+        values[3] = (double)nPoints;
+        values[6] = t;
+        values[7] = (double)rss;
+        benchmarkReport("tablesND", caseName, 10, keys, values);
+    }
+
+    ModelicaStandardTables_CombiTableND_close(tableID);
+    free(table);
+    free(p);
+    free(u);
+}
+
+static int checkDerivative(void) {
+    unsigned long nMismatches = 0;
+    int kind, smoothness, extrapolation;
+    for (kind = TIME_TABLE; kind <= TABLE_1D; kind++) {
+        for (smoothness = 1; smoothness <= 5; smoothness++) {
+            for (extrapolation = 1; extrapolation <= 4; extrapolation++) {
+                nMismatches += checkDerivativeTable(kind, 1000, smoothness,
+                    extrapolation);
+            }
+        }
+    }
+    for (smoothness = 1; smoothness <= 3; smoothness++) {
+        nMismatches += checkDerivativeTable(TABLE_2D, 100, smoothness, 2);
+    }
+    printf("%lu fused evaluations differ from the separate ones\n",
+        nMismatches);
+    return nMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static unsigned long checkInverseTable(size_t nRow, int smoothness,
+                                       int extrapolation, int sign) {
+    static const char* keys[] = {"rows", "smoothness", "extrapolation",
+        "sign", "evaluations", "nsInverse", "nsNewton", "callsNewton",
+        "maxResidual", "failures"};
+    const size_t nPoints = 20000;
+    const size_t nCol = 2;
+    const double uMin = abscissa(0);
+    const double uMax = abscissa(nRow - 1);
+    double* table = (double*)malloc(nRow*nCol*sizeof(double));
+    double* y = (double*)malloc(nPoints*sizeof(double));
+    double* u = (double*)malloc(nPoints*sizeof(double));
+    int cols[1] = {2};
+    unsigned long nFailures = 0;
+    size_t i;
+    int pattern;
+
+    if (table == NULL || y == NULL || u == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < nRow; i++) {
+        table[i*nCol] = abscissa(i);
+        table[i*nCol + 1] = sign*(2.0*(double)i + sin(0.1*(double)i));
+    }
+    for (pattern = 0; pattern < 3; pattern++) {
+        char caseName[128];
+        double values[10];
+        void* tableID = initTable(TABLE_1D, table, nRow, nCol, cols, 1,
+            smoothness, extrapolation);
+        /* Range of the table values, slightly reduced since the values of
+           the spline pieces at the table ends may differ from the table
+           values by the rounding error of the single precision storage */
+        const double y0 = ModelicaStandardTables_CombiTable1D_getValue(tableID,
+            1, uMin);
+        const double y1 = ModelicaStandardTables_CombiTable1D_getValue(tableID,
+            1, uMax);
+        const double tol = 1e-12*fabs(y1 - y0);
+        double yMin = sign > 0 ? y0 : y1;
+        double yMax = sign > 0 ? y1 : y0;
+        double dy = -1e-6*(yMax - yMin);
+        double calls = 0.0;
+        double uPrev = uMin;
+        double t;
+        size_t k;
+        if (extrapolation == 2) {
+            /* Extrapolated ordinate values */
+            dy = 0.1*(yMax - yMin);
+        }
+        yMin -= dy;
+        yMax += dy;
+        createPattern(pattern, yMin, yMax, y, nPoints);
+
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            u[k] = ModelicaStandardTables_CombiTable1D_getInverseValue(tableID,
+                1, y[k]);
+        }
+        values[5] = benchmarkTime() - t;
+        values[8] = 0.0;
+        values[9] = 0.0;
+        for (k = 0; k < nPoints; k++) {
+            const double r = fabs(ModelicaStandardTables_CombiTable1D_getValue(
+                tableID, 1, u[k]) - y[k]);
+            if (r > values[8]) {
+                values[8] = r;
+            }
+            if (!(r <= tol)) {
+                values[9] += 1.0;
+            }
+        }
+
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            double v = uPrev;
+            int iter;
+            for (iter = 0; iter < 50; iter++) {
+                double dy;
+                const double r = ModelicaStandardTables_CombiTable1D_getValueAndDer(
+                    tableID, 1, v, &dy) - y[k];
+                calls += 1.0;
+                if (fabs(r) <= tol || dy == 0.0) {
+                    break;
+                }
+                v -= r/dy;
+                if (extrapolation != 2) {
+                    /* Within the table range (as by min/max attributes) */
+                    v = v < uMin ? uMin : (v > uMax ? uMax : v);
+                }
+            }
+            uPrev = v;
+        }
+        values[6] = benchmarkTime() - t;
+
+        sprintf(caseName, "CombiTable1D_%lu_s%d_e%d_%s_%s",
+            (unsigned long)nRow, smoothness, extrapolation,
+            sign > 0 ? "increasing" : "decreasing", patternNames[pattern]);
+        values[0] = (double)nRow;
+        values[1] = (double)smoothness;
+        values[2] = (double)extrapolation;
+        values[3] = (double)sign;
+        values[4] = (double)nPoints;
+        values[5] *= 1e9/(double)nPoints;
+        values[6] *= 1e9/(double)nPoints;
+        values[7] = calls/(double)nPoints;
+        benchmarkReport("tablesInverse", caseName, 10, keys, values);
+        nFailures += (unsigned long)values[9];
+        ModelicaStandardTables_CombiTable1D_close(tableID);
+    }
+    free(table);
+    free(y);
+    free(u);
+    return nFailures;
+}
+
+static int checkInverse(void) {
+    static const int smoothnessKinds[] = {1, 2, 4, 5};
+    unsigned long nFailures = 0;
+    int i, extrapolation, sign;
+    for (i = 0; i < 4; i++) {
+        for (extrapolation = 1; extrapolation <= 4; extrapolation++) {
+            for (sign = 1; sign >= -1; sign -= 2) {
+                nFailures += checkInverseTable(1000, smoothnessKinds[i],
+                    extrapolation, sign);
+            }
+        }
+    }
+    printf("%lu inverse evaluations exceed the tolerance\n", nFailures);
+    return nFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static unsigned long checkAkimaTable(size_t n, const char* budget,
+                                     unsigned long* nExpensive) {
+    static const char* keys[] = {"grid", "budgetBytes", "evaluations",
+        "nsEager", "nsLazy", "initSecondsEager", "initSecondsLazy",
+        "memoryBytesEager", "memoryBytesLazy", "differences",
+        "missCostPerCell"};
+    const size_t nPoints = N_EVALUATIONS;
+    const double xMin = abscissa(0);
+    const double xMax = abscissa(n - 1);
+    double* table = createTable(TABLE_2D, n + 1, n + 1);
+    double* x = (double*)malloc(nPoints*sizeof(double));
+    double* y = (double*)malloc(2*nPoints*sizeof(double));
+    const char* env = getenv("MODELICA_TABLE_AKIMA_CACHE");
+    unsigned long nDifferences = 0;
+    size_t k;
+    int pattern;
+
+    if (table == NULL || x == NULL || y == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (pattern = 0; pattern < 3; pattern++) {
+        char caseName[128];
+        double values[11];
+        int lazy;
+        createPattern(pattern, xMin, xMax, x, nPoints);
+        for (lazy = 0; lazy <= 1; lazy++) {
+            /* The budget is read at initialization */
+            size_t rss = benchmarkRSS();
+            double* z = &y[lazy*nPoints];
+            void* tableID;
+            double t;
+            benchmarkSetEnv("MODELICA_TABLE_AKIMA_CACHE", lazy ? budget : "0");
+            t = benchmarkTime();
+            tableID = initTable(TABLE_2D, table, n + 1, n + 1, NULL, 0, 2, 2);
+            values[5 + lazy] = benchmarkTime() - t;
+            t = benchmarkTime();
+            for (k = 0; k < nPoints; k++) {
+                /* Second abscissa: same pattern in reverse order */
+                z[k] = ModelicaStandardTables_CombiTable2D_getValue(tableID,
+                    x[k], x[nPoints - 1 - k]);
+            }
+            values[3 + lazy] = 1e9*(benchmarkTime() - t)/(double)nPoints;
+            /* Including the cached coefficients */
+            rss = benchmarkRSS() - rss;
+            values[7 + lazy] = (double)rss;
+            closeTable(TABLE_2D, tableID);
+        }
+        values[9] = 0.0;
+        for (k = 0; k < nPoints; k++) {
+            if (memcmp(&y[k], &y[nPoints + k], sizeof(double)) != 0) {
+                values[9] += 1.0;
+            }
+        }
+        sprintf(caseName, "CombiTable2D_%lux%lu_akima_%s_%s",
+            (unsigned long)n, (unsigned long)n, budget,
+            patternNames[pattern]);
+        values[0] = (double)n;
+        values[1] = strtod(budget, NULL);
+        values[2] = (double)nPoints;
+        /* Additional time per evaluation relative to the initialization
+           time per grid cell */
+        values[10] = (values[4] - values[3])*
+            (double)((n - 1)*(n - 1))/(1e9*values[5]);
+        benchmarkReport("tablesAkima", caseName, 11, keys, values);
+        nDifferences += (unsigned long)values[9];
+        if (pattern == 2 && values[10] > AKIMA_MISS_COST) {
+            (*nExpensive)++;
+        }
+    }
+    benchmarkSetEnv("MODELICA_TABLE_AKIMA_CACHE", env);
+    free(table);
+    free(x);
+    free(y);
+    return nDifferences;
+}
+
+static int checkAkima(void) {
+    static const size_t grid[] = {100, 316, 1000};
+    static const char* budgets[] = {"262144", "16777216"};
+    unsigned long nDifferences = 0;
+    unsigned long nExpensive = 0;
+    size_t i, j;
+    for (i = 0; i < sizeof(grid)/sizeof(grid[0]); i++) {
+        for (j = 0; j < sizeof(budgets)/sizeof(budgets[0]); j++) {
+            nDifferences += checkAkimaTable(grid[i], budgets[j], &nExpensive);
+        }
+    }
+    printf("%lu on-demand Akima evaluations differ\n", nDifferences);
+    printf("%lu random access cases exceed the miss cost limit\n",
+        nExpensive);
+    return nDifferences == 0 && nExpensive == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static double referenceInterpolate(const double* x, const double* y,
+                                   int nx, double xi, int iLast, int* iNew) {
+    /* Linear search of Modelica.Math.Vectors.interpolate (Modelica code) */
+    int i = iLast < 1 ? 1 : (iLast > nx - 1 ? nx - 1 : iLast);
+    if (xi >= x[i - 1]) {
+        while (i < nx && xi >= x[i - 1]) {
+            i++;
+        }
+        i--;
+    }
+    else {
+        while (i > 1 && xi < x[i - 1]) {
+            i--;
+        }
+    }
+    *iNew = i;
+    return y[i - 1] + (y[i] - y[i - 1])*(xi - x[i - 1])/(x[i] - x[i - 1]);
+}
+
+/* Volatile, such that the call cannot be inlined into the measurement loop */
+static double (*volatile referenceInterpolateCall)(const double* x,
+    const double* y, int nx, double xi, int iLast, int* iNew) =
+    referenceInterpolate;
+
+static unsigned long checkInterpolateVector(size_t n) {
+    static const char* keys[] = {"size", "evaluations", "nsLinear",
+        "nsNative", "nsNativeVector", "differences"};
+    const size_t nPoints = 20000;
+    double* x = (double*)malloc(n*sizeof(double));
+    double* y = (double*)malloc(n*sizeof(double));
+    double* xi = (double*)malloc(nPoints*sizeof(double));
+    double* yi = (double*)malloc(3*nPoints*sizeof(double));
+    unsigned long nDifferences = 0;
+    size_t i;
+    int pattern;
+
+    if (x == NULL || y == NULL || xi == NULL || yi == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    for (i = 0; i < n; i++) {
+        x[i] = abscissa(i);
+        y[i] = sin(1e-2*(double)i);
+    }
+    for (pattern = 0; pattern < 3; pattern++) {
+        char caseName[128];
+        double values[6];
+        double t;
+        int iLast = 1;
+        int iNew = 1;
+        size_t k;
+        /* Including extrapolation */
+        createPattern(pattern, abscissa(0) - 1.0, abscissa(n - 1) + 1.0, xi,
+            nPoints);
+
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            yi[k] = referenceInterpolateCall(x, y, (int)n, xi[k], iLast,
+                &iNew);
+            iLast = iNew;
+        }
+        values[2] = benchmarkTime() - t;
+
+        iLast = 1;
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            yi[nPoints + k] = ModelicaMath_Vectors_interpolate(x, y, n,
+                xi[k], iLast, &iNew);
+            iLast = iNew;
+        }
+        values[3] = benchmarkTime() - t;
+
+        t = benchmarkTime();
+        (void)ModelicaMath_Vectors_interpolateVector(x, y, n, xi, nPoints, 1,
+            &yi[2*nPoints]);
+        values[4] = benchmarkTime() - t;
+
+        values[5] = 0.0;
+        for (k = 0; k < nPoints; k++) {
+            if (memcmp(&yi[k], &yi[nPoints + k], sizeof(double)) != 0 ||
+                memcmp(&yi[k], &yi[2*nPoints + k], sizeof(double)) != 0) {
+                values[5] += 1.0;
+            }
+        }
+        sprintf(caseName, "Vectors_interpolate_%lu_%s", (unsigned long)n,
+            patternNames[pattern]);
+        values[0] = (double)n;
+        values[1] = (double)nPoints;
+        values[2] *= 1e9/(double)nPoints;
+        values[3] *= 1e9/(double)nPoints;
+        values[4] *= 1e9/(double)nPoints;
+        benchmarkReport("vectorsInterpolate", caseName, 6, keys, values);
+        nDifferences += (unsigned long)values[5];
+    }
+    free(x);
+    free(y);
+    free(xi);
+    free(yi);
+    return nDifferences;
+}
+
+static int checkInterpolate(void) {
+    static const size_t sizes[] = {10, 1000, 100000};
+    unsigned long nDifferences = 0;
+    size_t i;
+    for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+        nDifferences += checkInterpolateVector(sizes[i]);
+    }
+    printf("%lu interpolations differ from the linear search\n",
+        nDifferences);
+    return nDifferences == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int sortGreater(double a, double b, int ascending) {
+    /* Element comparison of sortShell: NaN is larger than Inf */
+    if (ascending) {
+        return a != a ? b == b : a > b;
+    }
+    return b != b ? a == a : a < b;
+}
+
+static void sortShell(double* v, int* indices, int n, int ascending) {
+    /* Shellsort of Modelica.Math.Vectors.sort (Modelica code) */
+    int gap = n/2;
+    while (gap > 0) {
+        int i;
+        for (i = gap; i < n; i++) {
+            int j = i - gap;
+            while (j >= 0 && sortGreater(v[j], v[j + gap], ascending)) {
+                double wv = v[j];
+                int wi = indices[j];
+                v[j] = v[j + gap];
+                v[j + gap] = wv;
+                indices[j] = indices[j + gap];
+                indices[j + gap] = wi;
+                j -= gap;
+            }
+        }
+        gap /= 2;
+    }
+}
+
+static unsigned long checkSortResult(const double* v, const double* reference,
+                                     const double* sorted, const int* indices,
+                                     size_t n, int stable) {
+    /* Number of elements differing from the reference, not being
+       v[indices] or, if stable, not keeping the order of equal values */
+    unsigned long nDifferences = 0;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        int differs = indices[i] < 1 || (size_t)indices[i] > n ||
+            memcmp(&sorted[i], &reference[i], sizeof(double)) != 0;
+        if (!differs) {
+            differs = memcmp(&sorted[i], &v[indices[i] - 1],
+                sizeof(double)) != 0;
+        }
+        if (!differs && stable && i > 0 &&
+            memcmp(&sorted[i], &sorted[i - 1], sizeof(double)) == 0) {
+            differs = indices[i] < indices[i - 1];
+        }
+        if (differs) {
+            nDifferences++;
+        }
+    }
+    return nDifferences;
+}
+
+static unsigned long checkSortVector(size_t n) {
+    static const char* keys[] = {"size", "nsShell", "nsNative",
+        "nsNativeStable", "differences"};
+    double* v = (double*)malloc(n*sizeof(double));
+    double* reference = (double*)malloc(n*sizeof(double));
+    double* sorted = (double*)malloc(n*sizeof(double));
+    int* indices = (int*)malloc(n*sizeof(int));
+    const double zero = 0.0;
+    unsigned long nDifferences = 0;
+    size_t i;
+    int ascending;
+
+    if (v == NULL || reference == NULL || sorted == NULL || indices == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    srand(1);
+    for (i = 0; i < n; i++) {
+        /* About n/10 distinct values, every 100th value is NaN */
+        v[i] = i % 100 == 99 ? zero/zero :
+            floor((double)rand()/RAND_MAX*(double)n*0.1) - (double)n*0.05;
+    }
+    for (ascending = 1; ascending >= 0; ascending--) {
+        char caseName[128];
+        double values[5];
+        double t;
+
+        memcpy(reference, v, n*sizeof(double));
+        for (i = 0; i < n; i++) {
+            indices[i] = (int)i + 1;
+        }
+        t = benchmarkTime();
+        sortShell(reference, indices, (int)n, ascending);
+        values[1] = benchmarkTime() - t;
+
+        t = benchmarkTime();
+        ModelicaMath_Vectors_sort(v, n, ascending, 0, sorted,
+            indices);
+        values[2] = benchmarkTime() - t;
+        values[4] = (double)checkSortResult(v, reference, sorted, indices, n,
+            0);
+
+        t = benchmarkTime();
+        ModelicaMath_Vectors_sort(v, n, ascending, 1, sorted,
+            indices);
+        values[3] = benchmarkTime() - t;
+        values[4] += (double)checkSortResult(v, reference, sorted, indices, n,
+            1);
+
+        sprintf(caseName, "Vectors_sort_%lu_%s", (unsigned long)n,
+            ascending ? "ascending" : "descending");
+        values[0] = (double)n;
+        values[1] *= 1e9/(double)n;
+        values[2] *= 1e9/(double)n;
+        values[3] *= 1e9/(double)n;
+        benchmarkReport("vectorsSort", caseName, 5, keys, values);
+        nDifferences += (unsigned long)values[4];
+    }
+    free(v);
+    free(reference);
+    free(sorted);
+    free(indices);
+    return nDifferences;
+}
+
+static int checkSort(void) {
+    static const size_t sizes[] = {10, 1000, 100000, 1000000};
+    unsigned long nDifferences = 0;
+    size_t i;
+    for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+        nDifferences += checkSortVector(sizes[i]);
+    }
+    printf("%lu sorted elements differ from the shellsort\n", nDifferences);
+    return nDifferences == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static unsigned long checkSharedTable(size_t n) {
+    static const char* keys[] = {"grid", "evaluations", "interpolated",
+        "nsCombiTable2D", "nsShared", "nsSharedAndDer", "differences"};
+    const size_t nPoints = N_EVALUATIONS;
+    /* Including values outside of the table range */
+    const double xMin = abscissa(0) - 1.0;
+    const double xMax = abscissa(n - 1) + 1.0;
+    double* table = createTable(TABLE_2D, n + 1, n + 1);
+    double* valid = createTable(TABLE_2D, n + 1, n + 1);
+    double* x = (double*)malloc(nPoints*sizeof(double));
+    double* y = (double*)malloc(6*nPoints*sizeof(double));
+    int* status = (int*)malloc(2*nPoints*sizeof(int));
+    unsigned long nDifferences = 0;
+    void* tableID;
+    void* validID;
+    char tableName[64];
+    char invalidName[64];
+    double dummy;
+    size_t i, j, k;
+    int pattern;
+
+    if (table == NULL || valid == NULL || x == NULL || y == NULL ||
+        status == NULL) {
+        ModelicaError("Not enough memory");
+    }
+    /* Invalid: A band of rows, a band of columns and a diagonal */
+    for (i = 1; i <= n; i++) {
+        for (j = 1; j <= n; j++) {
+            valid[i*(n + 1) + j] = (i > n/3 && i <= n/3 + 2) ||
+                (j > n/2 && j <= n/2 + 3) || i == j ? 0.0 : 1.0;
+        }
+    }
+    /* The shared tables are kept for the process: One name per grid */
+    sprintf(tableName, "value%lu", (unsigned long)n);
+    if (ModelicaStandardTables_SharedTable2D_getValue(tableName, "valid",
+        0.0, 0.0, &dummy) != -1 ||
+        ModelicaStandardTables_SharedTable2D_setTables(tableName, "valid",
+        table, n + 1, n + 1, valid, n + 1, n + 1) != 1) {
+        nDifferences++;
+    }
+    tableID = ModelicaStandardTables_CombiTable2D_init2("NoName", "NoName",
+        table, n + 1, n + 1, 2, 0);
+    validID = ModelicaStandardTables_CombiTable2D_init2("NoName", "NoName",
+        valid, n + 1, n + 1, 1, 0);
+    /* The values of a second call are ignored */
+    for (j = 1; j <= n; j++) {
+        valid[n + 1 + j] = 1.0 - valid[n + 1 + j];
+    }
+    ModelicaStandardTables_SharedTable2D_setTables(tableName, "valid", valid,
+        n + 1, n + 1, valid, n + 1, n + 1);
+    for (j = 1; j <= n; j++) {
+        valid[n + 1 + j] = 1.0 - valid[n + 1 + j];
+    }
+
+    for (pattern = 0; pattern < 3; pattern++) {
+        char caseName[128];
+        double values[7];
+        double t;
+        createPattern(pattern, xMin, xMax, x, nPoints);
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            /* Second abscissa: same pattern in reverse order */
+            const double u1 = x[k];
+            const double u2 = x[nPoints - 1 - k];
+            y[k] = ModelicaStandardTables_CombiTable2D_getValue(tableID, u1,
+                u2);
+            y[nPoints + k] = ModelicaStandardTables_CombiTable2D_getValue(
+                validID, u1, u2);
+        }
+        values[3] = 1e9*(benchmarkTime() - t)/(double)nPoints;
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            status[k] = ModelicaStandardTables_SharedTable2D_getValue(
+                tableName, "valid", x[k], x[nPoints - 1 - k],
+                &y[2*nPoints + k]);
+        }
+        values[4] = 1e9*(benchmarkTime() - t)/(double)nPoints;
+        t = benchmarkTime();
+        for (k = 0; k < nPoints; k++) {
+            status[nPoints + k] =
+                ModelicaStandardTables_SharedTable2D_getValueAndDer(
+                tableName, "valid", x[k], x[nPoints - 1 - k],
+                &y[3*nPoints + k], &y[4*nPoints + k], &y[5*nPoints + k]);
+        }
+        values[5] = 1e9*(benchmarkTime() - t)/(double)nPoints;
+
+        values[2] = 0.0;
+        values[6] = 0.0;
+        for (k = 0; k < nPoints; k++) {
+            const double u1 = x[k];
+            const double u2 = x[nPoints - 1 - k];
+            const int expected = u1 >= abscissa(0) && u1 <= abscissa(n - 1) &&
+                u2 >= abscissa(0) && u2 <= abscissa(n - 1) &&
+                y[nPoints + k] >= 1.0 - 1e-10 ? 1 : 0;
+            if (status[k] != expected || status[nPoints + k] != expected) {
+                values[6] += 1.0;
+            }
+            else if (expected) {
+                double der_y1, der_y2;
+                const double yDer =
+                    ModelicaStandardTables_CombiTable2D_getValueAndDer(tableID,
+                    u1, u2, &der_y1, &der_y2);
+                if (memcmp(&y[k], &y[2*nPoints + k], sizeof(double)) != 0 ||
+                    memcmp(&yDer, &y[3*nPoints + k], sizeof(double)) != 0 ||
+                    memcmp(&der_y1, &y[4*nPoints + k], sizeof(double)) != 0 ||
+                    memcmp(&der_y2, &y[5*nPoints + k], sizeof(double)) != 0) {
+                    values[6] += 1.0;
+                }
+                values[2] += 1.0;
+            }
+        }
+        sprintf(caseName, "SharedTable2D_%lux%lu_%s", (unsigned long)n,
+            (unsigned long)n, patternNames[pattern]);
+        values[0] = (double)n;
+        values[1] = (double)nPoints;
+        benchmarkReport("tablesShared", caseName, 7, keys, values);
+        nDifferences += (unsigned long)values[6];
+    }
+    /* Table values with a non-increasing first row are not interpolated */
+    sprintf(invalidName, "invalid%lu", (unsigned long)n);
+    table[n] = table[n - 1];
+    if (ModelicaStandardTables_SharedTable2D_setTables(invalidName, "",
+        table, n + 1, n + 1, valid, 0, 0) != 0 ||
+        ModelicaStandardTables_SharedTable2D_getValue(invalidName, "",
+        abscissa(1), abscissa(1), &dummy) != 0) {
+        nDifferences++;
+    }
+    ModelicaStandardTables_CombiTable2D_close(tableID);
+    ModelicaStandardTables_CombiTable2D_close(validID);
+    free(table);
+    free(valid);
+    free(x);
+    free(y);
+    free(status);
+    return nDifferences;
+}
+
+static int checkShared(void) {
+    static const size_t grid[] = {100, 316, 1000};
+    unsigned long nDifferences = 0;
+    size_t i;
+    for (i = 0; i < sizeof(grid)/sizeof(grid[0]); i++) {
+        nDifferences += checkSharedTable(grid[i]);
+    }
+    printf("%lu shared table evaluations differ\n", nDifferences);
+    return nDifferences == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    static const size_t rowsDefault[] = {100, 10000, 1000000, 0};
+    static const size_t rowsQuick[] = {100, 10000, 0};
+    static const size_t rowsFull[] = {100, 10000, 1000000, 100000000, 0};
+    static const size_t colsDefault[] = {1, 10, 1000, 0};
+    static const size_t colsQuick[] = {1, 10, 0};
+    /* CombiTable2D: 1e2 to 1e8 grid values */
+    static const size_t gridDefault[] = {10, 100, 1000, 3162, 0};
+    static const size_t gridQuick[] = {10, 100, 0};
+    static const size_t gridFull[] = {10, 100, 1000, 3162, 10000, 0};
+    /* CombiTableND: 1e3 to 1e7 grid values of 3 and 5 dimensions */
+    static const size_t grid3Default[] = {10, 46, 215, 0};
+    static const size_t grid3Quick[] = {10, 46, 0};
+    static const size_t grid5[] = {4, 10, 25};
+    const size_t* rows = rowsDefault;
+    const size_t* columns = colsDefault;
+    const size_t* grid = gridDefault;
+    const size_t* grid3 = grid3Default;
+    double maxValues = 1e7;
+    const char* only = NULL;
+    int argi;
+    int kind;
+    size_t i, j;
+    int smoothness, extrapolation;
+
+    for (argi = 1; argi < argc; argi++) {
+        if (strcmp(argv[argi], "-periodic") == 0) {
+            return checkPeriodic();
+        }
+        else if (strcmp(argv[argi], "-derivative") == 0) {
+            return checkDerivative();
+        }
+        else if (strcmp(argv[argi], "-inverse") == 0) {
+            return checkInverse();
+        }
+        else if (strcmp(argv[argi], "-akima") == 0) {
+            return checkAkima();
+        }
+        else if (strcmp(argv[argi], "-interpolate") == 0) {
+            return checkInterpolate();
+        }
+        else if (strcmp(argv[argi], "-sort") == 0) {
+            return checkSort();
+        }
+        else if (strcmp(argv[argi], "-shared") == 0) {
+            return checkShared();
+        }
+        else if (strcmp(argv[argi], "-quick") == 0) {
+            rows = rowsQuick;
+            columns = colsQuick;
+            grid = gridQuick;
+            grid3 = grid3Quick;
+        }
+        else if (strcmp(argv[argi], "-full") == 0) {
+            rows = rowsFull;
+            grid = gridFull;
+            maxValues = 2e8;
+        }
+        else {
+            only = argv[argi];
+        }
+    }
+
+    for (kind = TIME_TABLE; kind <= TABLE_1D; kind++) {
+        if (only != NULL && strcmp(only, tableNames[kind]) != 0) {
+            continue;
+        }
+        for (i = 0; rows[i] > 0; i++) {
+            for (j = 0; columns[j] > 0; j++) {
+                if ((double)rows[i]*(double)columns[j] > maxValues) {
+                    continue;
+                }
+                for (smoothness = 1; smoothness <= 5; smoothness++) {
+                    for (extrapolation = 1; extrapolation <= 4; extrapolation++) {
+                        benchmarkTable(kind, rows[i], columns[j], smoothness,
+                            extrapolation);
+                    }
+                }
+            }
+        }
+    }
+    if (only == NULL || strcmp(only, tableNames[TABLE_2D]) == 0) {
+        for (i = 0; grid[i] > 0; i++) {
+            for (smoothness = 1; smoothness <= 3; smoothness++) {
+                /* Extrapolation is always linear */
+                benchmarkTable(TABLE_2D, grid[i], grid[i], smoothness, 2);
+            }
+        }
+    }
+    if (only == NULL || strcmp(only, "CombiTableND") == 0) {
+        for (i = 0; grid3[i] > 0; i++) {
+            for (smoothness = 1; smoothness <= 3; smoothness++) {
+                benchmarkTableND(3, grid3[i], smoothness);
+                benchmarkTableND(5, grid5[i], smoothness);
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
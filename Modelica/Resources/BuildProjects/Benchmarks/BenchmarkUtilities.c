@@ -0,0 +1,223 @@
+/* BenchmarkUtilities.c - Support functions for the benchmarks of the
+                          external C-code of the Modelica Standard Library
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "ModelicaUtilities.h"
+#include "BenchmarkUtilities.h"
+
+/* --------------------- ModelicaUtilities.h ------------------------------------------ */
+
+void ModelicaMessage(const char *string) {
+    fputs(string, stderr);
+}
+
+void ModelicaVFormatMessage(const char *string, va_list args) {
+    vfprintf(stderr, string, args);
+}
+
+void ModelicaFormatMessage(const char *string, ...) {
+    va_list args;
+    va_start(args, string);
+    vfprintf(stderr, string, args);
+    va_end(args);
+}
+
+/* Target of the errors raised within benchmarkCatchError */
+static jmp_buf* errorJump = NULL;
+static char* errorMessage = NULL;
+static size_t errorMessageSize = 0;
+
+MODELICA_NORETURN void ModelicaVFormatError(const char *string, va_list args) {
+    if (errorJump != NULL) {
+        if (errorMessageSize > 0) {
+            vsnprintf(errorMessage, errorMessageSize, string, args);
+        }
+        longjmp(*errorJump, 1);
+    }
+    vfprintf(stderr, string, args);
+    fputc('\n', stderr);
+    exit(EXIT_FAILURE);
+}
+
+MODELICA_NORETURN void ModelicaError(const char *string) {
+    ModelicaFormatError("%s", string);
+}
+
+MODELICA_NORETURN void ModelicaFormatError(const char *string, ...) {
+    va_list args;
+    va_start(args, string);
+    ModelicaVFormatError(string, args);
+    va_end(args);
+}
+
+char* ModelicaAllocateStringWithErrorReturn(size_t len) {
+    /* Strings are leaked on purpose as the tool would free them only
+       at the end of the simulation */
+    return (char*)malloc(len + 1);
+}
+
+char* ModelicaAllocateString(size_t len) {
+    char* str = ModelicaAllocateStringWithErrorReturn(len);
+    if (str == NULL) {
+        ModelicaError("Memory allocation error\n");
+    }
+    return str;
+}
+
+/* --------------------- Benchmark support -------------------------------------------- */
+
+double benchmarkTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
+}
+
+size_t benchmarkPeakRSS(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss*1024;
+#endif
+}
+
+size_t benchmarkRSS(void) {
+#if defined(__linux__)
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    FILE* fp = fopen("/proc/self/statm", "r");
+    if (fp != NULL) {
+        if (fscanf(fp, "%lu %lu", &size, &resident) != 2) {
+            resident = 0;
+        }
+        fclose(fp);
+    }
+    return (size_t)resident*(size_t)sysconf(_SC_PAGESIZE);
+#else
+    return benchmarkPeakRSS();
+#endif
+}
+
+void benchmarkDropCache(const char* fileName) {
+#if defined(POSIX_FADV_DONTNEED)
+    int fd = open(fileName, O_RDONLY);
+    if (fd >= 0) {
+        /* Dirty pages cannot be dropped */
+        (void)fdatasync(fd);
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+void benchmarkSetEnv(const char* name, const char* value) {
+    if (value != NULL) {
+        (void)setenv(name, value, 1);
+    }
+    else {
+        (void)unsetenv(name);
+    }
+}
+
+void benchmarkWriteFile(const char* fileName, size_t size) {
+    unsigned long state = 88172645UL;
+    unsigned long buf[8192];
+    FILE* fp = fopen(fileName, "wb");
+    if (fp == NULL) {
+        ModelicaFormatError("Not possible to open file \"%s\" for writing", fileName);
+    }
+    while (size > 0) {
+        size_t i;
+        size_t n = size < sizeof(buf) ? size : sizeof(buf);
+        for (i = 0; i < sizeof(buf)/sizeof(buf[0]); i++) {
+            /* xorshift */
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            buf[i] = state;
+        }
+        if (fwrite(buf, 1, n, fp) != n) {
+            fclose(fp);
+            ModelicaFormatError("Not possible to write to file \"%s\"", fileName);
+        }
+        size -= n;
+    }
+    fclose(fp);
+}
+
+int benchmarkCatchError(void (*func)(void*), void* data, char* msg,
+                        size_t msgSize) {
+    jmp_buf jump;
+    jmp_buf* volatile outerJump = errorJump;
+    char* volatile outerMessage = errorMessage;
+    volatile size_t outerMessageSize = errorMessageSize;
+    int caught = 0;
+
+    if (msgSize > 0) {
+        msg[0] = '\0';
+    }
+    if (setjmp(jump) == 0) {
+        errorJump = &jump;
+        errorMessage = msg;
+        errorMessageSize = msgSize;
+        func(data);
+    }
+    else {
+        caught = 1;
+    }
+    errorJump = outerJump;
+    errorMessage = outerMessage;
+    errorMessageSize = outerMessageSize;
+    return caught;
+}
+
+void benchmarkReport(const char* name, const char* caseName, size_t nValues,
+                     const char** keys, const double* values) {
+    size_t i;
+    printf("{\"benchmark\":\"%s\",\"case\":\"%s\"", name, caseName);
+    for (i = 0; i < nValues; i++) {
+        printf(",\"%s\":%.10g", keys[i], values[i]);
+    }
+    printf("}\n");
+    fflush(stdout);
+}
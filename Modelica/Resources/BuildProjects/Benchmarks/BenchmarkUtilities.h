@@ -0,0 +1,72 @@
+/* BenchmarkUtilities.h - Support functions for the benchmarks of the
+                          external C-code of the Modelica Standard Library
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* The benchmarks are stand-alone executables (POSIX only) that link the
+   external C-code directly. This file provides a minimal implementation of
+   the ModelicaUtilities.h interface (errors terminate the benchmark, unless
+   caught by benchmarkCatchError),
+   a monotonic timer and helpers to emit the results as one JSON object
+   per line, such that they can be collected for regression tracking.
+*/
+
+#ifndef BENCHMARK_UTILITIES_H
+#define BENCHMARK_UTILITIES_H
+
+#include <stddef.h>
+
+/* Monotonic time in seconds */
+double benchmarkTime(void);
+
+/* Peak resident set size of the process in bytes */
+size_t benchmarkPeakRSS(void);
+
+/* Current resident set size of the process in bytes (Linux, else the
+   peak resident set size) */
+size_t benchmarkRSS(void);
+
+/* Remove the pages of a file from the page cache (cold-cache runs) */
+void benchmarkDropCache(const char* fileName);
+
+/* Write a file of the given size with pseudo-random contents */
+void benchmarkWriteFile(const char* fileName, size_t size);
+
+/* Set (value != NULL) or remove (value == NULL) an environment variable */
+void benchmarkSetEnv(const char* name, const char* value);
+
+/* Call func(data) and return 1 if it raised a Modelica error (the message
+   is stored in msg) or 0 otherwise. Memory allocated before the error is
+   not freed. */
+int benchmarkCatchError(void (*func)(void*), void* data, char* msg,
+                        size_t msgSize);
+
+/* Emit one result record as JSON line to stdout:
+   {"benchmark":name,"case":caseName,key[0]:value[0],...} */
+void benchmarkReport(const char* name, const char* caseName, size_t nValues,
+                     const char** keys, const double* values);
+
+#endif
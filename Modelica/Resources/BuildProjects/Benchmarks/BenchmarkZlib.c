@@ -0,0 +1,438 @@
+/* BenchmarkZlib.c - Verification and benchmark of the checksum kernels of zlib
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Usage: BenchmarkZlib [-check]
+
+   Verifies that adler32_z and crc32_z (with the run-time selected SIMD
+   kernels) are bit-exact to the byte-wise reference definitions for all
+   lengths up to 4 KB, all buffer alignments, chunked (incremental) updates,
+   extreme byte values and a 64 MB buffer.
+   Verifies that inflate reproduces deflated table data (smooth and noisy
+   double columns) for all compression levels and window sizes when fed with
+   small input chunks (as ModelicaMatIO does) and small or large output
+   chunks.
+   Measures the throughput of the checksums, of deflate (with a checksum of
+   the compressed stream to detect changes of the output) and of inflate,
+   where inflateBack serves as reference for the portable inflate_fast().
+   With -check the benchmark part is skipped and the exit code reports the
+   result of the verification.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "zlib.h"
+#include "BenchmarkUtilities.h"
+
+static unsigned long adler32Reference(unsigned long adler,
+                                      const unsigned char* buf, size_t len) {
+    unsigned long a = adler & 0xffff;
+    unsigned long b = (adler >> 16) & 0xffff;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        a = (a + buf[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return a | (b << 16);
+}
+
+static unsigned long crc32Reference(unsigned long crc,
+                                    const unsigned char* buf, size_t len) {
+    size_t i;
+    int k;
+    crc = ~crc & 0xffffffffUL;
+    for (i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xedb88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc & 0xffffffffUL;
+}
+
+static int nFailures = 0;
+
+static void compare(const char* what, size_t len, size_t offset,
+                    unsigned long expected, unsigned long actual) {
+    if (expected != actual) {
+        if (nFailures < 20) {
+            fprintf(stderr, "%s mismatch: len=%lu, offset=%lu, expected=%08lx, actual=%08lx\n",
+                what, (unsigned long)len, (unsigned long)offset, expected, actual);
+        }
+        nFailures++;
+    }
+}
+
+static void check(unsigned char* data, size_t size) {
+    size_t len;
+    size_t offset;
+    size_t split;
+
+    /* All lengths and alignments */
+    for (len = 0; len <= 4096; len++) {
+        for (offset = 0; offset < 64; offset += (len < 512 ? 1 : 17)) {
+            const unsigned char* buf = data + offset;
+            compare("adler32", len, offset, adler32Reference(1, buf, len),
+                adler32_z(1, buf, len));
+            compare("crc32", len, offset, crc32Reference(0, buf, len),
+                crc32_z(0, buf, len));
+        }
+    }
+
+    /* Incremental updates with non-trivial start values */
+    for (split = 1; split < 3000; split = split*3 + 1) {
+        unsigned long a = 1;
+        unsigned long c = 0;
+        size_t pos = 0;
+        len = 100000;
+        while (pos < len) {
+            size_t n = pos + split > len ? len - pos : split;
+            a = adler32_z(a, data + pos, n);
+            c = crc32_z(c, data + pos, n);
+            pos += n;
+        }
+        compare("adler32 (chunked)", len, split, adler32Reference(1, data, len), a);
+        compare("crc32 (chunked)", len, split, crc32Reference(0, data, len), c);
+    }
+
+    /* Start values close to the modulus */
+    compare("adler32 (start)", 5000, 0, adler32Reference(0xfff0fff0UL, data, 5000),
+        adler32_z(0xfff0fff0UL, data, 5000));
+
+    /* Large buffer (several NMAX blocks per call) */
+    compare("adler32 (large)", size, 0, adler32Reference(1, data, size),
+        adler32_z(1, data, size));
+    compare("crc32 (large)", size, 0, crc32Reference(0, data, size),
+        crc32_z(0, data, size));
+
+    /* Worst case for the intermediate sums: all bytes 255 */
+    memset(data, 0xff, 1 << 20);
+    compare("adler32 (0xff)", 1 << 20, 0, adler32Reference(1, data, 1 << 20),
+        adler32_z(1, data, 1 << 20));
+    compare("crc32 (0xff)", 1 << 20, 0, crc32Reference(0, data, 1 << 20),
+        crc32_z(0, data, 1 << 20));
+}
+
+static void makeTable(unsigned char* data, size_t size, int noisy) {
+    /* Column-major table of doubles: time, smooth signals, step signals and
+       (optionally) measurement noise */
+    double* x = (double*)data;
+    size_t n = size/sizeof(double);
+    size_t nRow = n/8;
+    size_t i;
+    size_t j;
+    unsigned long state = 88172645UL;
+    for (j = 0; j < 8; j++) {
+        for (i = 0; i < nRow; i++) {
+            double t = 0.001*(double)i;
+            double v = j == 0 ? t : (j % 3 == 0 ? floor(j*sin(t)) : sin(j*t));
+            if (noisy && j > 0) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                v += 1e-3*(double)(state % 1000);
+            }
+            x[j*nRow + i] = v;
+        }
+    }
+}
+
+static size_t deflateTable(const unsigned char* data, size_t size,
+                           unsigned char* comp, size_t compSize,
+                           int level, int windowBits) {
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (deflateInit2(&z, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+    z.next_in = (Bytef*)data;
+    z.avail_in = (uInt)size;
+    z.next_out = comp;
+    z.avail_out = (uInt)compSize;
+    if (deflate(&z, Z_FINISH) != Z_STREAM_END) {
+        deflateEnd(&z);
+        return 0;
+    }
+    deflateEnd(&z);
+    return compSize - z.avail_out;
+}
+
+static int inflateTable(const unsigned char* comp, size_t compSize,
+                        unsigned char* out, size_t size, int windowBits,
+                        size_t inChunk, size_t outChunk) {
+    z_stream z;
+    int err = Z_OK;
+    size_t pos = 0;
+    memset(&z, 0, sizeof(z));
+    if (inflateInit2(&z, windowBits) != Z_OK) {
+        return 0;
+    }
+    z.next_out = out;
+    for (;;) {
+        size_t nOut = size - (size_t)(z.next_out - out);
+        if (z.avail_in == 0 && pos < compSize) {
+            z.avail_in = (uInt)(compSize - pos < inChunk ? compSize - pos : inChunk);
+            z.next_in = (Bytef*)comp + pos;
+            pos += z.avail_in;
+        }
+        z.avail_out = (uInt)(nOut < outChunk ? nOut : outChunk);
+        err = inflate(&z, Z_NO_FLUSH);
+        if (err == Z_STREAM_END || (err != Z_OK && err != Z_BUF_ERROR) ||
+            (err == Z_BUF_ERROR && (pos == compSize || nOut == 0))) {
+            break;
+        }
+    }
+    inflateEnd(&z);
+    return err == Z_STREAM_END && (size_t)(z.next_out - out) == size;
+}
+
+static void checkInflate(void) {
+    const size_t size = 1 << 20;
+    const size_t compSize = size + 1024;
+    const size_t inChunks[] = {1024, 7, 1 << 20};
+    const size_t outChunks[] = {1 << 20, 300, 4096, 65536};
+    unsigned char* data = (unsigned char*)malloc(size);
+    unsigned char* comp = (unsigned char*)malloc(compSize);
+    unsigned char* out = (unsigned char*)malloc(size);
+    int noisy;
+    int level;
+    int windowBits;
+    size_t i;
+    size_t k;
+
+    if (data == NULL || comp == NULL || out == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        exit(EXIT_FAILURE);
+    }
+    for (noisy = 0; noisy < 2; noisy++) {
+        makeTable(data, size, noisy);
+        for (level = 1; level <= 9; level += 4) {
+            for (windowBits = 9; windowBits <= 15; windowBits += 3) {
+                size_t n = deflateTable(data, size, comp, compSize, level, windowBits);
+                if (n == 0) {
+                    fprintf(stderr, "deflate failed\n");
+                    nFailures++;
+                    continue;
+                }
+                for (i = 0; i < sizeof(inChunks)/sizeof(inChunks[0]); i++) {
+                    for (k = 0; k < sizeof(outChunks)/sizeof(outChunks[0]); k++) {
+                        memset(out, 0, size);
+                        if (!inflateTable(comp, n, out, size, windowBits, inChunks[i], outChunks[k]) ||
+                            memcmp(data, out, size) != 0) {
+                            if (nFailures < 20) {
+                                fprintf(stderr, "inflate mismatch: noisy=%d, level=%d, "
+                                    "windowBits=%d, inChunk=%lu, outChunk=%lu\n", noisy,
+                                    level, windowBits, (unsigned long)inChunks[i],
+                                    (unsigned long)outChunks[k]);
+                            }
+                            nFailures++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    free(data);
+    free(comp);
+    free(out);
+}
+
+typedef struct OutDesc {
+    unsigned char* out;
+    size_t pos;
+} OutDesc;
+
+static unsigned inflateBackIn(void* desc, z_const unsigned char** buf) {
+    (void)desc;
+    (void)buf;
+    return 0;
+}
+
+static int inflateBackOut(void* desc, unsigned char* buf, unsigned len) {
+    OutDesc* o = (OutDesc*)desc;
+    memcpy(o->out + o->pos, buf, len);
+    o->pos += len;
+    return 0;
+}
+
+static void benchmarkInflate(const char* caseName, const unsigned char* data,
+                             size_t size, int noisy) {
+    const char* keys[] = {"bytes", "ratio", "seconds", "MBps"};
+    double values[4];
+    const size_t compSize = size + size/100 + 1024;
+    unsigned char* comp = (unsigned char*)malloc(compSize);
+    unsigned char* out = (unsigned char*)malloc(size);
+    unsigned char* window = (unsigned char*)malloc(1 << 15);
+    size_t n;
+    int i;
+    int nRepeat = 5;
+    double t;
+    char name[64];
+
+    if (comp == NULL || out == NULL || window == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        exit(EXIT_FAILURE);
+    }
+    n = deflateTable(data, size, comp, compSize, Z_DEFAULT_COMPRESSION, -15);
+    values[0] = (double)size;
+    values[1] = n > 0 ? (double)size/(double)n : 0;
+
+    /* inflate (as ModelicaMatIO: 1 KB input chunks, whole output buffer) */
+    t = benchmarkTime();
+    for (i = 0; i < nRepeat; i++) {
+        inflateTable(comp, n, out, size, -15, 1024, size);
+    }
+    t = (benchmarkTime() - t)/nRepeat;
+    values[2] = t;
+    values[3] = t > 0 ? (double)size/(1024.0*1024.0)/t : 0;
+    sprintf(name, "%s%s", caseName, noisy ? "_noisy" : "");
+    benchmarkReport("inflate", name, 4, keys, values);
+
+    /* inflateBack (portable inflate_fast) */
+    t = benchmarkTime();
+    for (i = 0; i < nRepeat; i++) {
+        z_stream z;
+        OutDesc o;
+        memset(&z, 0, sizeof(z));
+        o.out = out;
+        o.pos = 0;
+        inflateBackInit(&z, 15, window);
+        z.next_in = comp;
+        z.avail_in = (uInt)n;
+        inflateBack(&z, inflateBackIn, NULL, inflateBackOut, &o);
+        inflateBackEnd(&z);
+    }
+    t = (benchmarkTime() - t)/nRepeat;
+    values[2] = t;
+    values[3] = t > 0 ? (double)size/(1024.0*1024.0)/t : 0;
+    benchmarkReport("inflateBack", name, 4, keys, values);
+
+    free(comp);
+    free(out);
+    free(window);
+}
+
+static void benchmarkDeflate(const char* caseName, const unsigned char* data,
+                             size_t size, int noisy, int level) {
+    const char* keys[] = {"bytes", "level", "ratio", "crc", "seconds", "MBps"};
+    double values[6];
+    const size_t compSize = size + size/100 + 1024;
+    unsigned char* comp = (unsigned char*)malloc(compSize);
+    size_t n = 0;
+    double t;
+    char name[64];
+
+    if (comp == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        exit(EXIT_FAILURE);
+    }
+    t = benchmarkTime();
+    n = deflateTable(data, size, comp, compSize, level, 15);
+    t = benchmarkTime() - t;
+    values[0] = (double)size;
+    values[1] = level;
+    values[2] = n > 0 ? (double)size/(double)n : 0;
+    /* Checksum of the compressed stream to detect changes of the output */
+    values[3] = (double)crc32(0L, comp, (uInt)n);
+    values[4] = t;
+    values[5] = t > 0 ? (double)size/(1024.0*1024.0)/t : 0;
+    sprintf(name, "%s%s", caseName, noisy ? "_noisy" : "");
+    benchmarkReport("deflate", name, 6, keys, values);
+    free(comp);
+}
+
+static void benchmarkChecksum(const char* caseName, const unsigned char* data,
+                              size_t size, int crc) {
+    const char* keys[] = {"bytes", "seconds", "MBps"};
+    double values[3];
+    unsigned long sum = 0;
+    int i;
+    int nRepeat = size < 1024*1024 ? 10000 : 10;
+    double t = benchmarkTime();
+    for (i = 0; i < nRepeat; i++) {
+        sum += crc ? crc32_z(0, data, size) : adler32_z(1, data, size);
+    }
+    t = (benchmarkTime() - t)/nRepeat;
+    values[0] = (double)size;
+    values[1] = t;
+    values[2] = t > 0 ? (double)size/(1024.0*1024.0)/t : 0;
+    benchmarkReport(crc ? "crc32" : "adler32", caseName, 3, keys, values);
+    if (sum == 42) {
+        /* Prevent the calls from being optimized away */
+        printf("\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const size_t size = 64*1024*1024;
+    unsigned char* data = (unsigned char*)malloc(size);
+    size_t i;
+    unsigned long state = 2463534242UL;
+
+    if (data == NULL) {
+        fprintf(stderr, "Not enough memory\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < size; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        data[i] = (unsigned char)(state >> 11);
+    }
+
+    if (argc == 1) {
+        benchmarkChecksum("64MB", data, size, 0);
+        benchmarkChecksum("64MB", data, size, 1);
+        benchmarkChecksum("4KB", data, 4096, 0);
+        benchmarkChecksum("4KB", data, 4096, 1);
+        makeTable(data, size, 0);
+        benchmarkDeflate("16MB", data, size/4, 0, Z_DEFAULT_COMPRESSION);
+        benchmarkDeflate("16MB", data, size/4, 0, 9);
+        benchmarkInflate("64MB", data, size, 0);
+        makeTable(data, size, 1);
+        benchmarkDeflate("16MB", data, size/4, 1, Z_DEFAULT_COMPRESSION);
+        benchmarkDeflate("16MB", data, size/4, 1, 9);
+        benchmarkInflate("64MB", data, size, 1);
+        for (i = 0; i < size; i++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            data[i] = (unsigned char)(state >> 11);
+        }
+    }
+
+    check(data, size);
+    checkInflate();
+    free(data);
+    if (nFailures > 0) {
+        fprintf(stderr, "%d checksum or inflate mismatches\n", nFailures);
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "Checksums are bit-exact and inflate is lossless\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/* ModelicaCPUDispatch.h - Run-time selection of SIMD kernels
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* The libraries are built without -march (or /arch) options, such that the
+   same binaries run on every x86/x64 CPU. Kernels that benefit from wider
+   vector instructions are therefore compiled in several variants (with
+   MODELICA_CPU_TARGET) and one variant is selected when the library is
+   loaded. Each C-file keeps its own function pointers, filled from tables
+   indexed by the instruction set level:
+
+   #include "ModelicaCPUDispatch.h"
+
+   static void kernel_generic(double* x, size_t n);
+   #if defined(MODELICA_CPU_X86)
+   MODELICA_CPU_TARGET("avx2") static void kernel_avx2(double* x, size_t n);
+   static void (* const kernelVariants[MODELICA_CPU_LEVELS])(double*, size_t) = {
+       kernel_generic, kernel_generic, kernel_avx2, kernel_avx2
+   };
+   #endif
+   static void (*kernel)(double*, size_t) = kernel_generic;
+
+   #if defined(MODELICA_CPU_X86) && defined(G_HAS_CONSTRUCTORS)
+   G_DEFINE_CONSTRUCTOR(selectKernels)
+   static void selectKernels(void) {
+       kernel = kernelVariants[ModelicaCPU_level()];
+   }
+   #endif
+
+   The tables are indexed by MODELICA_CPU_GENERIC ... MODELICA_CPU_AVX512;
+   a level without a dedicated variant repeats the variant of the level
+   below. Without constructor support the generic variant is used.
+
+   The environment variable MODELICA_CPU_LEVEL (generic, sse2, avx2 or
+   avx512) lowers the selected level, e.g., to test the generic kernels on
+   a recent CPU. A level above the one supported by the CPU is ignored.
+
+   Code with a finer-grained choice of kernels (zlib) derives its feature
+   flags from ModelicaCPU_cpuid and ModelicaCPU_levelLimit instead of
+   querying the CPU and the environment on its own.
+
+   Define NO_SIMD to build the generic kernels only.
+*/
+
+#ifndef MODELICA_CPU_DISPATCH_H
+#define MODELICA_CPU_DISPATCH_H
+
+#define MODELICA_CPU_GENERIC (0) /* Plain C */
+#define MODELICA_CPU_SSE2 (1)    /* SSE2 (every x64 CPU) */
+#define MODELICA_CPU_AVX2 (2)    /* AVX2 */
+#define MODELICA_CPU_AVX512 (3)  /* AVX-512F and AVX-512BW */
+#define MODELICA_CPU_LEVELS (4)
+
+#if !defined(NO_SIMD) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64)) && \
+    ((defined(__GNUC__) && !defined(__clang__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+     (defined(__clang__) && __clang_major__ >= 4) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1700))
+#define MODELICA_CPU_X86
+#if !defined(_MSC_VER) || _MSC_VER >= 1911
+/* Compiler provides the AVX-512F and AVX-512BW intrinsics, otherwise the
+   AVX2 variants are used at level MODELICA_CPU_AVX512 */
+#define MODELICA_CPU_X86_AVX512
+#endif
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
+#undef MODELICA_CPU_X86_AVX512
+#endif
+#endif
+
+#if defined(MODELICA_CPU_X86)
+
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MODELICA_CPU_TARGET(isa)
+#else
+#include <cpuid.h>
+#define MODELICA_CPU_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+static void ModelicaCPU_cpuid(unsigned int r1[4], unsigned int r7[4],
+                              unsigned int* xcr0) {
+    /* Return the registers eax, ebx, ecx and edx of the cpuid leaves 1 and 7
+       (sub-leaf 0) and the XCR0 register (zero if not available) */
+#if defined(_MSC_VER)
+    int r[4];
+    int maxLeaf;
+    memset(r1, 0, 4*sizeof(unsigned int));
+    memset(r7, 0, 4*sizeof(unsigned int));
+    *xcr0 = 0;
+    __cpuid(r, 0);
+    maxLeaf = r[0];
+    if (maxLeaf >= 1) {
+        __cpuid(r, 1);
+        memcpy(r1, r, 4*sizeof(unsigned int));
+    }
+    if (maxLeaf >= 7) {
+        __cpuidex(r, 7, 0);
+        memcpy(r7, r, 4*sizeof(unsigned int));
+    }
+    if ((r1[2] & (1u << 27)) != 0) { /* OSXSAVE */
+        *xcr0 = (unsigned int)_xgetbv(0);
+    }
+#else
+    const unsigned int maxLeaf = __get_cpuid_max(0, NULL);
+    memset(r1, 0, 4*sizeof(unsigned int));
+    memset(r7, 0, 4*sizeof(unsigned int));
+    *xcr0 = 0;
+    if (maxLeaf >= 1) {
+        __cpuid(1, r1[0], r1[1], r1[2], r1[3]);
+    }
+    if (maxLeaf >= 7) {
+        __cpuid_count(7, 0, r7[0], r7[1], r7[2], r7[3]);
+    }
+    if ((r1[2] & (1u << 27)) != 0) { /* OSXSAVE */
+        unsigned int edx;
+        __asm__ ("xgetbv" : "=a" (*xcr0), "=d" (edx) : "c" (0));
+        (void)edx;
+    }
+#endif
+}
+
+static int ModelicaCPU_levelLimit(void) {
+    /* Return the level set by the environment variable MODELICA_CPU_LEVEL
+       or MODELICA_CPU_AVX512 if it is not set (or invalid) */
+    static const char* names[MODELICA_CPU_LEVELS] = {
+        "generic", "sse2", "avx2", "avx512"
+    };
+    const char* env = getenv("MODELICA_CPU_LEVEL");
+    if (env != NULL) {
+        int i;
+        for (i = 0; i < MODELICA_CPU_LEVELS; i++) {
+            if (strcmp(env, names[i]) == 0) {
+                return i;
+            }
+        }
+    }
+    return MODELICA_CPU_AVX512;
+}
+
+static int ModelicaCPU_level(void) {
+    /* Return the highest level supported by the CPU and the OS, limited
+       by the environment variable MODELICA_CPU_LEVEL */
+    int level = MODELICA_CPU_GENERIC;
+    int limit;
+    unsigned int r1[4]; /* Leaf 1: eax, ebx, ecx, edx */
+    unsigned int r7[4]; /* Leaf 7, sub-leaf 0 */
+    unsigned int xcr0;
+
+    ModelicaCPU_cpuid(r1, r7, &xcr0);
+    if ((r1[3] & (1u << 26)) != 0) { /* SSE2 */
+        level = MODELICA_CPU_SSE2;
+        /* AVX2 and the OS saves the XMM and YMM registers */
+        if ((r7[1] & (1u << 5)) != 0 && (xcr0 & 0x06) == 0x06) {
+            level = MODELICA_CPU_AVX2;
+            /* AVX-512F, AVX-512BW and the OS saves the opmask and ZMM
+               registers */
+            if ((r7[1] & (1u << 16)) != 0 && (r7[1] & (1u << 30)) != 0 &&
+                (xcr0 & 0xe6) == 0xe6) {
+                level = MODELICA_CPU_AVX512;
+            }
+        }
+    }
+
+    limit = ModelicaCPU_levelLimit();
+    return level < limit ? level : limit;
+}
+
+#else
+
+#define MODELICA_CPU_TARGET(isa)
+
+#endif
+
+#endif
@@ -61,6 +61,8 @@
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
+#include "gconstructor.h"
+#include "ModelicaCPUDispatch.h"
 
 #if !defined(MODELICA_EXPORT)
 #   define MODELICA_EXPORT
@@ -251,6 +253,100 @@ static void kf_bfly4(
     } while(--k);
 }
 
+/* SSE2 variants of kf_bfly2 and kf_bfly4 (one complex number per register).
+   They perform exactly the same floating point operations as the generic
+   code (no FMA), such that the results are bit-identical. AVX2 variants
+   with two complex numbers per register were not faster, since the
+   twiddle factors are not contiguous for fstride > 1. */
+#if defined(MODELICA_CPU_X86)
+MODELICA_CPU_TARGET("sse2") static __m128d kf_cmul_sse2(__m128d a, __m128d b) {
+    /* (a.r*b.r - a.i*b.i, a.i*b.r + a.r*b.i) */
+    const __m128d sign = _mm_set_pd(0.0, -0.0);
+    const __m128d t1 = _mm_mul_pd(a, _mm_unpacklo_pd(b, b));
+    const __m128d t2 = _mm_mul_pd(_mm_shuffle_pd(a, a, 1), _mm_unpackhi_pd(b, b));
+    return _mm_add_pd(t1, _mm_xor_pd(t2, sign));
+}
+
+MODELICA_CPU_TARGET("sse2") static void kf_bfly2_sse2(
+    mrkiss_fft_cpx * Fout,
+    const size_t fstride,
+    const mrkiss_fft_cfg st,
+    int m
+) {
+    double * F = (double *)Fout;
+    const double * tw1 = (const double *)st->twiddles;
+    int k;
+
+    for (k = 0; k < m; ++k) {
+        const __m128d f = _mm_loadu_pd(F + 2*k);
+        const __m128d t = kf_cmul_sse2(_mm_loadu_pd(F + 2*(k + m)), _mm_loadu_pd(tw1));
+        tw1 += 2*fstride;
+        _mm_storeu_pd(F + 2*(k + m), _mm_sub_pd(f, t));
+        _mm_storeu_pd(F + 2*k, _mm_add_pd(f, t));
+    }
+}
+
+MODELICA_CPU_TARGET("sse2") static void kf_bfly4_sse2(
+    mrkiss_fft_cpx * Fout,
+    const size_t fstride,
+    const mrkiss_fft_cfg st,
+    const size_t m
+) {
+    /* Forward: (s4.i, -s4.r), inverse: (-s4.i, s4.r) */
+    const __m128d rot = st->inverse ? _mm_set_pd(0.0, -0.0) : _mm_set_pd(-0.0, 0.0);
+    const double * tw1 = (const double *)st->twiddles;
+    const double * tw2 = tw1;
+    const double * tw3 = tw1;
+    double * F = (double *)Fout;
+    size_t k;
+
+    for (k = 0; k < m; ++k, F += 2) {
+        __m128d f = _mm_loadu_pd(F);
+        const __m128d s0 = kf_cmul_sse2(_mm_loadu_pd(F + 2*m), _mm_loadu_pd(tw1));
+        const __m128d s1 = kf_cmul_sse2(_mm_loadu_pd(F + 4*m), _mm_loadu_pd(tw2));
+        const __m128d s2 = kf_cmul_sse2(_mm_loadu_pd(F + 6*m), _mm_loadu_pd(tw3));
+        const __m128d s5 = _mm_sub_pd(f, s1);
+        const __m128d s3 = _mm_add_pd(s0, s2);
+        const __m128d s4 = _mm_sub_pd(s0, s2);
+        const __m128d s4rot = _mm_xor_pd(_mm_shuffle_pd(s4, s4, 1), rot);
+        tw1 += 2*fstride;
+        tw2 += 4*fstride;
+        tw3 += 6*fstride;
+        f = _mm_add_pd(f, s1);
+        _mm_storeu_pd(F + 4*m, _mm_sub_pd(f, s3));
+        _mm_storeu_pd(F, _mm_add_pd(f, s3));
+        _mm_storeu_pd(F + 2*m, _mm_add_pd(s5, s4rot));
+        _mm_storeu_pd(F + 6*m, _mm_sub_pd(s5, s4rot));
+    }
+}
+
+static void (* const kf_bfly2_variants[MODELICA_CPU_LEVELS])(mrkiss_fft_cpx *,
+    const size_t, const mrkiss_fft_cfg, int) = {
+    kf_bfly2, kf_bfly2_sse2, kf_bfly2_sse2, kf_bfly2_sse2
+};
+static void (* const kf_bfly4_variants[MODELICA_CPU_LEVELS])(mrkiss_fft_cpx *,
+    const size_t, const mrkiss_fft_cfg, const size_t) = {
+    kf_bfly4, kf_bfly4_sse2, kf_bfly4_sse2, kf_bfly4_sse2
+};
+#endif
+
+static void (*kf_bfly2_kernel)(mrkiss_fft_cpx *, const size_t,
+    const mrkiss_fft_cfg, int) = kf_bfly2;
+static void (*kf_bfly4_kernel)(mrkiss_fft_cpx *, const size_t,
+    const mrkiss_fft_cfg, const size_t) = kf_bfly4;
+
+#if defined(MODELICA_CPU_X86) && defined(G_HAS_CONSTRUCTORS)
+#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(kf_select_kernels)
+#endif
+G_DEFINE_CONSTRUCTOR(kf_select_kernels)
+static void kf_select_kernels(void) {
+    const int level = ModelicaCPU_level();
+    kf_bfly2_kernel = kf_bfly2_variants[level];
+    kf_bfly4_kernel = kf_bfly4_variants[level];
+}
+#endif
+
 static void kf_bfly3(
     mrkiss_fft_cpx * Fout,
     const size_t fstride,
@@ -437,13 +533,13 @@ static void kf_work(
     /* recombine the p smaller DFTs */
     switch (p) {
         case 2:
-            kf_bfly2(Fout,fstride,st,m);
+            kf_bfly2_kernel(Fout,fstride,st,m);
             break;
         case 3:
             kf_bfly3(Fout,fstride,st,m);
             break;
         case 4:
-            kf_bfly4(Fout,fstride,st,m);
+            kf_bfly4_kernel(Fout,fstride,st,m);
             break;
         case 5:
             kf_bfly5(Fout,fstride,st,m);
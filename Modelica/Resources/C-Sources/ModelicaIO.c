@@ -106,13 +106,50 @@ MODELICA_EXPORT double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
     _In_z_ const char* matrixName, _Out_ size_t* m, _Out_ size_t* n,
     int verbose) {
     ModelicaNotExistError("ModelicaIO_readRealTable"); return NULL; }
+MODELICA_EXPORT double* ModelicaIO_readRealTable2(_In_z_ const char* fileName,
+    _In_z_ const char* matrixName, _Out_ size_t* m, _Out_ size_t* n,
+    int verbose, _Inout_ ModelicaIOLoadEvent* event) {
+    ModelicaNotExistError("ModelicaIO_readRealTable2"); return NULL; }
+MODELICA_EXPORT double* ModelicaIO_readRealTableColumns(_In_z_ const char* fileName,
+    _In_z_ const char* matrixName, _Out_ size_t* m, _Out_ size_t* n,
+    _In_ const size_t* columns, size_t nColumns, int verbose,
+    _Inout_ ModelicaIOLoadEvent* event) {
+    ModelicaNotExistError("ModelicaIO_readRealTableColumns"); return NULL; }
+MODELICA_EXPORT double* ModelicaIO_readRealTableUpdate(_In_z_ const char* fileName,
+    _In_z_ const char* matrixName, _Out_ size_t* m, _Out_ size_t* n,
+    const size_t* columns, size_t nColumns, const double* table, int verbose,
+    _Inout_ ModelicaIOTableState* state, _Inout_ ModelicaIOLoadEvent* event) {
+    ModelicaNotExistError("ModelicaIO_readRealTableUpdate"); return NULL; }
+MODELICA_EXPORT int ModelicaIO_isTableFileUnchanged(_In_z_ const char* fileName,
+    _In_ const ModelicaIOTableState* state) {
+    return 0; }
+MODELICA_EXPORT void ModelicaIO_setLoadCallback(ModelicaIOLoadCallback callback,
+    void* userData) {
+}
+MODELICA_EXPORT void ModelicaIO_reportLoadEvent(_In_ const ModelicaIOLoadEvent* event) {
+}
 #else
 
 #include <stdio.h>
+#include <sys/stat.h>
 #if !defined(NO_LOCALE)
 #include <locale.h>
 #endif
 #include "ModelicaMatIO.h"
+#include "gconstructor.h"
+#define MODELICA_PROFILE_MODULE "ModelicaIO"
+#define MODELICA_PROFILE_FUNCTIONS(F) \
+    F(ModelicaIO_readMatrixSizes) \
+    F(ModelicaIO_readRealMatrix) \
+    F(ModelicaIO_writeRealMatrix) \
+    F(ModelicaIO_readRealTable) \
+    F(ModelicaIO_readRealTable2) \
+    F(ModelicaIO_readRealTableColumns) \
+    F(ModelicaIO_readRealTableUpdate) \
+    F(ModelicaIO_isTableFileUnchanged)
+#define MODELICA_PROFILE_COUNTERS(C)
+#define MODELICA_PROFILE_CLOCK
+#include "ModelicaProfiling.h"
 
 /* The standard way to detect posix is to check _POSIX_VERSION,
  * which is defined in <unistd.h>
@@ -124,6 +161,55 @@ MODELICA_EXPORT double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
 #define _POSIX_ 1
 #endif
 
+/* Mutex for the load callback and the file of load events */
+#if defined(_POSIX_)
+#include <pthread.h>
+#if defined(G_HAS_CONSTRUCTORS)
+static pthread_mutex_t m;
+G_DEFINE_CONSTRUCTOR(initializeMutex)
+static void initializeMutex(void) {
+    if (pthread_mutex_init(&m, NULL) != 0) {
+        ModelicaError("Initialization of mutex failed\n");
+    }
+}
+G_DEFINE_DESTRUCTOR(destroyMutex)
+static void destroyMutex(void) {
+    if (pthread_mutex_destroy(&m) != 0) {
+        ModelicaError("Destruction of mutex failed\n");
+    }
+}
+#else
+static pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#define MUTEX_LOCK() pthread_mutex_lock(&m)
+#define MUTEX_UNLOCK() pthread_mutex_unlock(&m)
+#elif defined(_WIN32) && defined(G_HAS_CONSTRUCTORS)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+static CRITICAL_SECTION cs;
+#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(initializeCS)
+#endif
+G_DEFINE_CONSTRUCTOR(initializeCS)
+static void initializeCS(void) {
+    InitializeCriticalSection(&cs);
+}
+#ifdef G_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_DESTRUCTOR_PRAGMA_ARGS(deleteCS)
+#endif
+G_DEFINE_DESTRUCTOR(deleteCS)
+static void deleteCS(void) {
+    DeleteCriticalSection(&cs);
+}
+#define MUTEX_LOCK() EnterCriticalSection(&cs)
+#define MUTEX_UNLOCK() LeaveCriticalSection(&cs)
+#else
+#define MUTEX_LOCK()
+#define MUTEX_UNLOCK()
+#endif
+
 /* Use re-entrant string tokenize function if available */
 #if defined(_POSIX_)
 #elif defined(_MSC_VER) && _MSC_VER >= 1400
@@ -139,15 +225,40 @@ MODELICA_EXPORT double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
 #define MATLAB_NAME_LENGTH_MAX (64)
 #endif
 
+/* Hash of the table lines of an ASCII text file (with the offset basis and
+   prime of the 64-bit FNV hash) */
+#define HASH_LINE_INIT (14695981039346656037ULL)
+#define HASH_LINE_PRIME (1099511628211ULL)
+
 typedef struct MatIO {
     mat_t* mat; /* Pointer to MAT-file */
     matvar_t* matvar; /* Pointer to MAT-file variable for data */
     matvar_t* matvarRoot; /* Pointer to MAT-file variable for free */
 } MatIO;
 
+static ModelicaIOLoadCallback loadCallback = NULL;
+static void* loadCallbackUserData = NULL;
+
+static double* readRealTable(_In_z_ const char* fileName,
+                             _In_z_ const char* tableName,
+                             _Out_ size_t* m, _Out_ size_t* n,
+                             const size_t* columns, size_t nColumns,
+                             const double* prevTable,
+                             ModelicaIOTableState* state, int verbose,
+                             _Inout_ ModelicaIOLoadEvent* event);
+  /* Read all (nColumns = 0) or the selected columns of a table from file
+     and fill in the load event and, if not NULL, the table state
+
+     <- RETURN: Pointer to array (row-wise storage) of table values
+  */
+
 static double* readMatTable(_In_z_ const char* tableName, _In_z_ const char* fileName,
-                            _Out_ size_t* m, _Out_ size_t* n) MODELICA_NONNULLATTR;
-  /* Read a table from a MATLAB MAT-file using MatIO functions
+                            _Out_ size_t* m, _Out_ size_t* n,
+                            const size_t* columns, size_t nColumns,
+                            _Inout_ ModelicaIOLoadEvent* event);
+  /* Read a table from a MATLAB MAT-file using MatIO functions. If nColumns
+     is not 0 only the selected columns are read (as linear slabs of
+     runs of consecutive columns).
 
      <- RETURN: Pointer to array (row-wise storage) of table values
   */
@@ -156,8 +267,15 @@ static void readMatIO(_In_z_ const char* fileName, _In_z_ const char* matrixName
   /* Read a variable from a MATLAB MAT-file using MatIO functions */
 
 static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fileName,
-                            _Out_ size_t* m, _Out_ size_t* n) MODELICA_NONNULLATTR;
-  /* Read a table from an ASCII text file
+                            _Out_ size_t* m, _Out_ size_t* n,
+                            const size_t* columns, size_t nColumns,
+                            const double* prevTable,
+                            ModelicaIOTableState* state,
+                            _Inout_ ModelicaIOLoadEvent* event);
+  /* Read a table from an ASCII text file. If nColumns is not 0 only the
+     numbers of the selected columns are converted and stored. If state is
+     not NULL the read is continued after the rows of prevTable if their
+     lines are unchanged since the read described by state.
 
      <- RETURN: Pointer to array (row-wise storage) of table values
   */
@@ -168,12 +286,34 @@ static int readLine(_In_ char** buf, _In_ int* bufLen, _In_ FILE* fp) MODELICA_N
 static int IsNumber(char* token);
   /*  Check, whether a token represents a floating-point number */
 
+static unsigned long long hashLine(unsigned long long hash,
+                                   _In_z_ const char* line) MODELICA_NONNULLATTR;
+  /* Continue the hash of the table lines with a line (without line break) */
+
+static int fileStamp(_In_z_ const char* fileName,
+                     _Out_ unsigned long long* size,
+                     _Out_ unsigned long long* time) MODELICA_NONNULLATTR;
+  /* Get size and modification time (in ns) of a file
+
+     <- RETURN: = 0, if the file status could be obtained
+  */
+
 static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) MODELICA_NONNULLATTR;
   /* Cycle-based in-place array transposition */
 
+static size_t escapeString(_Out_ char* buffer, _In_z_ const char* string,
+                           char quote) MODELICA_NONNULLATTR;
+  /* Copy string enclosed in quotes to buffer, escaping quotes (and, for JSON,
+     backslashes and control characters). The buffer must hold at least
+     6*strlen(string) + 3 characters.
+
+     <- RETURN: Number of characters copied (without the terminating '\0')
+  */
+
 MODELICA_EXPORT void ModelicaIO_readMatrixSizes(_In_z_ const char* fileName,
                                 _In_z_ const char* matrixName,
                                 _Out_ int* dim) {
+    MODELICA_PROFILE_BEGIN();
     MatIO matio = {NULL, NULL, NULL};
 
     dim[0] = 0;
@@ -189,12 +329,14 @@ MODELICA_EXPORT void ModelicaIO_readMatrixSizes(_In_z_ const char* fileName,
 
     Mat_VarFree(matio.matvarRoot);
     (void)Mat_Close(matio.mat);
+    MODELICA_PROFILE_END(ModelicaIO_readMatrixSizes);
 }
 
 MODELICA_EXPORT void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
                                _In_z_ const char* matrixName,
                                _Out_ double* matrix, size_t m, size_t n,
                                int verbose) {
+    MODELICA_PROFILE_BEGIN();
     MatIO matio = {NULL, NULL, NULL};
     int tableReadError = 0;
 
@@ -255,6 +397,7 @@ MODELICA_EXPORT void ModelicaIO_readRealMatrix(_In_z_ const char* fileName,
             "from file \"%s\"\n", matrixName, (unsigned long)m,
             (unsigned long)n, fileName);
     }
+    MODELICA_PROFILE_END(ModelicaIO_readRealMatrix);
 }
 
 MODELICA_EXPORT int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
@@ -262,6 +405,7 @@ MODELICA_EXPORT int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
                                _In_ double* matrix, size_t m, size_t n,
                                int append,
                                _In_z_ const char* version) {
+    MODELICA_PROFILE_BEGIN();
     int status;
     mat_t* mat;
     matvar_t* matvar;
@@ -330,6 +474,7 @@ MODELICA_EXPORT int ModelicaIO_writeRealMatrix(_In_z_ const char* fileName,
         ModelicaFormatError("Cannot write variable \"%s\" to \"%s\"\n", matrixName, fileName);
         return 0;
     }
+    MODELICA_PROFILE_END(ModelicaIO_writeRealMatrix);
     return 1;
 }
 
@@ -337,9 +482,83 @@ MODELICA_EXPORT double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
                                  _In_z_ const char* tableName,
                                  _Out_ size_t* m, _Out_ size_t* n,
                                  int verbose) {
+    MODELICA_PROFILE_BEGIN();
+    double* table;
+    ModelicaIOLoadEvent event;
+    const unsigned long long start = ModelicaProfile_now();
+
+    memset(&event, 0, sizeof(ModelicaIOLoadEvent));
+    event.shared = -1;
+    table = ModelicaIO_readRealTable2(fileName, tableName, m, n, verbose, &event);
+    event.totalTime = 1e-9*(double)(ModelicaProfile_now() - start);
+    ModelicaIO_reportLoadEvent(&event);
+    MODELICA_PROFILE_END(ModelicaIO_readRealTable);
+    return table;
+}
+
+MODELICA_EXPORT double* ModelicaIO_readRealTable2(_In_z_ const char* fileName,
+                                  _In_z_ const char* tableName,
+                                  _Out_ size_t* m, _Out_ size_t* n,
+                                  int verbose,
+                                  _Inout_ ModelicaIOLoadEvent* event) {
+    MODELICA_PROFILE_BEGIN();
+    double* table = readRealTable(fileName, tableName, m, n, NULL, 0, NULL,
+        NULL, verbose, event);
+    MODELICA_PROFILE_END(ModelicaIO_readRealTable2);
+    return table;
+}
+
+MODELICA_EXPORT double* ModelicaIO_readRealTableColumns(_In_z_ const char* fileName,
+                                        _In_z_ const char* tableName,
+                                        _Out_ size_t* m, _Out_ size_t* n,
+                                        _In_ const size_t* columns,
+                                        size_t nColumns, int verbose,
+                                        _Inout_ ModelicaIOLoadEvent* event) {
+    MODELICA_PROFILE_BEGIN();
+    double* table = readRealTable(fileName, tableName, m, n, columns,
+        nColumns, NULL, NULL, verbose, event);
+    MODELICA_PROFILE_END(ModelicaIO_readRealTableColumns);
+    return table;
+}
+
+MODELICA_EXPORT double* ModelicaIO_readRealTableUpdate(_In_z_ const char* fileName,
+                                       _In_z_ const char* tableName,
+                                       _Out_ size_t* m, _Out_ size_t* n,
+                                       const size_t* columns, size_t nColumns,
+                                       const double* table, int verbose,
+                                       _Inout_ ModelicaIOTableState* state,
+                                       _Inout_ ModelicaIOLoadEvent* event) {
+    MODELICA_PROFILE_BEGIN();
+    double* tableNew = readRealTable(fileName, tableName, m, n, columns,
+        nColumns, table, state, verbose, event);
+    MODELICA_PROFILE_END(ModelicaIO_readRealTableUpdate);
+    return tableNew;
+}
+
+MODELICA_EXPORT int ModelicaIO_isTableFileUnchanged(_In_z_ const char* fileName,
+                                    _In_ const ModelicaIOTableState* state) {
+    MODELICA_PROFILE_BEGIN();
+    int unchanged = 0;
+    unsigned long long size;
+    unsigned long long time;
+    if (state->fileSize > 0 && 0 == fileStamp(fileName, &size, &time)) {
+        unchanged = size == state->fileSize && time == state->fileTime;
+    }
+    MODELICA_PROFILE_END(ModelicaIO_isTableFileUnchanged);
+    return unchanged;
+}
+
+static double* readRealTable(_In_z_ const char* fileName,
+                             _In_z_ const char* tableName,
+                             _Out_ size_t* m, _Out_ size_t* n,
+                             const size_t* columns, size_t nColumns,
+                             const double* prevTable,
+                             ModelicaIOTableState* state, int verbose,
+                             _Inout_ ModelicaIOLoadEvent* event) {
     double* table = NULL;
     const char* ext;
     int isMatExt = 0;
+    unsigned long long start;
 
     /* Table file can be either ASCII text or binary MATLAB MAT-file */
     ext = strrchr(fileName, '.');
@@ -356,26 +575,223 @@ MODELICA_EXPORT double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
             tableName, fileName);
     }
 
+    event->fileName = fileName;
+    event->tableName = tableName;
+    start = ModelicaProfile_now();
+    if (state != NULL) {
+        /* Status of the file before the read, such that a change during
+           the read is detected by the next check */
+        if (0 != fileStamp(fileName, &state->fileSize, &state->fileTime)) {
+            state->fileSize = 0;
+            state->fileTime = 0;
+        }
+        state->nRowKept = 0;
+    }
     if (isMatExt == 1) {
-        table = readMatTable(fileName, tableName, m, n);
+        table = readMatTable(tableName, fileName, m, n, columns, nColumns,
+            event);
+        if (state != NULL) {
+            /* The read of a MAT-file cannot be continued */
+            state->nRow = 0;
+        }
     }
     else {
-        table = readTxtTable(fileName, tableName, m, n);
+        table = readTxtTable(tableName, fileName, m, n, columns, nColumns,
+            prevTable, state, event);
     }
+    event->readTime = 1e-9*(double)(ModelicaProfile_now() - start) -
+        event->transposeTime;
+    event->nRow = *m;
+    event->nCol = *n;
     return table;
 }
 
+MODELICA_EXPORT void ModelicaIO_setLoadCallback(ModelicaIOLoadCallback callback,
+                                void* userData) {
+    MUTEX_LOCK();
+    loadCallback = callback;
+    loadCallbackUserData = userData;
+    MUTEX_UNLOCK();
+}
+
+MODELICA_EXPORT void ModelicaIO_reportLoadEvent(_In_ const ModelicaIOLoadEvent* event) {
+    ModelicaIOLoadCallback callback;
+    void* userData;
+    const char* sink;
+
+    MUTEX_LOCK();
+    callback = loadCallback;
+    userData = loadCallbackUserData;
+    MUTEX_UNLOCK();
+    if (NULL != callback) {
+        callback(event, userData);
+    }
+
+    sink = getenv("MODELICA_LOAD_EVENTS");
+    if (NULL != sink && '\0' != sink[0]) {
+        const char* fileName = NULL != event->fileName ? event->fileName : "";
+        const char* tableName = NULL != event->tableName ? event->tableName : "";
+        const size_t len = strlen(sink);
+        const int csv = len > 4 && (0 == strcmp(sink + len - 4, ".csv") ||
+            0 == strcmp(sink + len - 4, ".CSV"));
+        /* The record is formatted first and written by a single fputs, such
+           that records of concurrent writers are not interleaved. Besides
+           the escaped names it needs less than 512 characters. */
+        char* record = (char*)malloc(
+            6*(strlen(fileName) + strlen(tableName)) + 512);
+        if (NULL != record) {
+            FILE* fp;
+            size_t n;
+            if (csv) {
+                n = escapeString(record, fileName, '"');
+                record[n++] = ',';
+                n += escapeString(record + n, tableName, '"');
+                sprintf(record + n, ",%lu,%lu,%lu,%d,%.9g,%.9g,%.9g,%.9g\n",
+                    (unsigned long)event->bytes, (unsigned long)event->nRow,
+                    (unsigned long)event->nCol, event->shared, event->readTime,
+                    event->transposeTime, event->splineTime, event->totalTime);
+            }
+            else {
+                strcpy(record, "{\"fileName\":");
+                n = strlen(record);
+                n += escapeString(record + n, fileName, '\\');
+                strcpy(record + n, ",\"tableName\":");
+                n += strlen(record + n);
+                n += escapeString(record + n, tableName, '\\');
+                sprintf(record + n, ",\"bytes\":%lu,\"nRow\":%lu,\"nCol\":%lu,"
+                    "\"shared\":%d,\"readTime\":%.9g,\"transposeTime\":%.9g,"
+                    "\"splineTime\":%.9g,\"totalTime\":%.9g}\n",
+                    (unsigned long)event->bytes, (unsigned long)event->nRow,
+                    (unsigned long)event->nCol, event->shared, event->readTime,
+                    event->transposeTime, event->splineTime, event->totalTime);
+            }
+            MUTEX_LOCK();
+            fp = fopen(sink, "a");
+            if (NULL != fp) {
+                if (csv) {
+                    /* Only serialized within the process, the header may
+                       hence be written more than once by several processes */
+                    fseek(fp, 0, SEEK_END);
+                    if (ftell(fp) == 0) {
+                        fputs("fileName,tableName,bytes,nRow,nCol,shared,"
+                            "readTime,transposeTime,splineTime,totalTime\n", fp);
+                    }
+                }
+                fputs(record, fp);
+                fclose(fp);
+            }
+            MUTEX_UNLOCK();
+            free(record);
+        }
+    }
+}
+
+static size_t escapeString(_Out_ char* buffer, _In_z_ const char* string,
+                           char quote) {
+    /* quote is '"' for CSV (quotes are doubled) and '\\' for JSON */
+    size_t n = 0;
+    buffer[n++] = '"';
+    for (; '\0' != *string; string++) {
+        const unsigned char c = (unsigned char)*string;
+        if (c == '"') {
+            buffer[n++] = quote;
+            buffer[n++] = '"';
+        }
+        else if (quote == '\\' && c == '\\') {
+            buffer[n++] = '\\';
+            buffer[n++] = '\\';
+        }
+        else if (quote == '\\' && c < 0x20) {
+            sprintf(buffer + n, "\\u%04x", (unsigned int)c);
+            n += 6;
+        }
+        else {
+            buffer[n++] = (char)c;
+        }
+    }
+    buffer[n++] = '"';
+    buffer[n] = '\0';
+    return n;
+}
+
 static double* readMatTable(_In_z_ const char* tableName, _In_z_ const char* fileName,
-                            _Out_ size_t* m, _Out_ size_t* n) {
+                            _Out_ size_t* m, _Out_ size_t* n,
+                            const size_t* columns, size_t nColumns,
+                            _Inout_ ModelicaIOLoadEvent* event) {
     double* table = NULL;
     MatIO matio = {NULL, NULL, NULL};
     int tableReadError = 0;
+#if defined(_WIN32)
+    struct _stat fileInfo;
+#else
+    struct stat fileInfo;
+#endif
 
     *m = 0;
     *n = 0;
 
     readMatIO(fileName, tableName, &matio);
-    if (NULL != matio.matvar) {
+    if (NULL != matio.matvar && nColumns > 0 && matio.matvar->dims[0] > 0) {
+        matvar_t* matvar = matio.matvar;
+        const size_t nRow = matvar->dims[0];
+        double* buffer = NULL;
+        size_t j;
+
+        if (columns[0] < 1 || columns[nColumns - 1] > matvar->dims[1]) {
+            const size_t nCol = matvar->dims[1];
+            Mat_VarFree(matio.matvarRoot);
+            (void)Mat_Close(matio.mat);
+            ModelicaFormatError("The column index %lu is out of range "
+                "for table matrix \"%s(%lu,%lu)\".\n", (unsigned long)(
+                columns[0] < 1 ? columns[0] : columns[nColumns - 1]),
+                tableName, (unsigned long)nRow, (unsigned long)nCol);
+            return NULL;
+        }
+        table = (double*)malloc(nRow*nColumns*sizeof(double));
+        if (matvar->compression != MAT_COMPRESSION_NONE && nColumns > 1) {
+            /* Each read of compressed data inflates the data from its
+               beginning -> read the range of the selected columns at once */
+            buffer = (double*)malloc(
+                nRow*(columns[nColumns - 1] - columns[0] + 1)*sizeof(double));
+        }
+        if (table == NULL || (buffer == NULL &&
+            matvar->compression != MAT_COMPRESSION_NONE && nColumns > 1)) {
+            free(table);
+            Mat_VarFree(matio.matvarRoot);
+            (void)Mat_Close(matio.mat);
+            ModelicaError("Memory allocation error\n");
+            return NULL;
+        }
+
+        if (buffer != NULL) {
+            tableReadError = Mat_VarReadDataLinear(matio.mat, matvar, buffer,
+                (int)((columns[0] - 1)*nRow), 1,
+                (int)((columns[nColumns - 1] - columns[0] + 1)*nRow));
+            for (j = 0; j < nColumns; j++) {
+                memcpy(&table[j*nRow], &buffer[(columns[j] - columns[0])*nRow],
+                    nRow*sizeof(double));
+            }
+            free(buffer);
+        }
+        else {
+            /* Column-major storage -> Each run of consecutive columns is
+               read as contiguous (linear) slab */
+            j = 0;
+            while (tableReadError == 0 && j < nColumns) {
+                size_t k = j + 1;
+                while (k < nColumns && columns[k] == columns[k - 1] + 1) {
+                    k++;
+                }
+                tableReadError = Mat_VarReadDataLinear(matio.mat, matvar,
+                    &table[j*nRow], (int)((columns[j] - 1)*nRow), 1,
+                    (int)((k - j)*nRow));
+                j = k;
+            }
+        }
+        *m = nRow;
+        *n = nColumns;
+    }
+    else if (NULL != matio.matvar) {
         matvar_t* matvar = matio.matvar;
 
         table = (double*)malloc(matvar->dims[0]*matvar->dims[1]*sizeof(double));
@@ -403,7 +819,16 @@ static double* readMatTable(_In_z_ const char* tableName, _In_z_ const char* fil
 
     if (tableReadError == 0 && NULL != table) {
         /* Array is stored column-wise -> need to transpose */
+        const unsigned long long start = ModelicaProfile_now();
         transpose(table, *m, *n);
+        event->transposeTime = 1e-9*(double)(ModelicaProfile_now() - start);
+#if defined(_WIN32)
+        if (0 == _stat(fileName, &fileInfo)) {
+#else
+        if (0 == stat(fileName, &fileInfo)) {
+#endif
+            event->bytes = (size_t)fileInfo.st_size;
+        }
     }
     else {
         size_t dim[2];
@@ -583,7 +1008,11 @@ static int IsNumber(char* token) {
 }
 
 static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fileName,
-                            _Out_ size_t* m, _Out_ size_t* n) {
+                            _Out_ size_t* m, _Out_ size_t* n,
+                            const size_t* columns, size_t nColumns,
+                            const double* prevTable,
+                            ModelicaIOTableState* state,
+                            _Inout_ ModelicaIOLoadEvent* event) {
 #define DELIM_TABLE_HEADER " \t(,)\r"
 #define DELIM_TABLE_NUMBER " \t,;\r"
     double* table = NULL;
@@ -595,6 +1024,12 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
     unsigned long nRow = 0;
     unsigned long nCol = 0;
     unsigned long lineNo = 1;
+    long dataStart = 0; /* File position after the table header line */
+    long dataEnd = 0; /* File position after the line of the last row */
+    unsigned long lineNoData = 0; /* Line number of the table header line */
+    unsigned long lineNoEnd = 0; /* Line number of the last row */
+    unsigned long long dataHash = HASH_LINE_INIT; /* Hash of the lines from
+        dataStart to dataEnd */
 #if defined(NO_LOCALE)
     const char * const dec = ".";
 #elif defined(_MSC_VER) && _MSC_VER >= 1400
@@ -729,11 +1164,31 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
         { /* foundTable == 1 */
             size_t i = 0;
             size_t j = 0;
+            size_t nColTable = nCol; /* Number of columns of table */
+            size_t* colMap = NULL; /* Column index (plus 1) in table of each
+                column of the file, 0 if the column is not selected */
 
-            table = (double*)malloc(nRow*nCol*sizeof(double));
-            if (table == NULL) {
+            if (nColumns > 0) {
+                if (columns[0] < 1 || columns[nColumns - 1] > nCol) {
+                    tableReadError = 3;
+                    break;
+                }
+                colMap = (size_t*)calloc(nCol, sizeof(size_t));
+                if (colMap != NULL) {
+                    size_t c;
+                    for (c = 0; c < nColumns; c++) {
+                        colMap[columns[c] - 1] = c + 1;
+                    }
+                }
+                nColTable = nColumns;
+            }
+            table = (double*)malloc(nRow*nColTable*sizeof(double));
+            if (table == NULL || (nColumns > 0 && colMap == NULL)) {
                 *m = 0;
                 *n = 0;
+                free(table);
+                table = NULL;
+                free(colMap);
                 free(buf);
                 fclose(fp);
 #if defined(NO_LOCALE)
@@ -746,6 +1201,40 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
                 return table;
             }
 
+            if (state != NULL) {
+                dataStart = ftell(fp);
+                dataEnd = dataStart;
+                lineNoData = lineNo;
+                lineNoEnd = lineNo;
+                if (prevTable != NULL && state->nRow > 0 &&
+                    state->nRow <= nRow && state->nCol == nCol) {
+                    /* Continue the previous read if the lines of its rows
+                       are unchanged, i.e., if rows were only appended */
+                    unsigned long long hash = HASH_LINE_INIT;
+                    size_t iLine = 0;
+                    while (iLine < state->nLine &&
+                        readLine(&buf, &bufLen, fp) == 0) {
+                        hash = hashLine(hash, buf);
+                        iLine++;
+                    }
+                    if (iLine == state->nLine && hash == state->hash &&
+                        ftell(fp) - dataStart ==
+                        state->dataEnd - state->dataStart) {
+                        memcpy(table, prevTable,
+                            state->nRow*nColTable*sizeof(double));
+                        i = state->nRow;
+                        lineNo += (unsigned long)iLine;
+                        lineNoEnd = lineNo;
+                        dataEnd = ftell(fp);
+                        dataHash = hash;
+                        state->nRowKept = state->nRow;
+                    }
+                    else if (0 != fseek(fp, dataStart, SEEK_SET)) {
+                        tableReadError = 1;
+                    }
+                }
+            }
+
             /* Loop over rows and store table row-wise */
             while (tableReadError == 0 && i < nRow) {
                 int k = 0;
@@ -754,6 +1243,9 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
                 if ((tableReadError = readLine(&buf, &bufLen, fp)) != 0) {
                     break;
                 }
+                if (state != NULL) {
+                    dataHash = hashLine(dataHash, buf);
+                }
                 /* Ignore leading white space */
                 while (k < bufLen - 1) {
                     if (buf[k] != ' ' && buf[k] != '\t') {
@@ -770,26 +1262,38 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
 #endif
                 token = strtok_r(&buf[k], DELIM_TABLE_NUMBER, &nextToken);
                 while (token != NULL && i < nRow && j < nCol) {
+                    size_t iTable;
                     if (token[0] == '#') {
                         /* Skip trailing comment line */
                         break;
                     }
+                    if (colMap != NULL && colMap[j] == 0) {
+                        /* Skip number of a column that is not selected */
+                        if (++j == nCol) {
+                            i++; /* Increment row index */
+                            j = 0; /* Reset column index */
+                        }
+                        token = strtok_r(NULL, DELIM_TABLE_NUMBER, &nextToken);
+                        continue;
+                    }
+                    iTable = colMap != NULL ? i*nColTable + colMap[j] - 1 :
+                        i*nCol + j;
 #if !defined(NO_LOCALE) && (defined(_MSC_VER) && _MSC_VER >= 1400)
-                    table[i*nCol + j] = _strtod_l(token, &endptr, loc);
+                    table[iTable] = _strtod_l(token, &endptr, loc);
                     if (*endptr != 0) {
                         tableReadError = 1;
                     }
 #elif !defined(NO_LOCALE) && (defined(__GLIBC__) && defined(__GLIBC_MINOR__) && ((__GLIBC__ << 16) + __GLIBC_MINOR__ >= (2 << 16) + 3))
-                    table[i*nCol + j] = strtod_l(token, &endptr, loc);
+                    table[iTable] = strtod_l(token, &endptr, loc);
                     if (*endptr != 0) {
                         tableReadError = 1;
                     }
 #else
                     if (*dec == '.') {
-                        table[i*nCol + j] = strtod(token, &endptr);
+                        table[iTable] = strtod(token, &endptr);
                     }
                     else if (NULL == strchr(token, '.')) {
-                        table[i*nCol + j] = strtod(token, &endptr);
+                        table[iTable] = strtod(token, &endptr);
                     }
                     else {
                         char* token2 = (char*)malloc(
@@ -799,7 +1303,7 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
                             strcpy(token2, token);
                             p = strchr(token2, '.');
                             *p = *dec;
-                            table[i*nCol + j] = strtod(token2, &endptr);
+                            table[iTable] = strtod(token2, &endptr);
                             if (*endptr != 0) {
                                 tableReadError = 1;
                             }
@@ -828,6 +1332,10 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
                         break;
                     }
                 }
+                if (state != NULL && i == nRow) {
+                    dataEnd = ftell(fp);
+                    lineNoEnd = lineNo;
+                }
                 /* Check for trailing non-comment character */
                 if (token != NULL && token[0] != '#') {
                     tableReadError = 1;
@@ -877,11 +1385,13 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
                     break;
                 }
             }
+            free(colMap);
             break;
         }
     }
 
     free(buf);
+    event->bytes = (size_t)ftell(fp);
     fclose(fp);
 #if defined(NO_LOCALE)
 #elif defined(_MSC_VER) && _MSC_VER >= 1400
@@ -898,7 +1408,15 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
 
     if (tableReadError == 0) {
         *m = (size_t)nRow;
-        *n = (size_t)nCol;
+        *n = nColumns > 0 ? nColumns : (size_t)nCol;
+        if (state != NULL) {
+            state->nRow = (size_t)nRow;
+            state->nCol = (size_t)nCol;
+            state->dataStart = dataStart;
+            state->dataEnd = dataEnd;
+            state->nLine = (size_t)(lineNoEnd - lineNoData);
+            state->hash = dataHash;
+        }
     }
     else {
         free(table);
@@ -911,6 +1429,12 @@ static double* readTxtTable(_In_z_ const char* tableName, _In_z_ const char* fil
                 "\"%s(%lu,%lu)\" from file \"%s\"\n", tableName, nRow,
                 nCol, fileName);
         }
+        else if (tableReadError == 3) {
+            ModelicaFormatError(
+                "The column index %lu is out of range for table matrix "
+                "\"%s(%lu,%lu)\".\n", (unsigned long)(columns[0] < 1 ?
+                columns[0] : columns[nColumns - 1]), tableName, nRow, nCol);
+        }
         else if (tableReadError == 2) {
             ModelicaFormatError(
                 "The table dimensions of matrix \"%s(%lu,%lu)\" from file "
@@ -963,6 +1487,51 @@ static int readLine(_In_ char** buf, _In_ int* bufLen, _In_ FILE* fp) {
     return 0;
 }
 
+static unsigned long long hashLine(unsigned long long hash,
+                                   _In_z_ const char* line) {
+    size_t len = strlen(line);
+    unsigned long long word;
+    /* Words of 8 bytes (in native byte order) */
+    while (len >= 8) {
+        memcpy(&word, line, 8);
+        hash = (hash ^ word)*HASH_LINE_PRIME;
+        hash ^= hash >> 32;
+        line += 8;
+        len -= 8;
+    }
+    /* Remaining bytes and line length (as line break) */
+    word = (unsigned long long)len << 56;
+    memcpy(&word, line, len);
+    hash = (hash ^ word)*HASH_LINE_PRIME;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static int fileStamp(_In_z_ const char* fileName,
+                     _Out_ unsigned long long* size,
+                     _Out_ unsigned long long* time) {
+#if defined(_WIN32)
+    struct _stat fileInfo;
+    if (0 != _stat(fileName, &fileInfo)) {
+        return 1;
+    }
+#else
+    struct stat fileInfo;
+    if (0 != stat(fileName, &fileInfo)) {
+        return 1;
+    }
+#endif
+    *size = (unsigned long long)fileInfo.st_size;
+    *time = 1000000000ULL*(unsigned long long)fileInfo.st_mtime;
+#if defined(__APPLE__) && defined(st_mtime)
+    *time += (unsigned long long)fileInfo.st_mtimespec.tv_nsec;
+#elif !defined(_WIN32) && defined(st_mtime)
+    /* POSIX.1-2008 time stamp of nanosecond resolution */
+    *time += (unsigned long long)fileInfo.st_mtim.tv_nsec;
+#endif
+    return 0;
+}
+
 static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) {
   /* Reference:
 
@@ -113,11 +113,155 @@ double* ModelicaIO_readRealTable(_In_z_ const char* fileName,
      from a Modelica environment
 
      -> fileName: Name of file
-     -> matrixName: Name of matrix
+     -> tableName: Name of table
+     -> m: Number of rows
+     -> n: Number of columns
+     -> verbose: Print message that file is loading
+     <- RETURN: Array of dimensions m by n
+  */
+
+
+typedef struct ModelicaIOLoadEvent {
+    const char* fileName; /* Name of file */
+    const char* tableName; /* Name of table */
+    size_t bytes; /* Number of bytes read from file */
+    size_t nRow; /* Number of rows */
+    size_t nCol; /* Number of columns */
+    int shared; /* TableShare lookup: -1 not used, 0 miss, 1 hit */
+    double readTime; /* Time in seconds to read and parse the file */
+    double transposeTime; /* Time in seconds to transpose the table */
+    double splineTime; /* Time in seconds to initialize the spline */
+    double totalTime; /* Time in seconds of the complete load */
+} ModelicaIOLoadEvent;
+  /* Telemetry of a table load (see ModelicaIO_reportLoadEvent) */
+
+typedef void (*ModelicaIOLoadCallback)(_In_ const ModelicaIOLoadEvent* event,
+                                       void* userData);
+
+void ModelicaIO_setLoadCallback(ModelicaIOLoadCallback callback,
+                                void* userData);
+  /* Register a function that is called after each table load
+     Note: Not called from a Modelica environment, but by the simulation
+     tool, e.g., to collect load statistics. The callback is called by
+     the thread that loads the table, possibly by several threads at once.
+
+     -> callback: Function to be called or NULL to unregister
+     -> userData: Pointer passed to the callback
+  */
+
+void ModelicaIO_reportLoadEvent(_In_ const ModelicaIOLoadEvent* event) MODELICA_NONNULLATTR;
+  /* Report a table load to the registered callback and, if the environment
+     variable MODELICA_LOAD_EVENTS is set, append it to the file of that name
+     (as comma-separated values if the file name ends with ".csv", else as a
+     JSON object per line). The header line of a CSV file is written if the
+     file is empty. It may hence appear more than once if several processes
+     append to the same file at the same time.
+     Note: Only called from ModelicaIO and ModelicaStandardTables
+
+     -> event: Telemetry of the table load
+  */
+
+double* ModelicaIO_readRealTable2(_In_z_ const char* fileName,
+                                  _In_z_ const char* tableName,
+                                  _Out_ size_t* m, _Out_ size_t* n,
+                                  int verbose,
+                                  _Inout_ ModelicaIOLoadEvent* event) MODELICA_NONNULLATTR;
+  /* Read matrix and its dimensions from file and fill in the byte count and
+     the read and transpose times of the load event. In contrast to
+     ModelicaIO_readRealTable the load is not reported.
+     Note: Only called from ModelicaStandardTables
+
+     -> fileName: Name of file
+     -> tableName: Name of table
+     -> m: Number of rows
+     -> n: Number of columns
+     -> verbose: Print message that file is loading
+     -> event: Load event to be filled
+     <- RETURN: Array of dimensions m by n
+  */
+
+double* ModelicaIO_readRealTableColumns(_In_z_ const char* fileName,
+                                        _In_z_ const char* tableName,
+                                        _Out_ size_t* m, _Out_ size_t* n,
+                                        _In_ const size_t* columns,
+                                        size_t nColumns, int verbose,
+                                        _Inout_ ModelicaIOLoadEvent* event) MODELICA_NONNULLATTR;
+  /* Read the selected columns of a matrix from file, otherwise like
+     ModelicaIO_readRealTable2. Only the numbers of the selected columns are
+     converted (ASCII text file) or read (MATLAB MAT-file) and stored, such
+     that memory and time scale with the number of selected columns.
+     Numbers of other columns are not checked for syntax errors.
+     Note: Only called from ModelicaStandardTables
+
+     -> fileName: Name of file
+     -> tableName: Name of table
+     -> m: Number of rows
+     -> n: Number of columns (= nColumns)
+     -> columns: Strictly increasing indices (starting at 1) of the columns
+                 to be read
+     -> nColumns: Number of columns to be read (> 0)
+     -> verbose: Print message that file is loading
+     -> event: Load event to be filled
+     <- RETURN: Array of dimensions m by n
+  */
+
+typedef struct ModelicaIOTableState {
+    unsigned long long fileSize; /* Size of file in bytes, 0 if unknown */
+    unsigned long long fileTime; /* Modification time of file in ns (in the
+        resolution of the file system) */
+    size_t nRow; /* Number of rows of the table in the file, 0 if the read
+        cannot be continued (e.g., MATLAB MAT-file) */
+    size_t nCol; /* Number of columns of the table in the file */
+    long dataStart; /* File position after the table header line */
+    long dataEnd; /* File position after the line of the last table row */
+    size_t nLine; /* Number of lines from dataStart to dataEnd */
+    unsigned long long hash; /* Hash of the lines from dataStart to dataEnd */
+    size_t nRowKept; /* Number of rows taken over from the previous table by
+        the last read, 0 if the table was read completely */
+} ModelicaIOTableState;
+  /* State of a table read from file (see ModelicaIO_readRealTableUpdate),
+     to be initialized with zeros */
+
+double* ModelicaIO_readRealTableUpdate(_In_z_ const char* fileName,
+                                       _In_z_ const char* tableName,
+                                       _Out_ size_t* m, _Out_ size_t* n,
+                                       const size_t* columns, size_t nColumns,
+                                       const double* table, int verbose,
+                                       _Inout_ ModelicaIOTableState* state,
+                                       _Inout_ ModelicaIOLoadEvent* event);
+  /* Read all (nColumns = 0) or the selected columns of a matrix from file,
+     otherwise like ModelicaIO_readRealTableColumns, and fill in the table
+     state. If table is the result of the previous read with this state and
+     only rows were appended to the matrix of an ASCII text file since then
+     (the lines of the previous rows are unchanged), only the appended rows
+     are parsed and the previous rows are copied from table.
+     Note: Only called from ModelicaStandardTables
+
+     -> fileName: Name of file
+     -> tableName: Name of table
      -> m: Number of rows
      -> n: Number of columns
+     -> columns: Strictly increasing indices (starting at 1) of the columns
+                 to be read or NULL
+     -> nColumns: Number of columns to be read, 0 if all columns are read
+     -> table: Result of the previous read with state or NULL
      -> verbose: Print message that file is loading
+     -> state: Table state to be continued and updated
+     -> event: Load event to be filled
      <- RETURN: Array of dimensions m by n
   */
 
+int ModelicaIO_isTableFileUnchanged(_In_z_ const char* fileName,
+                                    _In_ const ModelicaIOTableState* state) MODELICA_NONNULLATTR;
+  /* Check by size and modification time whether a file is unchanged since
+     the read that filled in the table state. A rewrite of the file that
+     keeps its size within the time stamp resolution of the file system is
+     not detected.
+     Note: Only called from ModelicaStandardTables
+
+     -> fileName: Name of file
+     -> state: Table state
+     <- RETURN: = 1, if the file is unchanged, else = 0
+  */
+
 #endif
@@ -123,6 +123,11 @@
   #define MODELICA_EXPORT
 #endif
 
+/* Declare syscall and posix_fadvise also for -std=c89 */
+#if defined(__linux__) && !defined(NO_FILE_SYSTEM)
+#define _GNU_SOURCE 1
+#endif
+
 #include <string.h>
 #include "ModelicaUtilities.h"
 
@@ -188,6 +193,9 @@ MODELICA_EXPORT void ModelicaInternal_copyFile(_In_z_ const char* oldFile,
 MODELICA_EXPORT void ModelicaInternal_readDirectory(_In_z_ const char* directory,
     int nFiles, _Out_ const char** files) {
     ModelicaNotExistError("ModelicaInternal_readDirectory"); }
+MODELICA_EXPORT void ModelicaInternal_readDirectorySorted(_In_z_ const char* directory,
+    int nFiles, _Out_ const char** files) {
+    ModelicaNotExistError("ModelicaInternal_readDirectorySorted"); }
 MODELICA_EXPORT int ModelicaInternal_getNumberOfFiles(_In_z_ const char* directory) {
     ModelicaNotExistError("ModelicaInternal_getNumberOfFiles"); return 0; }
 MODELICA_EXPORT const char* ModelicaInternal_fullPathName(_In_z_ const char* name) {
@@ -230,6 +238,7 @@ MODELICA_EXPORT void ModelicaInternal_setenv(_In_z_ const char* name,
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <time.h>
 
 #if defined(__WATCOMC__)
   #include <direct.h>
@@ -258,6 +267,17 @@ MODELICA_EXPORT void ModelicaInternal_setenv(_In_z_ const char* name,
   #include <sys/stat.h>
 #endif
 
+#if defined(__linux__)
+  #include <fcntl.h>
+  #include <sys/ioctl.h>
+  #include <sys/sendfile.h>
+  #include <sys/syscall.h>
+  #if !defined(FICLONE)
+    /* From <linux/fs.h>: share the extents of the source file (reflink) */
+    #define FICLONE _IOW(0x94, 9, int)
+  #endif
+#endif
+
 MODELICA_EXPORT void ModelicaInternal_mkdir(_In_z_ const char* directoryName) MODELICA_NONNULLATTR;
 MODELICA_EXPORT void ModelicaInternal_rmdir(_In_z_ const char* directoryName) MODELICA_NONNULLATTR;
 MODELICA_EXPORT int ModelicaInternal_stat(_In_z_ const char* name) MODELICA_NONNULLATTR;
@@ -268,6 +288,8 @@ MODELICA_EXPORT void ModelicaInternal_copyFile(_In_z_ const char* oldFile,
     _In_z_ const char* newFile) MODELICA_NONNULLATTR;
 MODELICA_EXPORT void ModelicaInternal_readDirectory(_In_z_ const char* directory, int nFiles,
     _Out_ const char** files) MODELICA_NONNULLATTR;
+MODELICA_EXPORT void ModelicaInternal_readDirectorySorted(_In_z_ const char* directory, int nFiles,
+    _Out_ const char** files) MODELICA_NONNULLATTR;
 MODELICA_EXPORT int ModelicaInternal_getNumberOfFiles(_In_z_ const char* directory) MODELICA_NONNULLATTR;
 MODELICA_EXPORT MODELICA_RETURNNONNULLATTR const char* ModelicaInternal_fullPathName(
     _In_z_ const char* name) MODELICA_NONNULLATTR;
@@ -296,6 +318,11 @@ MODELICA_EXPORT int ModelicaInternal_getpid(void);
 #define BUFFER_LENGTH 1024
 #endif
 
+/* Buffer size of the read/write fallback of ModelicaInternal_copyFile */
+#define COPY_BUFFER_LENGTH (1024*1024)
+/* Bytes per copy_file_range/sendfile call of ModelicaInternal_copyFile */
+#define COPY_CHUNK_LENGTH ((size_t)64*1024*1024)
+
 typedef enum {
     FileType_NoFile = 1,
     FileType_RegularFile,
@@ -331,6 +358,55 @@ static void ModelicaConvertFromUnixDirectorySeparator(char* string) {
   #define ModelicaConvertFromUnixDirectorySeparator(string) ;
 #endif
 
+/* Mutex for the caches of opened files and directory snapshots */
+#if defined(_POSIX_)
+#include <pthread.h>
+#if defined(G_HAS_CONSTRUCTORS)
+static pthread_mutex_t m;
+G_DEFINE_CONSTRUCTOR(initializeMutex)
+static void initializeMutex(void) {
+    if (pthread_mutex_init(&m, NULL) != 0) {
+        ModelicaError("Initialization of mutex failed\n");
+    }
+}
+G_DEFINE_DESTRUCTOR(destroyMutex)
+static void destroyMutex(void) {
+    if (pthread_mutex_destroy(&m) != 0) {
+        ModelicaError("Destruction of mutex failed\n");
+    }
+}
+#else
+static pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+#endif
+#define MUTEX_LOCK() pthread_mutex_lock(&m)
+#define MUTEX_UNLOCK() pthread_mutex_unlock(&m)
+#elif defined(_WIN32) && defined(G_HAS_CONSTRUCTORS)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+static CRITICAL_SECTION cs;
+#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(initializeCS)
+#endif
+G_DEFINE_CONSTRUCTOR(initializeCS)
+static void initializeCS(void) {
+    InitializeCriticalSection(&cs);
+}
+#ifdef G_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_DESTRUCTOR_PRAGMA_ARGS(deleteCS)
+#endif
+G_DEFINE_DESTRUCTOR(deleteCS)
+static void deleteCS(void) {
+    DeleteCriticalSection(&cs);
+}
+#define MUTEX_LOCK() EnterCriticalSection(&cs)
+#define MUTEX_UNLOCK() LeaveCriticalSection(&cs)
+#else
+#define MUTEX_LOCK()
+#define MUTEX_UNLOCK()
+#endif
+
 /* --------------------- Modelica_Utilities.Internal --------------------------------- */
 
 MODELICA_EXPORT void ModelicaInternal_mkdir(_In_z_ const char* directoryName) {
@@ -455,9 +531,95 @@ MODELICA_EXPORT void ModelicaInternal_removeFile(_In_z_ const char* file) {
     }
 }
 
+#if defined(__linux__)
+static int copyFileDescriptor(int fdOld, int fdNew, off_t size) {
+    /* Copy the contents of fdOld to fdNew. Returns 0 on success, otherwise
+       the errno value of the failing system call.
+
+       The fastest available mechanism is used: sharing the extents
+       (reflink on Btrfs/XFS), copy_file_range (in-kernel copy, server-side
+       copy on NFS 4.2), sendfile and finally a large-buffer read/write loop.
+       All mechanisms operate on (and advance) the file offsets, such that a
+       fallback continues where the previous one stopped. Interrupted system
+       calls (EINTR) are restarted. Files reporting a size of zero (e.g., in
+       /proc) are only copied by read/write.
+    */
+    char* buf;
+    ssize_t n;
+
+    if ( size > 0 ) {
+        if ( ioctl(fdNew, FICLONE, fdOld) == 0 ) {
+            return 0;
+        }
+
+#if defined(SYS_copy_file_range)
+        while ( (n = syscall(SYS_copy_file_range, fdOld, NULL, fdNew, NULL,
+            COPY_CHUNK_LENGTH, 0)) != 0 ) {
+            if ( n < 0 && errno != EINTR ) {
+                break;
+            }
+        }
+        if ( n == 0 ) {
+            return 0;
+        }
+        else if ( errno != ENOSYS && errno != EXDEV && errno != EINVAL &&
+            errno != EOPNOTSUPP && errno != EBADF && errno != EPERM ) {
+            return errno;
+        }
+#endif
+
+        while ( (n = sendfile(fdNew, fdOld, NULL, COPY_CHUNK_LENGTH)) != 0 ) {
+            if ( n < 0 && errno != EINTR ) {
+                break;
+            }
+        }
+        if ( n == 0 ) {
+            return 0;
+        }
+        else if ( errno != ENOSYS && errno != EINVAL ) {
+            return errno;
+        }
+    }
+
+    buf = (char*)malloc(COPY_BUFFER_LENGTH);
+    if ( buf == NULL ) {
+        return ENOMEM;
+    }
+    while ( (n = read(fdOld, buf, COPY_BUFFER_LENGTH)) != 0 ) {
+        ssize_t iWritten = 0;
+        if ( n < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            free(buf);
+            return errno;
+        }
+        while ( iWritten < n ) {
+            ssize_t m = write(fdNew, buf + iWritten, (size_t)(n - iWritten));
+            if ( m < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                }
+                free(buf);
+                return errno;
+            }
+            iWritten += m;
+        }
+    }
+    free(buf);
+    return 0;
+}
+#endif
+
 MODELICA_EXPORT void ModelicaInternal_copyFile(_In_z_ const char* oldFile,
                                _In_z_ const char* newFile) {
     /* Copy file */
+#if defined(__linux__)
+    int fdOld;
+    int fdNew;
+    int errnoTemp;
+    struct stat fileInfo;
+#else
 #ifdef _WIN32
     const char* modeOld = "rb";
     const char* modeNew = "wb";
@@ -467,8 +629,11 @@ MODELICA_EXPORT void ModelicaInternal_copyFile(_In_z_ const char* oldFile,
 #endif
     FILE* fpOld;
     FILE* fpNew;
+    char* buf;
+    size_t n;
+    int errnoTemp = 0;
+#endif
     ModelicaFileType type;
-    int c;
 
     /* Check file existence */
     type = (ModelicaFileType) ModelicaInternal_stat(oldFile);
@@ -493,6 +658,37 @@ MODELICA_EXPORT void ModelicaInternal_copyFile(_In_z_ const char* oldFile,
     }
 
     /* Copy file */
+#if defined(__linux__)
+    fdOld = open(oldFile, O_RDONLY);
+    if ( fdOld < 0 ) {
+        ModelicaFormatError("\"%s\" cannot be copied:\n%s", oldFile, strerror(errno));
+        return;
+    }
+    if ( fstat(fdOld, &fileInfo) != 0 ) {
+        fileInfo.st_size = 0;
+    }
+#if defined(POSIX_FADV_SEQUENTIAL)
+    /* Advise sequential access for the read/write fallback */
+    (void)posix_fadvise(fdOld, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    fdNew = open(newFile, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if ( fdNew < 0 ) {
+        errnoTemp = errno;
+        close(fdOld);
+        ModelicaFormatError("\"%s\" cannot be copied to \"%s\":\n%s",
+            oldFile, newFile, strerror(errnoTemp));
+        return;
+    }
+    errnoTemp = copyFileDescriptor(fdOld, fdNew, fileInfo.st_size);
+    close(fdOld);
+    if ( close(fdNew) != 0 && errnoTemp == 0 ) {
+        errnoTemp = errno;
+    }
+    if ( errnoTemp != 0 ) {
+        ModelicaFormatError("\"%s\" cannot be copied to \"%s\":\n%s",
+            oldFile, newFile, strerror(errnoTemp));
+    }
+#else
     fpOld = fopen(oldFile, modeOld);
     if ( fpOld == NULL ) {
         ModelicaFormatError("\"%s\" cannot be copied:\n%s", oldFile, strerror(errno));
@@ -505,124 +701,363 @@ MODELICA_EXPORT void ModelicaInternal_copyFile(_In_z_ const char* oldFile,
             oldFile, newFile, strerror(errno));
         return;
     }
-    while ( (c = getc(fpOld)) != EOF ) {
-        putc(c, fpNew);
+    buf = (char*)malloc(COPY_BUFFER_LENGTH);
+    if ( buf == NULL ) {
+        fclose(fpOld);
+        fclose(fpNew);
+        ModelicaFormatError("\"%s\" cannot be copied to \"%s\":\n"
+            "Not enough memory", oldFile, newFile);
+        return;
     }
+    while ( (n = fread(buf, 1, COPY_BUFFER_LENGTH, fpOld)) > 0 ) {
+        if ( fwrite(buf, 1, n, fpNew) != n ) {
+            errnoTemp = errno;
+            break;
+        }
+    }
+    if ( errnoTemp == 0 && ferror(fpOld) ) {
+        errnoTemp = errno != 0 ? errno : EIO;
+    }
+    free(buf);
     fclose(fpOld);
-    fclose(fpNew);
+    if ( fclose(fpNew) != 0 && errnoTemp == 0 ) {
+        errnoTemp = errno;
+    }
+    if ( errnoTemp != 0 ) {
+        ModelicaFormatError("\"%s\" cannot be copied to \"%s\":\n%s",
+            oldFile, newFile, strerror(errnoTemp));
+    }
+#endif
 }
 
-MODELICA_EXPORT void ModelicaInternal_readDirectory(_In_z_ const char* directory, int nFiles,
-                                    _Out_ const char** files) {
-    /* Get all file and directory names in a directory in any order
-       (must be very careful, to call closedir if an error occurs)
-    */
 #if defined(__WATCOMC__) || defined(__BORLANDC__) || defined(_WIN32) || defined(_POSIX_) || defined(__GNUC__)
-    int errnoTemp;
-    int iFiles  = 0;
-    char *pName;
+/* Directory snapshots: The Modelica functions first inquire the number of
+   entries of a directory (ModelicaInternal_getNumberOfFiles) and then read
+   the names (ModelicaInternal_readDirectory). Both are answered from one
+   readdir pass, the names of which are kept in a single character arena.
+   A snapshot is reused as long as the modification time of the directory is
+   unchanged and the snapshot was taken after the second of the last
+   modification (such that changes within the same second of a file system
+   with coarse time stamps are not missed).
+*/
+#define MAX_DIRECTORY_SNAPSHOTS (8)
+
+typedef struct DirectorySnapshot {
+    char* directory; /* Key = Directory name */
+    time_t mtime; /* Modification time of directory (seconds) */
+    long mtimeNsec; /* Modification time of directory (nanoseconds) */
+    time_t snapshotTime; /* Time when the directory was read */
+    int nFiles; /* Number of entries (without "." and "..") */
+    char* names; /* Arena of null-terminated entry names */
+    size_t namesSize; /* Used size of names */
+    size_t* offsets; /* Offsets of the nFiles entry names in names */
+    const char** sorted; /* Sorted entry names in names or NULL if not yet sorted */
+    UT_hash_handle hh; /* Hashable structure */
+} DirectorySnapshot;
+
+static DirectorySnapshot* directorySnapshots = NULL;
+
+static int directoryModificationTime(_In_z_ const char* directory,
+                                     time_t* mtime, long* mtimeNsec) {
+#if defined(_WIN32)
+    struct _stat fileInfo;
+    if (_stat(directory, &fileInfo) != 0) {
+        return 0;
+    }
+    *mtimeNsec = 0;
+#else
+    struct stat fileInfo;
+    if (stat(directory, &fileInfo) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    *mtimeNsec = (long)fileInfo.st_mtimespec.tv_nsec;
+#elif defined(st_mtime) /* st_mtime is defined as st_mtim.tv_sec (POSIX.1-2008) */
+    *mtimeNsec = (long)fileInfo.st_mtim.tv_nsec;
+#else
+    *mtimeNsec = 0;
+#endif
+#endif
+    *mtime = fileInfo.st_mtime;
+    return 1;
+}
+
+static void freeDirectorySnapshot(DirectorySnapshot* snapshot) {
+    free(snapshot->directory);
+    free(snapshot->names);
+    free(snapshot->offsets);
+    free(snapshot->sorted);
+    free(snapshot);
+}
+
+static int readDirectorySnapshot(_In_z_ const char* directory,
+                                 DirectorySnapshot* snapshot) {
+    /* Read all entry names of the directory in one pass. Returns 0 on
+       success, otherwise the errno value (-1 for insufficient memory). */
     struct dirent *pinfo;
     DIR* pdir;
+    size_t namesCapacity = 4096;
+    size_t offsetsCapacity = 256;
+    int errnoTemp;
+
+    snapshot->snapshotTime = time(NULL);
+    if (0 == directoryModificationTime(directory, &snapshot->mtime,
+        &snapshot->mtimeNsec)) {
+        return errno;
+    }
 
-    /* Open directory information inquiry */
     pdir = opendir(directory);
-    if ( pdir == NULL ) {
-        ModelicaFormatError("1: Not possible to get file names of \"%s\":\n%s",
-            directory, strerror(errno));
+    if (pdir == NULL) {
+        return errno;
+    }
+    snapshot->names = (char*)malloc(namesCapacity);
+    snapshot->offsets = (size_t*)malloc(offsetsCapacity*sizeof(size_t));
+    if (snapshot->names == NULL || snapshot->offsets == NULL) {
+        closedir(pdir);
+        return -1;
     }
 
-    /* Read file and directory names and store them in vector "files" */
     errno = 0;
     while ( (pinfo = readdir(pdir)) != NULL ) {
         if ( (strcmp(pinfo->d_name, "." ) != 0) &&
             (strcmp(pinfo->d_name, "..") != 0) ) {
-            /* Check if enough space in "files" vector */
-            if ( iFiles >= nFiles ) {
-                closedir(pdir);
-                ModelicaFormatError("Not possible to get file names of \"%s\":\n"
-                    "More files in this directory as reported by nFiles (= %i)",
-                    directory, nFiles);
-            }
-
-            /* Allocate Modelica memory for file/directory name and copy name */
-            pName = ModelicaAllocateStringWithErrorReturn(strlen(pinfo->d_name));
-            if ( pName == NULL ) {
-                errnoTemp = errno;
-                closedir(pdir);
-                if ( errnoTemp == 0 ) {
-                    ModelicaFormatError("Not possible to get file names of \"%s\":\n"
-                        "Not enough storage", directory);
+            size_t len = strlen(pinfo->d_name) + 1;
+            if (snapshot->namesSize + len > namesCapacity) {
+                char* names;
+                while (snapshot->namesSize + len > namesCapacity) {
+                    namesCapacity *= 2;
                 }
-                else {
-                    ModelicaFormatError("Not possible to get file names of \"%s\":\n%s",
-                        directory, strerror(errnoTemp));
+                names = (char*)realloc(snapshot->names, namesCapacity);
+                if (names == NULL) {
+                    closedir(pdir);
+                    return -1;
+                }
+                snapshot->names = names;
+            }
+            if ((size_t)snapshot->nFiles >= offsetsCapacity) {
+                size_t* offsets;
+                offsetsCapacity *= 2;
+                offsets = (size_t*)realloc(snapshot->offsets,
+                    offsetsCapacity*sizeof(size_t));
+                if (offsets == NULL) {
+                    closedir(pdir);
+                    return -1;
                 }
+                snapshot->offsets = offsets;
             }
-            strcpy(pName, pinfo->d_name);
+            memcpy(snapshot->names + snapshot->namesSize, pinfo->d_name, len);
+            snapshot->offsets[snapshot->nFiles++] = snapshot->namesSize;
+            snapshot->namesSize += len;
+        }
+    }
+    errnoTemp = errno;
+    closedir(pdir);
+    return errnoTemp;
+}
 
-            /* Save pointer to file */
-            files[iFiles] = pName;
-            iFiles++;
+static DirectorySnapshot* getDirectorySnapshot(_In_z_ const char* directory,
+                                               int update, _Out_ int* errnoOut) {
+    /* Get the (cached) snapshot of a directory, which is re-read if
+       outdated or if update is set. The snapshot is owned by the cache.
+       It must only be accessed while holding the mutex. Returns NULL on
+       error and sets errnoOut (-1 for insufficient memory). */
+    DirectorySnapshot* snapshot;
+    time_t mtime;
+    long mtimeNsec;
+
+    *errnoOut = 0;
+    HASH_FIND_STR(directorySnapshots, directory, snapshot);
+    if (snapshot != NULL) {
+        if (0 == update &&
+            0 != directoryModificationTime(directory, &mtime, &mtimeNsec) &&
+            mtime == snapshot->mtime && mtimeNsec == snapshot->mtimeNsec &&
+            snapshot->snapshotTime > mtime) {
+            return snapshot;
         }
+        HASH_DEL(directorySnapshots, snapshot);
+        freeDirectorySnapshot(snapshot);
     }
 
-    if ( errno != 0 ) {
-        errnoTemp = errno;
-        closedir(pdir);
-        ModelicaFormatError("Not possible to get file names of \"%s\":\n%s",
-            directory, strerror(errnoTemp));
+    snapshot = (DirectorySnapshot*)calloc(1, sizeof(DirectorySnapshot));
+    if (snapshot == NULL) {
+        *errnoOut = -1;
+        return NULL;
+    }
+    snapshot->directory = (char*)malloc((strlen(directory) + 1)*sizeof(char));
+    if (snapshot->directory == NULL) {
+        freeDirectorySnapshot(snapshot);
+        *errnoOut = -1;
+        return NULL;
+    }
+    strcpy(snapshot->directory, directory);
+    *errnoOut = readDirectorySnapshot(directory, snapshot);
+    if (*errnoOut != 0) {
+        freeDirectorySnapshot(snapshot);
+        return NULL;
     }
 
-    /* Check, whether the whole "files" vector is filled and close inquiry */
-    if ( iFiles != nFiles) {
-        closedir(pdir);
+    if (HASH_COUNT(directorySnapshots) >= MAX_DIRECTORY_SNAPSHOTS) {
+        /* Remove the least recently read snapshot */
+        DirectorySnapshot* oldest = directorySnapshots;
+        HASH_DEL(directorySnapshots, oldest);
+        freeDirectorySnapshot(oldest);
+    }
+#define uthash_fatal(msg) do { \
+    freeDirectorySnapshot(snapshot); \
+    *errnoOut = -1; \
+    return NULL; \
+} while (0)
+    HASH_ADD_KEYPTR(hh, directorySnapshots, snapshot->directory,
+        (unsigned)strlen(snapshot->directory), snapshot);
+#undef uthash_fatal
+    return snapshot;
+}
+
+static int compareDirectoryEntries(const char* a, const char* b) {
+    /* Case-insensitive order (as Modelica.Utilities.Strings.sort with
+       caseSensitive=false) with case-sensitive tie-breaking */
+    const char* a0 = a;
+    const char* b0 = b;
+    int ca, cb;
+    do {
+        ca = (unsigned char)*a++;
+        cb = (unsigned char)*b++;
+        if (ca >= 'A' && ca <= 'Z') {
+            ca += 'a' - 'A';
+        }
+        if (cb >= 'A' && cb <= 'Z') {
+            cb += 'a' - 'A';
+        }
+    } while (ca == cb && ca != '\0');
+    return ca != cb ? ca - cb : strcmp(a0, b0);
+}
+
+static int compareNames(const void* a, const void* b) {
+    return compareDirectoryEntries(*(const char* const*)a,
+        *(const char* const*)b);
+}
+
+static void readDirectory(_In_z_ const char* directory, int nFiles,
+                          int sorted, _Out_ const char** files) {
+    /* Copy the entry names of the directory snapshot to "files" */
+    DirectorySnapshot* snapshot;
+    const char* name;
+    char* pName;
+    int update;
+    int errnoTemp;
+    int i;
+
+    MUTEX_LOCK();
+    for (update = 0; update < 2; update++) {
+        snapshot = getDirectorySnapshot(directory, update, &errnoTemp);
+        if (snapshot == NULL || snapshot->nFiles == nFiles) {
+            break;
+        }
+        /* Snapshot and caller disagree: re-read once for sure */
+    }
+    if (snapshot == NULL) {
+        MUTEX_UNLOCK();
+        if (errnoTemp == -1) {
+            ModelicaFormatError("Not possible to get file names of \"%s\":\n"
+                "Not enough storage", directory);
+        }
+        else {
+            ModelicaFormatError("Not possible to get file names of \"%s\":\n%s",
+                directory, strerror(errnoTemp));
+        }
+        return;
+    }
+    if (snapshot->nFiles > nFiles) {
+        MUTEX_UNLOCK();
+        ModelicaFormatError("Not possible to get file names of \"%s\":\n"
+            "More files in this directory as reported by nFiles (= %i)",
+            directory, nFiles);
+        return;
+    }
+    else if (snapshot->nFiles < nFiles) {
+        i = snapshot->nFiles;
+        MUTEX_UNLOCK();
         ModelicaFormatError("Not possible to get file names of \"%s\":\n"
             "Less files (= %d) found as defined by argument nNames (= %d)",
-             directory, iFiles, nFiles);
+             directory, i, nFiles);
+        return;
     }
 
-    if ( closedir(pdir) != 0 ) {
-        ModelicaFormatError("Not possible to get file names of \"%s\":\n",
-            directory, strerror(errno));
+    if (sorted && nFiles > 1 && snapshot->sorted == NULL) {
+        snapshot->sorted = (const char**)malloc(nFiles*sizeof(const char*));
+        if (snapshot->sorted != NULL) {
+            for (i = 0; i < nFiles; i++) {
+                snapshot->sorted[i] = snapshot->names + snapshot->offsets[i];
+            }
+            qsort((void*)snapshot->sorted, (size_t)nFiles, sizeof(const char*),
+                compareNames);
+        }
     }
 
+    for (i = 0; i < nFiles; i++) {
+        /* Unsorted if out of memory for the sorted names */
+        name = sorted && snapshot->sorted != NULL ? snapshot->sorted[i] :
+            snapshot->names + snapshot->offsets[i];
+        pName = ModelicaAllocateStringWithErrorReturn(strlen(name));
+        if ( pName == NULL ) {
+            errnoTemp = errno;
+            MUTEX_UNLOCK();
+            if ( errnoTemp == 0 ) {
+                ModelicaFormatError("Not possible to get file names of \"%s\":\n"
+                    "Not enough storage", directory);
+            }
+            else {
+                ModelicaFormatError("Not possible to get file names of \"%s\":\n%s",
+                    directory, strerror(errnoTemp));
+            }
+            return;
+        }
+        strcpy(pName, name);
+        files[i] = pName;
+    }
+    MUTEX_UNLOCK();
+}
+#endif
+
+MODELICA_EXPORT void ModelicaInternal_readDirectory(_In_z_ const char* directory, int nFiles,
+                                    _Out_ const char** files) {
+    /* Get all file and directory names in a directory in any order */
+#if defined(__WATCOMC__) || defined(__BORLANDC__) || defined(_WIN32) || defined(_POSIX_) || defined(__GNUC__)
+    readDirectory(directory, nFiles, 0, files);
 #else
     ModelicaNotExistError("ModelicaInternal_readDirectory");
 #endif
 }
 
+MODELICA_EXPORT void ModelicaInternal_readDirectorySorted(_In_z_ const char* directory, int nFiles,
+                                    _Out_ const char** files) {
+    /* Get all file and directory names in a directory in case-insensitive
+       alphabetical order */
+#if defined(__WATCOMC__) || defined(__BORLANDC__) || defined(_WIN32) || defined(_POSIX_) || defined(__GNUC__)
+    readDirectory(directory, nFiles, 1, files);
+#else
+    ModelicaNotExistError("ModelicaInternal_readDirectorySorted");
+#endif
+}
+
 MODELICA_EXPORT int ModelicaInternal_getNumberOfFiles(_In_z_ const char* directory) {
     /* Get number of files and directories in a directory */
 #if defined(__WATCOMC__) || defined(__BORLANDC__) || defined(_WIN32) || defined(_POSIX_) || defined(__GNUC__)
+    DirectorySnapshot* snapshot;
     int nFiles = 0;
     int errnoTemp;
-    struct dirent *pinfo;
-    DIR* pdir;
 
-    pdir = opendir(directory);
-    if ( pdir == NULL ) {
-        goto Modelica_ERROR;
-    }
-    errno = 0;
-    while ( (pinfo = readdir(pdir)) != NULL ) {
-        if ( (strcmp(pinfo->d_name, "." ) != 0) &&
-                (strcmp(pinfo->d_name, "..") != 0) ) {
-            nFiles++;
-        }
+    MUTEX_LOCK();
+    snapshot = getDirectorySnapshot(directory, 0, &errnoTemp);
+    if (snapshot != NULL) {
+        nFiles = snapshot->nFiles;
     }
-    errnoTemp = errno;
-    closedir(pdir);
-    if ( errnoTemp != 0 ) {
-        errno = errnoTemp;
-        goto Modelica_ERROR;
+    MUTEX_UNLOCK();
+    if (snapshot == NULL) {
+        ModelicaFormatError("Not possible to get number of files in \"%s\":\n%s",
+            directory, errnoTemp == -1 ? "Not enough storage" : strerror(errnoTemp));
     }
-
     return nFiles;
-
-Modelica_ERROR:
-    ModelicaFormatError("Not possible to get number of files in \"%s\":\n%s",
-        directory, strerror(errno));
-    return 0;
 #else
     ModelicaNotExistError("ModelicaInternal_getNumberOfFiles");
     return 0;
@@ -702,53 +1137,6 @@ typedef struct FileCache {
 } FileCache;
 
 static FileCache* fileCache = NULL;
-#if defined(_POSIX_)
-#include <pthread.h>
-#if defined(G_HAS_CONSTRUCTORS)
-static pthread_mutex_t m;
-G_DEFINE_CONSTRUCTOR(initializeMutex)
-static void initializeMutex(void) {
-    if (pthread_mutex_init(&m, NULL) != 0) {
-        ModelicaError("Initialization of mutex failed\n");
-    }
-}
-G_DEFINE_DESTRUCTOR(destroyMutex)
-static void destroyMutex(void) {
-    if (pthread_mutex_destroy(&m) != 0) {
-        ModelicaError("Destruction of mutex failed\n");
-    }
-}
-#else
-static pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
-#endif
-#define MUTEX_LOCK() pthread_mutex_lock(&m)
-#define MUTEX_UNLOCK() pthread_mutex_unlock(&m)
-#elif defined(_WIN32) && defined(G_HAS_CONSTRUCTORS)
-#if !defined(WIN32_LEAN_AND_MEAN)
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <windows.h>
-static CRITICAL_SECTION cs;
-#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
-#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(initializeCS)
-#endif
-G_DEFINE_CONSTRUCTOR(initializeCS)
-static void initializeCS(void) {
-    InitializeCriticalSection(&cs);
-}
-#ifdef G_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
-#pragma G_DEFINE_DESTRUCTOR_PRAGMA_ARGS(deleteCS)
-#endif
-G_DEFINE_DESTRUCTOR(deleteCS)
-static void deleteCS(void) {
-    DeleteCriticalSection(&cs);
-}
-#define MUTEX_LOCK() EnterCriticalSection(&cs)
-#define MUTEX_UNLOCK() LeaveCriticalSection(&cs)
-#else
-#define MUTEX_LOCK()
-#define MUTEX_UNLOCK()
-#endif
 
 static void CacheFileForReading(FILE* fp, const char* fileName, int line) {
 #define uthash_fatal(msg) do { \
@@ -290,6 +290,8 @@
 #undef Z_PREFIX
 
 #include "ModelicaMatIO.h"
+#include "gconstructor.h"
+#include "ModelicaCPUDispatch.h"
 #if HAVE_INTTYPES_H
 #   define __STDC_FORMAT_MACROS
 #endif
@@ -377,6 +379,7 @@ int rpl_asprintf(char **, const char *, ...);
 
 /* endian.c */
 static double        Mat_doubleSwap(double  *a);
+static void          Mat_doubleSwapArray(double *a, size_t n);
 static float         Mat_floatSwap(float   *a);
 #ifdef HAVE_MATIO_INT64_T
 static mat_int64_t   Mat_int64Swap(mat_int64_t  *a);
@@ -709,6 +712,106 @@ Mat_doubleSwap( double *a )
 
 }
 
+/** @brief swap the bytes of an array of 8 byte double-precision floats
+ *
+ * The kernel is selected at load time by the CPU features
+ * (see ModelicaCPUDispatch.h)
+ * @ingroup mat_internal
+ * @param a pointer to the array to swap in place
+ * @param n number of elements
+ */
+static void
+Mat_doubleSwapArray_generic( double *a, size_t n )
+{
+    size_t i;
+
+    for ( i = 0; i < n; i++ )
+        (void)Mat_doubleSwap(a+i);
+}
+
+#if defined(MODELICA_CPU_X86) && SIZEOF_DOUBLE == 8
+MODELICA_CPU_TARGET("sse2") static void
+Mat_doubleSwapArray_sse2( double *a, size_t n )
+{
+    size_t i;
+
+    for ( i = 0; i + 2 <= n; i += 2 ) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(a+i));
+        /* Reverse the 16-bit words, then the bytes in each word */
+        v = _mm_shufflelo_epi16(v,_MM_SHUFFLE(0,1,2,3));
+        v = _mm_shufflehi_epi16(v,_MM_SHUFFLE(0,1,2,3));
+        v = _mm_or_si128(_mm_slli_epi16(v,8),_mm_srli_epi16(v,8));
+        _mm_storeu_si128((__m128i*)(a+i),v);
+    }
+    Mat_doubleSwapArray_generic(a+i,n-i);
+}
+
+MODELICA_CPU_TARGET("avx2") static void
+Mat_doubleSwapArray_avx2( double *a, size_t n )
+{
+    const __m256i mask = _mm256_setr_epi8(
+        7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8,
+        7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+    size_t i;
+
+    for ( i = 0; i + 4 <= n; i += 4 ) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(a+i));
+        _mm256_storeu_si256((__m256i*)(a+i),_mm256_shuffle_epi8(v,mask));
+    }
+    Mat_doubleSwapArray_generic(a+i,n-i);
+}
+
+#if defined(MODELICA_CPU_X86_AVX512)
+MODELICA_CPU_TARGET("avx512f,avx512bw") static void
+Mat_doubleSwapArray_avx512( double *a, size_t n )
+{
+    const __m512i mask = _mm512_broadcast_i32x4(_mm_setr_epi8(
+        7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8));
+    size_t i;
+
+    for ( i = 0; i + 8 <= n; i += 8 ) {
+        __m512i v = _mm512_loadu_si512((const void*)(a+i));
+        _mm512_storeu_si512((void*)(a+i),_mm512_shuffle_epi8(v,mask));
+    }
+    Mat_doubleSwapArray_generic(a+i,n-i);
+}
+#endif
+
+static void (* const Mat_doubleSwapArrayVariants[MODELICA_CPU_LEVELS])(double*, size_t) = {
+    Mat_doubleSwapArray_generic,
+    Mat_doubleSwapArray_sse2,
+    Mat_doubleSwapArray_avx2,
+#if defined(MODELICA_CPU_X86_AVX512)
+    Mat_doubleSwapArray_avx512
+#else
+    Mat_doubleSwapArray_avx2
+#endif
+};
+#endif
+
+static void (*Mat_doubleSwapArrayKernel)(double*, size_t) =
+    Mat_doubleSwapArray_generic;
+
+#if defined(MODELICA_CPU_X86) && SIZEOF_DOUBLE == 8 && \
+    defined(G_HAS_CONSTRUCTORS)
+#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(Mat_selectKernels)
+#endif
+G_DEFINE_CONSTRUCTOR(Mat_selectKernels)
+static void
+Mat_selectKernels(void)
+{
+    Mat_doubleSwapArrayKernel =
+        Mat_doubleSwapArrayVariants[ModelicaCPU_level()];
+}
+#endif
+
+static void
+Mat_doubleSwapArray( double *a, size_t n )
+{
+    Mat_doubleSwapArrayKernel(a,n);
+}
+
 /* -------------------------------
  * ---------- inflate.c
  * -------------------------------
@@ -1771,9 +1874,7 @@ ReadDoubleData(mat_t *mat,double *data,enum matio_types data_type,int len)
         {
             if ( mat->byteswap ) {
                 bytesread += fread(data,data_size,len,(FILE*)mat->fp);
-                for ( i = 0; i < len; i++ ) {
-                    (void)Mat_doubleSwap(data+i);
-                }
+                Mat_doubleSwapArray(data,len);
             } else {
                 bytesread += fread(data,data_size,len,(FILE*)mat->fp);
             }
@@ -1893,8 +1994,7 @@ ReadCompressedDoubleData(mat_t *mat,z_streamp z,double *data,
         {
             if ( mat->byteswap ) {
                 InflateData(mat,z,data,len*data_size);
-                for ( i = 0; i < len; i++ )
-                    (void)Mat_doubleSwap(data+i);
+                Mat_doubleSwapArray(data,len);
             } else {
                 InflateData(mat,z,data,len*data_size);
             }
@@ -0,0 +1,728 @@
+/* ModelicaMath.c - External functions for Modelica.Math
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Implementation of external functions in the Modelica Standard Library:
+
+      Modelica.Math.Vectors.interpolate
+      Modelica.Math.Vectors.interpolateVector
+      Modelica.Math.Vectors.sort
+      Modelica.Math.Matrices.sort
+
+   The following #define's are available.
+
+   MODELICA_EXPORT: Prefix used for function calls. If not defined, blank is used
+                    Useful definitions:
+                    - "static" that is all functions become static
+                      (useful if file is included with other C-sources for an
+                       embedded system)
+                    - "__declspec(dllexport)" if included in a DLL and the
+                      functions shall be visible outside of the DLL
+   SEARCH_LINEAR  : Number of intervals searched linearly by interpolation.
+                    Default: 4
+   SORT_RADIX     : Minimum number of elements sorted by radix sort.
+                    Default: 2048
+   SORT_INSERTION : Maximum number of elements sorted by insertion sort.
+                    Default: 16
+*/
+
+#if !defined(MODELICA_EXPORT)
+#   define MODELICA_EXPORT
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "ModelicaUtilities.h"
+
+/* Define to 1 if you have the <stdint.h> header file. */
+#if defined(_WIN32)
+#if defined(_MSC_VER) && _MSC_VER >= 1600
+#define HAVE_MATH_STDINT_H 1
+#elif defined(__WATCOMC__) || defined(__MINGW32__) || defined(__CYGWIN__)
+#define HAVE_MATH_STDINT_H 1
+#else
+#undef HAVE_MATH_STDINT_H
+#endif
+#elif defined(__GNUC__) && !defined(__VXWORKS__)
+#define HAVE_MATH_STDINT_H 1
+#else
+#undef HAVE_MATH_STDINT_H
+#endif
+
+/* Include integer type header (for the 64-bit sort keys) */
+#if defined(HAVE_MATH_STDINT_H)
+#include <stdint.h>
+#elif defined(_MSC_VER) && _MSC_VER < 1300
+#define uint64_t unsigned __int64
+#else
+#define uint64_t unsigned long long
+#endif
+
+/* Number of intervals next to the one of the previous call that are searched
+   linearly by Vectors_interpolate (before the exponential search) */
+#if !defined(SEARCH_LINEAR)
+#define SEARCH_LINEAR (4)
+#endif
+/* Minimum number of elements sorted by radix sort (instead of introsort or
+   merge sort) and maximum number of elements sorted by insertion sort */
+#if !defined(SORT_RADIX)
+#define SORT_RADIX (2048)
+#endif
+#if !defined(SORT_INSERTION)
+#define SORT_INSERTION (16)
+#endif
+
+/*
+ * Non-null pointers need to be passed to external functions.
+ *
+ * The following macros handle nonnull attributes for GNU C and Microsoft SAL.
+ */
+#if defined(__GNUC__)
+#define MODELICA_NONNULLATTR __attribute__((nonnull))
+#else
+#define MODELICA_NONNULLATTR
+#endif
+#if !defined(__ATTR_SAL)
+#define _In_
+#define _Inout_
+#define _Out_
+#endif
+
+MODELICA_EXPORT double ModelicaMath_Vectors_interpolate(_In_ const double* x,
+    _In_ const double* y, size_t nx, double xi, int iLast,
+    _Out_ int* iNew) MODELICA_NONNULLATTR;
+  /* Interpolate linearly in the vectors x and y, extrapolate through the
+     first or last two values. The interval x[iNew] <= xi < x[iNew + 1]
+     (1-based, the one with the largest index for identical values of x)
+     is searched from the interval iLast of the previous call: If xi is in
+     this interval, it is found by two comparisons, else by exponential and
+     binary search. The result is the one of the linear search of the
+     former Modelica implementation of Modelica.Math.Vectors.interpolate.
+     Not profiled, since reading the clock takes longer than a call.
+
+     -> x: Abscissa values (monotonically increasing)
+     -> y: Ordinate values
+     -> nx: Number of values of x and y
+     -> xi: Abscissa value
+     -> iLast: Interval index of the previous call
+     <- iNew: Interval index of xi (= 1 for nx = 1)
+     <- RETURN: Interpolated value
+  */
+
+MODELICA_EXPORT int ModelicaMath_Vectors_interpolateVector(
+    _In_ const double* x, _In_ const double* y, size_t nx,
+    _In_ const double* xi, size_t nxi, int iLast,
+    _Out_ double* yi) MODELICA_NONNULLATTR;
+  /* Same as ModelicaMath_Vectors_interpolate for the abscissa values
+     xi[0], ..., xi[nxi - 1], where the search for xi[k] starts at the
+     interval of xi[k - 1]
+
+     -> xi: Abscissa values
+     -> nxi: Number of abscissa values
+     -> iLast: Interval index to start the search for xi[0]
+     <- yi: Interpolated values
+     <- RETURN: Interval index of xi[nxi - 1] (= iLast clamped to 1, ...,
+        nx - 1 for nxi = 0, = 1 for nx = 1)
+  */
+
+MODELICA_EXPORT void ModelicaMath_Vectors_sort(_In_ const double* v, size_t n,
+    int ascending, int stable, _Out_ double* sorted_v,
+    _Out_ int* indices) MODELICA_NONNULLATTR;
+  /* Sort a vector in ascending or descending order. -0 and 0 are equal,
+     NaN is larger than Inf (i.e., NaN values are sorted to the end in
+     ascending and to the beginning in descending order). Vectors of at
+     least SORT_RADIX elements are sorted by radix sort, else by
+     introsort or, if stable, by merge sort.
+
+     -> v: Vector to be sorted
+     -> n: Number of elements of v
+     -> ascending: = 1, if ascending order, = 0, if descending order
+     -> stable: = 1, if equal elements keep their order, = 0, if their
+        order is unspecified
+     <- sorted_v: Sorted vector
+     <- indices: Indices (1-based) such that sorted_v = v[indices]
+  */
+
+MODELICA_EXPORT void ModelicaMath_Matrices_sort(_In_ const double* M,
+    size_t nRow, size_t nCol, int sortRows, int ascending, int stable,
+    _Out_ double* sorted_M, _Out_ int* indices) MODELICA_NONNULLATTR;
+  /* Sort the rows or columns of a matrix (row-wise storage) in
+     lexicographic ascending or descending order, the elements are compared
+     as by ModelicaMath_Vectors_sort
+
+     -> M: Matrix to be sorted
+     -> nRow: Number of rows of M
+     -> nCol: Number of columns of M
+     -> sortRows: = 1, if the rows are sorted, = 0, if the columns are sorted
+     -> ascending: = 1, if ascending order, = 0, if descending order
+     -> stable: = 1, if equal rows (columns) keep their order, = 0, if their
+        order is unspecified
+     <- sorted_M: Sorted matrix
+     <- indices: Indices (1-based) of the rows (columns) such that
+        sorted_M = M[indices, :] (sorted_M = M[:, indices])
+  */
+
+static size_t findVectorIndex(_In_ const double* x, size_t n, size_t last,
+                              double xi) MODELICA_NONNULLATTR;
+  /* Find the index i of the non-decreasing vector x (n > 1) such that
+      * i + 1 < n
+      * x[i] <= xi or i = 0
+      * x[i + 1] > xi or i + 2 = n
+     by linear search of the SEARCH_LINEAR intervals next to index last,
+     else by exponential search followed by binary search, i.e., in
+     O(log(|i - last|)) steps. The result is the one of a linear search
+     from index last: If xi is NaN, last is returned.
+  */
+
+static double vectorInterpolate(_In_ const double* x, _In_ const double* y,
+                                size_t i, double xi) MODELICA_NONNULLATTR;
+  /* Linear interpolation in the interval i of the vectors x and y
+
+     <- RETURN: Interpolated value
+  */
+
+static uint64_t sortKey(double x, int ascending);
+  /* Map x to an unsigned integer key with the same order (IEEE 754 key
+     transform), where -0 and 0 are equal and NaN is larger than Inf. The
+     order is reversed for ascending = 0.
+
+     <- RETURN: Key of x
+  */
+
+static void sortIntro(_Inout_ uint64_t* key, _Inout_ int* index,
+                      size_t n, size_t depth) MODELICA_NONNULLATTR;
+  /* Sort the keys in place by introsort (quicksort with median of three
+     pivot, heapsort after depth partitions and insertion sort of short
+     ranges), the indices are permuted accordingly. Not stable. */
+
+static void sortHeap(_Inout_ uint64_t* key, _Inout_ int* index,
+                     size_t n) MODELICA_NONNULLATTR;
+  /* Sort the keys in place by heapsort, the indices are permuted
+     accordingly. Not stable. */
+
+static void sortInsertion(_Inout_ uint64_t* key,
+                          _Inout_ int* index, size_t n) MODELICA_NONNULLATTR;
+  /* Sort the keys in place by insertion sort, the indices are permuted
+     accordingly. Stable. */
+
+static void sortMerge(_Inout_ uint64_t* key, _Inout_ int* index,
+                      size_t n, _Inout_ uint64_t* key2,
+                      _Inout_ int* index2) MODELICA_NONNULLATTR;
+  /* Sort the keys in place by merge sort with the buffers key2 and index2
+     of n elements, the indices are permuted accordingly. Stable. */
+
+static int* sortRadix(_Inout_ uint64_t* key, _Inout_ int* index,
+                      size_t n, _Inout_ uint64_t* key2,
+                      _Inout_ int* index2) MODELICA_NONNULLATTR;
+  /* Sort the keys by least significant digit radix sort (8 bit digits,
+     passes of a constant digit are skipped) alternating between the
+     buffers key, index and key2, index2 of n elements. Stable.
+
+     <- RETURN: Pointer to the permuted indices (index or index2)
+  */
+
+static int* sortKeys(_Inout_ uint64_t* key, _Inout_ int* index,
+                     size_t n, int stable, _Inout_ uint64_t* key2,
+                     _Inout_ int* index2) MODELICA_NONNULLATTR;
+  /* Sort the keys with radix sort (n >= SORT_RADIX), merge sort
+     (stable) or introsort and permute the indices accordingly, key2 and
+     index2 are buffers of n elements
+
+     <- RETURN: Pointer to the permuted indices (index or index2)
+  */
+
+MODELICA_EXPORT double ModelicaMath_Vectors_interpolate(_In_ const double* x,
+    _In_ const double* y, size_t nx, double xi, int iLast,
+    _Out_ int* iNew) {
+    if (nx > 1) {
+        size_t i = iLast > 1 ? (size_t)iLast - 1 : 0;
+        if (i > nx - 2) {
+            i = nx - 2;
+        }
+        /* Hit of the interval of the previous call (the negated comparison
+           is also true for NaN) */
+        if (!(xi >= x[i] && (i + 2 == nx || xi < x[i + 1]))) {
+            i = findVectorIndex(x, nx, i, xi);
+        }
+        *iNew = (int)i + 1;
+        return vectorInterpolate(x, y, i, xi);
+    }
+    *iNew = 1;
+    if (nx == 0) {
+        ModelicaError("The table vectors must have at least 1 entry.\n");
+        return 0.;
+    }
+    return y[0];
+}
+
+MODELICA_EXPORT int ModelicaMath_Vectors_interpolateVector(
+    _In_ const double* x, _In_ const double* y, size_t nx,
+    _In_ const double* xi, size_t nxi, int iLast, _Out_ double* yi) {
+    size_t i;
+    size_t k;
+    if (nx == 0) {
+        ModelicaError("The table vectors must have at least 1 entry.\n");
+        return 1;
+    }
+    if (nx == 1) {
+        for (k = 0; k < nxi; k++) {
+            yi[k] = y[0];
+        }
+        return 1;
+    }
+    i = iLast > 1 ? (size_t)iLast - 1 : 0;
+    if (i > nx - 2) {
+        i = nx - 2;
+    }
+    for (k = 0; k < nxi; k++) {
+        /* The search starts at the interval of the previous value */
+        if (!(xi[k] >= x[i] && (i + 2 == nx || xi[k] < x[i + 1]))) {
+            i = findVectorIndex(x, nx, i, xi[k]);
+        }
+        yi[k] = vectorInterpolate(x, y, i, xi[k]);
+    }
+    return (int)i + 1;
+}
+
+MODELICA_EXPORT void ModelicaMath_Vectors_sort(_In_ const double* v, size_t n,
+    int ascending, int stable, _Out_ double* sorted_v, _Out_ int* indices) {
+    uint64_t* key;
+    int* index2;
+    int* sortedIndex;
+    size_t i;
+    if (n == 0) {
+        return;
+    }
+    key = (uint64_t*)malloc(2*n*sizeof(uint64_t));
+    index2 = (int*)malloc(n*sizeof(int));
+    if (NULL == key || NULL == index2) {
+        free(key);
+        free(index2);
+        ModelicaError("Memory allocation error\n");
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        key[i] = sortKey(v[i], ascending);
+        indices[i] = (int)i + 1;
+    }
+    sortedIndex = sortKeys(key, indices, n, stable, &key[n], index2);
+    if (sortedIndex != indices) {
+        memcpy(indices, sortedIndex, n*sizeof(int));
+    }
+    for (i = 0; i < n; i++) {
+        sorted_v[i] = v[indices[i] - 1];
+    }
+    free(key);
+    free(index2);
+}
+
+MODELICA_EXPORT void ModelicaMath_Matrices_sort(_In_ const double* M,
+    size_t nRow, size_t nCol, int sortRows, int ascending, int stable,
+    _Out_ double* sorted_M, _Out_ int* indices) {
+    /* Sort n rows (columns) of m elements */
+    const size_t n = sortRows ? nRow : nCol;
+    const size_t m = sortRows ? nCol : nRow;
+    const size_t stride = sortRows ? nCol : 1;
+    const size_t step = sortRows ? 1 : nCol;
+    uint64_t* key;
+    int* index2;
+    size_t i, j;
+    if (n == 0) {
+        return;
+    }
+    key = (uint64_t*)malloc(2*n*sizeof(uint64_t));
+    index2 = (int*)malloc(n*sizeof(int));
+    if (NULL == key || NULL == index2) {
+        free(key);
+        free(index2);
+        ModelicaError("Memory allocation error\n");
+        return;
+    }
+    for (i = 0; i < n; i++) {
+        indices[i] = (int)i + 1;
+    }
+    /* Lexicographic order by stable sorts from the last to the first
+       element of the rows (columns) */
+    for (j = m; j-- > 0;) {
+        int* sortedIndex;
+        for (i = 0; i < n; i++) {
+            key[i] = sortKey(M[(size_t)(indices[i] - 1)*stride + j*step],
+                ascending);
+        }
+        sortedIndex = sortKeys(key, indices, n, stable || j + 1 < m, &key[n],
+            index2);
+        if (sortedIndex != indices) {
+            memcpy(indices, sortedIndex, n*sizeof(int));
+        }
+    }
+    free(key);
+    free(index2);
+    if (sortRows) {
+        for (i = 0; i < nRow; i++) {
+            memcpy(&sorted_M[i*nCol], &M[(size_t)(indices[i] - 1)*nCol],
+                nCol*sizeof(double));
+        }
+    }
+    else {
+        for (i = 0; i < nRow; i++) {
+            for (j = 0; j < nCol; j++) {
+                sorted_M[i*nCol + j] = M[i*nCol + (size_t)(indices[j] - 1)];
+            }
+        }
+    }
+}
+
+/* ----- Internal interpolation functions ---- */
+
+static size_t findVectorIndex(_In_ const double* x, size_t n, size_t last,
+                              double xi) {
+    size_t i0;
+    size_t i1;
+    size_t step = 1;
+    size_t k;
+    if (xi >= x[last]) {
+        if (last + 2 == n || xi < x[last + 1]) {
+            return last;
+        }
+        /* Linear search of the next intervals */
+        i0 = last + 1;
+        for (k = 0; k < SEARCH_LINEAR; k++) {
+            if (i0 + 2 == n || xi < x[i0 + 1]) {
+                return i0;
+            }
+            i0++;
+        }
+        /* Exponential search forward: x[i0] <= xi and x[i1] > xi or
+           i1 = n - 1 */
+        for (;;) {
+            i1 = n - 1 - i0 > step ? i0 + step : n - 1;
+            if (i1 == n - 1 || xi < x[i1]) {
+                break;
+            }
+            i0 = i1;
+            step *= 2;
+        }
+    }
+    else if (xi < x[last]) {
+        /* Linear search of the previous intervals */
+        i1 = last;
+        for (k = 0; k < SEARCH_LINEAR; k++) {
+            if (i1 <= 1 || xi >= x[i1 - 1]) {
+                return i1 > 0 ? i1 - 1 : 0;
+            }
+            i1--;
+        }
+        /* Exponential search backward: x[i0] <= xi or i0 = 0 and
+           x[i1] > xi */
+        for (;;) {
+            i0 = i1 > step ? i1 - step : 0;
+            if (i0 == 0 || xi >= x[i0]) {
+                break;
+            }
+            i1 = i0;
+            step *= 2;
+        }
+    }
+    else {
+        /* NaN */
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + 1) {
+        const size_t i = (i0 + i1)/2;
+        if (xi < x[i]) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+    }
+    return i0;
+}
+
+static double vectorInterpolate(_In_ const double* x, _In_ const double* y,
+                                size_t i, double xi) {
+    const double x1 = x[i];
+    const double x2 = x[i + 1];
+    if (!(x2 > x1)) {
+        ModelicaError("Abscissa table vector values must be increasing\n");
+        return 0.;
+    }
+    return y[i] + (y[i + 1] - y[i])*(xi - x1)/(x2 - x1);
+}
+
+/* ----- Internal sort functions ---- */
+
+static uint64_t sortKey(double x, int ascending) {
+    uint64_t key;
+    if (x != x) {
+        /* NaN */
+        key = ~(uint64_t)0;
+    }
+    else {
+        if (x == 0.) {
+            /* -0 */
+            x = 0.;
+        }
+        memcpy(&key, &x, sizeof(key));
+        key = (key >> 63) != 0 ? ~key : key | ((uint64_t)1 << 63);
+    }
+    return ascending ? key : ~key;
+}
+
+static void sortInsertion(_Inout_ uint64_t* key,
+                          _Inout_ int* index, size_t n) {
+    size_t i;
+    for (i = 1; i < n; i++) {
+        const uint64_t k = key[i];
+        const int idx = index[i];
+        size_t j = i;
+        while (j > 0 && key[j - 1] > k) {
+            key[j] = key[j - 1];
+            index[j] = index[j - 1];
+            j--;
+        }
+        key[j] = k;
+        index[j] = idx;
+    }
+}
+
+static void sortHeap(_Inout_ uint64_t* key, _Inout_ int* index,
+                     size_t n) {
+    size_t end = n;
+    size_t start = n/2;
+    while (end > 1) {
+        uint64_t k;
+        int idx;
+        size_t i;
+        if (start > 0) {
+            /* Build the heap */
+            start--;
+            i = start;
+        }
+        else {
+            /* Move the maximum to the end */
+            end--;
+            k = key[0];
+            key[0] = key[end];
+            key[end] = k;
+            idx = index[0];
+            index[0] = index[end];
+            index[end] = idx;
+            i = 0;
+        }
+        /* Sift down */
+        k = key[i];
+        idx = index[i];
+        for (;;) {
+            size_t child = 2*i + 1;
+            if (child >= end) {
+                break;
+            }
+            if (child + 1 < end && key[child + 1] > key[child]) {
+                child++;
+            }
+            if (key[child] <= k) {
+                break;
+            }
+            key[i] = key[child];
+            index[i] = index[child];
+            i = child;
+        }
+        key[i] = k;
+        index[i] = idx;
+    }
+}
+
+static void sortIntro(_Inout_ uint64_t* key, _Inout_ int* index,
+                      size_t n, size_t depth) {
+#define SORT_SWAP(a, b) do { \
+    const uint64_t k_ = key[a]; \
+    const int i_ = index[a]; \
+    key[a] = key[b]; \
+    key[b] = k_; \
+    index[a] = index[b]; \
+    index[b] = i_; \
+} while (0)
+    while (n > SORT_INSERTION) {
+        uint64_t pivot;
+        size_t i, j;
+        if (depth == 0) {
+            sortHeap(key, index, n);
+            return;
+        }
+        depth--;
+
+        /* Median of three as pivot at position 0, key[1] <= pivot and
+           key[n - 1] >= pivot are sentinels of the partition */
+        SORT_SWAP(1, n/2);
+        if (key[1] > key[n - 1]) {
+            SORT_SWAP(1, n - 1);
+        }
+        if (key[0] > key[n - 1]) {
+            SORT_SWAP(0, n - 1);
+        }
+        if (key[1] > key[0]) {
+            SORT_SWAP(0, 1);
+        }
+        pivot = key[0];
+
+        /* Hoare partition of [2, n - 1) */
+        i = 1;
+        j = n - 1;
+        for (;;) {
+            do {
+                i++;
+            } while (key[i] < pivot);
+            do {
+                j--;
+            } while (key[j] > pivot);
+            if (i >= j) {
+                break;
+            }
+            SORT_SWAP(i, j);
+        }
+        SORT_SWAP(0, j);
+
+        /* Recursion for the smaller part, iteration for the larger one */
+        if (j < n - 1 - j) {
+            sortIntro(key, index, j, depth);
+            key += j + 1;
+            index += j + 1;
+            n -= j + 1;
+        }
+        else {
+            sortIntro(&key[j + 1], &index[j + 1], n - 1 - j, depth);
+            n = j;
+        }
+    }
+    sortInsertion(key, index, n);
+#undef SORT_SWAP
+}
+
+static void sortMerge(_Inout_ uint64_t* key, _Inout_ int* index,
+                      size_t n, _Inout_ uint64_t* key2,
+                      _Inout_ int* index2) {
+    size_t half, i, j, k;
+    if (n <= SORT_INSERTION) {
+        sortInsertion(key, index, n);
+        return;
+    }
+    half = n/2;
+    sortMerge(key, index, half, key2, index2);
+    sortMerge(&key[half], &index[half], n - half, key2, index2);
+    if (key[half - 1] <= key[half]) {
+        /* Already in order */
+        return;
+    }
+
+    /* Merge the first half from the buffer and the second half in place */
+    memcpy(key2, key, half*sizeof(uint64_t));
+    memcpy(index2, index, half*sizeof(int));
+    i = 0;
+    j = half;
+    k = 0;
+    while (i < half && j < n) {
+        if (key[j] < key2[i]) {
+            key[k] = key[j];
+            index[k++] = index[j++];
+        }
+        else {
+            key[k] = key2[i];
+            index[k++] = index2[i++];
+        }
+    }
+    memcpy(&key[k], &key2[i], (half - i)*sizeof(uint64_t));
+    memcpy(&index[k], &index2[i], (half - i)*sizeof(int));
+}
+
+static int* sortRadix(_Inout_ uint64_t* key, _Inout_ int* index,
+                      size_t n, _Inout_ uint64_t* key2,
+                      _Inout_ int* index2) {
+    size_t count[8][256];
+    size_t i;
+    int pass;
+
+    /* Histograms of all digits in one pass */
+    memset(count, 0, sizeof(count));
+    for (i = 0; i < n; i++) {
+        const uint64_t k = key[i];
+        for (pass = 0; pass < 8; pass++) {
+            count[pass][(size_t)(k >> (8*pass)) & 255]++;
+        }
+    }
+
+    for (pass = 0; pass < 8; pass++) {
+        const int shift = 8*pass;
+        size_t* c = count[pass];
+        size_t sum = 0;
+        uint64_t* keyTmp;
+        int* indexTmp;
+        if (c[(size_t)(key[0] >> shift) & 255] == n) {
+            /* All keys have the same digit */
+            continue;
+        }
+        for (i = 0; i < 256; i++) {
+            const size_t ci = c[i];
+            c[i] = sum;
+            sum += ci;
+        }
+        for (i = 0; i < n; i++) {
+            const size_t pos = c[(size_t)(key[i] >> shift) & 255]++;
+            key2[pos] = key[i];
+            index2[pos] = index[i];
+        }
+        keyTmp = key;
+        key = key2;
+        key2 = keyTmp;
+        indexTmp = index;
+        index = index2;
+        index2 = indexTmp;
+    }
+    return index;
+}
+
+static int* sortKeys(_Inout_ uint64_t* key, _Inout_ int* index,
+                     size_t n, int stable, _Inout_ uint64_t* key2,
+                     _Inout_ int* index2) {
+    if (n >= SORT_RADIX) {
+        return sortRadix(key, index, n, key2, index2);
+    }
+    if (stable) {
+        sortMerge(key, index, n, key2, index2);
+    }
+    else {
+        /* Depth limit 2*log2(n) */
+        size_t depth = 0;
+        size_t m;
+        for (m = n; m > 1; m /= 2) {
+            depth += 2;
+        }
+        sortIntro(key, index, n, depth);
+    }
+    return index;
+}
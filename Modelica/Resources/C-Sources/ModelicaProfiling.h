@@ -0,0 +1,354 @@
+/* ModelicaProfiling.h - Call counters and latency histograms of the
+                         external C-functions
+
+   Copyright (C) 2017, Modelica Association and contributors
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions are met:
+
+   1. Redistributions of source code must retain the above copyright notice,
+      this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+   ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+   WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+   FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+   SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+   CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+   OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Each C-file lists its external functions and additional event counters
+   before including this header:
+
+   #define MODELICA_PROFILE_MODULE "ModelicaFoo"
+   #define MODELICA_PROFILE_FUNCTIONS(F) \
+       F(ModelicaFoo_bar) \
+       F(ModelicaFoo_baz)
+   #define MODELICA_PROFILE_COUNTERS(C) \
+       C(cacheHits)
+   #include "ModelicaProfiling.h"
+
+   MODELICA_EXPORT double ModelicaFoo_bar(double x) {
+       MODELICA_PROFILE_BEGIN();
+       double y = 2*x;
+       MODELICA_PROFILE_COUNT(cacheHits, 1);
+       MODELICA_PROFILE_END(ModelicaFoo_bar);
+       return y;
+   }
+
+   MODELICA_PROFILE_BEGIN() is a declaration and therefore the first
+   statement of the function body, MODELICA_PROFILE_END is placed before
+   each return. Calls terminated by ModelicaError are not recorded.
+
+   Exported functions that only forward to a function pointer record the
+   forwarded call by
+
+       MODELICA_PROFILE_CALL(ModelicaFoo_baz, y = foo->baz(foo, x));
+
+   instead, which keeps the forwarding a tail call if profiling is disabled.
+
+   Profiling is enabled by the environment variable MODELICA_PROFILE when
+   the library is loaded. Its value is the name of the file to which a JSON
+   object per C-file is appended at exit (or when the library is unloaded),
+   "1" or "stderr" print to stderr. For each called function the number of
+   calls, the cumulative and maximum time and a histogram of the call
+   durations are reported, where bucket i counts the calls that took between
+   2^i and 2^(i+1) nanoseconds (bucket 0 also counts shorter calls).
+
+   The counters are kept per thread, such that recording a call does not
+   need any locking. If disabled, the overhead is a test of a static flag
+   per call and counter. The flag is only set by the constructor. The blocks
+   of counters are intentionally not freed at exit, since other threads may
+   still record calls while or after the counters are written. They remain
+   reachable from a static list. Define NO_PROFILING to build without the
+   counters. They are not available without constructor support or
+   thread-local storage.
+
+   Define MODELICA_PROFILE_CLOCK before the inclusion to use the monotonic
+   clock ModelicaProfile_now() independent of the profiling.
+*/
+
+#ifndef MODELICA_PROFILING_H
+#define MODELICA_PROFILING_H
+
+#if !defined(NO_PROFILING) && defined(G_HAS_CONSTRUCTORS)
+#if defined(_MSC_VER)
+#define MODELICA_PROFILE_TLS __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define MODELICA_PROFILE_TLS __thread
+#endif
+#endif
+
+#if defined(MODELICA_PROFILE_TLS) || defined(MODELICA_PROFILE_CLOCK)
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+static unsigned long long ModelicaProfile_now(void) {
+    /* Monotonic time in nanoseconds, never zero */
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return 1 + (unsigned long long)((double)counter.QuadPart*
+        (1e9/(double)frequency.QuadPart));
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1 + (unsigned long long)ts.tv_sec*1000000000ULL +
+        (unsigned long long)ts.tv_nsec;
+#else
+    return 1 + (unsigned long long)((double)clock()*(1e9/CLOCKS_PER_SEC));
+#endif
+}
+
+#endif
+
+#if defined(MODELICA_PROFILE_TLS)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MODELICA_PROFILE_BUCKETS (32)
+
+#define MODELICA_PROFILE_ENUM_FUNCTION(name) PROFILE_##name,
+#define MODELICA_PROFILE_ENUM_COUNTER(name) PROFILE_COUNTER_##name,
+#define MODELICA_PROFILE_NAME(name) #name,
+
+enum ModelicaProfileFunctionId {
+    MODELICA_PROFILE_FUNCTIONS(MODELICA_PROFILE_ENUM_FUNCTION)
+    MODELICA_PROFILE_N_FUNCTIONS
+};
+
+enum ModelicaProfileCounterId {
+    MODELICA_PROFILE_COUNTERS(MODELICA_PROFILE_ENUM_COUNTER)
+    MODELICA_PROFILE_N_COUNTERS
+};
+
+typedef struct ModelicaProfileFunction {
+    unsigned long long calls;
+    unsigned long long ns; /* Cumulative time */
+    unsigned long long maxNs;
+    unsigned long long histogram[MODELICA_PROFILE_BUCKETS];
+} ModelicaProfileFunction;
+
+typedef struct ModelicaProfileThread {
+    struct ModelicaProfileThread* next;
+    ModelicaProfileFunction functions[MODELICA_PROFILE_N_FUNCTIONS];
+    unsigned long long counters[MODELICA_PROFILE_N_COUNTERS + 1];
+} ModelicaProfileThread;
+
+static int ModelicaProfile_enabled = 0;
+/* List of the counters of all threads, extended lock-free */
+static ModelicaProfileThread* volatile ModelicaProfile_threads = NULL;
+static MODELICA_PROFILE_TLS ModelicaProfileThread* ModelicaProfile_thread = NULL;
+
+static ModelicaProfileThread* ModelicaProfile_getThread(void) {
+    /* Return the counters of the calling thread */
+    ModelicaProfileThread* thread = ModelicaProfile_thread;
+    if (thread == NULL) {
+        thread = (ModelicaProfileThread*)calloc(1, sizeof(ModelicaProfileThread));
+        if (thread != NULL) {
+            ModelicaProfileThread* head;
+            do {
+                head = ModelicaProfile_threads;
+                thread->next = head;
+            }
+#if defined(_WIN32) && !defined(__GNUC__)
+            while (InterlockedCompareExchangePointer(
+                (PVOID volatile*)&ModelicaProfile_threads, thread, head) != head);
+#else
+            while (!__sync_bool_compare_and_swap(&ModelicaProfile_threads,
+                head, thread));
+#endif
+            ModelicaProfile_thread = thread;
+        }
+    }
+    return thread;
+}
+
+static void ModelicaProfile_end(enum ModelicaProfileFunctionId id,
+                                unsigned long long start) {
+    /* Record a call that started at time start */
+    const unsigned long long ns = ModelicaProfile_now() - start;
+    ModelicaProfileThread* thread = ModelicaProfile_getThread();
+    if (thread != NULL) {
+        ModelicaProfileFunction* f = &thread->functions[id];
+        int bucket = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        if (ns > 1) {
+            bucket = 63 - __builtin_clzll(ns);
+        }
+#else
+        unsigned long long n = ns;
+        while (n > 1) {
+            n >>= 1;
+            bucket++;
+        }
+#endif
+        if (bucket >= MODELICA_PROFILE_BUCKETS) {
+            bucket = MODELICA_PROFILE_BUCKETS - 1;
+        }
+        f->calls++;
+        f->ns += ns;
+        if (ns > f->maxNs) {
+            f->maxNs = ns;
+        }
+        f->histogram[bucket]++;
+    }
+}
+
+#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(ModelicaProfile_initialize)
+#endif
+G_DEFINE_CONSTRUCTOR(ModelicaProfile_initialize)
+static void ModelicaProfile_initialize(void) {
+    const char* env = getenv("MODELICA_PROFILE");
+    ModelicaProfile_enabled = env != NULL && env[0] != '\0' &&
+        strcmp(env, "0") != 0;
+}
+
+#ifdef G_DEFINE_DESTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_DESTRUCTOR_PRAGMA_ARGS(ModelicaProfile_dump)
+#endif
+G_DEFINE_DESTRUCTOR(ModelicaProfile_dump)
+static void ModelicaProfile_dump(void) {
+    /* Sum up the counters of all threads and write them as JSON object */
+    static const char* functionNames[MODELICA_PROFILE_N_FUNCTIONS + 1] = {
+        MODELICA_PROFILE_FUNCTIONS(MODELICA_PROFILE_NAME) NULL
+    };
+    static const char* counterNames[MODELICA_PROFILE_N_COUNTERS + 1] = {
+        MODELICA_PROFILE_COUNTERS(MODELICA_PROFILE_NAME) NULL
+    };
+    ModelicaProfileThread total;
+    ModelicaProfileThread* thread;
+    const char* env = getenv("MODELICA_PROFILE");
+    FILE* fp;
+    size_t nThreads = 0;
+    int i;
+    int first = 1;
+
+    if (!ModelicaProfile_enabled || ModelicaProfile_threads == NULL) {
+        return;
+    }
+    memset(&total, 0, sizeof(total));
+    for (thread = ModelicaProfile_threads; thread != NULL; thread = thread->next) {
+        for (i = 0; i < MODELICA_PROFILE_N_FUNCTIONS; i++) {
+            const ModelicaProfileFunction* f = &thread->functions[i];
+            int j;
+            total.functions[i].calls += f->calls;
+            total.functions[i].ns += f->ns;
+            if (f->maxNs > total.functions[i].maxNs) {
+                total.functions[i].maxNs = f->maxNs;
+            }
+            for (j = 0; j < MODELICA_PROFILE_BUCKETS; j++) {
+                total.functions[i].histogram[j] += f->histogram[j];
+            }
+        }
+        for (i = 0; i < MODELICA_PROFILE_N_COUNTERS; i++) {
+            total.counters[i] += thread->counters[i];
+        }
+        nThreads++;
+    }
+
+    if (env == NULL || strcmp(env, "1") == 0 || strcmp(env, "stderr") == 0) {
+        fp = stderr;
+    }
+    else {
+        fp = fopen(env, "a");
+        if (fp == NULL) {
+            return;
+        }
+    }
+    fprintf(fp, "{\"module\":\"%s\",\"threads\":%lu,\"functions\":{",
+        MODELICA_PROFILE_MODULE, (unsigned long)nThreads);
+    for (i = 0; i < MODELICA_PROFILE_N_FUNCTIONS; i++) {
+        const ModelicaProfileFunction* f = &total.functions[i];
+        int j;
+        int nBuckets = MODELICA_PROFILE_BUCKETS;
+        if (f->calls == 0) {
+            continue;
+        }
+        while (nBuckets > 1 && f->histogram[nBuckets - 1] == 0) {
+            nBuckets--;
+        }
+        fprintf(fp, "%s\"%s\":{\"calls\":%.0f,\"seconds\":%.9g,"
+            "\"maxSeconds\":%.9g,\"histogram\":[", first ? "" : ",",
+            functionNames[i], (double)f->calls, 1e-9*(double)f->ns,
+            1e-9*(double)f->maxNs);
+        for (j = 0; j < nBuckets; j++) {
+            fprintf(fp, "%s%.0f", j > 0 ? "," : "", (double)f->histogram[j]);
+        }
+        fputs("]}", fp);
+        first = 0;
+    }
+    fputs("},\"counters\":{", fp);
+    for (i = 0; i < MODELICA_PROFILE_N_COUNTERS; i++) {
+        fprintf(fp, "%s\"%s\":%.0f", i > 0 ? "," : "", counterNames[i],
+            (double)total.counters[i]);
+    }
+    fputs("}}\n", fp);
+    if (fp != stderr) {
+        fclose(fp);
+    }
+}
+
+#define MODELICA_PROFILE_BEGIN() \
+    const unsigned long long modelicaProfileStart = \
+        ModelicaProfile_enabled ? ModelicaProfile_now() : 0
+#define MODELICA_PROFILE_END(name) do { \
+    if (modelicaProfileStart != 0) { \
+        ModelicaProfile_end(PROFILE_##name, modelicaProfileStart); \
+    } \
+} while (0)
+#define MODELICA_PROFILE_COUNT(name, n) do { \
+    if (ModelicaProfile_enabled) { \
+        ModelicaProfileThread* modelicaProfileThread = ModelicaProfile_getThread(); \
+        if (modelicaProfileThread != NULL) { \
+            modelicaProfileThread->counters[PROFILE_COUNTER_##name] += \
+                (unsigned long long)(n); \
+        } \
+    } \
+} while (0)
+#define MODELICA_PROFILE_CALL(name, statement) do { \
+    if (ModelicaProfile_enabled) { \
+        const unsigned long long modelicaProfileStart = ModelicaProfile_now(); \
+        statement; \
+        ModelicaProfile_end(PROFILE_##name, modelicaProfileStart); \
+    } \
+    else { \
+        statement; \
+    } \
+} while (0)
+
+#else
+
+#define MODELICA_PROFILE_BEGIN() const int modelicaProfileStart = 0
+#define MODELICA_PROFILE_END(name) (void)modelicaProfileStart
+#define MODELICA_PROFILE_COUNT(name, n) (void)(n)
+#define MODELICA_PROFILE_CALL(name, statement) do { \
+    statement; \
+} while (0)
+
+#endif
+
+#endif
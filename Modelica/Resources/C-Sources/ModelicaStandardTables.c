@@ -31,7 +31,10 @@
       Modelica.Blocks.Sources.CombiTimeTable
       Modelica.Blocks.Tables.CombiTable1D
       Modelica.Blocks.Tables.CombiTable1Ds
+      Modelica.Blocks.Tables.CombiTable1DInverse
       Modelica.Blocks.Tables.CombiTable2D
+      Modelica.Blocks.Tables.CombiTableND
+      Modelica.Media.Water.IF97_Utilities.Tabulated
 
    The following #define's are available.
 
@@ -44,8 +47,57 @@
                            arrays are stored in a global hash table in order to
                            avoid superfluous file input access and to decrease the
                            utilized memory (tickets #1110 and #1550).
+                           Tables of CombiTimeTable and CombiTable1D read from
+                           file only hold the first column and the columns to
+                           be interpolated and are shared per column selection.
+                           If NO_TABLE_COPY is not defined then also identical
+                           table arrays passed to the _init functions and their
+                           pre-calculated spline coefficients are shared
+                           (identified by a hash of the table content).
+   TABLE_AKIMA_CACHE     : If TABLE_SHARE is defined, the default budget (in bytes)
+                           of a cache of Akima spline coefficients of CombiTable2D,
+                           which are calculated per tile of grid cells on first use
+                           instead of at initialization. The cache is shared by all
+                           tables and the least recently used tiles are discarded.
+                           The budget can be set by the environment variable
+                           MODELICA_TABLE_AKIMA_CACHE (in bytes, optionally with
+                           suffix k, M or G). Default: 0, i.e., the coefficients
+                           are calculated at initialization.
+                           A cache miss calculates the coefficients of a tile of
+                           TABLE_AKIMA_TILE x TABLE_AKIMA_TILE cells from the
+                           table values around it. For random access patterns
+                           that mostly miss the cache, an evaluation is hence
+                           about 3 times slower than with the coefficients
+                           calculated at initialization (1.5 us instead of 0.5 us
+                           for a 1000 x 1000 grid), whereas monotone evaluation
+                           is about as fast.
+   NO_PROFILING          : Do not compile the call counters and latency histograms
+                           enabled by the environment variable MODELICA_PROFILE
+                           (see ModelicaProfiling.h)
 
    Release Notes:
+      Oct. 18, 2026: by Modelica Association
+                     Select specialized evaluation kernels of CombiTimeTable,
+                     CombiTable1D and CombiTable2D at initialization
+                     Interpolate with pre-calculated inverse interval widths
+                     (define TABLE_EXACT_DIVISION to divide instead)
+                     Wrap periodic inputs of CombiTimeTable in constant time
+                     Locate time events of CombiTimeTable by bisection
+                     Added fused functions getValueAndDer for all table types
+                     Added optional single precision storage of table values
+                     and spline coefficients (init2/init3 functions and
+                     environment variable MODELICA_TABLE_FLOAT)
+                     Share identical table arrays passed to the _init functions
+                     and their spline coefficients (TABLE_SHARE without
+                     NO_TABLE_COPY)
+                     Read only the used columns of table files, skip unchanged
+                     files and parse only appended rows on forced reads
+                     Added inverse evaluation of monotonic columns of
+                     CombiTable1D
+                     Added N-dimensional table CombiTableND
+                     Added optional cache of the Akima spline coefficients of
+                     CombiTable2D (TABLE_AKIMA_CACHE)
+
       Mar. 08, 2017: by Thomas Beutlich, ESI ITI GmbH
                      Moved file I/O functions to ModelicaIO (ticket #2192)
 
@@ -138,10 +190,56 @@
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
 #include "uthash.h"
 #undef uthash_fatal /* Ensure that nowhere in this file uses uthash_fatal by accident */
-#include "gconstructor.h"
+#if !defined(NO_TABLE_COPY)
+#define TABLE_CONTENT_SHARE
+#endif
 #endif
+#include "gconstructor.h"
+#include "ModelicaCPUDispatch.h"
+#define MODELICA_PROFILE_MODULE "ModelicaStandardTables"
+#define MODELICA_PROFILE_FUNCTIONS(F) \
+    F(ModelicaStandardTables_CombiTimeTable_init2) \
+    F(ModelicaStandardTables_CombiTimeTable_getValue) \
+    F(ModelicaStandardTables_CombiTimeTable_getDerValue) \
+    F(ModelicaStandardTables_CombiTimeTable_getValueAndDer) \
+    F(ModelicaStandardTables_CombiTimeTable_nextTimeEvent) \
+    F(ModelicaStandardTables_CombiTimeTable_read) \
+    F(ModelicaStandardTables_CombiTable1D_init3) \
+    F(ModelicaStandardTables_CombiTable1D_getValue) \
+    F(ModelicaStandardTables_CombiTable1D_getDerValue) \
+    F(ModelicaStandardTables_CombiTable1D_getValueAndDer) \
+    F(ModelicaStandardTables_CombiTable1D_getInverseValue) \
+    F(ModelicaStandardTables_CombiTable1D_getInverseDerValue) \
+    F(ModelicaStandardTables_CombiTable1D_read) \
+    F(ModelicaStandardTables_CombiTable2D_init2) \
+    F(ModelicaStandardTables_CombiTable2D_read) \
+    F(ModelicaStandardTables_CombiTable2D_getValue) \
+    F(ModelicaStandardTables_CombiTable2D_getDerValue) \
+    F(ModelicaStandardTables_CombiTable2D_getValueAndDer) \
+    F(ModelicaStandardTables_CombiTableND_init) \
+    F(ModelicaStandardTables_CombiTableND_read) \
+    F(ModelicaStandardTables_CombiTableND_getValue) \
+    F(ModelicaStandardTables_CombiTableND_getDerValue) \
+    F(ModelicaStandardTables_SharedTable2D_getValue) \
+    F(ModelicaStandardTables_SharedTable2D_getValueAndDer) \
+    F(ModelicaStandardTables_SharedTable2D_setTables)
+/* Interval searches (findRowIndex and findColIndex), searches answered by
+   the interval of the previous call, binary searches and their total number
+   of bisection steps, extrapolated evaluations and evaluations of spline
+   coefficients */
+#define MODELICA_PROFILE_COUNTERS(C) \
+    C(searches) \
+    C(searchHintHits) \
+    C(binarySearches) \
+    C(binarySearchSteps) \
+    C(extrapolations) \
+    C(splineEvaluations) \
+    C(splineTiles)
+#define MODELICA_PROFILE_CLOCK
+#include "ModelicaProfiling.h"
 #include <float.h>
 #include <math.h>
+#include <stdio.h>
 #include <string.h>
 
 #if !defined(NO_FILE_SYSTEM)
@@ -174,6 +272,12 @@ enum Extrapolation {
     NO_EXTRAPOLATION
 };
 
+enum TableStorage {
+    STORAGE_DEFAULT = 0,
+    STORAGE_DOUBLE,
+    STORAGE_FLOAT
+};
+
 /* ----- Internal enumerations ----- */
 
 enum PointInterval {
@@ -189,6 +293,21 @@ enum TableSource {
     TABLESOURCE_FUNCTION_TRANSPOSE
 };
 
+enum TableShape {
+    SHAPE_GENERAL = 0,
+    SHAPE_SINGLE_ROW, /* Single row of values */
+    SHAPE_SINGLE_COLUMN, /* Single column of values (CombiTable2D only) */
+    SHAPE_SINGLE_VALUE, /* Single value (CombiTable2D only) */
+    SHAPE_NONE /* Invalid table dimensions */
+};
+
+enum SharedTableState {
+    SHAREDTABLE_NEW = 0, /* Table values not yet provided */
+    SHAREDTABLE_LOADED,
+    SHAREDTABLE_UNAVAILABLE /* Table values not valid or being initialized
+        by another thread */
+};
+
 /* ----- Internal table memory ----- */
 
 /* 3 (of 4) 1D cubic Hermite spline coefficients (per interval) */
@@ -197,9 +316,76 @@ typedef double CubicHermite1D[3];
 /* 15 (of 16) 2D cubic Hermite spline coefficients (per grid) */
 typedef double CubicHermite2D[15];
 
+/* Single precision storage of the 1D and 2D cubic Hermite spline
+   coefficients */
+typedef float CubicHermite1DFloat[3];
+typedef float CubicHermite2DFloat[15];
+
 /* Left and right interval indices (per interval) */
 typedef size_t Interval[2];
 
+/* Tile of on-demand calculated 2D cubic Hermite spline coefficients, member
+   of the cache shared by all CombiTable2D (see TABLE_AKIMA_CACHE) */
+typedef struct AkimaTile {
+    struct AkimaTile* prev; /* Next more recently used tile of the cache */
+    struct AkimaTile* next; /* Next less recently used tile of the cache */
+    struct AkimaGrid* grid; /* Grid of the tile */
+    size_t index; /* Index of the tile in the grid */
+    size_t width; /* Number of cells per row of the tile */
+    size_t size; /* Allocated memory in bytes */
+    CubicHermite2D* spline; /* Coefficients of the cells of the tile
+        (row-wise storage), allocated together with the tile */
+} AkimaTile;
+
+/* On-demand calculated 2D cubic Hermite spline coefficients of a
+   CombiTable2D */
+typedef struct AkimaGrid {
+    const double* table; /* Table values (not owned) */
+    size_t nRow; /* Number of rows of table */
+    size_t nCol; /* Number of columns of table */
+    double* xy; /* Grid points of both inputs, extended by two extrapolated
+        grid points on each side (nRow + 3 followed by nCol + 3 values) */
+    size_t nTile2; /* Number of tiles per row of tiles */
+    AkimaTile** tiles; /* Tiles of the grid, NULL if not in the cache */
+    size_t lastCell; /* Index of the cell of coefficients, (size_t)-1 if
+        there is none */
+    CubicHermite2D coefficients; /* Copy of the coefficients of cell
+        lastCell */
+} AkimaGrid;
+
+struct CombiTimeTable;
+struct CombiTable1D;
+struct CombiTable2D;
+struct CombiTableND;
+struct ContentShare;
+
+/* Evaluation kernels, specialized for the table shape, smoothness and
+   extrapolation kind and selected when the table is (re)initialized */
+typedef double (*CombiTimeTableValue)(struct CombiTimeTable* tableID,
+    int iCol, double t, double nextTimeEvent, double preNextTimeEvent);
+typedef double (*CombiTimeTableDerValue)(struct CombiTimeTable* tableID,
+    int iCol, double t, double nextTimeEvent, double preNextTimeEvent,
+    double der_t);
+typedef double (*CombiTimeTableValueAndDer)(struct CombiTimeTable* tableID,
+    int iCol, double t, double nextTimeEvent, double preNextTimeEvent,
+    double* der_y);
+typedef double (*CombiTable1DValue)(struct CombiTable1D* tableID, int iCol,
+    double u);
+typedef double (*CombiTable1DDerValue)(struct CombiTable1D* tableID,
+    int iCol, double u, double der_u);
+typedef double (*CombiTable1DValueAndDer)(struct CombiTable1D* tableID,
+    int iCol, double u, double* der_y);
+typedef double (*CombiTable2DValue)(struct CombiTable2D* tableID, double u1,
+    double u2);
+typedef double (*CombiTable2DDerValue)(struct CombiTable2D* tableID,
+    double u1, double u2, double der_u1, double der_u2);
+typedef double (*CombiTable2DValueAndDer)(struct CombiTable2D* tableID,
+    double u1, double u2, double* der_y1, double* der_y2);
+typedef double (*CombiTableNDValue)(struct CombiTableND* tableID,
+    const double* u);
+typedef double (*CombiTableNDDerValue)(struct CombiTableND* tableID,
+    const double* u, const double* der_u);
+
 typedef struct CombiTimeTable {
     char* fileName; /* Name of table file */
     char* tableName; /* Name of table */
@@ -212,6 +398,13 @@ typedef struct CombiTimeTable {
     enum TableSource source; /* Source kind */
     int* cols; /* Columns of table to be interpolated */
     size_t nCols; /* Number of columns of table to be interpolated */
+    size_t* columns; /* Columns of the table file held by table (strictly
+        increasing, starting with 1), only used if source is TABLESOURCE_FILE,
+        cols then refers to the columns of table */
+    size_t nColumns; /* Number of columns of the table file held by table,
+        0 if all columns are held */
+    ModelicaIOTableState fileState; /* State of the last read of the table
+        file, only used if source is TABLESOURCE_FILE */
     double startTime; /* Start time of interpolation */
     CubicHermite1D* spline; /* Pre-calculated cubic Hermite spline coefficients,
         only used if smoothness is AKIMA_C1 or
@@ -227,6 +420,24 @@ typedef struct CombiTimeTable {
     double tOffset; /* Time offset, calculated by floor function, discrete,
         only used if extrapolation is PERIODIC */
     Interval* intervals; /* Event interval indices */
+    size_t* eventRows; /* Sorted row indices of the time events within the
+        table range (maxEvents - 1 entries), only used if smoothness is
+        LINEAR_SEGMENTS or CONSTANT_SEGMENTS */
+    double* invWidth; /* Pre-calculated inverse widths of the row intervals */
+    enum TableStorage storage; /* Storage precision kind */
+    float* tableFloat; /* Table values without the first column in single
+        precision (row-wise storage), only used if storage is STORAGE_FLOAT and
+        the table array is owned, table then only holds the first column */
+    CubicHermite1DFloat* splineFloat; /* Pre-calculated cubic Hermite spline
+        coefficients in single precision, replace spline if storage is
+        STORAGE_FLOAT */
+    struct ContentShare* share; /* Content share owning the table values,
+        spline coefficients and inverse interval widths (if not NULL), only
+        used if source is TABLESOURCE_MODEL */
+    CombiTimeTableValue getValue; /* Evaluation kernel of value */
+    CombiTimeTableDerValue getDerValue; /* Evaluation kernel of derivative */
+    CombiTimeTableValueAndDer getValueAndDer; /* Evaluation kernel of value and
+        partial derivative(s) */
 } CombiTimeTable;
 
 typedef struct CombiTable1D {
@@ -241,9 +452,35 @@ typedef struct CombiTable1D {
     enum TableSource source; /* Source kind */
     int* cols; /* Columns of table to be interpolated */
     size_t nCols; /* Number of columns of table to be interpolated */
+    size_t* columns; /* Columns of the table file held by table (strictly
+        increasing, starting with 1), only used if source is TABLESOURCE_FILE,
+        cols then refers to the columns of table */
+    size_t nColumns; /* Number of columns of the table file held by table,
+        0 if all columns are held */
+    ModelicaIOTableState fileState; /* State of the last read of the table
+        file, only used if source is TABLESOURCE_FILE */
     CubicHermite1D* spline; /* Pre-calculated cubic Hermite spline coefficients,
         only used if smoothness is AKIMA_C1 or
         FRITSCH_BUTLAND_MONOTONE_C1 or STEFFEN_MONOTONE_C1 */
+    double* invWidth; /* Pre-calculated inverse widths of the row intervals */
+    int* monotony; /* Monotonicity of the interpolation of the columns to be
+        interpolated (see monotony1DInit), determined by the first inverse
+        evaluation after the table is initialized or read */
+    size_t lastInverse; /* Last accessed row index of the inverse evaluation */
+    enum TableStorage storage; /* Storage precision kind */
+    float* tableFloat; /* Table values without the first column in single
+        precision (row-wise storage), only used if storage is STORAGE_FLOAT and
+        the table array is owned, table then only holds the first column */
+    CubicHermite1DFloat* splineFloat; /* Pre-calculated cubic Hermite spline
+        coefficients in single precision, replace spline if storage is
+        STORAGE_FLOAT */
+    struct ContentShare* share; /* Content share owning the table values,
+        spline coefficients and inverse interval widths (if not NULL), only
+        used if source is TABLESOURCE_MODEL */
+    CombiTable1DValue getValue; /* Evaluation kernel of value */
+    CombiTable1DDerValue getDerValue; /* Evaluation kernel of derivative */
+    CombiTable1DValueAndDer getValueAndDer; /* Evaluation kernel of value and
+        partial derivative(s) */
 } CombiTable1D;
 
 typedef struct CombiTable2D {
@@ -256,10 +493,94 @@ typedef struct CombiTable2D {
     size_t last2; /* Last accessed column index of table */
     enum Smoothness smoothness; /* Smoothness kind */
     enum TableSource source; /* Source kind */
+    ModelicaIOTableState fileState; /* State of the last read of the table
+        file, only used if source is TABLESOURCE_FILE */
     CubicHermite2D* spline; /* Pre-calculated cubic Hermite spline coefficients,
         only used if smoothness is AKIMA_C1 */
+    double* invWidth1; /* Pre-calculated inverse widths of the row intervals
+        (of the first input) */
+    double* invWidth2; /* Pre-calculated inverse widths of the column
+        intervals (of the second input) */
+    enum TableStorage storage; /* Storage precision kind */
+    float* tableFloat; /* Table values without the first row and column in
+        single precision (row-wise storage), only used if storage is
+        STORAGE_FLOAT and the table array is owned, table then only holds the
+        first column */
+    double* tableU2; /* First row of table, only used if tableFloat is not
+        NULL */
+    CubicHermite2DFloat* splineFloat; /* Pre-calculated cubic Hermite spline
+        coefficients in single precision, replace spline if storage is
+        STORAGE_FLOAT */
+    AkimaGrid* akima; /* On-demand calculated cubic Hermite spline
+        coefficients, replace spline if not NULL (see TABLE_AKIMA_CACHE) */
+    struct ContentShare* share; /* Content share owning the table values,
+        spline coefficients and inverse interval widths (if not NULL), only
+        used if source is TABLESOURCE_MODEL */
+    CombiTable2DValue getValue; /* Evaluation kernel of value */
+    CombiTable2DDerValue getDerValue; /* Evaluation kernel of derivative */
+    CombiTable2DValueAndDer getValueAndDer; /* Evaluation kernel of value and
+        partial derivative(s) */
 } CombiTable2D;
 
+typedef struct TableNDAxis {
+    size_t n; /* Number of grid points */
+    size_t last; /* Last accessed interval index */
+    const double* x; /* Grid points */
+    const double* invWidth; /* Pre-calculated inverse widths of the
+        intervals */
+    const double* slope; /* Pre-calculated weights of the slope at each grid
+        point (3 per grid point, see tableNDInit), only used if smoothness is
+        AKIMA_C1 */
+    const size_t* offset; /* Offset of the values of each grid point in the
+        tiled value block */
+} TableNDAxis;
+
+typedef struct CombiTableND {
+    char* fileName; /* Name of table file */
+    char* tableName; /* Name of table */
+    double* table; /* Table vector read from file (see
+        ModelicaStandardTables_CombiTableND_init), only used if source is
+        TABLESOURCE_FILE */
+    size_t nRow; /* Number of rows of table */
+    size_t nCol; /* Number of columns of table */
+    size_t nDim; /* Number of dimensions (inputs) */
+    enum Smoothness smoothness; /* Smoothness kind */
+    enum Extrapolation extrapolation; /* Extrapolation kind */
+    enum TableSource source; /* Source kind */
+    enum TableStorage storage; /* Storage precision kind */
+    ModelicaIOTableState fileState; /* State of the last read of the table
+        file, only used if source is TABLESOURCE_FILE */
+    TableNDAxis* axis; /* Axes (of the nDim inputs), the arrays of the axes
+        are stored in axes, invWidth, slope and offset */
+    double* axes; /* Grid points of all axes */
+    double* invWidth; /* Pre-calculated inverse interval widths of all axes */
+    double* slope; /* Pre-calculated slope weights of all axes */
+    size_t* offset; /* Offsets of the grid points of all axes */
+    double* values; /* Function values on the grid in tiled order (see
+        tableNDInit) */
+    float* valuesFloat; /* Function values in single precision, replace
+        values if storage is STORAGE_FLOAT */
+    CombiTableNDValue getValue; /* Evaluation kernel of value */
+    CombiTableNDDerValue getDerValue; /* Evaluation kernel of derivative */
+} CombiTableND;
+
+typedef struct SharedTable2D {
+    char* tableName; /* Name of table of values */
+    char* validName; /* Name of table of validity, empty if all values are
+        valid */
+    CombiTable2D* table; /* Table of values (Akima-spline interpolation) */
+    CombiTable2D* valid; /* Table of validity (linear interpolation) or NULL */
+#if defined(NO_TABLE_COPY)
+    double* values; /* Copy of the values of table and valid */
+#endif
+    double u1Min; /* Minimum value of the first input */
+    double u1Max; /* Maximum value of the first input */
+    double u2Min; /* Minimum value of the second input */
+    double u2Max; /* Maximum value of the second input */
+    enum SharedTableState state; /* Load state, guarded by the mutex */
+    struct SharedTable2D* next; /* Next entry of the registry */
+} SharedTable2D;
+
 /* ----- Internal constants ----- */
 
 #if !defined(_EPSILON)
@@ -268,14 +589,66 @@ typedef struct CombiTable2D {
 #if !defined(MAX_TABLE_DIMENSIONS)
 #define MAX_TABLE_DIMENSIONS (3)
 #endif
+#if !defined(MAX_TABLE_ND_DIMENSIONS)
+#define MAX_TABLE_ND_DIMENSIONS (8)
+#endif
+/* Edge length (in grid points) of the tiles of the value block of an N-D
+   table. With the default of 4, the values of a multilinear (cubic)
+   interpolation stencil lie in 1 to 2^N (4^N) tiles of 4^N values instead
+   of N - 1 (or more) rows far apart. */
+#if !defined(TABLE_ND_TILE)
+#define TABLE_ND_TILE (4)
+#endif
+/* Maximum number of abscissa values between the bounds of a binary search
+   that are counted (by the SIMD kernel countNotAbove) instead of bisected */
+#if !defined(TABLE_SEARCH_TAIL)
+#define TABLE_SEARCH_TAIL (16)
+#endif
+#if !defined(TABLE_AKIMA_CACHE)
+#define TABLE_AKIMA_CACHE (0)
+#endif
+/* Edge length (in grid cells) of the tiles of on-demand calculated Akima
+   spline coefficients of CombiTable2D. A tile of 2 x 2 cells is calculated
+   from 7 x 7 table values, i.e., a cache miss costs about as much as the
+   calculation of 7 grid cells at initialization, whereas larger tiles
+   calculate many coefficients that are never used by random access. */
+#if !defined(TABLE_AKIMA_TILE)
+#define TABLE_AKIMA_TILE (2)
+#endif
+/* Number of doubles of the work space on the stack used by the calculation
+   of the Akima spline coefficients of a tile of at most 4 x 4 cells */
+#define SPLINE2D_TILE_BUFFER (192)
 
 /* ----- Internal shortcuts ----- */
 
+#if defined(__GNUC__)
+#define TABLE_ALWAYS_INLINE __inline__ __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define TABLE_ALWAYS_INLINE __forceinline
+#else
+#define TABLE_ALWAYS_INLINE
+#endif
+
 #define IDX(i, j, n) ((i)*(n) + (j))
 #define TABLE(i, j) table[IDX(i, j, nCol)]
 #define TABLE_ROW0(j) table[j]
 #define TABLE_COL0(i) table[(i)*nCol]
 
+/* Access of the table values in the evaluation kernels. If the table values
+   are stored in single precision (tableFloat), the first column (time,
+   abscissa or first input) is stored separately in table with a row stride
+   of 1 and, for CombiTable2D, the first row (second input) in tableU2. */
+#define ABSCISSA_STRIDE(tableID) \
+    (NULL != (tableID)->tableFloat ? 1 : (tableID)->nCol)
+#define TABLE_VALUE(i, j) (NULL != tableFloat ? \
+    (double)tableFloat[IDX(i, (j) - 1, nColFloat)] : TABLE(i, j))
+#define TABLE2D_VALUE(i, j) (NULL != tableFloat ? \
+    (double)tableFloat[IDX((i) - 1, (j) - 1, nColFloat)] : TABLE(i, j))
+#define TABLE_U1(i) table[(i)*strideU1]
+#define TABLE_U2(j) tableU2[j]
+#define TABLEND_VALUE(i) (NULL != valuesFloat ? \
+    (double)valuesFloat[i] : values[i])
+
 #define LINEAR(u, u0, u1, y0, y1) \
     y = (y0) + ((y1) - (y0))*((u) - (u0))/((u1) - (u0));
 /*
@@ -297,6 +670,35 @@ BILINEAR(u11, u20, ...) -> y10
 BILINEAR(u11, u21, ...) -> y11
 */
 
+/* Division by the width u1 - u0 of a table interval: By default, the
+   division is replaced by the multiplication with the pre-calculated inverse
+   width of the interval. The relative error of the quotient is then bounded
+   by 2 ulp (instead of 0.5 ulp), i.e., the interpolated values agree with
+   the ones of the exact division up to a relative tolerance of 5e-16 with
+   respect to the difference of the ordinate values of the interval. Define
+   TABLE_EXACT_DIVISION to divide by the interval width and obtain results
+   bitwise identical to LINEAR and BILINEAR. */
+#if defined(TABLE_EXACT_DIVISION)
+#define DIV_WIDTH(x, u0, u1, invWidth) ((x)/((u1) - (u0)))
+#define BILINEAR_INV(u1, u2, u10, u11, u20, u21, invWidth1, invWidth2, \
+    y00, y01, y10, y11) \
+    BILINEAR(u1, u2, u10, u11, u20, u21, y00, y01, y10, y11)
+#else
+#define DIV_WIDTH(x, u0, u1, invWidth) \
+    ((void)(u0), (void)(u1), (x)*(invWidth))
+#define BILINEAR_INV(u1, u2, u10, u11, u20, u21, invWidth1, invWidth2, \
+    y00, y01, y10, y11) {\
+    const double tmp = ((u20) - (u2))*(invWidth2); \
+    y = (y00) + tmp*((y00) - (y01)) + ((u10) - (u1))*(invWidth1)* \
+        ((1 + tmp)*((y00) - (y10)) + tmp*((y11) - (y01))); \
+    (void)(u11); \
+    (void)(u21); \
+}
+#endif
+
+#define LINEAR_INV(u, u0, u1, invWidth, y0, y1) \
+    y = (y0) + DIV_WIDTH(((y1) - (y0))*((u) - (u0)), u0, u1, invWidth);
+
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
 typedef struct TableShare {
     char* key; /* Key consisting of concatenated names of table and file */
@@ -307,9 +709,46 @@ typedef struct TableShare {
     UT_hash_handle hh; /* Hashable structure */
 } TableShare;
 
+#if defined(TABLE_CONTENT_SHARE)
+typedef struct ContentShare {
+    unsigned long long key; /* Hash of table content and parameters */
+    size_t refCount; /* Reference counter */
+    int dim; /* 1: CombiTimeTable or CombiTable1D, 2: CombiTable2D */
+    size_t nRow; /* Number of rows of table */
+    size_t nCol; /* Number of columns of table */
+    int* cols; /* Columns of table to be interpolated (dim = 1) */
+    size_t nCols; /* Number of columns of table to be interpolated (dim = 1) */
+    enum Smoothness smoothness; /* Smoothness kind of the spline coefficients,
+        LINEAR_SEGMENTS if there are none */
+    enum TableStorage storage; /* Storage precision kind */
+    double* table; /* Table values (or first column if tableFloat is not
+        NULL) */
+    float* tableFloat; /* Table values in single precision */
+    double* tableU2; /* First row of table (dim = 2) */
+    CubicHermite1D* spline1D; /* Pre-calculated cubic Hermite spline
+        coefficients (dim = 1) */
+    CubicHermite1DFloat* spline1DFloat; /* Pre-calculated cubic Hermite spline
+        coefficients in single precision (dim = 1) */
+    CubicHermite2D* spline2D; /* Pre-calculated cubic Hermite spline
+        coefficients (dim = 2) */
+    CubicHermite2DFloat* spline2DFloat; /* Pre-calculated cubic Hermite spline
+        coefficients in single precision (dim = 2) */
+    double* invWidth1; /* Pre-calculated inverse widths of the row intervals */
+    double* invWidth2; /* Pre-calculated inverse widths of the column
+        intervals (dim = 2) */
+    UT_hash_handle hh; /* Hashable structure */
+} ContentShare;
+#endif
+
 /* ----- Static variables ----- */
 
 static TableShare* tableShare = NULL;
+#if defined(TABLE_CONTENT_SHARE)
+static ContentShare* contentShare = NULL;
+#endif
+#endif
+
+#if defined(TABLE_SHARE)
 #if defined(_POSIX_)
 #include <pthread.h>
 #if defined(G_HAS_CONSTRUCTORS)
@@ -357,8 +796,23 @@ static void deleteCS(void) {
 #define MUTEX_LOCK()
 #define MUTEX_UNLOCK()
 #endif
+#else
+/* The cache of Akima spline coefficients is not used */
+#define MUTEX_LOCK()
+#define MUTEX_UNLOCK()
 #endif
 
+/* Cache of on-demand calculated Akima spline coefficients of CombiTable2D
+   (see TABLE_AKIMA_CACHE), guarded by the mutex */
+static AkimaTile* akimaCacheFirst = NULL; /* Most recently used tile */
+static AkimaTile* akimaCacheLast = NULL; /* Least recently used tile */
+static size_t akimaCacheSize = 0; /* Memory of all tiles in bytes */
+static size_t akimaCacheLimit = 0; /* Budget in bytes */
+
+/* Registry of the tables evaluated by ModelicaStandardTables_SharedTable2D_*,
+   guarded by the mutex, the entries are kept until the end of the process */
+static SharedTable2D* sharedTable2D = NULL;
+
 /* ----- Function declarations ----- */
 
 extern int usertab(char* tableName, int nipo, int dim[], int* colWise,
@@ -370,6 +824,8 @@ extern int usertab(char* tableName, int nipo, int dim[], int* colWise,
      -> nipo : = 0: time-table required (time interpolation)
                = 1: 1D-table required
                = 2: 2D-table required
+               = 3: N-D-table required (vector, see
+                    ModelicaStandardTables_CombiTableND_init)
      <- dim: Actual values of dimensions
      <- colWise: = 0: table stored row-wise    (row_1, row_2, ..., row_n)
                  = 1: table stored column-wise (column_1, column_2, ...)
@@ -387,15 +843,128 @@ static size_t findRowIndex(const double* table, size_t nRow, size_t nCol,
       * i + 1 < nRow
       * table[i*nCol] <= x
       * table[(i + 1)*nCol] > x for i + 2 < nRow
+     The last at most TABLE_SEARCH_TAIL candidates are counted by
+     countNotAbove instead of bisected
   */
 
 static size_t findColIndex(_In_ const double* table, size_t nCol, size_t last,
                            double x) MODELICA_NONNULLATTR;
   /* Same as findRowIndex but works on rows */
 
+static size_t findInverseRowIndex(_In_ const CombiTable1D* tableID, size_t col,
+                                  int sign, size_t last,
+                                  double y) MODELICA_NONNULLATTR;
+  /* Find the row index i of the strictly increasing (sign = 1) or
+     decreasing (sign = -1) table column col using binary search such that
+      * i + 1 < nRow
+      * sign*y[i] <= sign*y
+      * sign*y[i + 1] > sign*y for i + 2 < nRow
+     where y[i] is the value of column col in row i
+  */
+
+static size_t countEventRows(_In_ const size_t* eventRows, size_t nEventRows,
+                             size_t row) MODELICA_NONNULLATTR;
+  /* Count the event rows that are not greater than row using binary search
+
+     <- RETURN: Number of event rows <= row
+  */
+
+static size_t findEventInterval(_In_ const CombiTimeTable* tableID, size_t k0,
+                                size_t k1, double offset1, double offset2,
+                                double t) MODELICA_NONNULLATTR;
+  /* Find the first event interval k in [k0, k1) whose event time
+     TABLE_COL0(tableID->intervals[k - 1][1]) + offset1 + offset2 is not less
+     than t. Event interval k0 is checked first, the remaining event
+     intervals are searched by bisection.
+
+     <- RETURN: Event interval k, or k1 if there is none
+  */
+
+static double periodicShift(double x, double xMin, double xMax);
+  /* Shift x by an integer multiple of the period T = xMax - xMin into the
+     table range [xMin, xMax] in O(1), independent of the distance of x to
+     the table range. As with repeatedly adding (x < xMin) or subtracting
+     (x > xMax) T, a value on a period boundary is shifted to xMin (x < xMin)
+     or xMax (x > xMax), but without accumulating the rounding errors of the
+     repeated additions.
+
+     <- RETURN: Shifted value
+  */
+
+static double* invWidthInit(_In_ const double* x, size_t n,
+                            size_t stride) MODELICA_NONNULLATTR;
+  /* Calculate the inverse widths 1/(x[(i + 1)*stride] - x[i*stride]) of the
+     n - 1 intervals of the abscissa values x[0], x[stride], ...,
+     x[(n - 1)*stride], the inverse width of an interval of zero width is 0
+
+     <- RETURN: Pointer to array of inverse widths
+  */
+
+#if !defined(NO_FILE_SYSTEM)
+static double* invWidthExtend(_In_ double* invWidth, _In_ const double* x,
+                              size_t nKept, size_t n,
+                              size_t stride) MODELICA_NONNULLATTR;
+  /* Extend the inverse widths of the intervals of the first nKept abscissa
+     values (see invWidthInit) to the intervals of all n values
+
+     <- RETURN: Pointer to reallocated array of inverse widths or NULL in
+                case of memory allocation error (invWidth is then freed)
+  */
+#endif
+
+static size_t findNonIncreasing(_In_ const double* x, size_t n,
+                                size_t stride, int strict) MODELICA_NONNULLATTR;
+  /* Find the smallest index i such that x[i*stride] >= x[(i + 1)*stride]
+     (strict = 1) or x[i*stride] > x[(i + 1)*stride] (strict = 0), return
+     n - 1 if the n values are strictly (monotonically) increasing. The
+     SIMD variant is selected at load time, see ModelicaCPUDispatch.h */
+
+static size_t countNotAbove(_In_ const double* x, size_t n, size_t stride,
+                            double xi) MODELICA_NONNULLATTR;
+  /* Count the indices i < n with !(xi < x[i*stride]), i.e., the number of
+     values of the non-decreasing x that are below or equal to xi (all if xi
+     is NaN, as in the binary search). The SIMD variant is selected at load
+     time, see ModelicaCPUDispatch.h */
+
 static int isValidName(_In_z_ const char* name) MODELICA_NONNULLATTR;
   /* Check, whether a file or table name is valid */
 
+static SharedTable2D* sharedTable2DFind(_In_z_ const char* tableName,
+                                        _In_z_ const char* validName) MODELICA_NONNULLATTR;
+  /* Find the entry of a shared 2D table in the registry or insert a new
+     one (to be called with locked mutex)
+
+     <- RETURN: Pointer to entry or NULL in case of memory allocation error
+  */
+
+static SharedTable2D* sharedTable2DGet(_In_z_ const char* tableName,
+                                       _In_z_ const char* validName,
+                                       _Out_ int* status) MODELICA_NONNULLATTR;
+  /* Get the entry of a shared 2D table from the registry
+
+     <- status: 1 if the tables are initialized, -1 if the table values are
+                not yet provided, 0 otherwise
+     <- RETURN: Pointer to entry or NULL if status is not 1
+  */
+
+static int sharedTable2DInit(_Inout_ SharedTable2D* entry,
+                             _In_ const double* table, size_t nRow,
+                             size_t nCol, const double* valid);
+  /* Check the table values and initialize the tables of an entry. The
+     tables are assigned to the entry as soon as they are created, such
+     that they are not lost if the initialization fails with ModelicaError
+     (memory allocation error).
+
+     <- RETURN: 1 if the tables are initialized, 0 if the dimensions or
+                abscissa values are not valid
+  */
+
+static int sharedTable2DIsValid(_In_ SharedTable2D* entry, double u1,
+                                double u2) MODELICA_NONNULLATTR;
+  /* Check, whether (u1, u2) is in the input range of a shared 2D table and
+     only interpolated by valid table values
+  */
+
 static int isValidCombiTimeTable(const CombiTimeTable* tableID);
   /* Check, whether a CombiTimeTable is well parameterized */
 
@@ -405,6 +974,13 @@ static int isValidCombiTable1D(const CombiTable1D* tableID);
 static int isValidCombiTable2D(const CombiTable2D* tableID);
   /* Check, whether a CombiTable2D is well parameterized */
 
+static int isValidCombiTableND(_In_ const CombiTableND* tableID,
+                               _In_z_ const char* tableName,
+                               _In_ const double* table, size_t nRow,
+                               size_t nCol) MODELICA_NONNULLATTR;
+  /* Check, whether the table vector of a CombiTableND is well
+     parameterized (and has tableID->nDim dimensions) */
+
 static enum TableSource getTableSource(_In_z_ const char *tableName,
                                        _In_z_ const char *fileName) MODELICA_NONNULLATTR;
   /* Determine table source (file, model or "usertab" function) from table
@@ -416,12 +992,44 @@ static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) MODELICA_
 
 #if !defined(NO_FILE_SYSTEM)
 static double* readTable(_In_z_ const char* tableName, _In_z_ const char* fileName,
-                         _Inout_ size_t* nRow, _Inout_ size_t* nCol, int verbose,
-                         int force) MODELICA_NONNULLATTR;
-  /* Read a table from an ASCII text or MATLAB MAT-file
+                         _Inout_ size_t* nRow, _Inout_ size_t* nCol,
+                         const size_t* columns, size_t nColumns,
+                         const double* prevTable,
+                         _Inout_ ModelicaIOTableState* state, int verbose,
+                         int force, _Out_ ModelicaIOLoadEvent* event);
+  /* Read a table (or only the selected columns if nColumns > 0) from an
+     ASCII text or MATLAB MAT-file and record the load telemetry (without
+     the spline initialization) in event. If only rows were appended to the
+     table of an ASCII text file since the read of prevTable (described by
+     state), only the appended rows are parsed.
 
      <- RETURN: Pointer to array (row-wise storage) of table values
   */
+
+static size_t* tableColumns(_Inout_ int* cols, size_t nCols,
+                            _Out_ size_t* nColumns);
+  /* Get the columns of a table file to be read, i.e., the first column and
+     the columns to be interpolated, and map cols to the columns of the
+     table that is read
+
+     <- RETURN: Strictly increasing column indices (starting with 1) or NULL
+                if all columns are to be read (column index < 1, all columns
+                selected or memory allocation error)
+  */
+
+static int compareSize(const void* a, const void* b);
+  /* Compare function of qsort for values of type size_t */
+
+#if defined(TABLE_SHARE)
+static char* tableShareKey(_In_z_ const char* tableName,
+                           _In_z_ const char* fileName,
+                           const size_t* columns, size_t nColumns);
+  /* Get the key of the table share consisting of the concatenated names of
+     table and file and the selected columns
+
+     <- RETURN: Key to be freed or NULL in case of memory allocation error
+  */
+#endif
 #endif /* #if !defined(NO_FILE_SYSTEM) */
 
 static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
@@ -456,6 +1064,48 @@ static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
 static void spline1DClose(CubicHermite1D** spline);
   /* Free allocated memory of the 1D cubic Hermite spline coefficients */
 
+#if !defined(NO_FILE_SYSTEM)
+static CubicHermite1D* spline1DExtend(_In_ CubicHermite1D* spline,
+                                      enum Smoothness smoothness,
+                                      _In_ const double* table, size_t nKept,
+                                      size_t nRow, size_t nCol,
+                                      _In_ const int* cols,
+                                      size_t nCols) MODELICA_NONNULLATTR;
+  /* Extend the 1D cubic Hermite spline coefficients of the first nKept rows
+     of a table to all nRow rows. Only the coefficients of the intervals
+     that depend on the appended rows are recalculated (on the last rows of
+     the table), such that the result is identical to a complete
+     initialization.
+
+     <- RETURN: Pointer to reallocated array of coefficients or NULL in case
+                of memory allocation error (spline is then freed)
+  */
+#endif
+
+static int* monotony1DInit(_In_ const CombiTable1D* tableID) MODELICA_NONNULLATTR;
+  /* Determine the monotonicity of the interpolation of the columns to be
+     interpolated: The values of a column need to be strictly monotonic and,
+     for cubic Hermite spline interpolation, the derivative of each spline
+     piece must not change its sign within its interval
+
+     <- RETURN: Pointer to array of monotonicity flags (= 1: strictly
+                increasing, = -1: strictly decreasing, = 0: not strictly
+                monotonic, e.g., for constant segments) or NULL in case of
+                memory allocation error
+  */
+
+static double spline1DInverse(_In_ const double* c, double h,
+                              double dy) MODELICA_NONNULLATTR;
+  /* Find v in [0, h] such that ((c[0]*v + c[1])*v + c[2])*v = dy for the
+     coefficients c of a monotonic cubic Hermite spline piece of width h,
+     where dy lies between 0 and the increment of the piece. Starting at the
+     linear inverse, Halley steps are taken that are safeguarded by
+     bisection of the enclosing interval, until the residual is in the
+     order of the rounding error.
+
+     <- RETURN: v
+  */
+
 static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
                                     size_t nCol) MODELICA_NONNULLATTR;
   /* Calculate the coefficients for bivariate cubic Hermite spline
@@ -467,6 +1117,248 @@ static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
 static void spline2DClose(CubicHermite2D** spline);
   /* Free allocated memory of the 2D cubic Hermite spline coefficients */
 
+static double* spline2DExtendedGrid(_In_ const double* table, size_t nRow,
+                                    size_t nCol) MODELICA_NONNULLATTR;
+  /* Extend the grid points of both inputs of a table with nRow > 2 and
+     nCol > 2 by two extrapolated grid points on each side
+
+     <- RETURN: Pointer to the nRow + 3 extended grid points of the first
+        input followed by the nCol + 3 ones of the second input
+  */
+
+static void spline2DExtendedRow(_In_ const double* table, size_t nCol,
+                                _In_ const double* y, size_t i, size_t j0,
+                                size_t j1, _Out_ double* z) MODELICA_NONNULLATTR;
+  /* Get the columns j0 <= j < j1 of row i (1 <= i < nRow) of the table
+     extended by two extrapolated columns on each side, i.e., column j of
+     the extended row is column j - 1 of the table row for 2 <= j <= nCol */
+
+static int spline2DTile(_In_ const double* table, size_t nRow, size_t nCol,
+                        _In_ const double* x, _In_ const double* y, size_t i0,
+                        size_t i1, size_t j0, size_t j1,
+                        _Out_ CubicHermite2D* spline,
+                        size_t stride) MODELICA_NONNULLATTR;
+  /* Calculate the Akima spline coefficients of the grid cells i0 <= i < i1,
+     j0 <= j < j1 of a table with nRow > 2 and nCol > 2 from its extended
+     grid points x and y, the coefficients of cell (i, j) are stored in
+     spline[(i - i0)*stride + j - j0]. The result is independent of the
+     partition of the grid into tiles.
+
+     <- RETURN: 0 if a memory allocation error occurred, else 1
+  */
+
+static size_t akimaCacheBudget(void);
+  /* Get the budget of the cache of Akima spline coefficients, i.e., the
+     value of the environment variable MODELICA_TABLE_AKIMA_CACHE or, if not
+     set, TABLE_AKIMA_CACHE
+
+     <- RETURN: Budget in bytes, 0 if the coefficients are to be calculated
+        at initialization
+  */
+
+static int isAkimaGrid2D(_In_ const CombiTable2D* tableID) MODELICA_NONNULLATTR;
+  /* Check, whether the Akima spline coefficients of a valid CombiTable2D are
+     calculated per grid cell (nRow > 2 and nCol > 2) */
+
+static AkimaGrid* akimaGridNew(_In_ const double* table, size_t nRow,
+                               size_t nCol) MODELICA_NONNULLATTR;
+  /* Create the grid of on-demand calculated Akima spline coefficients of a
+     valid table with nRow > 2 and nCol > 2, the table values must not be
+     changed or freed before the grid is closed
+
+     <- RETURN: Pointer to the grid, NULL if a memory allocation error
+        occurred
+  */
+
+static void akimaGridClose(_Inout_ AkimaGrid** grid) MODELICA_NONNULLATTR;
+  /* Remove the tiles of a grid from the cache and free the grid */
+
+static void akimaCacheUnlink(_Inout_ AkimaTile* tile) MODELICA_NONNULLATTR;
+  /* Unlink a tile from the list of cached tiles (mutex must be locked) */
+
+static void akimaCacheRemove(_Inout_ AkimaTile* tile) MODELICA_NONNULLATTR;
+  /* Remove a tile from the cache and free it (mutex must be locked) */
+
+static const double* akimaGridCoefficients(_Inout_ AkimaGrid* grid, size_t i,
+                                           size_t j) MODELICA_NONNULLATTR;
+  /* Get the coefficients of grid cell (i, j), the tile of the cell is
+     calculated if it is not in the cache. The coefficients remain valid
+     until the next call for the same grid.
+
+     <- RETURN: Pointer to the 15 coefficients
+  */
+
+static int tableNDInit(_Inout_ CombiTableND* tableID,
+                       _In_ const double* table) MODELICA_NONNULLATTR;
+  /* Initialize the axes, the pre-calculated interval widths and slope
+     weights and the tiled value block of an N-D table from a valid table
+     vector (see isValidCombiTableND), previous data is released
+
+     <- RETURN: 0 if a memory allocation error occurred, else 1
+  */
+
+static void tableNDClose(_Inout_ CombiTableND* tableID) MODELICA_NONNULLATTR;
+  /* Free allocated memory of the axes and the value block of an N-D table */
+
+static TABLE_ALWAYS_INLINE void tableNDAddSlope(_In_ const TableNDAxis* axis,
+                                                size_t i, size_t i0,
+                                                double scale,
+                                                _Inout_ double* w);
+  /* Add the weights of the slope at grid point i of an axis (see
+     tableNDInit) multiplied by scale to the weights w of the grid points
+     i0, i0 + 1, ... */
+
+static TABLE_ALWAYS_INLINE size_t tableNDWeights(
+    _Inout_ TableNDAxis* axis, double u, enum Smoothness smoothness,
+    enum Extrapolation extrapolation, _Out_ double* w, _Out_ double* dw,
+    _Out_ size_t* nw);
+  /* Calculate the interpolation weights w of the grid points i0, ...,
+     i0 + nw - 1 of an axis at u and their derivatives dw with respect to u
+     (nw <= 4, nw = 0 in case of an error)
+
+     <- RETURN: Index i0 of the first grid point
+  */
+
+static TABLE_ALWAYS_INLINE const double* spline1DCoefficients(
+    const CubicHermite1D* spline, const CubicHermite1DFloat* splineFloat,
+    size_t k, _Out_ double* buffer);
+  /* Get the coefficients of interval k from spline or, if not NULL, from
+     splineFloat widened to double precision in buffer
+
+     <- RETURN: Pointer to the 3 coefficients
+  */
+
+static TABLE_ALWAYS_INLINE const double* spline2DCoefficients(
+    const CubicHermite2D* spline, const CubicHermite2DFloat* splineFloat,
+    size_t k, _Out_ double* buffer);
+  /* Get the coefficients of grid k from spline or, if not NULL, from
+     splineFloat widened to double precision in buffer
+
+     <- RETURN: Pointer to the 15 coefficients
+  */
+
+static enum TableStorage tableStorage(int storage);
+  /* Resolve the storage precision kind passed to the _init functions, the
+     default is STORAGE_FLOAT if the environment variable MODELICA_TABLE_FLOAT
+     is set to a value other than "0", else STORAGE_DOUBLE
+
+     <- RETURN: STORAGE_DOUBLE or STORAGE_FLOAT
+  */
+
+static int isOwnedTable(enum TableSource source);
+  /* Check, whether the table array is exclusively owned by the table
+     structure (and hence may be replaced) */
+
+static int toFloat(_Out_ float* y, _In_ const double* x,
+                   size_t n) MODELICA_NONNULLATTR;
+  /* Convert n values to single precision
+
+     <- RETURN: 0 if a finite value exceeds the single precision range, else 1
+  */
+
+static void compactTable1D(_Inout_ double** table, size_t nRow, size_t nCol,
+                           const int* cols, size_t nCols,
+                           enum TableSource source, _Inout_ float** tableFloat,
+                           _Inout_ CubicHermite1D** spline,
+                           _Inout_ CubicHermite1DFloat** splineFloat);
+  /* Convert the spline coefficients and, if the table array is owned, the
+     table values (except for the first column) of a CombiTimeTable or
+     CombiTable1D to single precision. The first column is kept in double
+     precision in a new table array. Data that cannot be converted (range
+     or memory allocation error) is kept in double precision. */
+
+static void compactTable2D(_Inout_ double** table, size_t nRow, size_t nCol,
+                           enum TableSource source, _Inout_ float** tableFloat,
+                           _Inout_ double** tableU2,
+                           _Inout_ CubicHermite2D** spline,
+                           _Inout_ CubicHermite2DFloat** splineFloat);
+  /* Convert the spline coefficients and, if the table array is owned, the
+     table values (except for the first row and column) of a CombiTable2D to
+     single precision. The first column is kept in double precision in a new
+     table array and the first row in tableU2. Data that cannot be converted
+     (range or memory allocation error) is kept in double precision. */
+
+#if defined(TABLE_CONTENT_SHARE)
+static enum Smoothness contentSmoothness(int dim, enum Smoothness smoothness);
+  /* Get the smoothness kind determining the pre-calculated spline
+     coefficients
+
+     -> dim: = 1: CombiTimeTable or CombiTable1D
+             = 2: CombiTable2D
+     <- RETURN: smoothness if spline coefficients are pre-calculated, else
+                LINEAR_SEGMENTS
+  */
+
+static unsigned long long contentHash(_In_ const double* table, size_t nRow,
+                                      size_t nCol, const int* cols,
+                                      size_t nCols, int dim,
+                                      enum Smoothness smoothness,
+                                      enum TableStorage storage);
+  /* Calculate the 64-bit hash of the table dimensions and values, of the
+     columns to be interpolated and of the smoothness and storage kind
+
+     <- RETURN: Hash value
+  */
+
+static int contentMatches(_In_ const ContentShare* share,
+                          _In_ const double* table, size_t nRow, size_t nCol,
+                          const int* cols, size_t nCols, int dim,
+                          enum Smoothness smoothness,
+                          enum TableStorage storage);
+  /* Compare the table with the content of the content share. Values stored
+     in single precision by the content share are compared after conversion.
+
+     <- RETURN: 1 if equal, else 0
+  */
+
+static ContentShare* contentShareAcquire(unsigned long long key,
+                                         _In_ const double* table, size_t nRow,
+                                         size_t nCol, const int* cols,
+                                         size_t nCols, int dim,
+                                         enum Smoothness smoothness,
+                                         enum TableStorage storage);
+  /* Find the content share of the table and increment its reference counter
+
+     <- RETURN: Pointer to content share or NULL if the table is not shared
+                (no entry with key or hash collision)
+  */
+
+static ContentShare* contentShareNew(unsigned long long key, size_t nRow,
+                                     size_t nCol, const int* cols,
+                                     size_t nCols, int dim,
+                                     enum Smoothness smoothness,
+                                     enum TableStorage storage);
+  /* Allocate a content share with reference counter 1 and without payload
+
+     <- RETURN: Pointer to content share or NULL in case of memory allocation
+                error
+  */
+
+static ContentShare* contentShareInsert(_Inout_ ContentShare* share) MODELICA_NONNULLATTR;
+  /* Insert the content share (taking ownership of its payload) into the hash
+     table. If the key already exists (concurrent initialization or hash
+     collision), share is freed without its payload.
+
+     <- RETURN: share or NULL if not inserted
+  */
+
+static void contentShareRelease(_Inout_ ContentShare* share) MODELICA_NONNULLATTR;
+  /* Decrement the reference counter and free the content share and its
+     payload if it is no longer referenced */
+#endif
+
+static void selectCombiTimeTableKernels(_Inout_ CombiTimeTable* tableID) MODELICA_NONNULLATTR;
+  /* Select the evaluation kernels of the time table */
+
+static void selectCombiTable1DKernels(_Inout_ CombiTable1D* tableID) MODELICA_NONNULLATTR;
+  /* Select the evaluation kernels of the 1D table */
+
+static void selectCombiTable2DKernels(_Inout_ CombiTable2D* tableID) MODELICA_NONNULLATTR;
+  /* Select the evaluation kernels of the 2D table */
+
+static void selectCombiTableNDKernels(_Inout_ CombiTableND* tableID) MODELICA_NONNULLATTR;
+  /* Select the evaluation kernels of the N-D table */
+
 /* ----- Interface functions ----- */
 
 void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
@@ -477,10 +1369,29 @@ void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
                                                  _In_ int* cols,
                                                  size_t nCols, int smoothness,
                                                  int extrapolation) {
+    return ModelicaStandardTables_CombiTimeTable_init2(tableName,
+        fileName, table, nRow, nColumn, startTime, cols, nCols, smoothness,
+        extrapolation, STORAGE_DEFAULT);
+}
+
+void* ModelicaStandardTables_CombiTimeTable_init2(_In_z_ const char* tableName,
+                                                  _In_z_ const char* fileName,
+                                                  _In_ double* table, size_t nRow,
+                                                  size_t nColumn,
+                                                  double startTime,
+                                                  _In_ int* cols,
+                                                  size_t nCols, int smoothness,
+                                                  int extrapolation,
+                                                  int storage) {
+    MODELICA_PROFILE_BEGIN();
     CombiTimeTable* tableID = (CombiTimeTable*)calloc(1, sizeof(CombiTimeTable));
     if (tableID != NULL) {
+#if defined(TABLE_CONTENT_SHARE)
+        unsigned long long key = 0;
+#endif
         tableID->smoothness = (enum Smoothness)smoothness;
         tableID->extrapolation = (enum Extrapolation)extrapolation;
+        tableID->storage = tableStorage(storage);
         tableID->nCols = nCols;
         if (nCols > 0) {
             tableID->cols = (int*)malloc(tableID->nCols*sizeof(int));
@@ -525,6 +1436,12 @@ void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
                     ModelicaError("Memory allocation error\n");
                     return NULL;
                 }
+#if !defined(NO_FILE_SYSTEM)
+                /* Only read the first column and the columns to be
+                   interpolated */
+                tableID->columns = tableColumns(tableID->cols,
+                    tableID->nCols, &tableID->nColumns);
+#endif
                 break;
 
             case TABLESOURCE_MODEL:
@@ -539,6 +1456,25 @@ void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
                             tableID->smoothness = LINEAR_SEGMENTS;
                         }
                     }
+#if defined(TABLE_CONTENT_SHARE)
+                    key = contentHash(table, tableID->nRow, tableID->nCol,
+                        (const int*)tableID->cols, tableID->nCols, 1,
+                        tableID->smoothness, tableID->storage);
+                    tableID->share = contentShareAcquire(key, table,
+                        tableID->nRow, tableID->nCol, (const int*)tableID->cols,
+                        tableID->nCols, 1, tableID->smoothness,
+                        tableID->storage);
+                    if (tableID->share != NULL) {
+                        /* Share hit -> Use table values, spline coefficients
+                           and inverse interval widths of the content share */
+                        tableID->table = tableID->share->table;
+                        tableID->tableFloat = tableID->share->tableFloat;
+                        tableID->spline = tableID->share->spline1D;
+                        tableID->splineFloat = tableID->share->spline1DFloat;
+                        tableID->invWidth = tableID->share->invWidth1;
+                        break;
+                    }
+#endif
                     if (tableID->smoothness == AKIMA_C1) {
                         /* Initialization of the cubic Hermite spline coefficients */
                         tableID->spline = akimaSpline1DInit(table,
@@ -709,26 +1645,69 @@ void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
                 ModelicaError("Table source error\n");
                 return NULL;
         }
+        if (tableID->table != NULL && tableID->share == NULL) {
+            tableID->invWidth = invWidthInit((const double*)tableID->table,
+                tableID->nRow, tableID->nCol);
+            if (tableID->invWidth == NULL) {
+                ModelicaStandardTables_CombiTimeTable_close(tableID);
+                ModelicaError("Memory allocation error\n");
+                return NULL;
+            }
+            if (tableID->storage == STORAGE_FLOAT) {
+                compactTable1D(&tableID->table, tableID->nRow, tableID->nCol,
+                    (const int*)tableID->cols, tableID->nCols,
+                    tableID->source, &tableID->tableFloat, &tableID->spline,
+                    &tableID->splineFloat);
+            }
+#if defined(TABLE_CONTENT_SHARE)
+            if (tableID->source == TABLESOURCE_MODEL) {
+                /* Share miss -> Insert new content share */
+                ContentShare* share = contentShareNew(key, tableID->nRow,
+                    tableID->nCol, (const int*)tableID->cols, tableID->nCols,
+                    1, tableID->smoothness, tableID->storage);
+                if (share != NULL) {
+                    share->table = tableID->table;
+                    share->tableFloat = tableID->tableFloat;
+                    share->spline1D = tableID->spline;
+                    share->spline1DFloat = tableID->splineFloat;
+                    share->invWidth1 = tableID->invWidth;
+                    tableID->share = contentShareInsert(share);
+                }
+            }
+#endif
+        }
+        selectCombiTimeTableKernels(tableID);
     }
     else {
         ModelicaError("Memory allocation error\n");
     }
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTimeTable_init2);
     return (void*)tableID;
 }
 
 void ModelicaStandardTables_CombiTimeTable_close(void* _tableID) {
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     if (tableID != NULL) {
+#if defined(TABLE_CONTENT_SHARE)
+        if (tableID->share != NULL) {
+            /* Table values, spline coefficients and inverse interval widths
+               are owned by the content share */
+            contentShareRelease(tableID->share);
+            tableID->share = NULL;
+            tableID->table = NULL;
+            tableID->tableFloat = NULL;
+            tableID->spline = NULL;
+            tableID->splineFloat = NULL;
+            tableID->invWidth = NULL;
+        }
+#endif
         if (tableID->table != NULL && tableID->source == TABLESOURCE_FILE) {
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
             if (tableID->tableName != NULL && tableID->fileName != NULL) {
-                char* key = malloc((strlen(tableID->tableName) +
-                    strlen(tableID->fileName) + 2)*sizeof(char));
+                char* key = tableShareKey(tableID->tableName,
+                    tableID->fileName, tableID->columns, tableID->nColumns);
                 if (key != NULL) {
                     TableShare *iter;
-                    strcpy(key, tableID->tableName);
-                    strcat(key, "|");
-                    strcat(key, tableID->fileName);
                     MUTEX_LOCK();
                     HASH_FIND_STR(tableShare, key, iter);
                     if (iter != NULL) {
@@ -765,6 +1744,10 @@ void ModelicaStandardTables_CombiTimeTable_close(void* _tableID) {
             free(tableID->cols);
             tableID->cols = NULL;
         }
+        if (tableID->columns != NULL) {
+            free(tableID->columns);
+            tableID->columns = NULL;
+        }
         if (tableID->tableName != NULL) {
             free(tableID->tableName);
             tableID->tableName = NULL;
@@ -777,279 +1760,299 @@ void ModelicaStandardTables_CombiTimeTable_close(void* _tableID) {
             free(tableID->intervals);
             tableID->intervals = NULL;
         }
+        if (tableID->eventRows != NULL) {
+            free(tableID->eventRows);
+            tableID->eventRows = NULL;
+        }
+        if (tableID->invWidth != NULL) {
+            free(tableID->invWidth);
+            tableID->invWidth = NULL;
+        }
+        if (tableID->tableFloat != NULL) {
+            free(tableID->tableFloat);
+            tableID->tableFloat = NULL;
+        }
+        if (tableID->splineFloat != NULL) {
+            free(tableID->splineFloat);
+            tableID->splineFloat = NULL;
+        }
         spline1DClose(&tableID->spline);
         free(tableID);
     }
 }
 
-double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
-                                                      double t, double nextTimeEvent,
-                                                      double preNextTimeEvent) {
+static TABLE_ALWAYS_INLINE double combiTimeTableValue(CombiTimeTable* tableID,
+                                                      int iCol, double t,
+                                                      double nextTimeEvent,
+                                                      double preNextTimeEvent,
+                                                      enum TableShape shape,
+                                                      enum Smoothness smoothness,
+                                                      enum Extrapolation extrapolation) {
     double y = 0.;
-    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
-    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
-        /* Shift time by start time */
-        const double tOld = t;
-        t -= tableID->startTime;
+    /* Shift time by start time */
+    const double tOld = t;
+    t -= tableID->startTime;
+
+    if (t >= 0 && nextTimeEvent < DBL_MAX &&
+        nextTimeEvent == preNextTimeEvent &&
+        tableID->startTime >= nextTimeEvent) {
+        /* Before start time event iteration: Return zero */
+        return 0.;
+    }
+    else if (t >= 0) {
+        const double* table = tableID->table;
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = ABSCISSA_STRIDE(tableID);
+        const float* tableFloat = tableID->tableFloat;
+        const size_t nColFloat = tableID->nCol - 1;
+        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
 
-        if (t >= 0 && nextTimeEvent < DBL_MAX &&
-            nextTimeEvent == preNextTimeEvent &&
-            tableID->startTime >= nextTimeEvent) {
-            /* Before start time event iteration: Return zero */
-            return 0.;
+        if (shape == SHAPE_SINGLE_ROW) {
+            /* Single row */
+            y = TABLE_VALUE(0, col);
         }
-        else if (t >= 0) {
-            const double* table = tableID->table;
-            const size_t nRow = tableID->nRow;
-            const size_t nCol = tableID->nCol;
-            const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+        else {
+            enum PointInterval extrapolate = IN_TABLE;
+            const double tMin = TABLE_ROW0(0);
+            const double tMax = TABLE_COL0(nRow - 1);
+
+            /* Periodic extrapolation */
+            if (extrapolation == PERIODIC) {
+                /* Event handling for periodic extrapolation */
+                if (nextTimeEvent == preNextTimeEvent &&
+                    tOld >= nextTimeEvent) {
+                    /* Before event iteration: Return previous
+                       interval value */
+                    size_t i;
+                    if (smoothness == CONSTANT_SEGMENTS) {
+                        i = tableID->intervals[
+                            tableID->eventInterval - 1][0];
+                    }
+                    else {
+                        i = tableID->intervals[
+                            tableID->eventInterval - 1][1];
+                    }
+                    y = TABLE_VALUE(i, col);
+                    return y;
+                }
+                else if (nextTimeEvent > preNextTimeEvent &&
+                    tOld >= preNextTimeEvent &&
+                    tableID->startTime < preNextTimeEvent) {
+                    /* In regular (= not start time) event iteration:
+                       Return left interval value */
+                    size_t i = tableID->intervals[
+                        tableID->eventInterval - 1][0];
+                    y = TABLE_VALUE(i, col);
+                    return y;
+                }
+                else {
+                    /* After event iteration */
+                    const size_t i0 = tableID->intervals[
+                        tableID->eventInterval - 1][0];
+                    const size_t i1 = tableID->intervals[
+                        tableID->eventInterval - 1][1];
 
-            if (nRow == 1) {
-                /* Single row */
-                y = TABLE_ROW0(col);
+                    t -= tableID->tOffset;
+                    t = periodicShift(t, tMin, tMax);
+                    tableID->last = findRowIndex(
+                        table, nRow, nCol, tableID->last, t);
+                    /* Event interval correction */
+                    if (tableID->last < i0) {
+                        t = TABLE_COL0(i0);
+                    }
+                    if (tableID->last >= i1) {
+                        if (tableID->eventInterval == 1) {
+                            t = TABLE_COL0(i0);
+                        }
+                        else {
+                            t = TABLE_COL0(i1);
+                        }
+                    }
+                }
+            }
+            else if (t < tMin) {
+                extrapolate = LEFT;
+            }
+            else if (t >= tMax) {
+                extrapolate = RIGHT;
+                /* Event handling for non-periodic extrapolation */
+                if (nextTimeEvent == preNextTimeEvent &&
+                    nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
+                    /* Before event iteration */
+                    extrapolate = IN_TABLE;
+                }
             }
-            else {
-                enum PointInterval extrapolate = IN_TABLE;
-                const double tMin = TABLE_ROW0(0);
-                const double tMax = TABLE_COL0(nRow - 1);
 
-                /* Periodic extrapolation */
-                if (tableID->extrapolation == PERIODIC) {
-                    const double T = tMax - tMin;
-                    /* Event handling for periodic extrapolation */
+            if (extrapolate == IN_TABLE) {
+                size_t last;
+                if (extrapolation == PERIODIC) {
+                    last = findRowIndex(table, nRow, nCol,
+                        tableID->last, t);
+                }
+                else {
+                    /* Event handling for non-periodic extrapolation */
                     if (nextTimeEvent == preNextTimeEvent &&
-                        tOld >= nextTimeEvent) {
+                        nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
                         /* Before event iteration: Return previous
                            interval value */
-                        size_t i;
-                        if (tableID->smoothness == CONSTANT_SEGMENTS) {
-                            i = tableID->intervals[
-                                tableID->eventInterval - 1][0];
+                        if (tableID->eventInterval == 1) {
+                            last = 0;
+                        }
+                        else if (smoothness == CONSTANT_SEGMENTS) {
+                            last = tableID->intervals[
+                                tableID->eventInterval - 2][0];
+                        }
+                        else if (smoothness == LINEAR_SEGMENTS) {
+                            last = tableID->intervals[
+                                tableID->eventInterval - 2][1];
+                        }
+                        else if (t >= TABLE_COL0(nRow - 1)) {
+                            last = nRow - 1;
                         }
                         else {
-                            i = tableID->intervals[
-                                tableID->eventInterval - 1][1];
+                            last = findRowIndex(table, nRow, nCol,
+                                tableID->last, t);
                         }
-                        y = TABLE(i, col);
-                        return y;
-                    }
-                    else if (nextTimeEvent > preNextTimeEvent &&
-                        tOld >= preNextTimeEvent &&
-                        tableID->startTime < preNextTimeEvent) {
-                        /* In regular (= not start time) event iteration:
-                           Return left interval value */
-                        size_t i = tableID->intervals[
-                            tableID->eventInterval - 1][0];
-                        y = TABLE(i, col);
+                        y = TABLE_VALUE(last, col);
                         return y;
                     }
                     else {
-                        /* After event iteration */
-                        const size_t i0 = tableID->intervals[
-                            tableID->eventInterval - 1][0];
-                        const size_t i1 = tableID->intervals[
-                            tableID->eventInterval - 1][1];
-
-                        t -= tableID->tOffset;
-                        if (t < tMin) {
-                            do {
-                                t += T;
-                            } while (t < tMin);
-                        }
-                        else if (t > tMax) {
-                            do {
-                                t -= T;
-                            } while (t > tMax);
-                        }
-                        tableID->last = findRowIndex(
-                            table, nRow, nCol, tableID->last, t);
-                        /* Event interval correction */
-                        if (tableID->last < i0) {
-                            t = TABLE_COL0(i0);
-                        }
-                        if (tableID->last >= i1) {
-                            if (tableID->eventInterval == 1) {
-                                t = TABLE_COL0(i0);
+                        last = findRowIndex(table, nRow, nCol,
+                            tableID->last, t);
+                        if (tableID->eventInterval > 1) {
+                            const size_t i0 = tableID->intervals[
+                                tableID->eventInterval - 2][0];
+                            const size_t i1 = tableID->intervals[
+                                tableID->eventInterval - 2][1];
+
+                            /* Event interval correction */
+                            if (last < i0) {
+                                last = i0;
                             }
-                            else {
-                                t = TABLE_COL0(i1);
+                            if (last >= i1) {
+                                last = i0;
                             }
                         }
                     }
                 }
-                else if (t < tMin) {
-                    extrapolate = LEFT;
-                }
-                else if (t >= tMax) {
-                    extrapolate = RIGHT;
-                    /* Event handling for non-periodic extrapolation */
-                    if (nextTimeEvent == preNextTimeEvent &&
-                        nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
-                        /* Before event iteration */
-                        extrapolate = IN_TABLE;
-                    }
-                }
+                tableID->last = last;
 
-                if (extrapolate == IN_TABLE) {
-                    size_t last;
-                    if (tableID->extrapolation == PERIODIC) {
-                        last = findRowIndex(table, nRow, nCol,
-                            tableID->last, t);
-                    }
-                    else {
-                        /* Event handling for non-periodic extrapolation */
-                        if (nextTimeEvent == preNextTimeEvent &&
-                            nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
-                            /* Before event iteration: Return previous
-                               interval value */
-                            if (tableID->eventInterval == 1) {
-                                last = 0;
-                            }
-                            else if (tableID->smoothness == CONSTANT_SEGMENTS) {
-                                last = tableID->intervals[
-                                    tableID->eventInterval - 2][0];
-                            }
-                            else if (tableID->smoothness == LINEAR_SEGMENTS) {
-                                last = tableID->intervals[
-                                    tableID->eventInterval - 2][1];
-                            }
-                            else if (t >= TABLE_COL0(nRow - 1)) {
-                                last = nRow - 1;
-                            }
-                            else {
-                                last = findRowIndex(table, nRow, nCol,
-                                    tableID->last, t);
-                            }
-                            y = TABLE(last, col);
-                            return y;
+                /* Interpolation */
+                switch (smoothness) {
+                    case LINEAR_SEGMENTS: {
+                        const double t0 = TABLE_COL0(last);
+                        const double t1 = TABLE_COL0(last + 1);
+                        const double y0 = TABLE_VALUE(last, col);
+                        const double y1 = TABLE_VALUE(last + 1, col);
+                        if (isNearlyEqual(t0, t1)) {
+                            y = y1;
                         }
                         else {
-                            last = findRowIndex(table, nRow, nCol,
-                                tableID->last, t);
-                            if (tableID->eventInterval > 1) {
-                                const size_t i0 = tableID->intervals[
-                                    tableID->eventInterval - 2][0];
-                                const size_t i1 = tableID->intervals[
-                                    tableID->eventInterval - 2][1];
-
-                                /* Event interval correction */
-                                if (last < i0) {
-                                    last = i0;
-                                }
-                                if (last >= i1) {
-                                    last = i0;
-                                }
-                            }
+                            LINEAR_INV(t, t0, t1, tableID->invWidth[last],
+                                y0, y1)
                         }
+                        break;
                     }
-                    tableID->last = last;
 
-                    /* Interpolation */
-                    switch (tableID->smoothness) {
-                        case LINEAR_SEGMENTS: {
-                            const double t0 = TABLE_COL0(last);
-                            const double t1 = TABLE_COL0(last + 1);
-                            const double y0 = TABLE(last, col);
-                            const double y1 = TABLE(last + 1, col);
-                            if (isNearlyEqual(t0, t1)) {
-                                y = y1;
-                            }
-                            else {
-                                LINEAR(t, t0, t1, y0, y1)
-                            }
-                            break;
+                    case CONSTANT_SEGMENTS:
+                        if (t >= TABLE_COL0(last + 1)) {
+                            last += 1;
                         }
+                        y = TABLE_VALUE(last, col);
+                        break;
 
-                        case CONSTANT_SEGMENTS:
-                            if (t >= TABLE_COL0(last + 1)) {
-                                last += 1;
-                            }
-                            y = TABLE(last, col);
-                            break;
+                    case AKIMA_C1:
+                    case FRITSCH_BUTLAND_MONOTONE_C1:
+                    case STEFFEN_MONOTONE_C1:
+                        MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                        if (NULL != tableID->spline ||
+                            NULL != tableID->splineFloat) {
+                            double cFloat[3];
+                            const double* c = spline1DCoefficients(
+                                tableID->spline, tableID->splineFloat,
+                                IDX(last, iCol - 1, tableID->nCols), cFloat);
+                            t -= TABLE_COL0(last);
+                            y = TABLE_VALUE(last, col); /* c[3] = y0 */
+                            y += ((c[0]*t + c[1])*t + c[2])*t;
+                        }
+                        break;
 
-                        case AKIMA_C1:
-                        case FRITSCH_BUTLAND_MONOTONE_C1:
-                        case STEFFEN_MONOTONE_C1:
-                            if (NULL != tableID->spline) {
-                                const double* c = tableID->spline[
-                                    IDX(last, iCol - 1, tableID->nCols)];
-                                t -= TABLE_COL0(last);
-                                y = TABLE(last, col); /* c[3] = y0 */
-                                y += ((c[0]*t + c[1])*t + c[2])*t;
+                    default:
+                        ModelicaError("Unknown smoothness kind\n");
+                        return y;
+                }
+            }
+            else {
+                /* Extrapolation */
+                MODELICA_PROFILE_COUNT(extrapolations, 1);
+                switch (extrapolation) {
+                    case LAST_TWO_POINTS: {
+                        const size_t last =
+                            (extrapolate == RIGHT) ? nRow - 2 : 0;
+                        const double t0 = TABLE_COL0(last);
+                        const double y0 = TABLE_VALUE(last, col);
+
+                        switch(smoothness) {
+                            case LINEAR_SEGMENTS:
+                            case CONSTANT_SEGMENTS: {
+                                const double t1 = TABLE_COL0(last + 1);
+                                const double y1 = TABLE_VALUE(last + 1, col);
+                                if (isNearlyEqual(t0, t1)) {
+                                    y = y1;
+                                }
+                                else {
+                                    LINEAR_INV(t, t0, t1, tableID->invWidth[last],
+                                y0, y1)
+                                }
+                                break;
                             }
-                            break;
 
-                        default:
-                            ModelicaError("Unknown smoothness kind\n");
-                            return y;
-                    }
-                }
-                else {
-                    /* Extrapolation */
-                    switch (tableID->extrapolation) {
-                        case LAST_TWO_POINTS: {
-                            const size_t last =
-                                (extrapolate == RIGHT) ? nRow - 2 : 0;
-                            const double t0 = TABLE_COL0(last);
-                            const double y0 = TABLE(last, col);
-
-                            switch(tableID->smoothness) {
-                                case LINEAR_SEGMENTS:
-                                case CONSTANT_SEGMENTS: {
-                                    const double t1 = TABLE_COL0(last + 1);
-                                    const double y1 = TABLE(last + 1, col);
-                                    if (isNearlyEqual(t0, t1)) {
-                                        y = y1;
+                            case AKIMA_C1:
+                            case FRITSCH_BUTLAND_MONOTONE_C1:
+                            case STEFFEN_MONOTONE_C1:
+                                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                                if (NULL != tableID->spline ||
+                                    NULL != tableID->splineFloat) {
+                                    double cFloat[3];
+                                    const double* c = spline1DCoefficients(
+                                        tableID->spline, tableID->splineFloat,
+                                        IDX(last, iCol - 1, tableID->nCols), cFloat);
+                                    if (extrapolate == LEFT) {
+                                        y = LINEAR_SLOPE(y0, c[2], t - t0);
                                     }
-                                    else {
-                                        LINEAR(t, t0, t1, y0, y1)
+                                    else /* if (extrapolate == RIGHT) */ {
+                                        const double t1 = TABLE_COL0(last + 1);
+                                        const double v = t1 - t0;
+                                        y = LINEAR_SLOPE(TABLE_VALUE(last + 1, col),
+                                            (3*c[0]*v + 2*c[1])*v + c[2],
+                                            t - t1);
                                     }
-                                    break;
                                 }
+                                break;
 
-                                case AKIMA_C1:
-                                case FRITSCH_BUTLAND_MONOTONE_C1:
-                                case STEFFEN_MONOTONE_C1:
-                                    if (NULL != tableID->spline) {
-                                        const double* c = tableID->spline[
-                                            IDX(last, iCol - 1, tableID->nCols)];
-                                        if (extrapolate == LEFT) {
-                                            y = LINEAR_SLOPE(y0, c[2], t - t0);
-                                        }
-                                        else /* if (extrapolate == RIGHT) */ {
-                                            const double t1 = TABLE_COL0(last + 1);
-                                            const double v = t1 - t0;
-                                            y = LINEAR_SLOPE(TABLE(last + 1, col),
-                                                (3*c[0]*v + 2*c[1])*v + c[2],
-                                                t - t1);
-                                        }
-                                    }
-                                    break;
-
-                                default:
-                                    ModelicaError("Unknown smoothness kind\n");
-                                    return y;
-                            }
-                            break;
+                            default:
+                                ModelicaError("Unknown smoothness kind\n");
+                                return y;
                         }
+                        break;
+                    }
 
-                        case HOLD_LAST_POINT:
-                            y = (extrapolate == RIGHT) ? TABLE(nRow - 1, col) :
-                                TABLE_ROW0(col);
-                            break;
+                    case HOLD_LAST_POINT:
+                        y = (extrapolate == RIGHT) ? TABLE_VALUE(nRow - 1, col) :
+                            TABLE_VALUE(0, col);
+                        break;
 
-                        case NO_EXTRAPOLATION:
-                            ModelicaError("Extrapolation error\n");
-                            return y;
+                    case NO_EXTRAPOLATION:
+                        ModelicaError("Extrapolation error\n");
+                        return y;
 
-                        case PERIODIC:
-                            /* Should not be possible to get here */
-                            break;
+                    case PERIODIC:
+                        /* Should not be possible to get here */
+                        break;
 
-                        default:
-                            ModelicaError("Unknown extrapolation kind\n");
-                            return y;
-                    }
+                    default:
+                        ModelicaError("Unknown extrapolation kind\n");
+                        return y;
                 }
             }
         }
@@ -1057,250 +2060,253 @@ double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
     return y;
 }
 
-double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCol,
-                                                         double t,
+static TABLE_ALWAYS_INLINE double combiTimeTableDerValue(CombiTimeTable* tableID,
+                                                         int iCol, double t,
                                                          double nextTimeEvent,
                                                          double preNextTimeEvent,
-                                                         double der_t) {
+                                                         double der_t,
+                                                         enum TableShape shape,
+                                                         enum Smoothness smoothness,
+                                                         enum Extrapolation extrapolation) {
     double der_y = 0.;
-    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
-    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
-        /* Shift time by start time */
-        const double tOld = t;
-        t -= tableID->startTime;
+    /* Shift time by start time */
+    const double tOld = t;
+    t -= tableID->startTime;
+
+    if (t >= 0 && nextTimeEvent < DBL_MAX &&
+        nextTimeEvent == preNextTimeEvent &&
+        tableID->startTime >= nextTimeEvent) {
+        /* Before start time event iteration: Return zero */
+        return 0.;
+    }
+    else if (t >= 0) {
+        const double* table = tableID->table;
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = ABSCISSA_STRIDE(tableID);
+        const float* tableFloat = tableID->tableFloat;
+        const size_t nColFloat = tableID->nCol - 1;
+        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
 
-        if (t >= 0 && nextTimeEvent < DBL_MAX &&
-            nextTimeEvent == preNextTimeEvent &&
-            tableID->startTime >= nextTimeEvent) {
-            /* Before start time event iteration: Return zero */
-            return 0.;
-        }
-        else if (t >= 0) {
-            const double* table = tableID->table;
-            const size_t nRow = tableID->nRow;
-            const size_t nCol = tableID->nCol;
-            const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+        if (shape != SHAPE_SINGLE_ROW) {
+            enum PointInterval extrapolate = IN_TABLE;
+            const double tMin = TABLE_ROW0(0);
+            const double tMax = TABLE_COL0(nRow - 1);
+            size_t last = 0;
+            int haveLast = 0;
 
-            if (nRow > 1) {
-                enum PointInterval extrapolate = IN_TABLE;
-                const double tMin = TABLE_ROW0(0);
-                const double tMax = TABLE_COL0(nRow - 1);
-                size_t last = 0;
-                int haveLast = 0;
+            /* Periodic extrapolation */
+            if (extrapolation == PERIODIC) {
+                /* Event handling for periodic extrapolation */
+                if (nextTimeEvent == preNextTimeEvent &&
+                    tOld >= nextTimeEvent) {
+                    /* Before event iteration: Return previous
+                       interval value */
+                    last = tableID->intervals[
+                        tableID->eventInterval - 1][1] - 1;
+                    haveLast = 1;
+                }
+                else if (nextTimeEvent > preNextTimeEvent &&
+                    tOld >= preNextTimeEvent &&
+                    tableID->startTime < preNextTimeEvent) {
+                    /* In regular (= not start time) event iteration:
+                       Return left interval value */
+                    last = tableID->intervals[
+                        tableID->eventInterval - 1][0];
+                    haveLast = 1;
+                }
+                else {
+                    /* After event iteration */
+                    const size_t i0 = tableID->intervals[
+                        tableID->eventInterval - 1][0];
+                    const size_t i1 = tableID->intervals[
+                        tableID->eventInterval - 1][1];
 
-                /* Periodic extrapolation */
-                if (tableID->extrapolation == PERIODIC) {
-                    const double T = tMax - tMin;
-                    /* Event handling for periodic extrapolation */
-                    if (nextTimeEvent == preNextTimeEvent &&
-                        tOld >= nextTimeEvent) {
-                        /* Before event iteration: Return previous
-                           interval value */
-                        last = tableID->intervals[
-                            tableID->eventInterval - 1][1] - 1;
-                        haveLast = 1;
-                    }
-                    else if (nextTimeEvent > preNextTimeEvent &&
-                        tOld >= preNextTimeEvent &&
-                        tableID->startTime < preNextTimeEvent) {
-                        /* In regular (= not start time) event iteration:
-                           Return left interval value */
-                        last = tableID->intervals[
-                            tableID->eventInterval - 1][0];
-                        haveLast = 1;
+                    t -= tableID->tOffset;
+                    t = periodicShift(t, tMin, tMax);
+                    tableID->last = findRowIndex(
+                        table, nRow, nCol, tableID->last, t);
+                    /* Event interval correction */
+                    if (tableID->last < i0) {
+                        t = TABLE_COL0(i0);
                     }
-                    else {
-                        /* After event iteration */
-                        const size_t i0 = tableID->intervals[
-                            tableID->eventInterval - 1][0];
-                        const size_t i1 = tableID->intervals[
-                            tableID->eventInterval - 1][1];
-
-                        t -= tableID->tOffset;
-                        if (t < tMin) {
-                            do {
-                                t += T;
-                            } while (t < tMin);
-                        }
-                        else if (t > tMax) {
-                            do {
-                                t -= T;
-                            } while (t > tMax);
-                        }
-                        tableID->last = findRowIndex(
-                            table, nRow, nCol, tableID->last, t);
-                        /* Event interval correction */
-                        if (tableID->last < i0) {
+                    if (tableID->last >= i1) {
+                        if (tableID->eventInterval == 1) {
                             t = TABLE_COL0(i0);
                         }
-                        if (tableID->last >= i1) {
-                            if (tableID->eventInterval == 1) {
-                                t = TABLE_COL0(i0);
-                            }
-                            else {
-                                t = TABLE_COL0(i1);
-                            }
+                        else {
+                            t = TABLE_COL0(i1);
                         }
                     }
                 }
-                else if (t < tMin) {
-                    extrapolate = LEFT;
+            }
+            else if (t < tMin) {
+                extrapolate = LEFT;
+            }
+            else if (t >= tMax) {
+                extrapolate = RIGHT;
+                /* Event handling for non-periodic extrapolation */
+                if (nextTimeEvent == preNextTimeEvent &&
+                    nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
+                    /* Before event iteration */
+                    extrapolate = IN_TABLE;
                 }
-                else if (t >= tMax) {
-                    extrapolate = RIGHT;
+            }
+
+            if (extrapolate == IN_TABLE) {
+                if (extrapolation != PERIODIC) {
                     /* Event handling for non-periodic extrapolation */
                     if (nextTimeEvent == preNextTimeEvent &&
                         nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
                         /* Before event iteration */
-                        extrapolate = IN_TABLE;
-                    }
-                }
-
-                if (extrapolate == IN_TABLE) {
-                    if (tableID->extrapolation != PERIODIC) {
-                        /* Event handling for non-periodic extrapolation */
-                        if (nextTimeEvent == preNextTimeEvent &&
-                            nextTimeEvent < DBL_MAX && tOld >= nextTimeEvent) {
-                            /* Before event iteration */
-                            if (tableID->eventInterval == 1) {
-                                last = 0;
-                                extrapolate = LEFT;
-                            }
-                            else if (tableID->smoothness == CONSTANT_SEGMENTS) {
-                                last = tableID->intervals[
-                                    tableID->eventInterval - 2][0];
-                            }
-                            else if (tableID->smoothness == LINEAR_SEGMENTS) {
-                                last = tableID->intervals[
-                                    tableID->eventInterval - 2][1];
-                            }
-                            else if (t >= TABLE_COL0(nRow - 1)) {
-                                last = nRow - 1;
-                            }
-                            else {
-                                last = findRowIndex(table, nRow, nCol,
-                                    tableID->last, t);
-                                tableID->last = last;
-                            }
-                            if (last > 0 && extrapolate == IN_TABLE) {
-                                last--;
-                            }
-                            haveLast = 1;
+                        if (tableID->eventInterval == 1) {
+                            last = 0;
+                            extrapolate = LEFT;
+                        }
+                        else if (smoothness == CONSTANT_SEGMENTS) {
+                            last = tableID->intervals[
+                                tableID->eventInterval - 2][0];
+                        }
+                        else if (smoothness == LINEAR_SEGMENTS) {
+                            last = tableID->intervals[
+                                tableID->eventInterval - 2][1];
+                        }
+                        else if (t >= TABLE_COL0(nRow - 1)) {
+                            last = nRow - 1;
+                        }
+                        else {
+                            last = findRowIndex(table, nRow, nCol,
+                                tableID->last, t);
+                            tableID->last = last;
+                        }
+                        if (last > 0 && extrapolate == IN_TABLE) {
+                            last--;
                         }
+                        haveLast = 1;
                     }
+                }
 
-                    if (!haveLast) {
-                        last = findRowIndex(table, nRow, nCol, tableID->last, t);
-                        tableID->last = last;
-                    }
+                if (!haveLast) {
+                    last = findRowIndex(table, nRow, nCol, tableID->last, t);
+                    tableID->last = last;
+                }
 
-                    if (tableID->extrapolation != PERIODIC &&
-                        tableID->eventInterval > 1) {
-                        const size_t i0 = tableID->intervals[
-                            tableID->eventInterval - 2][0];
-                        const size_t i1 = tableID->intervals[
-                            tableID->eventInterval - 2][1];
+                if (extrapolation != PERIODIC &&
+                    tableID->eventInterval > 1) {
+                    const size_t i0 = tableID->intervals[
+                        tableID->eventInterval - 2][0];
+                    const size_t i1 = tableID->intervals[
+                        tableID->eventInterval - 2][1];
 
-                       if (last < i0) {
-                            last = i0;
-                        }
-                        if (last >= i1) {
-                            last = i0;
-                        }
+                   if (last < i0) {
+                        last = i0;
+                    }
+                    if (last >= i1) {
+                        last = i0;
                     }
                 }
+            }
 
-                if (extrapolate == IN_TABLE) {
-                    /* Interpolation */
-                    switch (tableID->smoothness) {
-                        case LINEAR_SEGMENTS: {
-                            const double t0 = TABLE_COL0(last);
-                            const double t1 = TABLE_COL0(last + 1);
-                            if (!isNearlyEqual(t0, t1)) {
-                                der_y = (TABLE(last + 1, col) - TABLE(last, col))/
-                                    (t1 - t0);
-                                der_y *= der_t;
-                            }
-                            break;
+            if (extrapolate == IN_TABLE) {
+                /* Interpolation */
+                switch (smoothness) {
+                    case LINEAR_SEGMENTS: {
+                        const double t0 = TABLE_COL0(last);
+                        const double t1 = TABLE_COL0(last + 1);
+                        if (!isNearlyEqual(t0, t1)) {
+                            der_y = DIV_WIDTH(TABLE_VALUE(last + 1, col) -
+                                TABLE_VALUE(last, col), t0, t1,
+                                tableID->invWidth[last]);
+                            der_y *= der_t;
                         }
+                        break;
+                    }
 
-                        case CONSTANT_SEGMENTS:
-                            break;
+                    case CONSTANT_SEGMENTS:
+                        break;
 
-                        case AKIMA_C1:
-                        case FRITSCH_BUTLAND_MONOTONE_C1:
-                        case STEFFEN_MONOTONE_C1:
-                            if (NULL != tableID->spline) {
-                                const double* c = tableID->spline[
-                                    IDX(last, iCol - 1, tableID->nCols)];
-                                t -= TABLE_COL0(last);
-                                der_y = (3*c[0]*t + 2*c[1])*t + c[2];
-                                der_y *= der_t;
-                            }
-                            break;
+                    case AKIMA_C1:
+                    case FRITSCH_BUTLAND_MONOTONE_C1:
+                    case STEFFEN_MONOTONE_C1:
+                        MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                        if (NULL != tableID->spline ||
+                            NULL != tableID->splineFloat) {
+                            double cFloat[3];
+                            const double* c = spline1DCoefficients(
+                                tableID->spline, tableID->splineFloat,
+                                IDX(last, iCol - 1, tableID->nCols), cFloat);
+                            t -= TABLE_COL0(last);
+                            der_y = (3*c[0]*t + 2*c[1])*t + c[2];
+                            der_y *= der_t;
+                        }
+                        break;
 
-                        default:
-                            ModelicaError("Unknown smoothness kind\n");
-                            return der_y;
-                    }
+                    default:
+                        ModelicaError("Unknown smoothness kind\n");
+                        return der_y;
                 }
-                else {
-                    /* Extrapolation */
-                    switch (tableID->extrapolation) {
-                        case LAST_TWO_POINTS:
-                            last = (extrapolate == RIGHT) ? nRow - 2 : 0;
-                            switch(tableID->smoothness) {
-                                case LINEAR_SEGMENTS:
-                                case CONSTANT_SEGMENTS: {
-                                    const double t0 = TABLE_COL0(last);
-                                    const double t1 = TABLE_COL0(last + 1);
-                                    if (!isNearlyEqual(t0, t1)) {
-                                        der_y = (TABLE(last + 1, col) - TABLE(last, col))/
-                                            (t1 - t0);
-                                    }
-                                    break;
+            }
+            else {
+                /* Extrapolation */
+                MODELICA_PROFILE_COUNT(extrapolations, 1);
+                switch (extrapolation) {
+                    case LAST_TWO_POINTS:
+                        last = (extrapolate == RIGHT) ? nRow - 2 : 0;
+                        switch(smoothness) {
+                            case LINEAR_SEGMENTS:
+                            case CONSTANT_SEGMENTS: {
+                                const double t0 = TABLE_COL0(last);
+                                const double t1 = TABLE_COL0(last + 1);
+                                if (!isNearlyEqual(t0, t1)) {
+                                    der_y = DIV_WIDTH(TABLE_VALUE(last + 1, col) -
+                                        TABLE_VALUE(last, col), t0, t1,
+                                        tableID->invWidth[last]);
                                 }
+                                break;
+                            }
 
-                                case AKIMA_C1:
-                                case FRITSCH_BUTLAND_MONOTONE_C1:
-                                case STEFFEN_MONOTONE_C1:
-                                    if (NULL != tableID->spline) {
-                                        const double* c = tableID->spline[
-                                            IDX(last, iCol - 1, tableID->nCols)];
-                                        if (extrapolate == LEFT) {
-                                            der_y = c[2];
-                                        }
-                                        else /* if (extrapolate == RIGHT) */ {
-                                            der_y = TABLE_COL0(last + 1) -
-                                                TABLE_COL0(last); /* = (t1 - t0) */
-                                            der_y = (3*c[0]*der_y + 2*c[1])*
-                                                der_y + c[2];
-                                        }
+                            case AKIMA_C1:
+                            case FRITSCH_BUTLAND_MONOTONE_C1:
+                            case STEFFEN_MONOTONE_C1:
+                                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                                if (NULL != tableID->spline ||
+                                    NULL != tableID->splineFloat) {
+                                    double cFloat[3];
+                                    const double* c = spline1DCoefficients(
+                                        tableID->spline, tableID->splineFloat,
+                                        IDX(last, iCol - 1, tableID->nCols), cFloat);
+                                    if (extrapolate == LEFT) {
+                                        der_y = c[2];
+                                    }
+                                    else /* if (extrapolate == RIGHT) */ {
+                                        der_y = TABLE_COL0(last + 1) -
+                                            TABLE_COL0(last); /* = (t1 - t0) */
+                                        der_y = (3*c[0]*der_y + 2*c[1])*
+                                            der_y + c[2];
                                     }
-                                    break;
+                                }
+                                break;
 
-                                default:
-                                    ModelicaError("Unknown smoothness kind\n");
-                                    return der_y;
-                            }
-                            der_y *= der_t;
-                            break;
+                            default:
+                                ModelicaError("Unknown smoothness kind\n");
+                                return der_y;
+                        }
+                        der_y *= der_t;
+                        break;
 
-                        case HOLD_LAST_POINT:
-                            break;
+                    case HOLD_LAST_POINT:
+                        break;
 
-                        case NO_EXTRAPOLATION:
-                            ModelicaError("Extrapolation error\n");
-                            return der_y;
+                    case NO_EXTRAPOLATION:
+                        ModelicaError("Extrapolation error\n");
+                        return der_y;
 
-                        case PERIODIC:
-                            /* Should not be possible to get here */
-                            break;
+                    case PERIODIC:
+                        /* Should not be possible to get here */
+                        break;
 
-                        default:
-                            ModelicaError("Unknown extrapolation kind\n");
-                            return der_y;
-                    }
+                    default:
+                        ModelicaError("Unknown extrapolation kind\n");
+                        return der_y;
                 }
             }
         }
@@ -1308,22 +2314,204 @@ double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCo
     return der_y;
 }
 
-double ModelicaStandardTables_CombiTimeTable_minimumTime(void* _tableID) {
-    double tMin = 0.;
-    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
-    if (NULL != tableID && NULL != tableID->table) {
-        const double* table = tableID->table;
-        tMin = TABLE_ROW0(0);
-    }
-    return tMin;
+/* Evaluation kernels of CombiTimeTable: The evaluation functions are
+   instantiated for each combination of table shape, smoothness and
+   extrapolation kind such that the compiler can remove the dispatch on
+   these (at evaluation time constant) table properties. The monotone cubic
+   Hermite spline kinds only differ in their spline coefficients and are
+   evaluated by the kernels of AKIMA_C1.
+   The fused kernel of value and derivative inlines both evaluations: The
+   interval search of the derivative starts at the row index just found for
+   the value and the table data is still in cache. The results are identical
+   to the ones of the separate kernels called in sequence. */
+#define COMBITIMETABLE_KERNELS(shape, smooth, extrap) \
+static double combiTimeTableValue_##shape##_##smooth##_##extrap( \
+    CombiTimeTable* tableID, int iCol, double t, double nextTimeEvent, \
+    double preNextTimeEvent) { \
+    return combiTimeTableValue(tableID, iCol, t, nextTimeEvent, \
+        preNextTimeEvent, shape, smooth, extrap); \
+} \
+static double combiTimeTableDerValue_##shape##_##smooth##_##extrap( \
+    CombiTimeTable* tableID, int iCol, double t, double nextTimeEvent, \
+    double preNextTimeEvent, double der_t) { \
+    return combiTimeTableDerValue(tableID, iCol, t, nextTimeEvent, \
+        preNextTimeEvent, der_t, shape, smooth, extrap); \
+} \
+static double combiTimeTableValueAndDer_##shape##_##smooth##_##extrap( \
+    CombiTimeTable* tableID, int iCol, double t, double nextTimeEvent, \
+    double preNextTimeEvent, double* der_y) { \
+    const double y = combiTimeTableValue(tableID, iCol, t, nextTimeEvent, \
+        preNextTimeEvent, shape, smooth, extrap); \
+    *der_y = combiTimeTableDerValue(tableID, iCol, t, nextTimeEvent, \
+        preNextTimeEvent, 1., shape, smooth, extrap); \
+    return y; \
 }
 
-double ModelicaStandardTables_CombiTimeTable_maximumTime(void* _tableID) {
+#define COMBITIMETABLE_KERNEL_ROW(prefix, smooth) { \
+    prefix##_SHAPE_GENERAL_##smooth##_HOLD_LAST_POINT, \
+    prefix##_SHAPE_GENERAL_##smooth##_LAST_TWO_POINTS, \
+    prefix##_SHAPE_GENERAL_##smooth##_PERIODIC, \
+    prefix##_SHAPE_GENERAL_##smooth##_NO_EXTRAPOLATION \
+}
+
+#define COMBITIMETABLE_KERNELS_EXTRAPOLATION(smooth) \
+    COMBITIMETABLE_KERNELS(SHAPE_GENERAL, smooth, HOLD_LAST_POINT) \
+    COMBITIMETABLE_KERNELS(SHAPE_GENERAL, smooth, LAST_TWO_POINTS) \
+    COMBITIMETABLE_KERNELS(SHAPE_GENERAL, smooth, PERIODIC) \
+    COMBITIMETABLE_KERNELS(SHAPE_GENERAL, smooth, NO_EXTRAPOLATION)
+
+COMBITIMETABLE_KERNELS_EXTRAPOLATION(LINEAR_SEGMENTS)
+COMBITIMETABLE_KERNELS_EXTRAPOLATION(CONSTANT_SEGMENTS)
+COMBITIMETABLE_KERNELS_EXTRAPOLATION(AKIMA_C1)
+COMBITIMETABLE_KERNELS(SHAPE_SINGLE_ROW, LINEAR_SEGMENTS, HOLD_LAST_POINT)
+
+/* Fallback kernels for unknown smoothness or extrapolation kinds (which are
+   reported at evaluation time) */
+static double combiTimeTableValue_generic(CombiTimeTable* tableID, int iCol,
+                                          double t, double nextTimeEvent,
+                                          double preNextTimeEvent) {
+    return combiTimeTableValue(tableID, iCol, t, nextTimeEvent,
+        preNextTimeEvent, tableID->nRow == 1 ? SHAPE_SINGLE_ROW :
+        SHAPE_GENERAL, tableID->smoothness, tableID->extrapolation);
+}
+
+static double combiTimeTableDerValue_generic(CombiTimeTable* tableID,
+                                             int iCol, double t,
+                                             double nextTimeEvent,
+                                             double preNextTimeEvent,
+                                             double der_t) {
+    return combiTimeTableDerValue(tableID, iCol, t, nextTimeEvent,
+        preNextTimeEvent, der_t, tableID->nRow == 1 ? SHAPE_SINGLE_ROW :
+        SHAPE_GENERAL, tableID->smoothness, tableID->extrapolation);
+}
+
+static double combiTimeTableValueAndDer_generic(CombiTimeTable* tableID,
+                                                int iCol, double t,
+                                                double nextTimeEvent,
+                                                double preNextTimeEvent,
+                                                double* der_y) {
+    const double y = combiTimeTableValue_generic(tableID, iCol, t,
+        nextTimeEvent, preNextTimeEvent);
+    *der_y = combiTimeTableDerValue_generic(tableID, iCol, t, nextTimeEvent,
+        preNextTimeEvent, 1.);
+    return y;
+}
+
+static int smoothnessKernelIndex(enum Smoothness smoothness) {
+    switch (smoothness) {
+        case LINEAR_SEGMENTS:
+            return 0;
+        case CONSTANT_SEGMENTS:
+            return 1;
+        case AKIMA_C1:
+        case FRITSCH_BUTLAND_MONOTONE_C1:
+        case STEFFEN_MONOTONE_C1:
+            return 2;
+        default:
+            return -1;
+    }
+}
+
+static void selectCombiTimeTableKernels(CombiTimeTable* tableID) {
+    static CombiTimeTableValue const valueKernels[3][4] = {
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableValue, LINEAR_SEGMENTS),
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableValue, CONSTANT_SEGMENTS),
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableValue, AKIMA_C1)
+    };
+    static CombiTimeTableDerValue const derValueKernels[3][4] = {
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableDerValue, LINEAR_SEGMENTS),
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableDerValue, CONSTANT_SEGMENTS),
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableDerValue, AKIMA_C1)
+    };
+    static CombiTimeTableValueAndDer const valueAndDerKernels[3][4] = {
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableValueAndDer, LINEAR_SEGMENTS),
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableValueAndDer, CONSTANT_SEGMENTS),
+        COMBITIMETABLE_KERNEL_ROW(combiTimeTableValueAndDer, AKIMA_C1)
+    };
+    const int i = smoothnessKernelIndex(tableID->smoothness);
+    const int j = (int)tableID->extrapolation - (int)HOLD_LAST_POINT;
+
+    if (tableID->nRow == 1) {
+        tableID->getValue =
+            combiTimeTableValue_SHAPE_SINGLE_ROW_LINEAR_SEGMENTS_HOLD_LAST_POINT;
+        tableID->getDerValue =
+            combiTimeTableDerValue_SHAPE_SINGLE_ROW_LINEAR_SEGMENTS_HOLD_LAST_POINT;
+        tableID->getValueAndDer =
+            combiTimeTableValueAndDer_SHAPE_SINGLE_ROW_LINEAR_SEGMENTS_HOLD_LAST_POINT;
+    }
+    else if (i >= 0 && j >= 0 && j < 4) {
+        tableID->getValue = valueKernels[i][j];
+        tableID->getDerValue = derValueKernels[i][j];
+        tableID->getValueAndDer = valueAndDerKernels[i][j];
+    }
+    else {
+        tableID->getValue = combiTimeTableValue_generic;
+        tableID->getDerValue = combiTimeTableDerValue_generic;
+        tableID->getValueAndDer = combiTimeTableValueAndDer_generic;
+    }
+}
+
+double ModelicaStandardTables_CombiTimeTable_getValue(void* _tableID, int iCol,
+                                                      double t, double nextTimeEvent,
+                                                      double preNextTimeEvent) {
+    double y = 0.;
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTimeTable_getValue,
+            y = tableID->getValue(tableID, iCol, t, nextTimeEvent,
+                preNextTimeEvent));
+    }
+    return y;
+}
+
+double ModelicaStandardTables_CombiTimeTable_getDerValue(void* _tableID, int iCol,
+                                                         double t,
+                                                         double nextTimeEvent,
+                                                         double preNextTimeEvent,
+                                                         double der_t) {
+    double der_y = 0.;
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTimeTable_getDerValue,
+            der_y = tableID->getDerValue(tableID, iCol, t, nextTimeEvent,
+                preNextTimeEvent, der_t));
+    }
+    return der_y;
+}
+
+double ModelicaStandardTables_CombiTimeTable_getValueAndDer(void* _tableID,
+                                                            int iCol,
+                                                            double t,
+                                                            double nextTimeEvent,
+                                                            double preNextTimeEvent,
+                                                            double* der_y) {
+    double y = 0.;
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    *der_y = 0.;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTimeTable_getValueAndDer,
+            y = tableID->getValueAndDer(tableID, iCol, t, nextTimeEvent,
+                preNextTimeEvent, der_y));
+    }
+    return y;
+}
+
+double ModelicaStandardTables_CombiTimeTable_minimumTime(void* _tableID) {
+    double tMin = 0.;
+    CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
+    if (NULL != tableID && NULL != tableID->table) {
+        const double* table = tableID->table;
+        tMin = TABLE_ROW0(0);
+    }
+    return tMin;
+}
+
+double ModelicaStandardTables_CombiTimeTable_maximumTime(void* _tableID) {
     double tMax = 0.;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     if (NULL != tableID && NULL != tableID->table) {
         const double* table = tableID->table;
-        const size_t nCol = tableID->nCol;
+        const size_t nCol = ABSCISSA_STRIDE(tableID);
         tMax = TABLE_COL0(tableID->nRow - 1);
     }
     return tMax;
@@ -1331,12 +2519,13 @@ double ModelicaStandardTables_CombiTimeTable_maximumTime(void* _tableID) {
 
 double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                                                            double t) {
+    MODELICA_PROFILE_BEGIN();
     double nextTimeEvent = DBL_MAX;
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     if (NULL != tableID && NULL != tableID->table) {
         const double* table = tableID->table;
         const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
+        const size_t nCol = ABSCISSA_STRIDE(tableID);
 
         if (tableID->nEvent > 0) {
             if (t > tableID->preNextTimeEventCalled) {
@@ -1351,6 +2540,7 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                 tableID->preNextTimeEvent = -DBL_MAX;
             }
             else {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTimeTable_nextTimeEvent);
                 return tableID->preNextTimeEvent;
             }
         }
@@ -1378,11 +2568,32 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
             /* Once again with storage of indices of event intervals */
             tableID->intervals = (Interval*)calloc(tableID->maxEvents,
                 sizeof(Interval));
-            if (tableID->intervals == NULL) {
+            tableID->eventRows = (size_t*)malloc(tableID->maxEvents*
+                sizeof(size_t));
+            if (tableID->intervals == NULL || tableID->eventRows == NULL) {
                 ModelicaError("Memory allocation error\n");
                 return nextTimeEvent;
             }
 
+            /* Sorted rows of the time events within the table range, such
+               that the event interval can be found by binary search */
+            tEvent = TABLE_ROW0(0);
+            eventInterval = 0;
+            if (tableID->smoothness == LINEAR_SEGMENTS ||
+                tableID->smoothness == CONSTANT_SEGMENTS) {
+                for (i = 0; i < nRow - 1; i++) {
+                    double t0 = TABLE_COL0(i);
+                    double t1 = TABLE_COL0(i + 1);
+                    if (t1 > tEvent && !isNearlyEqual(t1, tMax)) {
+                        if (!isNearlyEqual(t0, t1)) {
+                            tEvent = t1;
+                            tableID->eventRows[eventInterval] = i + 1;
+                            eventInterval++;
+                        }
+                    }
+                }
+            }
+
             tEvent = TABLE_ROW0(0);
             eventInterval = 0;
             if (tableID->smoothness == LINEAR_SEGMENTS ||
@@ -1422,7 +2633,6 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
 #if defined(DEBUG_TIME_EVENTS)
                 const double tOld = t;
 #endif
-                double tEvent = tMin;
                 size_t i, iStart, iEnd;
 
                 t -= tableID->startTime;
@@ -1478,16 +2688,9 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                         }
                     }
 
-                    for (i = 0; i < iEnd; i++) {
-                        double t0 = TABLE_COL0(i);
-                        double t1 = TABLE_COL0(i + 1);
-                        if (t1 > tEvent && !isNearlyEqual(t1, tMax)) {
-                            if (!isNearlyEqual(t0, t1)) {
-                                tEvent = t1;
-                                tableID->eventInterval++;
-                            }
-                        }
-                    }
+                    /* Count the time events up to row iEnd */
+                    tableID->eventInterval += countEventRows(
+                        tableID->eventRows, tableID->maxEvents - 1, iEnd);
                 }
 
                 if (tableID->extrapolation == PERIODIC) {
@@ -1504,34 +2707,52 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
                 }
             }
             else {
-                do {
-                    if (tableID->extrapolation == PERIODIC) {
-                        /* Increment event interval */
-                        tableID->eventInterval =
-                            1 + tableID->eventInterval % tableID->maxEvents;
-                        if (tableID->eventInterval == tableID->maxEvents) {
-                            nextTimeEvent = tMax + tableID->tOffset +
-                                tableID->startTime;
+                /* Advance to the first event interval with a time event not
+                   less than t */
+                const size_t maxEvents = tableID->maxEvents;
+                if (tableID->extrapolation == PERIODIC) {
+                    for (;;) {
+                        size_t k = 1 + tableID->eventInterval % maxEvents;
+                        nextTimeEvent = tMax + tableID->tOffset +
+                            tableID->startTime;
+                        if (nextTimeEvent < t) {
+                            /* Skip the remaining event intervals of period */
+                            tableID->eventInterval = maxEvents;
+                            tableID->tOffset += T;
+                            continue;
+                        }
+                        k = findEventInterval(tableID, k, maxEvents,
+                            tableID->tOffset, tableID->startTime, t);
+                        tableID->eventInterval = k;
+                        if (k == maxEvents) {
                             tableID->tOffset += T;
                         }
                         else {
-                            size_t i = tableID->intervals[
-                                tableID->eventInterval - 1][1];
+                            size_t i = tableID->intervals[k - 1][1];
                             nextTimeEvent = TABLE_COL0(i) + tableID->tOffset +
                                 tableID->startTime;
                         }
+                        break;
                     }
-                    else if (tableID->eventInterval <= tableID->maxEvents) {
-                        size_t i = tableID->intervals[
-                            tableID->eventInterval - 1][1];
+                }
+                else if (tableID->eventInterval <= maxEvents) {
+                    const size_t k = findEventInterval(tableID,
+                        tableID->eventInterval, maxEvents + 1,
+                        tableID->startTime, 0.0, t);
+                    if (k <= maxEvents) {
+                        size_t i = tableID->intervals[k - 1][1];
                         nextTimeEvent = TABLE_COL0(i) + tableID->startTime;
                         /* Increment event interval */
-                        tableID->eventInterval++;
+                        tableID->eventInterval = k + 1;
                     }
                     else {
                         nextTimeEvent = DBL_MAX;
+                        tableID->eventInterval = k;
                     }
-                } while (nextTimeEvent < t);
+                }
+                else {
+                    nextTimeEvent = DBL_MAX;
+                }
             }
         }
 
@@ -1559,27 +2780,50 @@ double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* _tableID,
         return nextTimeEvent;
     }
 
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTimeTable_nextTimeEvent);
     return nextTimeEvent;
 }
 
 double ModelicaStandardTables_CombiTimeTable_read(void* _tableID, int force,
                                                   int verbose) {
+    MODELICA_PROFILE_BEGIN();
 #if !defined(NO_FILE_SYSTEM)
     CombiTimeTable* tableID = (CombiTimeTable*)_tableID;
     if (tableID != NULL && tableID->source == TABLESOURCE_FILE) {
-        if (force || tableID->table == NULL) {
-#if !defined(TABLE_SHARE)
-            if (tableID->table != NULL) {
-                free(tableID->table);
-            }
-#endif
+        if (force && tableID->table != NULL &&
+            ModelicaIO_isTableFileUnchanged(tableID->fileName,
+            &tableID->fileState)) {
+            /* Table file is unchanged since the last read */
+        }
+        else if (force || tableID->table == NULL) {
+            ModelicaIOLoadEvent event;
+            const unsigned long long start = ModelicaProfile_now();
+            unsigned long long splineStart;
+            double* prevTable = tableID->table;
+            /* The previous table can only be continued by the rows appended
+               to the table file if it holds all values in double precision */
+            const int isContinuable = tableID->tableFloat == NULL;
+            size_t nRowKept;
+            /* Release the single precision storage of the previous table */
+            free(tableID->tableFloat);
+            tableID->tableFloat = NULL;
+            free(tableID->splineFloat);
+            tableID->splineFloat = NULL;
             tableID->table = readTable(tableID->tableName,
                 tableID->fileName, &tableID->nRow, &tableID->nCol,
-                verbose, force);
+                tableID->columns, tableID->nColumns,
+                isContinuable ? (const double*)prevTable : NULL,
+                &tableID->fileState, verbose, force, &event);
+#if !defined(TABLE_SHARE)
+            free(prevTable);
+#endif
+            nRowKept = tableID->fileState.nRowKept;
             if (tableID->table == NULL) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTimeTable_read);
                 return 0.; /* Error */
             }
             if (!isValidCombiTimeTable((const CombiTimeTable*)tableID)) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTimeTable_read);
                 return 0.; /* Error */
             }
             if (tableID->nRow <= 2) {
@@ -1589,7 +2833,37 @@ double ModelicaStandardTables_CombiTimeTable_read(void* _tableID, int force,
                     tableID->smoothness = LINEAR_SEGMENTS;
                 }
             }
-            if (tableID->smoothness == AKIMA_C1) {
+            if (nRowKept > 0 && tableID->invWidth != NULL) {
+                /* Extension of the inverse interval widths */
+                tableID->invWidth = invWidthExtend(tableID->invWidth,
+                    (const double*)tableID->table, nRowKept, tableID->nRow,
+                    tableID->nCol);
+            }
+            else {
+                /* Reinitialization of the inverse interval widths */
+                free(tableID->invWidth);
+                tableID->invWidth = invWidthInit(
+                    (const double*)tableID->table, tableID->nRow,
+                    tableID->nCol);
+            }
+            if (tableID->invWidth == NULL) {
+                ModelicaError("Memory allocation error\n");
+                return 0.; /* Error */
+            }
+            selectCombiTimeTableKernels(tableID);
+            splineStart = ModelicaProfile_now();
+            if (nRowKept > 0 && tableID->spline != NULL) {
+                /* Extension of the cubic Hermite spline coefficients */
+                tableID->spline = spline1DExtend(tableID->spline,
+                    tableID->smoothness, (const double*)tableID->table,
+                    nRowKept, tableID->nRow, tableID->nCol,
+                    (const int*)tableID->cols, tableID->nCols);
+                if (tableID->spline == NULL) {
+                    ModelicaError("Memory allocation error\n");
+                    return 0.; /* Error */
+                }
+            }
+            else if (tableID->smoothness == AKIMA_C1) {
                 /* Reinitialization of the cubic Hermite spline coefficients */
                 spline1DClose(&tableID->spline);
                 tableID->spline = akimaSpline1DInit(
@@ -1622,9 +2896,19 @@ double ModelicaStandardTables_CombiTimeTable_read(void* _tableID, int force,
                     return 0.; /* Error */
                 }
             }
+            event.splineTime = 1e-9*(double)(ModelicaProfile_now() - splineStart);
+            if (tableID->storage == STORAGE_FLOAT) {
+                compactTable1D(&tableID->table, tableID->nRow, tableID->nCol,
+                    (const int*)tableID->cols, tableID->nCols,
+                    tableID->source, &tableID->tableFloat, &tableID->spline,
+                    &tableID->splineFloat);
+            }
+            event.totalTime = 1e-9*(double)(ModelicaProfile_now() - start);
+            ModelicaIO_reportLoadEvent(&event);
         }
     }
 #endif
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTimeTable_read);
     return 1.; /* Success */
 }
 
@@ -1634,8 +2918,9 @@ void* ModelicaStandardTables_CombiTable1D_init(_In_z_ const char* tableName,
                                                size_t nColumn,
                                                _In_ int* cols,
                                                size_t nCols, int smoothness) {
-    return ModelicaStandardTables_CombiTable1D_init2(tableName, fileName,
-        table, nRow, nColumn, cols, nCols, smoothness, LAST_TWO_POINTS);
+    return ModelicaStandardTables_CombiTable1D_init2(tableName,
+        fileName, table, nRow, nColumn, cols, nCols, smoothness,
+        LAST_TWO_POINTS);
 }
 
 void* ModelicaStandardTables_CombiTable1D_init2(_In_z_ const char* tableName,
@@ -1645,8 +2930,25 @@ void* ModelicaStandardTables_CombiTable1D_init2(_In_z_ const char* tableName,
                                                 _In_ int* cols,
                                                 size_t nCols, int smoothness,
                                                 int extrapolation) {
+    return ModelicaStandardTables_CombiTable1D_init3(tableName,
+        fileName, table, nRow, nColumn, cols, nCols, smoothness,
+        extrapolation, STORAGE_DEFAULT);
+}
+
+void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* tableName,
+                                                _In_z_ const char* fileName,
+                                                _In_ double* table, size_t nRow,
+                                                size_t nColumn,
+                                                _In_ int* cols,
+                                                size_t nCols, int smoothness,
+                                                int extrapolation, int storage) {
+    MODELICA_PROFILE_BEGIN();
     CombiTable1D* tableID = (CombiTable1D*)calloc(1, sizeof(CombiTable1D));
     if (tableID != NULL) {
+#if defined(TABLE_CONTENT_SHARE)
+        unsigned long long key = 0;
+#endif
+        tableID->storage = tableStorage(storage);
         tableID->smoothness = (enum Smoothness)smoothness;
         tableID->extrapolation = (enum Extrapolation)extrapolation;
         tableID->nCols = nCols;
@@ -1692,6 +2994,12 @@ void* ModelicaStandardTables_CombiTable1D_init2(_In_z_ const char* tableName,
                     ModelicaError("Memory allocation error\n");
                     return NULL;
                 }
+#if !defined(NO_FILE_SYSTEM)
+                /* Only read the first column and the columns to be
+                   interpolated */
+                tableID->columns = tableColumns(tableID->cols,
+                    tableID->nCols, &tableID->nColumns);
+#endif
                 break;
 
             case TABLESOURCE_MODEL:
@@ -1706,6 +3014,25 @@ void* ModelicaStandardTables_CombiTable1D_init2(_In_z_ const char* tableName,
                             tableID->smoothness = LINEAR_SEGMENTS;
                         }
                     }
+#if defined(TABLE_CONTENT_SHARE)
+                    key = contentHash(table, tableID->nRow, tableID->nCol,
+                        (const int*)tableID->cols, tableID->nCols, 1,
+                        tableID->smoothness, tableID->storage);
+                    tableID->share = contentShareAcquire(key, table,
+                        tableID->nRow, tableID->nCol, (const int*)tableID->cols,
+                        tableID->nCols, 1, tableID->smoothness,
+                        tableID->storage);
+                    if (tableID->share != NULL) {
+                        /* Share hit -> Use table values, spline coefficients
+                           and inverse interval widths of the content share */
+                        tableID->table = tableID->share->table;
+                        tableID->tableFloat = tableID->share->tableFloat;
+                        tableID->spline = tableID->share->spline1D;
+                        tableID->splineFloat = tableID->share->spline1DFloat;
+                        tableID->invWidth = tableID->share->invWidth1;
+                        break;
+                    }
+#endif
                     if (tableID->smoothness == AKIMA_C1) {
                         /* Initialization of the cubic Hermite spline coefficients */
                         tableID->spline = akimaSpline1DInit(table,
@@ -1876,26 +3203,69 @@ void* ModelicaStandardTables_CombiTable1D_init2(_In_z_ const char* tableName,
                 ModelicaError("Table source error\n");
                 return NULL;
         }
+        if (tableID->table != NULL && tableID->share == NULL) {
+            tableID->invWidth = invWidthInit((const double*)tableID->table,
+                tableID->nRow, tableID->nCol);
+            if (tableID->invWidth == NULL) {
+                ModelicaStandardTables_CombiTable1D_close(tableID);
+                ModelicaError("Memory allocation error\n");
+                return NULL;
+            }
+            if (tableID->storage == STORAGE_FLOAT) {
+                compactTable1D(&tableID->table, tableID->nRow, tableID->nCol,
+                    (const int*)tableID->cols, tableID->nCols,
+                    tableID->source, &tableID->tableFloat, &tableID->spline,
+                    &tableID->splineFloat);
+            }
+#if defined(TABLE_CONTENT_SHARE)
+            if (tableID->source == TABLESOURCE_MODEL) {
+                /* Share miss -> Insert new content share */
+                ContentShare* share = contentShareNew(key, tableID->nRow,
+                    tableID->nCol, (const int*)tableID->cols, tableID->nCols,
+                    1, tableID->smoothness, tableID->storage);
+                if (share != NULL) {
+                    share->table = tableID->table;
+                    share->tableFloat = tableID->tableFloat;
+                    share->spline1D = tableID->spline;
+                    share->spline1DFloat = tableID->splineFloat;
+                    share->invWidth1 = tableID->invWidth;
+                    tableID->share = contentShareInsert(share);
+                }
+            }
+#endif
+        }
+        selectCombiTable1DKernels(tableID);
     }
     else {
         ModelicaError("Memory allocation error\n");
     }
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_init3);
     return (void*)tableID;
 }
 
 void ModelicaStandardTables_CombiTable1D_close(void* _tableID) {
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     if (tableID != NULL) {
+#if defined(TABLE_CONTENT_SHARE)
+        if (tableID->share != NULL) {
+            /* Table values, spline coefficients and inverse interval widths
+               are owned by the content share */
+            contentShareRelease(tableID->share);
+            tableID->share = NULL;
+            tableID->table = NULL;
+            tableID->tableFloat = NULL;
+            tableID->spline = NULL;
+            tableID->splineFloat = NULL;
+            tableID->invWidth = NULL;
+        }
+#endif
         if (tableID->table != NULL && tableID->source == TABLESOURCE_FILE) {
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
             if (tableID->tableName != NULL && tableID->fileName != NULL) {
-                char* key = malloc((strlen(tableID->tableName) +
-                    strlen(tableID->fileName) + 2)*sizeof(char));
+                char* key = tableShareKey(tableID->tableName,
+                    tableID->fileName, tableID->columns, tableID->nColumns);
                 if (key != NULL) {
                     TableShare *iter;
-                    strcpy(key, tableID->tableName);
-                    strcat(key, "|");
-                    strcat(key, tableID->fileName);
                     MUTEX_LOCK();
                     HASH_FIND_STR(tableShare, key, iter);
                     if (iter != NULL) {
@@ -1932,6 +3302,10 @@ void ModelicaStandardTables_CombiTable1D_close(void* _tableID) {
             free(tableID->cols);
             tableID->cols = NULL;
         }
+        if (tableID->columns != NULL) {
+            free(tableID->columns);
+            tableID->columns = NULL;
+        }
         if (tableID->tableName != NULL) {
             free(tableID->tableName);
             tableID->tableName = NULL;
@@ -1940,294 +3314,600 @@ void ModelicaStandardTables_CombiTable1D_close(void* _tableID) {
             free(tableID->fileName);
             tableID->fileName = NULL;
         }
+        if (tableID->invWidth != NULL) {
+            free(tableID->invWidth);
+            tableID->invWidth = NULL;
+        }
+        if (tableID->monotony != NULL) {
+            free(tableID->monotony);
+            tableID->monotony = NULL;
+        }
+        if (tableID->tableFloat != NULL) {
+            free(tableID->tableFloat);
+            tableID->tableFloat = NULL;
+        }
+        if (tableID->splineFloat != NULL) {
+            free(tableID->splineFloat);
+            tableID->splineFloat = NULL;
+        }
         spline1DClose(&tableID->spline);
         free(tableID);
     }
 }
 
-double ModelicaStandardTables_CombiTable1D_getValue(void* _tableID, int iCol,
-                                                    double u) {
+static TABLE_ALWAYS_INLINE double combiTable1DValue(CombiTable1D* tableID,
+                                                    int iCol, double u,
+                                                    enum TableShape shape,
+                                                    enum Smoothness smoothness,
+                                                    enum Extrapolation extrapolation) {
     double y = 0.;
-    CombiTable1D* tableID = (CombiTable1D*)_tableID;
-    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
-        const double* table = tableID->table;
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
-
-        if (nRow == 1) {
-            /* Single row */
-            y = TABLE_ROW0(col);
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = ABSCISSA_STRIDE(tableID);
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = tableID->nCol - 1;
+    const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+
+    if (shape == SHAPE_SINGLE_ROW) {
+        /* Single row */
+        y = TABLE_VALUE(0, col);
+    }
+    else {
+        enum PointInterval extrapolate = IN_TABLE;
+        const double uMin = TABLE_ROW0(0);
+        const double uMax = TABLE_COL0(nRow - 1);
+        size_t last;
+
+        /* Periodic extrapolation */
+        if (extrapolation == PERIODIC) {
+            u = periodicShift(u, uMin, uMax);
+            last = findRowIndex(table, nRow, nCol, tableID->last, u);
+            tableID->last = last;
+        }
+        else if (u < uMin) {
+            extrapolate = LEFT;
+            last = 0;
+        }
+        else if (u > uMax) {
+            extrapolate = RIGHT;
+            last = nRow - 2;
         }
         else {
-            enum PointInterval extrapolate = IN_TABLE;
-            const double uMin = TABLE_ROW0(0);
-            const double uMax = TABLE_COL0(nRow - 1);
-            size_t last;
-
-            /* Periodic extrapolation */
-            if (tableID->extrapolation == PERIODIC) {
-                const double T = uMax - uMin;
+            last = findRowIndex(table, nRow, nCol, tableID->last, u);
+            tableID->last = last;
+        }
 
-                if (u < uMin) {
-                    do {
-                        u += T;
-                    } while (u < uMin);
-                }
-                else if (u > uMax) {
-                    do {
-                        u -= T;
-                    } while (u > uMax);
+        if (extrapolate == IN_TABLE) {
+            switch (smoothness) {
+                case LINEAR_SEGMENTS: {
+                    const double u0 = TABLE_COL0(last);
+                    const double u1 = TABLE_COL0(last + 1);
+                    const double y0 = TABLE_VALUE(last, col);
+                    const double y1 = TABLE_VALUE(last + 1, col);
+                    LINEAR_INV(u, u0, u1, tableID->invWidth[last], y0, y1)
+                    break;
                 }
-                last = findRowIndex(table, nRow, nCol, tableID->last, u);
-                tableID->last = last;
-            }
-            else if (u < uMin) {
-                extrapolate = LEFT;
-                last = 0;
-            }
-            else if (u > uMax) {
-                extrapolate = RIGHT;
-                last = nRow - 2;
-            }
-            else {
-                last = findRowIndex(table, nRow, nCol, tableID->last, u);
-                tableID->last = last;
-            }
 
-            if (extrapolate == IN_TABLE) {
-                switch (tableID->smoothness) {
-                    case LINEAR_SEGMENTS: {
-                        const double u0 = TABLE_COL0(last);
-                        const double u1 = TABLE_COL0(last + 1);
-                        const double y0 = TABLE(last, col);
-                        const double y1 = TABLE(last + 1, col);
-                        LINEAR(u, u0, u1, y0, y1)
-                        break;
+                case CONSTANT_SEGMENTS:
+                    if (u >= TABLE_COL0(last + 1)) {
+                        last += 1;
                     }
+                    y = TABLE_VALUE(last, col);
+                    break;
 
-                    case CONSTANT_SEGMENTS:
-                        if (u >= TABLE_COL0(last + 1)) {
-                            last += 1;
-                        }
-                        y = TABLE(last, col);
-                        break;
+                case AKIMA_C1:
+                case FRITSCH_BUTLAND_MONOTONE_C1:
+                case STEFFEN_MONOTONE_C1:
+                    MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                    if (NULL != tableID->spline ||
+                        NULL != tableID->splineFloat) {
+                        double cFloat[3];
+                        const double* c = spline1DCoefficients(
+                            tableID->spline, tableID->splineFloat,
+                            IDX(last, iCol - 1, tableID->nCols), cFloat);
+                        const double u0 = TABLE_COL0(last);
+                        const double v = u - u0;
+                        y = TABLE_VALUE(last, col); /* c[3] = y0 */
+                        y += ((c[0]*v + c[1])*v + c[2])*v;
+                    }
+                    break;
 
-                    case AKIMA_C1:
-                    case FRITSCH_BUTLAND_MONOTONE_C1:
-                    case STEFFEN_MONOTONE_C1:
-                        if (NULL != tableID->spline) {
-                            const double* c = tableID->spline[
-                                IDX(last, iCol - 1, tableID->nCols)];
+                default:
+                    ModelicaError("Unknown smoothness kind\n");
+                    return y;
+            }
+        }
+        else {
+            /* Extrapolation */
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+            switch (extrapolation) {
+                case LAST_TWO_POINTS:
+                    switch (smoothness) {
+                        case LINEAR_SEGMENTS:
+                        case CONSTANT_SEGMENTS: {
                             const double u0 = TABLE_COL0(last);
-                            const double v = u - u0;
-                            y = TABLE(last, col); /* c[3] = y0 */
-                            y += ((c[0]*v + c[1])*v + c[2])*v;
+                            const double u1 = TABLE_COL0(last + 1);
+                            const double y0 = TABLE_VALUE(last, col);
+                            const double y1 = TABLE_VALUE(last + 1, col);
+                            LINEAR_INV(u, u0, u1, tableID->invWidth[last],
+                                y0, y1)
+                            break;
                         }
-                        break;
 
-                    default:
-                        ModelicaError("Unknown smoothness kind\n");
-                        return y;
-                }
-            }
-            else {
-                /* Extrapolation */
-                switch (tableID->extrapolation) {
-                    case LAST_TWO_POINTS:
-                        switch (tableID->smoothness) {
-                            case LINEAR_SEGMENTS:
-                            case CONSTANT_SEGMENTS: {
+                        case AKIMA_C1:
+                        case FRITSCH_BUTLAND_MONOTONE_C1:
+                        case STEFFEN_MONOTONE_C1:
+                            MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                            if (NULL != tableID->spline ||
+                                NULL != tableID->splineFloat) {
                                 const double u0 = TABLE_COL0(last);
-                                const double u1 = TABLE_COL0(last + 1);
-                                const double y0 = TABLE(last, col);
-                                const double y1 = TABLE(last + 1, col);
-                                LINEAR(u, u0, u1, y0, y1)
-                                break;
-                            }
-
-                            case AKIMA_C1:
-                            case FRITSCH_BUTLAND_MONOTONE_C1:
-                            case STEFFEN_MONOTONE_C1:
-                                if (NULL != tableID->spline) {
-                                    const double u0 = TABLE_COL0(last);
-                                    const double* c = tableID->spline[
-                                        IDX(last, iCol - 1, tableID->nCols)];
-                                    if (extrapolate == LEFT) {
-                                        y = LINEAR_SLOPE(TABLE(last, col), c[2],
-                                            u - u0);
-                                    }
-                                    else /* if (extrapolate == RIGHT) */ {
-                                        const double u1 = TABLE_COL0(last + 1);
-                                        const double v = u1 - u0;
-                                        y = LINEAR_SLOPE(TABLE(last + 1, col),
-                                            (3*c[0]*v + 2*c[1])*v + c[2],
-                                            u - u1);
-                                    }
+                                double cFloat[3];
+                                const double* c = spline1DCoefficients(
+                                    tableID->spline, tableID->splineFloat,
+                                    IDX(last, iCol - 1, tableID->nCols), cFloat);
+                                if (extrapolate == LEFT) {
+                                    y = LINEAR_SLOPE(TABLE_VALUE(last, col), c[2],
+                                        u - u0);
                                 }
-                                break;
+                                else /* if (extrapolate == RIGHT) */ {
+                                    const double u1 = TABLE_COL0(last + 1);
+                                    const double v = u1 - u0;
+                                    y = LINEAR_SLOPE(TABLE_VALUE(last + 1, col),
+                                        (3*c[0]*v + 2*c[1])*v + c[2],
+                                        u - u1);
+                                }
+                            }
+                            break;
 
-                            default:
-                                ModelicaError("Unknown smoothness kind\n");
-                                return y;
-                        }
-                        break;
+                        default:
+                            ModelicaError("Unknown smoothness kind\n");
+                            return y;
+                    }
+                    break;
 
-                    case HOLD_LAST_POINT:
-                        y = (extrapolate == RIGHT) ? TABLE(nRow - 1, col) :
-                            TABLE_ROW0(col);
-                        break;
+                case HOLD_LAST_POINT:
+                    y = (extrapolate == RIGHT) ? TABLE_VALUE(nRow - 1, col) :
+                        TABLE_VALUE(0, col);
+                    break;
 
-                    case NO_EXTRAPOLATION:
-                        ModelicaError("Extrapolation error\n");
-                        return y;
+                case NO_EXTRAPOLATION:
+                    ModelicaError("Extrapolation error\n");
+                    return y;
 
-                    case PERIODIC:
-                        /* Should not be possible to get here */
-                        break;
+                case PERIODIC:
+                    /* Should not be possible to get here */
+                    break;
 
-                    default:
-                        ModelicaError("Unknown extrapolation kind\n");
-                        return y;
-                }
+                default:
+                    ModelicaError("Unknown extrapolation kind\n");
+                    return y;
             }
         }
     }
     return y;
 }
 
-double ModelicaStandardTables_CombiTable1D_getDerValue(void* _tableID, int iCol,
-                                                       double u, double der_u) {
+static TABLE_ALWAYS_INLINE double combiTable1DDerValue(CombiTable1D* tableID,
+                                                       int iCol, double u,
+                                                       double der_u,
+                                                       enum TableShape shape,
+                                                       enum Smoothness smoothness,
+                                                       enum Extrapolation extrapolation) {
     double der_y = 0.;
-    CombiTable1D* tableID = (CombiTable1D*)_tableID;
-    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
-        const double* table = tableID->table;
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = ABSCISSA_STRIDE(tableID);
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = tableID->nCol - 1;
+    const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+
+    if (shape != SHAPE_SINGLE_ROW) {
+        enum PointInterval extrapolate = IN_TABLE;
+        const double uMin = TABLE_ROW0(0);
+        const double uMax = TABLE_COL0(nRow - 1);
+        size_t last;
+
+        /* Periodic extrapolation */
+        if (extrapolation == PERIODIC) {
+            u = periodicShift(u, uMin, uMax);
+            last = findRowIndex(table, nRow, nCol, tableID->last, u);
+            tableID->last = last;
+        }
+        else if (u < uMin) {
+            extrapolate = LEFT;
+            last = 0;
+        }
+        else if (u > uMax) {
+            extrapolate = RIGHT;
+            last = nRow - 2;
+        }
+        else {
+            last = findRowIndex(table, nRow, nCol, tableID->last, u);
+            tableID->last = last;
+        }
 
-        if (nRow > 1) {
-            enum PointInterval extrapolate = IN_TABLE;
-            const double uMin = TABLE_ROW0(0);
-            const double uMax = TABLE_COL0(nRow - 1);
-            size_t last;
+        if (extrapolate == IN_TABLE) {
+            switch (smoothness) {
+                case LINEAR_SEGMENTS:
+                    der_y = DIV_WIDTH(TABLE_VALUE(last + 1, col) - TABLE_VALUE(last, col),
+                        TABLE_COL0(last), TABLE_COL0(last + 1),
+                        tableID->invWidth[last]);
+                    der_y *= der_u;
+                    break;
 
-            /* Periodic extrapolation */
-            if (tableID->extrapolation == PERIODIC) {
-                const double T = uMax - uMin;
+                case CONSTANT_SEGMENTS:
+                    break;
 
-                if (u < uMin) {
-                    do {
-                        u += T;
-                    } while (u < uMin);
-                }
-                else if (u > uMax) {
-                    do {
-                        u -= T;
-                    } while (u > uMax);
-                }
-                last = findRowIndex(table, nRow, nCol, tableID->last, u);
-                tableID->last = last;
-            }
-            else if (u < uMin) {
-                extrapolate = LEFT;
-                last = 0;
-            }
-            else if (u > uMax) {
-                extrapolate = RIGHT;
-                last = nRow - 2;
-            }
-            else {
-                last = findRowIndex(table, nRow, nCol, tableID->last, u);
-                tableID->last = last;
+                case AKIMA_C1:
+                case FRITSCH_BUTLAND_MONOTONE_C1:
+                case STEFFEN_MONOTONE_C1:
+                    MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                    if (NULL != tableID->spline ||
+                        NULL != tableID->splineFloat) {
+                        double cFloat[3];
+                        const double* c = spline1DCoefficients(
+                            tableID->spline, tableID->splineFloat,
+                            IDX(last, iCol - 1, tableID->nCols), cFloat);
+                        const double v = u - TABLE_COL0(last);
+                        der_y = (3*c[0]*v + 2*c[1])*v + c[2];
+                        der_y *= der_u;
+                    }
+                    break;
+
+                default:
+                    ModelicaError("Unknown smoothness kind\n");
+                    return der_y;
             }
+        }
+        else {
+            /* Extrapolation */
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+            switch (extrapolation) {
+                case LAST_TWO_POINTS:
+                    switch (smoothness) {
+                        case LINEAR_SEGMENTS:
+                        case  CONSTANT_SEGMENTS: {
+                            const double u0 = TABLE_COL0(last);
+                            const double u1 = TABLE_COL0(last + 1);
+                            der_y = DIV_WIDTH(TABLE_VALUE(last + 1, col) -
+                                TABLE_VALUE(last, col), u0, u1, tableID->invWidth[last]);
+                            break;
+                        }
 
-            if (extrapolate == IN_TABLE) {
-                switch (tableID->smoothness) {
-                    case LINEAR_SEGMENTS:
-                        der_y = (TABLE(last + 1, col) - TABLE(last, col))/
-                            (TABLE_COL0(last + 1) - TABLE_COL0(last));
-                        der_y *= der_u;
-                        break;
+                        case AKIMA_C1:
+                        case FRITSCH_BUTLAND_MONOTONE_C1:
+                        case STEFFEN_MONOTONE_C1:
+                            MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                            if (NULL != tableID->spline ||
+                                NULL != tableID->splineFloat) {
+                                double cFloat[3];
+                                const double* c = spline1DCoefficients(
+                                    tableID->spline, tableID->splineFloat,
+                                    IDX(last, iCol - 1, tableID->nCols), cFloat);
+                                if (extrapolate == LEFT) {
+                                    der_y = c[2];
+                                }
+                                else /* if (extrapolate == RIGHT) */ {
+                                    der_y = TABLE_COL0(last + 1) -
+                                        TABLE_COL0(last); /* = (t1 - t0) */
+                                    der_y = (3*c[0]*der_y + 2*c[1])*
+                                        der_y + c[2];
+                                }
+                            }
+                            break;
 
-                    case CONSTANT_SEGMENTS:
-                        break;
+                        default:
+                            ModelicaError("Unknown smoothness kind\n");
+                            return der_y;
+                    }
+                    der_y *= der_u;
+                    break;
 
-                    case AKIMA_C1:
-                    case FRITSCH_BUTLAND_MONOTONE_C1:
-                    case STEFFEN_MONOTONE_C1:
-                        if (NULL != tableID->spline) {
-                            const double* c = tableID->spline[
-                                IDX(last, iCol - 1, tableID->nCols)];
-                            const double v = u - TABLE_COL0(last);
-                            der_y = (3*c[0]*v + 2*c[1])*v + c[2];
-                            der_y *= der_u;
-                        }
-                        break;
+                case HOLD_LAST_POINT:
+                    break;
 
-                    default:
-                        ModelicaError("Unknown smoothness kind\n");
-                        return der_y;
-                }
+                case NO_EXTRAPOLATION:
+                    ModelicaError("Extrapolation error\n");
+                    return der_y;
+
+                case PERIODIC:
+                    /* Should not be possible to get here */
+                    break;
+
+                default:
+                    ModelicaError("Unknown extrapolation kind\n");
+                    return der_y;
             }
-            else {
-                /* Extrapolation */
-                switch (tableID->extrapolation) {
-                    case LAST_TWO_POINTS:
-                        switch (tableID->smoothness) {
-                            case LINEAR_SEGMENTS:
-                            case  CONSTANT_SEGMENTS: {
-                                const double u0 = TABLE_COL0(last);
-                                const double u1 = TABLE_COL0(last + 1);
-                                der_y = (TABLE(last + 1, col) - TABLE(last, col))/
-                                    (u1 - u0);
-                                break;
-                            }
+        }
+    }
+    return der_y;
+}
 
-                            case AKIMA_C1:
-                            case FRITSCH_BUTLAND_MONOTONE_C1:
-                            case STEFFEN_MONOTONE_C1:
-                                if (NULL != tableID->spline) {
-                                    const double* c = tableID->spline[
-                                        IDX(last, iCol - 1, tableID->nCols)];
-                                    if (extrapolate == LEFT) {
-                                        der_y = c[2];
-                                    }
-                                    else /* if (extrapolate == RIGHT) */ {
-                                        der_y = TABLE_COL0(last + 1) -
-                                            TABLE_COL0(last); /* = (t1 - t0) */
-                                        der_y = (3*c[0]*der_y + 2*c[1])*
-                                            der_y + c[2];
-                                    }
-                                }
-                                break;
+/* Evaluation kernels of CombiTable1D, see the kernels of CombiTimeTable */
+#define COMBITABLE1D_KERNELS(shape, smooth, extrap) \
+static double combiTable1DValue_##shape##_##smooth##_##extrap( \
+    CombiTable1D* tableID, int iCol, double u) { \
+    return combiTable1DValue(tableID, iCol, u, shape, smooth, extrap); \
+} \
+static double combiTable1DDerValue_##shape##_##smooth##_##extrap( \
+    CombiTable1D* tableID, int iCol, double u, double der_u) { \
+    return combiTable1DDerValue(tableID, iCol, u, der_u, shape, smooth, \
+        extrap); \
+} \
+static double combiTable1DValueAndDer_##shape##_##smooth##_##extrap( \
+    CombiTable1D* tableID, int iCol, double u, double* der_y) { \
+    const double y = combiTable1DValue(tableID, iCol, u, shape, smooth, \
+        extrap); \
+    *der_y = combiTable1DDerValue(tableID, iCol, u, 1., shape, smooth, \
+        extrap); \
+    return y; \
+}
 
-                            default:
-                                ModelicaError("Unknown smoothness kind\n");
-                                return der_y;
-                        }
-                        der_y *= der_u;
-                        break;
+#define COMBITABLE1D_KERNEL_ROW(prefix, smooth) { \
+    prefix##_SHAPE_GENERAL_##smooth##_HOLD_LAST_POINT, \
+    prefix##_SHAPE_GENERAL_##smooth##_LAST_TWO_POINTS, \
+    prefix##_SHAPE_GENERAL_##smooth##_PERIODIC, \
+    prefix##_SHAPE_GENERAL_##smooth##_NO_EXTRAPOLATION \
+}
 
-                    case HOLD_LAST_POINT:
-                        break;
+#define COMBITABLE1D_KERNELS_EXTRAPOLATION(smooth) \
+    COMBITABLE1D_KERNELS(SHAPE_GENERAL, smooth, HOLD_LAST_POINT) \
+    COMBITABLE1D_KERNELS(SHAPE_GENERAL, smooth, LAST_TWO_POINTS) \
+    COMBITABLE1D_KERNELS(SHAPE_GENERAL, smooth, PERIODIC) \
+    COMBITABLE1D_KERNELS(SHAPE_GENERAL, smooth, NO_EXTRAPOLATION)
+
+COMBITABLE1D_KERNELS_EXTRAPOLATION(LINEAR_SEGMENTS)
+COMBITABLE1D_KERNELS_EXTRAPOLATION(CONSTANT_SEGMENTS)
+COMBITABLE1D_KERNELS_EXTRAPOLATION(AKIMA_C1)
+COMBITABLE1D_KERNELS(SHAPE_SINGLE_ROW, LINEAR_SEGMENTS, HOLD_LAST_POINT)
+
+/* Fallback kernels for unknown smoothness or extrapolation kinds (which are
+   reported at evaluation time) */
+static double combiTable1DValue_generic(CombiTable1D* tableID, int iCol,
+                                        double u) {
+    return combiTable1DValue(tableID, iCol, u, tableID->nRow == 1 ?
+        SHAPE_SINGLE_ROW : SHAPE_GENERAL, tableID->smoothness,
+        tableID->extrapolation);
+}
 
-                    case NO_EXTRAPOLATION:
-                        ModelicaError("Extrapolation error\n");
-                        return der_y;
+static double combiTable1DDerValue_generic(CombiTable1D* tableID, int iCol,
+                                           double u, double der_u) {
+    return combiTable1DDerValue(tableID, iCol, u, der_u, tableID->nRow == 1 ?
+        SHAPE_SINGLE_ROW : SHAPE_GENERAL, tableID->smoothness,
+        tableID->extrapolation);
+}
 
-                    case PERIODIC:
-                        /* Should not be possible to get here */
-                        break;
+static double combiTable1DValueAndDer_generic(CombiTable1D* tableID, int iCol,
+                                              double u, double* der_y) {
+    const double y = combiTable1DValue_generic(tableID, iCol, u);
+    *der_y = combiTable1DDerValue_generic(tableID, iCol, u, 1.);
+    return y;
+}
 
-                    default:
-                        ModelicaError("Unknown extrapolation kind\n");
-                        return der_y;
+static void selectCombiTable1DKernels(CombiTable1D* tableID) {
+    static CombiTable1DValue const valueKernels[3][4] = {
+        COMBITABLE1D_KERNEL_ROW(combiTable1DValue, LINEAR_SEGMENTS),
+        COMBITABLE1D_KERNEL_ROW(combiTable1DValue, CONSTANT_SEGMENTS),
+        COMBITABLE1D_KERNEL_ROW(combiTable1DValue, AKIMA_C1)
+    };
+    static CombiTable1DDerValue const derValueKernels[3][4] = {
+        COMBITABLE1D_KERNEL_ROW(combiTable1DDerValue, LINEAR_SEGMENTS),
+        COMBITABLE1D_KERNEL_ROW(combiTable1DDerValue, CONSTANT_SEGMENTS),
+        COMBITABLE1D_KERNEL_ROW(combiTable1DDerValue, AKIMA_C1)
+    };
+    static CombiTable1DValueAndDer const valueAndDerKernels[3][4] = {
+        COMBITABLE1D_KERNEL_ROW(combiTable1DValueAndDer, LINEAR_SEGMENTS),
+        COMBITABLE1D_KERNEL_ROW(combiTable1DValueAndDer, CONSTANT_SEGMENTS),
+        COMBITABLE1D_KERNEL_ROW(combiTable1DValueAndDer, AKIMA_C1)
+    };
+    const int i = smoothnessKernelIndex(tableID->smoothness);
+    const int j = (int)tableID->extrapolation - (int)HOLD_LAST_POINT;
+
+    if (tableID->nRow == 1) {
+        tableID->getValue =
+            combiTable1DValue_SHAPE_SINGLE_ROW_LINEAR_SEGMENTS_HOLD_LAST_POINT;
+        tableID->getDerValue =
+            combiTable1DDerValue_SHAPE_SINGLE_ROW_LINEAR_SEGMENTS_HOLD_LAST_POINT;
+        tableID->getValueAndDer =
+            combiTable1DValueAndDer_SHAPE_SINGLE_ROW_LINEAR_SEGMENTS_HOLD_LAST_POINT;
+    }
+    else if (i >= 0 && j >= 0 && j < 4) {
+        tableID->getValue = valueKernels[i][j];
+        tableID->getDerValue = derValueKernels[i][j];
+        tableID->getValueAndDer = valueAndDerKernels[i][j];
+    }
+    else {
+        tableID->getValue = combiTable1DValue_generic;
+        tableID->getDerValue = combiTable1DDerValue_generic;
+        tableID->getValueAndDer = combiTable1DValueAndDer_generic;
+    }
+}
+
+double ModelicaStandardTables_CombiTable1D_getValue(void* _tableID, int iCol,
+                                                    double u) {
+    double y = 0.;
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTable1D_getValue,
+            y = tableID->getValue(tableID, iCol, u));
+    }
+    return y;
+}
+
+double ModelicaStandardTables_CombiTable1D_getDerValue(void* _tableID, int iCol,
+                                                       double u, double der_u) {
+    double der_y = 0.;
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTable1D_getDerValue,
+            der_y = tableID->getDerValue(tableID, iCol, u, der_u));
+    }
+    return der_y;
+}
+
+double ModelicaStandardTables_CombiTable1D_getValueAndDer(void* _tableID,
+                                                          int iCol, double u,
+                                                          double* der_y) {
+    double y = 0.;
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    *der_y = 0.;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTable1D_getValueAndDer,
+            y = tableID->getValueAndDer(tableID, iCol, u, der_y));
+    }
+    return y;
+}
+
+static double combiTable1DInverseValue(CombiTable1D* tableID, int iCol,
+                                       double y, double* dy_du) {
+    double u = 0.;
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = ABSCISSA_STRIDE(tableID);
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = tableID->nCol - 1;
+    const size_t col = (size_t)tableID->cols[iCol - 1] - 1;
+    const int isSpline = NULL != tableID->spline || NULL != tableID->splineFloat;
+    int sign;
+    double y0, y1;
+    size_t last;
+
+    *dy_du = 0.;
+    if (tableID->monotony == NULL) {
+        tableID->monotony = monotony1DInit(tableID);
+        if (tableID->monotony == NULL) {
+            ModelicaError("Memory allocation error\n");
+            return u;
+        }
+    }
+    sign = tableID->monotony[iCol - 1];
+    if (sign == 0) {
+        if (nRow < 2 || tableID->smoothness == CONSTANT_SEGMENTS) {
+            ModelicaFormatError("Inverse interpolation error: The "
+                "interpolation of table column %d is not invertible, since it "
+                "is constant or piecewise constant\n", (int)col + 1);
+        }
+        else {
+            ModelicaFormatError("Inverse interpolation error: The "
+                "interpolation of table column %d is not strictly monotonic%s"
+                "\n", (int)col + 1, tableID->smoothness == AKIMA_C1 ?
+                " (the Akima interpolation of strictly monotonic values can "
+                "overshoot, use smoothness = MonotoneContinuousDerivative1 or "
+                "MonotoneContinuousDerivative2 instead)" : "");
+        }
+        return u;
+    }
+
+    y0 = TABLE_VALUE(0, col);
+    y1 = TABLE_VALUE(nRow - 1, col);
+    if (sign*y < sign*y0 || sign*y > sign*y1) {
+        /* Extrapolation */
+        const int isLeft = sign*y < sign*y0;
+        MODELICA_PROFILE_COUNT(extrapolations, 1);
+        if (tableID->extrapolation != LAST_TWO_POINTS) {
+            ModelicaFormatError("Extrapolation error: The value %lf is not "
+                "in the range [%lf, %lf] of table column %d, such that the "
+                "inverse is not defined for this kind of extrapolation\n", y,
+                sign > 0 ? y0 : y1, sign > 0 ? y1 : y0, (int)col + 1);
+            return u;
+        }
+        last = isLeft ? 0 : nRow - 2;
+        {
+            const double u0 = TABLE_COL0(last);
+            const double u1 = TABLE_COL0(last + 1);
+            if (isSpline) {
+                double cFloat[3];
+                const double* c = spline1DCoefficients(tableID->spline,
+                    tableID->splineFloat, IDX(last, iCol - 1, tableID->nCols),
+                    cFloat);
+                if (isLeft) {
+                    *dy_du = c[2];
+                }
+                else {
+                    const double v = u1 - u0;
+                    *dy_du = (3*c[0]*v + 2*c[1])*v + c[2];
                 }
             }
+            else {
+                *dy_du = DIV_WIDTH(TABLE_VALUE(last + 1, col) -
+                    TABLE_VALUE(last, col), u0, u1, tableID->invWidth[last]);
+            }
+            if (sign*(*dy_du) <= 0.) {
+                ModelicaFormatError("Extrapolation error: The extrapolation "
+                    "of table column %d is not strictly monotonic, such that "
+                    "the inverse of %lf is not defined\n", (int)col + 1, y);
+                return u;
+            }
+            u = isLeft ? u0 + (y - y0)/(*dy_du) : u1 + (y - y1)/(*dy_du);
         }
     }
-    return der_y;
+    else {
+        double u0, u1;
+        last = findInverseRowIndex(tableID, col, sign, tableID->lastInverse, y);
+        tableID->lastInverse = last;
+        u0 = TABLE_COL0(last);
+        u1 = TABLE_COL0(last + 1);
+        y0 = TABLE_VALUE(last, col);
+        y1 = TABLE_VALUE(last + 1, col);
+        if (isSpline) {
+            double cFloat[3];
+            const double* c = spline1DCoefficients(tableID->spline,
+                tableID->splineFloat, IDX(last, iCol - 1, tableID->nCols),
+                cFloat);
+            const double v = spline1DInverse(c, u1 - u0, y - y0);
+            MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+            u = u0 + v;
+            *dy_du = (3*c[0]*v + 2*c[1])*v + c[2];
+        }
+        else {
+            *dy_du = (y1 - y0)/(u1 - u0);
+            u = u0 + (y - y0)*(u1 - u0)/(y1 - y0);
+        }
+        /* Rounding */
+        if (u < u0) {
+            u = u0;
+        }
+        else if (u > u1) {
+            u = u1;
+        }
+    }
+    return u;
+}
+
+double ModelicaStandardTables_CombiTable1D_getInverseValue(void* _tableID,
+                                                           int iCol, double y) {
+    MODELICA_PROFILE_BEGIN();
+    double u = 0.;
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        double dy_du;
+        u = combiTable1DInverseValue(tableID, iCol, y, &dy_du);
+    }
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_getInverseValue);
+    return u;
+}
+
+double ModelicaStandardTables_CombiTable1D_getInverseDerValue(void* _tableID,
+                                                              int iCol,
+                                                              double y,
+                                                              double der_y) {
+    MODELICA_PROFILE_BEGIN();
+    double der_u = 0.;
+    CombiTable1D* tableID = (CombiTable1D*)_tableID;
+    if (tableID != NULL && tableID->table != NULL && tableID->cols != NULL) {
+        double dy_du;
+        const double u = combiTable1DInverseValue(tableID, iCol, y, &dy_du);
+        if (dy_du == 0.) {
+            ModelicaFormatError("Inverse interpolation error: The derivative "
+                "of the inverse of table column %d is infinite at u = %lf\n",
+                tableID->cols[iCol - 1], u);
+            MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_getInverseDerValue);
+            return der_u;
+        }
+        der_u = der_y/dy_du;
+    }
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_getInverseDerValue);
+    return der_u;
 }
 
 double ModelicaStandardTables_CombiTable1D_minimumAbscissa(void* _tableID) {
@@ -2245,7 +3925,7 @@ double ModelicaStandardTables_CombiTable1D_maximumAbscissa(void* _tableID) {
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     if (NULL != tableID && NULL != tableID->table) {
         const double* table = tableID->table;
-        const size_t nCol = tableID->nCol;
+        const size_t nCol = ABSCISSA_STRIDE(tableID);
         uMax = TABLE_COL0(tableID->nRow - 1);
     }
     return uMax;
@@ -2253,22 +3933,49 @@ double ModelicaStandardTables_CombiTable1D_maximumAbscissa(void* _tableID) {
 
 double ModelicaStandardTables_CombiTable1D_read(void* _tableID, int force,
                                                 int verbose) {
+    MODELICA_PROFILE_BEGIN();
 #if !defined(NO_FILE_SYSTEM)
     CombiTable1D* tableID = (CombiTable1D*)_tableID;
     if (tableID != NULL && tableID->source == TABLESOURCE_FILE) {
-        if (force || tableID->table == NULL) {
-#if !defined(TABLE_SHARE)
-            if (tableID->table != NULL) {
-                free(tableID->table);
-            }
-#endif
+        if (force && tableID->table != NULL &&
+            ModelicaIO_isTableFileUnchanged(tableID->fileName,
+            &tableID->fileState)) {
+            /* Table file is unchanged since the last read */
+        }
+        else if (force || tableID->table == NULL) {
+            ModelicaIOLoadEvent event;
+            const unsigned long long start = ModelicaProfile_now();
+            unsigned long long splineStart;
+            double* prevTable = tableID->table;
+            /* The previous table can only be continued by the rows appended
+               to the table file if it holds all values in double precision */
+            const int isContinuable = tableID->tableFloat == NULL;
+            size_t nRowKept;
+            /* Release the single precision storage of the previous table */
+            free(tableID->tableFloat);
+            tableID->tableFloat = NULL;
+            free(tableID->splineFloat);
+            tableID->splineFloat = NULL;
+            /* The monotonicity is determined anew by the next inverse
+               evaluation */
+            free(tableID->monotony);
+            tableID->monotony = NULL;
+            tableID->lastInverse = 0;
             tableID->table = readTable(tableID->tableName,
                 tableID->fileName, &tableID->nRow, &tableID->nCol,
-                verbose, force);
+                tableID->columns, tableID->nColumns,
+                isContinuable ? (const double*)prevTable : NULL,
+                &tableID->fileState, verbose, force, &event);
+#if !defined(TABLE_SHARE)
+            free(prevTable);
+#endif
+            nRowKept = tableID->fileState.nRowKept;
             if (tableID->table == NULL) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_read);
                 return 0.; /* Error */
             }
             if (!isValidCombiTable1D((const CombiTable1D*)tableID)) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_read);
                 return 0.; /* Error */
             }
             if (tableID->nRow <= 2) {
@@ -2278,7 +3985,37 @@ double ModelicaStandardTables_CombiTable1D_read(void* _tableID, int force,
                     tableID->smoothness = LINEAR_SEGMENTS;
                 }
             }
-            if (tableID->smoothness == AKIMA_C1) {
+            if (nRowKept > 0 && tableID->invWidth != NULL) {
+                /* Extension of the inverse interval widths */
+                tableID->invWidth = invWidthExtend(tableID->invWidth,
+                    (const double*)tableID->table, nRowKept, tableID->nRow,
+                    tableID->nCol);
+            }
+            else {
+                /* Reinitialization of the inverse interval widths */
+                free(tableID->invWidth);
+                tableID->invWidth = invWidthInit(
+                    (const double*)tableID->table, tableID->nRow,
+                    tableID->nCol);
+            }
+            if (tableID->invWidth == NULL) {
+                ModelicaError("Memory allocation error\n");
+                return 0.; /* Error */
+            }
+            selectCombiTable1DKernels(tableID);
+            splineStart = ModelicaProfile_now();
+            if (nRowKept > 0 && tableID->spline != NULL) {
+                /* Extension of the cubic Hermite spline coefficients */
+                tableID->spline = spline1DExtend(tableID->spline,
+                    tableID->smoothness, (const double*)tableID->table,
+                    nRowKept, tableID->nRow, tableID->nCol,
+                    (const int*)tableID->cols, tableID->nCols);
+                if (tableID->spline == NULL) {
+                    ModelicaError("Memory allocation error\n");
+                    return 0.; /* Error */
+                }
+            }
+            else if (tableID->smoothness == AKIMA_C1) {
                 /* Reinitialization of the cubic Hermite spline coefficients */
                 spline1DClose(&tableID->spline);
                 tableID->spline = akimaSpline1DInit(
@@ -2311,9 +4048,19 @@ double ModelicaStandardTables_CombiTable1D_read(void* _tableID, int force,
                     return 0.; /* Error */
                 }
             }
+            event.splineTime = 1e-9*(double)(ModelicaProfile_now() - splineStart);
+            if (tableID->storage == STORAGE_FLOAT) {
+                compactTable1D(&tableID->table, tableID->nRow, tableID->nCol,
+                    (const int*)tableID->cols, tableID->nCols,
+                    tableID->source, &tableID->tableFloat, &tableID->spline,
+                    &tableID->splineFloat);
+            }
+            event.totalTime = 1e-9*(double)(ModelicaProfile_now() - start);
+            ModelicaIO_reportLoadEvent(&event);
         }
     }
 #endif
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable1D_read);
     return 1.; /* Success */
 }
 
@@ -2321,8 +4068,22 @@ void* ModelicaStandardTables_CombiTable2D_init(_In_z_ const char* tableName,
                                                _In_z_ const char* fileName,
                                                _In_ double* table, size_t nRow,
                                                size_t nColumn, int smoothness) {
+    return ModelicaStandardTables_CombiTable2D_init2(tableName,
+        fileName, table, nRow, nColumn, smoothness, STORAGE_DEFAULT);
+}
+
+void* ModelicaStandardTables_CombiTable2D_init2(_In_z_ const char* tableName,
+                                                _In_z_ const char* fileName,
+                                                _In_ double* table, size_t nRow,
+                                                size_t nColumn, int smoothness,
+                                                int storage) {
+    MODELICA_PROFILE_BEGIN();
     CombiTable2D* tableID = (CombiTable2D*)calloc(1, sizeof(CombiTable2D));
     if (tableID != NULL) {
+#if defined(TABLE_CONTENT_SHARE)
+        unsigned long long key = 0;
+#endif
+        tableID->storage = tableStorage(storage);
         tableID->smoothness = (enum Smoothness)smoothness;
         tableID->source = getTableSource(tableName, fileName);
 
@@ -2359,7 +4120,27 @@ void* ModelicaStandardTables_CombiTable2D_init(_In_z_ const char* tableName,
                         tableID->nRow <= 3 && tableID->nCol <= 3) {
                         tableID->smoothness = LINEAR_SEGMENTS;
                     }
-                    if (tableID->smoothness == AKIMA_C1) {
+#if defined(TABLE_CONTENT_SHARE)
+                    key = contentHash(table, tableID->nRow, tableID->nCol,
+                        NULL, 0, 2, tableID->smoothness, tableID->storage);
+                    tableID->share = contentShareAcquire(key, table,
+                        tableID->nRow, tableID->nCol, NULL, 0, 2,
+                        tableID->smoothness, tableID->storage);
+                    if (tableID->share != NULL) {
+                        /* Share hit -> Use table values, spline coefficients
+                           and inverse interval widths of the content share */
+                        tableID->table = tableID->share->table;
+                        tableID->tableFloat = tableID->share->tableFloat;
+                        tableID->tableU2 = tableID->share->tableU2;
+                        tableID->spline = tableID->share->spline2D;
+                        tableID->splineFloat = tableID->share->spline2DFloat;
+                        tableID->invWidth1 = tableID->share->invWidth1;
+                        tableID->invWidth2 = tableID->share->invWidth2;
+                        break;
+                    }
+#endif
+                    if (tableID->smoothness == AKIMA_C1 &&
+                        (!isAkimaGrid2D(tableID) || 0 == akimaCacheBudget())) {
                         /* Initialization of the Akima-spline coefficients */
                         tableID->spline = spline2DInit(table, tableID->nRow,
                             tableID->nCol);
@@ -2420,7 +4201,9 @@ void* ModelicaStandardTables_CombiTable2D_init(_In_z_ const char* tableName,
                             tableID->nRow <= 3 && tableID->nCol <= 3) {
                             tableID->smoothness = LINEAR_SEGMENTS;
                         }
-                        if (tableID->smoothness == AKIMA_C1) {
+                        if (tableID->smoothness == AKIMA_C1 &&
+                            (!isAkimaGrid2D(tableID) ||
+                            0 == akimaCacheBudget())) {
                             /* Initialization of the Akima-spline coefficients */
                             tableID->spline = spline2DInit(tableID->table,
                                 tableID->nRow, tableID->nCol);
@@ -2447,26 +4230,90 @@ void* ModelicaStandardTables_CombiTable2D_init(_In_z_ const char* tableName,
                 ModelicaError("Table source error\n");
                 return NULL;
         }
+        if (tableID->table != NULL && tableID->share == NULL) {
+            tableID->invWidth1 = invWidthInit(
+                (const double*)&tableID->table[tableID->nCol],
+                tableID->nRow - 1, tableID->nCol);
+            tableID->invWidth2 = invWidthInit(
+                (const double*)&tableID->table[1], tableID->nCol - 1, 1);
+            if (tableID->invWidth1 == NULL || tableID->invWidth2 == NULL) {
+                ModelicaStandardTables_CombiTable2D_close(tableID);
+                ModelicaError("Memory allocation error\n");
+                return NULL;
+            }
+            if (tableID->storage == STORAGE_FLOAT &&
+                (tableID->smoothness != AKIMA_C1 || NULL != tableID->spline)) {
+                /* The table values of on-demand calculated Akima spline
+                   coefficients are kept in double precision */
+                compactTable2D(&tableID->table, tableID->nRow, tableID->nCol,
+                    tableID->source, &tableID->tableFloat, &tableID->tableU2,
+                    &tableID->spline, &tableID->splineFloat);
+            }
+#if defined(TABLE_CONTENT_SHARE)
+            if (tableID->source == TABLESOURCE_MODEL) {
+                /* Share miss -> Insert new content share */
+                ContentShare* share = contentShareNew(key, tableID->nRow,
+                    tableID->nCol, NULL, 0, 2, tableID->smoothness,
+                    tableID->storage);
+                if (share != NULL) {
+                    share->table = tableID->table;
+                    share->tableFloat = tableID->tableFloat;
+                    share->tableU2 = tableID->tableU2;
+                    share->spline2D = tableID->spline;
+                    share->spline2DFloat = tableID->splineFloat;
+                    share->invWidth1 = tableID->invWidth1;
+                    share->invWidth2 = tableID->invWidth2;
+                    tableID->share = contentShareInsert(share);
+                }
+            }
+#endif
+        }
+        if (tableID->table != NULL && tableID->smoothness == AKIMA_C1 &&
+            NULL == tableID->spline && NULL == tableID->splineFloat &&
+            isAkimaGrid2D(tableID)) {
+            /* Akima-spline coefficients calculated on demand */
+            tableID->akima = akimaGridNew(tableID->table, tableID->nRow,
+                tableID->nCol);
+            if (tableID->akima == NULL) {
+                ModelicaStandardTables_CombiTable2D_close(tableID);
+                ModelicaError("Memory allocation error\n");
+                return NULL;
+            }
+        }
+        selectCombiTable2DKernels(tableID);
     }
     else {
         ModelicaError("Memory allocation error\n");
     }
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable2D_init2);
     return (void*)tableID;
 }
 
 void ModelicaStandardTables_CombiTable2D_close(void* _tableID) {
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     if (tableID != NULL) {
+#if defined(TABLE_CONTENT_SHARE)
+        if (tableID->share != NULL) {
+            /* Table values, spline coefficients and inverse interval widths
+               are owned by the content share */
+            contentShareRelease(tableID->share);
+            tableID->share = NULL;
+            tableID->table = NULL;
+            tableID->tableFloat = NULL;
+            tableID->tableU2 = NULL;
+            tableID->spline = NULL;
+            tableID->splineFloat = NULL;
+            tableID->invWidth1 = NULL;
+            tableID->invWidth2 = NULL;
+        }
+#endif
         if (tableID->table != NULL && tableID->source == TABLESOURCE_FILE) {
 #if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
             if (tableID->tableName != NULL && tableID->fileName != NULL) {
-                char* key = malloc((strlen(tableID->tableName) +
-                    strlen(tableID->fileName) + 2)*sizeof(char));
+                char* key = tableShareKey(tableID->tableName,
+                    tableID->fileName, NULL, 0);
                 if (key != NULL) {
                     TableShare *iter;
-                    strcpy(key, tableID->tableName);
-                    strcat(key, "|");
-                    strcat(key, tableID->fileName);
                     MUTEX_LOCK();
                     HASH_FIND_STR(tableShare, key, iter);
                     if (iter != NULL) {
@@ -2507,1751 +4354,4057 @@ void ModelicaStandardTables_CombiTable2D_close(void* _tableID) {
             free(tableID->fileName);
             tableID->fileName = NULL;
         }
+        if (tableID->invWidth1 != NULL) {
+            free(tableID->invWidth1);
+            tableID->invWidth1 = NULL;
+        }
+        if (tableID->invWidth2 != NULL) {
+            free(tableID->invWidth2);
+            tableID->invWidth2 = NULL;
+        }
+        if (tableID->tableFloat != NULL) {
+            free(tableID->tableFloat);
+            tableID->tableFloat = NULL;
+        }
+        if (tableID->tableU2 != NULL) {
+            free(tableID->tableU2);
+            tableID->tableU2 = NULL;
+        }
+        if (tableID->splineFloat != NULL) {
+            free(tableID->splineFloat);
+            tableID->splineFloat = NULL;
+        }
         spline2DClose(&tableID->spline);
+        akimaGridClose(&tableID->akima);
         free(tableID);
     }
 }
 
 double ModelicaStandardTables_CombiTable2D_read(void* _tableID, int force,
                                                 int verbose) {
+    MODELICA_PROFILE_BEGIN();
 #if !defined(NO_FILE_SYSTEM)
     CombiTable2D* tableID = (CombiTable2D*)_tableID;
     if (tableID != NULL && tableID->source == TABLESOURCE_FILE) {
-        if (force || tableID->table == NULL) {
+        if (force && tableID->table != NULL &&
+            ModelicaIO_isTableFileUnchanged(tableID->fileName,
+            &tableID->fileState)) {
+            /* Table file is unchanged since the last read */
+        }
+        else if (force || tableID->table == NULL) {
+            ModelicaIOLoadEvent event;
+            const unsigned long long start = ModelicaProfile_now();
+            unsigned long long splineStart;
+            double* prevTable = tableID->table;
+            /* The previous table can only be continued by the rows appended
+               to the table file if it holds all values in double precision */
+            const int isContinuable = tableID->tableFloat == NULL;
+            size_t nRowKept;
+            /* Release the single precision storage of the previous table */
+            free(tableID->tableFloat);
+            tableID->tableFloat = NULL;
+            free(tableID->tableU2);
+            tableID->tableU2 = NULL;
+            free(tableID->splineFloat);
+            tableID->splineFloat = NULL;
+            tableID->table = readTable(tableID->tableName,
+                tableID->fileName, &tableID->nRow, &tableID->nCol, NULL, 0,
+                isContinuable ? (const double*)prevTable : NULL,
+                &tableID->fileState, verbose, force, &event);
+            /* The on-demand calculated Akima-spline coefficients refer to
+               the previous table */
+            akimaGridClose(&tableID->akima);
 #if !defined(TABLE_SHARE)
-            if (tableID->table != NULL) {
-                free(tableID->table);
-            }
+            free(prevTable);
 #endif
-            tableID->table = readTable(tableID->tableName,
-                tableID->fileName, &tableID->nRow, &tableID->nCol,
-                verbose, force);
+            nRowKept = tableID->fileState.nRowKept;
             if (tableID->table == NULL) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable2D_read);
                 return 0.; /* Error */
             }
             if (!isValidCombiTable2D((const CombiTable2D*)tableID)) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable2D_read);
                 return 0.; /* Error */
             }
             if (tableID->smoothness == AKIMA_C1 &&
                 tableID->nRow <= 3 && tableID->nCol <= 3) {
                 tableID->smoothness = LINEAR_SEGMENTS;
             }
-            if (tableID->smoothness == AKIMA_C1) {
-                /* Reinitialization of the Akima-spline coefficients */
-                spline2DClose(&tableID->spline);
-                tableID->spline = spline2DInit(tableID->table, tableID->nRow,
-                    tableID->nCol);
-                if (tableID->spline == NULL) {
-                    ModelicaError("Memory allocation error\n");
-                    return 0.; /* Error */
+            if (nRowKept > 1 && tableID->invWidth1 != NULL &&
+                tableID->invWidth2 != NULL) {
+                /* Extension of the inverse row interval widths (the first
+                   row is unchanged) */
+                tableID->invWidth1 = invWidthExtend(tableID->invWidth1,
+                    (const double*)&tableID->table[tableID->nCol],
+                    nRowKept - 1, tableID->nRow - 1, tableID->nCol);
+            }
+            else {
+                /* Reinitialization of the inverse interval widths */
+                free(tableID->invWidth1);
+                free(tableID->invWidth2);
+                tableID->invWidth1 = invWidthInit(
+                    (const double*)&tableID->table[tableID->nCol],
+                    tableID->nRow - 1, tableID->nCol);
+                tableID->invWidth2 = invWidthInit(
+                    (const double*)&tableID->table[1], tableID->nCol - 1, 1);
+            }
+            if (tableID->invWidth1 == NULL || tableID->invWidth2 == NULL) {
+                ModelicaError("Memory allocation error\n");
+                return 0.; /* Error */
+            }
+            selectCombiTable2DKernels(tableID);
+            splineStart = ModelicaProfile_now();
+            if (tableID->smoothness == AKIMA_C1) {
+                /* Reinitialization of the Akima-spline coefficients */
+                spline2DClose(&tableID->spline);
+                if (isAkimaGrid2D(tableID) && akimaCacheBudget() > 0) {
+                    tableID->akima = akimaGridNew(tableID->table,
+                        tableID->nRow, tableID->nCol);
+                    if (tableID->akima == NULL) {
+                        ModelicaError("Memory allocation error\n");
+                        return 0.; /* Error */
+                    }
+                }
+                else {
+                    tableID->spline = spline2DInit(tableID->table,
+                        tableID->nRow, tableID->nCol);
+                    if (tableID->spline == NULL) {
+                        ModelicaError("Memory allocation error\n");
+                        return 0.; /* Error */
+                    }
                 }
             }
+            event.splineTime = 1e-9*(double)(ModelicaProfile_now() - splineStart);
+            if (tableID->storage == STORAGE_FLOAT && NULL == tableID->akima) {
+                compactTable2D(&tableID->table, tableID->nRow, tableID->nCol,
+                    tableID->source, &tableID->tableFloat, &tableID->tableU2,
+                    &tableID->spline, &tableID->splineFloat);
+            }
+            event.totalTime = 1e-9*(double)(ModelicaProfile_now() - start);
+            ModelicaIO_reportLoadEvent(&event);
         }
     }
 #endif
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTable2D_read);
     return 1.; /* Success */
 }
 
-double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
-                                                    double u2) {
+static TABLE_ALWAYS_INLINE double combiTable2DValue(CombiTable2D* tableID,
+                                                    double u1, double u2,
+                                                    enum TableShape shape,
+                                                    enum Smoothness smoothness) {
     double y = 0;
-    CombiTable2D* tableID = (CombiTable2D*)_tableID;
-    if (NULL != tableID && NULL != tableID->table) {
-        const double* table = tableID->table;
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = tableID->nCol;
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = nCol - 1;
+    const size_t strideU1 = ABSCISSA_STRIDE(tableID);
+    const double* tableU2 = NULL != tableFloat ? tableID->tableU2 :
+        table;
+
+    if (shape == SHAPE_SINGLE_VALUE) {
+        /* Single row */
+        y = TABLE2D_VALUE(1, 1);
+    }
+    else if (shape == SHAPE_SINGLE_ROW) {
+        enum PointInterval extrapolate2 = IN_TABLE;
+        size_t last2;
 
-        if (nRow == 2 && nCol == 2) {
-            /* Single row */
-            y = TABLE(1, 1);
+        if (u2 < TABLE_U2(1)) {
+            extrapolate2 = LEFT;
+            last2 = 0;
+        }
+        else if (u2 > TABLE_U2(nCol - 1)) {
+            extrapolate2 = RIGHT;
+            last2 = nCol - 3;
+        }
+        else {
+            last2 = findColIndex(&TABLE_U2(1), nCol - 1,
+                tableID->last2, u2);
+            tableID->last2 = last2;
         }
-        else if (nRow == 2 && nCol > 2) {
-            enum PointInterval extrapolate2 = IN_TABLE;
-            size_t last2;
 
-            if (u2 < TABLE_ROW0(1)) {
-                extrapolate2 = LEFT;
-                last2 = 0;
-            }
-            else if (u2 > TABLE_ROW0(nCol - 1)) {
-                extrapolate2 = RIGHT;
-                last2 = nCol - 3;
-            }
-            else {
-                last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                    tableID->last2, u2);
-                tableID->last2 = last2;
-            }
+        if (extrapolate2 != IN_TABLE) {
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+        }
 
-            switch (tableID->smoothness) {
-                case CONSTANT_SEGMENTS:
-                    if (extrapolate2 == IN_TABLE) {
-                        if (u2 >= TABLE_ROW0(last2 + 2)) {
-                            last2 += 1;
-                        }
-                        y = TABLE(1, last2 + 1);
-                        break;
+        switch (smoothness) {
+            case CONSTANT_SEGMENTS:
+                if (extrapolate2 == IN_TABLE) {
+                    if (u2 >= TABLE_U2(last2 + 2)) {
+                        last2 += 1;
                     }
-                    /* Fall through: linear extrapolation */
-                case LINEAR_SEGMENTS: {
-                    const double u20 = TABLE_ROW0(last2 + 1);
-                    const double u21 = TABLE_ROW0(last2 + 2);
-                    const double y0 = TABLE(1, last2 + 1);
-                    const double y1 = TABLE(1, last2 + 2);
-                    LINEAR(u2, u20, u21, y0, y1)
+                    y = TABLE2D_VALUE(1, last2 + 1);
                     break;
                 }
+                /* Fall through: linear extrapolation */
+            case LINEAR_SEGMENTS: {
+                const double u20 = TABLE_U2(last2 + 1);
+                const double u21 = TABLE_U2(last2 + 2);
+                const double y0 = TABLE2D_VALUE(1, last2 + 1);
+                const double y1 = TABLE2D_VALUE(1, last2 + 2);
+                LINEAR_INV(u2, u20, u21, tableID->invWidth2[last2], y0, y1)
+                break;
+            }
 
-                case AKIMA_C1:
-                    if (NULL != tableID->spline) {
-                        const double* c = tableID->spline[last2];
-                        const double u20 = TABLE_ROW0(last2 + 1);
-                        if (extrapolate2 == IN_TABLE) {
-                            u2 -= u20;
-                            y = TABLE(1, last2 + 1); /* c[3] = y0 */
-                            y += ((c[0]*u2 + c[1])*u2 + c[2])*u2;
-                        }
-                        else if (extrapolate2 == LEFT) {
-                            y = LINEAR_SLOPE(TABLE(1, last2 + 1), c[2],
-                                u2 - u20);
-                        }
-                        else /* if (extrapolate2 == RIGHT) */ {
-                            const double u21 = TABLE_ROW0(last2 + 2);
-                            const double v2 = u21 - u20;
-                            y = LINEAR_SLOPE(TABLE(1, last2 + 2), (3*c[0]*v2 +
-                                2*c[1])*v2 + c[2], u2 - u21);
-                        }
+            case AKIMA_C1:
+                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                if (NULL != tableID->spline ||
+                    NULL != tableID->splineFloat) {
+                    double cFloat[15];
+                    const double* c = spline2DCoefficients(
+                        tableID->spline, tableID->splineFloat, last2,
+                        cFloat);
+                    const double u20 = TABLE_U2(last2 + 1);
+                    if (extrapolate2 == IN_TABLE) {
+                        u2 -= u20;
+                        y = TABLE2D_VALUE(1, last2 + 1); /* c[3] = y0 */
+                        y += ((c[0]*u2 + c[1])*u2 + c[2])*u2;
                     }
-                    break;
+                    else if (extrapolate2 == LEFT) {
+                        y = LINEAR_SLOPE(TABLE2D_VALUE(1, last2 + 1), c[2],
+                            u2 - u20);
+                    }
+                    else /* if (extrapolate2 == RIGHT) */ {
+                        const double u21 = TABLE_U2(last2 + 2);
+                        const double v2 = u21 - u20;
+                        y = LINEAR_SLOPE(TABLE2D_VALUE(1, last2 + 2), (3*c[0]*v2 +
+                            2*c[1])*v2 + c[2], u2 - u21);
+                    }
+                }
+                break;
 
-                case FRITSCH_BUTLAND_MONOTONE_C1:
-                case STEFFEN_MONOTONE_C1:
-                    ModelicaError("Bivariate monotone C1 interpolation is "
-                        "not implemented\n");
-                    return y;
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                ModelicaError("Bivariate monotone C1 interpolation is "
+                    "not implemented\n");
+                return y;
 
-                default:
-                    ModelicaError("Unknown smoothness kind\n");
-                    return y;
-            }
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return y;
+        }
+    }
+    else if (shape == SHAPE_SINGLE_COLUMN) {
+        enum PointInterval extrapolate1 = IN_TABLE;
+        size_t last1;
+
+        if (u1 < TABLE_U1(1)) {
+            extrapolate1 = LEFT;
+            last1 = 0;
+        }
+        else if (u1 > TABLE_U1(nRow - 1)) {
+            extrapolate1 = RIGHT;
+            last1 = nRow - 3;
+        }
+        else {
+            last1 = findRowIndex(&TABLE_U1(1), nRow - 1, strideU1,
+                tableID->last1, u1);
+            tableID->last1 = last1;
         }
-        else if (nRow > 2 && nCol == 2) {
-            enum PointInterval extrapolate1 = IN_TABLE;
-            size_t last1;
 
-            if (u1 < TABLE_COL0(1)) {
-                extrapolate1 = LEFT;
-                last1 = 0;
-            }
-            else if (u1 > TABLE_COL0(nRow - 1)) {
-                extrapolate1 = RIGHT;
-                last1 = nRow - 3;
-            }
-            else {
-                last1 = findRowIndex(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1);
-                tableID->last1 = last1;
-            }
+        if (extrapolate1 != IN_TABLE) {
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+        }
 
-            switch (tableID->smoothness) {
-                case CONSTANT_SEGMENTS:
-                    if (extrapolate1 == IN_TABLE) {
-                        if (u1 >= TABLE_COL0(last1 + 2)) {
-                            last1 += 1;
-                        }
-                        y = TABLE(last1 + 1, 1);
-                        break;
+        switch (smoothness) {
+            case CONSTANT_SEGMENTS:
+                if (extrapolate1 == IN_TABLE) {
+                    if (u1 >= TABLE_U1(last1 + 2)) {
+                        last1 += 1;
                     }
-                    /* Fall through: linear extrapolation */
-                case LINEAR_SEGMENTS: {
-                    const double u10 = TABLE_COL0(last1 + 1);
-                    const double u11 = TABLE_COL0(last1 + 2);
-                    const double y0 = TABLE(last1 + 1, 1);
-                    const double y1 = TABLE(last1 + 2, 1);
-                    LINEAR(u1, u10, u11, y0, y1)
+                    y = TABLE2D_VALUE(last1 + 1, 1);
                     break;
                 }
+                /* Fall through: linear extrapolation */
+            case LINEAR_SEGMENTS: {
+                const double u10 = TABLE_U1(last1 + 1);
+                const double u11 = TABLE_U1(last1 + 2);
+                const double y0 = TABLE2D_VALUE(last1 + 1, 1);
+                const double y1 = TABLE2D_VALUE(last1 + 2, 1);
+                LINEAR_INV(u1, u10, u11, tableID->invWidth1[last1], y0, y1)
+                break;
+            }
 
-                case AKIMA_C1:
-                    if (NULL != tableID->spline) {
-                        const double* c = tableID->spline[last1];
-                        const double u10 = TABLE_COL0(last1 + 1);
-                        if (extrapolate1 == IN_TABLE) {
-                            u1 -= u10;
-                            y = TABLE(last1 + 1, 1); /* c[3] = y0 */
-                            y += ((c[0]*u1 + c[1])*u1 + c[2])*u1;
-                        }
-                        else if (extrapolate1 == LEFT) {
-                            y = LINEAR_SLOPE(TABLE(last1 + 1, 1), c[2],
-                                u1 - u10);
-                        }
-                        else /* if (extrapolate1 == RIGHT) */ {
-                            const double u11 = TABLE_COL0(last1 + 2);
-                            const double v1 = u11 - u10;
-                            y = LINEAR_SLOPE(TABLE(last1 + 2, 1), (3*c[0]*v1 +
-                                2*c[1])*v1 + c[2], u1 - u11);
-                        }
+            case AKIMA_C1:
+                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                if (NULL != tableID->spline ||
+                    NULL != tableID->splineFloat) {
+                    double cFloat[15];
+                    const double* c = spline2DCoefficients(
+                        tableID->spline, tableID->splineFloat, last1,
+                        cFloat);
+                    const double u10 = TABLE_U1(last1 + 1);
+                    if (extrapolate1 == IN_TABLE) {
+                        u1 -= u10;
+                        y = TABLE2D_VALUE(last1 + 1, 1); /* c[3] = y0 */
+                        y += ((c[0]*u1 + c[1])*u1 + c[2])*u1;
                     }
-                    break;
+                    else if (extrapolate1 == LEFT) {
+                        y = LINEAR_SLOPE(TABLE2D_VALUE(last1 + 1, 1), c[2],
+                            u1 - u10);
+                    }
+                    else /* if (extrapolate1 == RIGHT) */ {
+                        const double u11 = TABLE_U1(last1 + 2);
+                        const double v1 = u11 - u10;
+                        y = LINEAR_SLOPE(TABLE2D_VALUE(last1 + 2, 1), (3*c[0]*v1 +
+                            2*c[1])*v1 + c[2], u1 - u11);
+                    }
+                }
+                break;
 
-                case FRITSCH_BUTLAND_MONOTONE_C1:
-                case STEFFEN_MONOTONE_C1:
-                    ModelicaError("Bivariate monotone C1 interpolation is "
-                        "not implemented\n");
-                    return y;
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                ModelicaError("Bivariate monotone C1 interpolation is "
+                    "not implemented\n");
+                return y;
 
-                default:
-                    ModelicaError("Unknown smoothness kind\n");
-                    return y;
-            }
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return y;
+        }
+    }
+    else if (shape == SHAPE_GENERAL) {
+        enum PointInterval extrapolate1 = IN_TABLE;
+        enum PointInterval extrapolate2 = IN_TABLE;
+        size_t last1, last2;
+
+        if (u1 < TABLE_U1(1)) {
+            extrapolate1 = LEFT;
+            last1 = 0;
+        }
+        else if (u1 > TABLE_U1(nRow - 1)) {
+            extrapolate1 = RIGHT;
+            last1 = nRow - 3;
+        }
+        else {
+            last1 = findRowIndex(&TABLE_U1(1), nRow - 1, strideU1,
+                tableID->last1, u1);
+            tableID->last1 = last1;
         }
-        else if (nRow > 2 && nCol > 2) {
-            enum PointInterval extrapolate1 = IN_TABLE;
-            enum PointInterval extrapolate2 = IN_TABLE;
-            size_t last1, last2;
 
-            if (u1 < TABLE_COL0(1)) {
-                extrapolate1 = LEFT;
-                last1 = 0;
-            }
-            else if (u1 > TABLE_COL0(nRow - 1)) {
-                extrapolate1 = RIGHT;
-                last1 = nRow - 3;
-            }
-            else {
-                last1 = findRowIndex(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1);
-                tableID->last1 = last1;
-            }
+        if (u2 < TABLE_U2(1)) {
+            extrapolate2 = LEFT;
+            last2 = 0;
+        }
+        else if (u2 > TABLE_U2(nCol - 1)) {
+            extrapolate2 = RIGHT;
+            last2 = nCol - 3;
+        }
+        else {
+            last2 = findColIndex(&TABLE_U2(1), nCol - 1,
+                tableID->last2, u2);
+            tableID->last2 = last2;
+        }
 
-            if (u2 < TABLE_ROW0(1)) {
-                extrapolate2 = LEFT;
-                last2 = 0;
-            }
-            else if (u2 > TABLE_ROW0(nCol - 1)) {
-                extrapolate2 = RIGHT;
-                last2 = nCol - 3;
-            }
-            else {
-                last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                    tableID->last2, u2);
-                tableID->last2 = last2;
-            }
+        if (extrapolate1 != IN_TABLE || extrapolate2 != IN_TABLE) {
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+        }
 
-            switch (tableID->smoothness) {
-                case  CONSTANT_SEGMENTS:
-                    if (extrapolate1 == IN_TABLE && extrapolate2 == IN_TABLE) {
-                        if (u1 >= TABLE_COL0(last1 + 2)) {
-                            last1 += 1;
-                        }
-                        if (u2 >= TABLE_ROW0(last2 + 2)) {
-                            last2 += 1;
-                        }
-                        y = TABLE(last1 + 1, last2 + 1);
-                        break;
+        switch (smoothness) {
+            case  CONSTANT_SEGMENTS:
+                if (extrapolate1 == IN_TABLE && extrapolate2 == IN_TABLE) {
+                    if (u1 >= TABLE_U1(last1 + 2)) {
+                        last1 += 1;
                     }
-                    /* Fall through: bilinear extrapolation */
-                case LINEAR_SEGMENTS: {
-                    const double u10 = TABLE_COL0(last1 + 1);
-                    const double u11 = TABLE_COL0(last1 + 2);
-                    const double u20 = TABLE_ROW0(last2 + 1);
-                    const double u21 = TABLE_ROW0(last2 + 2);
-                    const double y00 = TABLE(last1 + 1, last2 + 1);
-                    const double y01 = TABLE(last1 + 1, last2 + 2);
-                    const double y10 = TABLE(last1 + 2, last2 + 1);
-                    const double y11 = TABLE(last1 + 2, last2 + 2);
-                    BILINEAR(u1, u2,
-                        u10, u11, u20, u21, y00, y01, y10, y11)
+                    if (u2 >= TABLE_U2(last2 + 2)) {
+                        last2 += 1;
+                    }
+                    y = TABLE2D_VALUE(last1 + 1, last2 + 1);
                     break;
                 }
+                /* Fall through: bilinear extrapolation */
+            case LINEAR_SEGMENTS: {
+                const double u10 = TABLE_U1(last1 + 1);
+                const double u11 = TABLE_U1(last1 + 2);
+                const double u20 = TABLE_U2(last2 + 1);
+                const double u21 = TABLE_U2(last2 + 2);
+                const double y00 = TABLE2D_VALUE(last1 + 1, last2 + 1);
+                const double y01 = TABLE2D_VALUE(last1 + 1, last2 + 2);
+                const double y10 = TABLE2D_VALUE(last1 + 2, last2 + 1);
+                const double y11 = TABLE2D_VALUE(last1 + 2, last2 + 2);
+                BILINEAR_INV(u1, u2, u10, u11, u20, u21,
+                    tableID->invWidth1[last1], tableID->invWidth2[last2],
+                    y00, y01, y10, y11)
+                break;
+            }
 
-                case AKIMA_C1:
-                    if (NULL != tableID->spline) {
-                        const double* c = tableID->spline[
-                            IDX(last1, last2, nCol - 2)];
-                        if (extrapolate1 == IN_TABLE) {
-                            u1 -= TABLE_COL0(last1 + 1);
-                            y = TABLE(last1 + 1, last2 + 1); /* c[15] = y00 */
-                            if (extrapolate2 == IN_TABLE) {
-                                double p1, p2, p3;
-                                u2 -= TABLE_ROW0(last2 + 1);
-                                p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
-                                y += ((p1*u1 + p2)*u1 + p3)*u1;
-                            }
-                            else if (extrapolate2 == LEFT) {
-                                double der_y2;
-                                u2 -= TABLE_ROW0(1);
-                                der_y2 = ((c[2]*u1 + c[6])*u1 + c[10])*u1 + c[14];
-                                y += ((c[3]*u1 + c[7])*u1 + c[11])*u1;
-                                y += der_y2*u2;
-                            }
-                            else /* if (extrapolate2 == RIGHT) */ {
-                                const double v2 = TABLE_ROW0(nCol - 1) -
-                                    TABLE_ROW0(nCol - 2);
-                                double p1, p2, p3;
-                                double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                double der_y2;
-                                u2 -= TABLE_ROW0(nCol - 1);
-                                p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
-                                p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
-                                p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
-                                dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
-                                dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
-                                dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
-                                dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
-                                der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
-                                y += ((c[12]*v2 + c[13])*v2 + c[14])*v2; /* p4 */
-                                y += ((p1*u1 + p2)*u1 + p3)*u1;
-                                y += der_y2*u2;
-                            }
+            case AKIMA_C1:
+                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                if (NULL != tableID->spline ||
+                    NULL != tableID->splineFloat ||
+                    NULL != tableID->akima) {
+                    double cFloat[15];
+                    const double* c = NULL != tableID->akima ?
+                        akimaGridCoefficients(tableID->akima, last1, last2) :
+                        spline2DCoefficients(tableID->spline,
+                        tableID->splineFloat, IDX(last1, last2, nCol - 2),
+                        cFloat);
+                    if (extrapolate1 == IN_TABLE) {
+                        u1 -= TABLE_U1(last1 + 1);
+                        y = TABLE2D_VALUE(last1 + 1, last2 + 1); /* c[15] = y00 */
+                        if (extrapolate2 == IN_TABLE) {
+                            double p1, p2, p3;
+                            u2 -= TABLE_U2(last2 + 1);
+                            p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
+                            p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
+                            p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
+                            y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
+                            y += ((p1*u1 + p2)*u1 + p3)*u1;
                         }
-                        else if (extrapolate1 == LEFT) {
-                            u1 -= TABLE_COL0(1);
-                            if (extrapolate2 == IN_TABLE) {
-                                double der_y1;
-                                u2 -= TABLE_ROW0(last2 + 1);
-                                der_y1 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                y = TABLE(last1 + 1, last2 + 1); /* c[15] = y00 */
-                                y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
-                                y += der_y1*u1;
-                            }
-                            else if (extrapolate2 == LEFT) {
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(1);
-                                der_y1 = c[11];
-                                der_y2 = c[14];
-                                der_y12 = c[10];
-                                y = TABLE(1, 1);
-                                y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
-                            }
-                            else /* if (extrapolate2 == RIGHT) */ {
-                                const double v2 = TABLE_ROW0(nCol - 1) -
-                                    TABLE_ROW0(nCol - 2);
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(nCol - 1);
-                                der_y1 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
-                                der_y2 =(3*c[12]*v2 + 2*c[13])*v2 + c[14];
-                                der_y12 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
-                                y = TABLE(1, nCol - 1);
-                                y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
-                            }
+                        else if (extrapolate2 == LEFT) {
+                            double der_y2;
+                            u2 -= TABLE_U2(1);
+                            der_y2 = ((c[2]*u1 + c[6])*u1 + c[10])*u1 + c[14];
+                            y += ((c[3]*u1 + c[7])*u1 + c[11])*u1;
+                            y += der_y2*u2;
                         }
-                        else /* if (extrapolate1 == RIGHT) */ {
-                            const double v1 = TABLE_COL0(nRow - 1) -
-                                TABLE_COL0(nRow - 2);
-                            u1 -= TABLE_COL0(nRow - 1);
-                            if (extrapolate2 == IN_TABLE) {
-                                double p1, p2, p3;
-                                double der_y1;
-                                u2 -= TABLE_ROW0(last2 + 1);
-                                p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
-                                y = TABLE(last1 + 1, last2 + 1); /* c[15] = y00 */
-                                y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
-                                y += ((p1*v1 + p2)*v1 + p3)*v1;
-                                y += der_y1*u1;
-                            }
-                            else if (extrapolate2 == LEFT) {
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(1);
-                                der_y1 = (3*c[3]*v1 + 2*c[7])*v1 + c[11];
-                                der_y2 = ((c[2]*v1 + c[6])*v1 + c[10])*v1 + c[14];
-                                der_y12 = (3*c[2]*v1 + 2*c[6])*v1 + c[10];
-                                y = TABLE(nRow - 1, 1);
-                                y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
-                            }
-                            else /* if (extrapolate2 == RIGHT) */ {
-                                const double v2 = TABLE_ROW0(nCol - 1) -
-                                    TABLE_ROW0(nCol - 2);
-                                double p1, p2, p3;
-                                double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(nCol - 1);
-                                p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
-                                p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
-                                p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
-                                dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
-                                dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
-                                dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
-                                dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
-                                der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
-                                der_y2 = ((dp1_u2*v1 + dp2_u2)*v1 + dp3_u2)*v1 + dp4_u2;
-                                der_y12 = (3*dp1_u2*v1 + 2*dp2_u2)*v1 + dp3_u2;
-                                y = TABLE(nRow - 1, nCol - 1);
-                                y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
-                            }
+                        else /* if (extrapolate2 == RIGHT) */ {
+                            const double v2 = TABLE_U2(nCol - 1) -
+                                TABLE_U2(nCol - 2);
+                            double p1, p2, p3;
+                            double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                            double der_y2;
+                            u2 -= TABLE_U2(nCol - 1);
+                            p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
+                            p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
+                            p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
+                            dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
+                            dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
+                            dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
+                            dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
+                            der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
+                            y += ((c[12]*v2 + c[13])*v2 + c[14])*v2; /* p4 */
+                            y += ((p1*u1 + p2)*u1 + p3)*u1;
+                            y += der_y2*u2;
                         }
                     }
-                    break;
+                    else if (extrapolate1 == LEFT) {
+                        u1 -= TABLE_U1(1);
+                        if (extrapolate2 == IN_TABLE) {
+                            double der_y1;
+                            u2 -= TABLE_U2(last2 + 1);
+                            der_y1 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
+                            y = TABLE2D_VALUE(last1 + 1, last2 + 1); /* c[15] = y00 */
+                            y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
+                            y += der_y1*u1;
+                        }
+                        else if (extrapolate2 == LEFT) {
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(1);
+                            der_y1 = c[11];
+                            der_y2 = c[14];
+                            der_y12 = c[10];
+                            y = TABLE2D_VALUE(1, 1);
+                            y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
+                        }
+                        else /* if (extrapolate2 == RIGHT) */ {
+                            const double v2 = TABLE_U2(nCol - 1) -
+                                TABLE_U2(nCol - 2);
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(nCol - 1);
+                            der_y1 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
+                            der_y2 =(3*c[12]*v2 + 2*c[13])*v2 + c[14];
+                            der_y12 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
+                            y = TABLE2D_VALUE(1, nCol - 1);
+                            y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
+                        }
+                    }
+                    else /* if (extrapolate1 == RIGHT) */ {
+                        const double v1 = TABLE_U1(nRow - 1) -
+                            TABLE_U1(nRow - 2);
+                        u1 -= TABLE_U1(nRow - 1);
+                        if (extrapolate2 == IN_TABLE) {
+                            double p1, p2, p3;
+                            double der_y1;
+                            u2 -= TABLE_U2(last2 + 1);
+                            p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
+                            p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
+                            p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
+                            der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
+                            y = TABLE2D_VALUE(last1 + 1, last2 + 1); /* c[15] = y00 */
+                            y += ((c[12]*u2 + c[13])*u2 + c[14])*u2; /* p4 */
+                            y += ((p1*v1 + p2)*v1 + p3)*v1;
+                            y += der_y1*u1;
+                        }
+                        else if (extrapolate2 == LEFT) {
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(1);
+                            der_y1 = (3*c[3]*v1 + 2*c[7])*v1 + c[11];
+                            der_y2 = ((c[2]*v1 + c[6])*v1 + c[10])*v1 + c[14];
+                            der_y12 = (3*c[2]*v1 + 2*c[6])*v1 + c[10];
+                            y = TABLE2D_VALUE(nRow - 1, 1);
+                            y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
+                        }
+                        else /* if (extrapolate2 == RIGHT) */ {
+                            const double v2 = TABLE_U2(nCol - 1) -
+                                TABLE_U2(nCol - 2);
+                            double p1, p2, p3;
+                            double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(nCol - 1);
+                            p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
+                            p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
+                            p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
+                            dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
+                            dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
+                            dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
+                            dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
+                            der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
+                            der_y2 = ((dp1_u2*v1 + dp2_u2)*v1 + dp3_u2)*v1 + dp4_u2;
+                            der_y12 = (3*dp1_u2*v1 + 2*dp2_u2)*v1 + dp3_u2;
+                            y = TABLE2D_VALUE(nRow - 1, nCol - 1);
+                            y += der_y1*u1 + der_y2*u2 + der_y12*u1*u2;
+                        }
+                    }
+                }
+                break;
 
-                case FRITSCH_BUTLAND_MONOTONE_C1:
-                case STEFFEN_MONOTONE_C1:
-                    ModelicaError("Bivariate monotone C1 interpolation is "
-                        "not implemented\n");
-                    return y;
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                ModelicaError("Bivariate monotone C1 interpolation is "
+                    "not implemented\n");
+                return y;
 
-                default:
-                    ModelicaError("Unknown smoothness kind\n");
-                    return y;
-            }
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return y;
         }
     }
     return y;
 }
 
-double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1,
-                                                       double u2, double der_u1,
-                                                       double der_u2) {
+static TABLE_ALWAYS_INLINE double combiTable2DDerValue(CombiTable2D* tableID,
+                                                       double u1, double u2,
+                                                       double der_u1,
+                                                       double der_u2,
+                                                       enum TableShape shape,
+                                                       enum Smoothness smoothness) {
     double der_y = 0;
-    CombiTable2D* tableID = (CombiTable2D*)_tableID;
-    if (NULL != tableID && NULL != tableID->table) {
-        const double* table = tableID->table;
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = tableID->nCol;
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = nCol - 1;
+    const size_t strideU1 = ABSCISSA_STRIDE(tableID);
+    const double* tableU2 = NULL != tableFloat ? tableID->tableU2 :
+        table;
+
+    if (shape == SHAPE_SINGLE_VALUE) {
+    }
+    else if (shape == SHAPE_SINGLE_ROW) {
+        enum PointInterval extrapolate2 = IN_TABLE;
+        size_t last2;
 
-        if (nRow == 2 && nCol == 2) {
+        if (u2 < TABLE_U2(1)) {
+            extrapolate2 = LEFT;
+            last2 = 0;
+        }
+        else if (u2 > TABLE_U2(nCol - 1)) {
+            extrapolate2 = RIGHT;
+            last2 = nCol - 3;
+        }
+        else {
+            last2 = findColIndex(&TABLE_U2(1), nCol - 1,
+                tableID->last2, u2);
+            tableID->last2 = last2;
         }
-        else if (nRow == 2 && nCol > 2) {
-            enum PointInterval extrapolate2 = IN_TABLE;
-            size_t last2;
 
-            if (u2 < TABLE_ROW0(1)) {
-                extrapolate2 = LEFT;
-                last2 = 0;
-            }
-            else if (u2 > TABLE_ROW0(nCol - 1)) {
-                extrapolate2 = RIGHT;
-                last2 = nCol - 3;
-            }
-            else {
-                last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                    tableID->last2, u2);
-                tableID->last2 = last2;
+        if (extrapolate2 != IN_TABLE) {
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+        }
+
+        switch (smoothness) {
+            case CONSTANT_SEGMENTS:
+                if (extrapolate2 == IN_TABLE) {
+                    break;
+                }
+                /* Fall through: linear extrapolation */
+            case LINEAR_SEGMENTS: {
+                der_y = DIV_WIDTH(TABLE2D_VALUE(1, last2 + 2) - TABLE2D_VALUE(1, last2 + 1),
+                    TABLE_U2(last2 + 1), TABLE_U2(last2 + 2),
+                    tableID->invWidth2[last2]);
+                der_y *= der_u2;
+                break;
             }
 
-            switch (tableID->smoothness) {
-                case CONSTANT_SEGMENTS:
+            case AKIMA_C1:
+                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                if (NULL != tableID->spline ||
+                    NULL != tableID->splineFloat) {
+                    double cFloat[15];
+                    const double* c = spline2DCoefficients(
+                        tableID->spline, tableID->splineFloat, last2,
+                        cFloat);
+                    const double u20 = TABLE_U2(last2 + 1);
                     if (extrapolate2 == IN_TABLE) {
-                        break;
+                        u2 -= u20;
+                        der_y = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
+                    }
+                    else if (extrapolate2 == LEFT) {
+                        der_y = c[2];
+                    }
+                    else /* if (extrapolate2 == RIGHT) */ {
+                        const double u21 = TABLE_U2(last2 + 2);
+                        der_y = u21 - u20;
+                        der_y = (3*c[0]*der_y + 2*c[1])*der_y + c[2];
                     }
-                    /* Fall through: linear extrapolation */
-                case LINEAR_SEGMENTS: {
-                    der_y = (TABLE(1, last2 + 2) - TABLE(1, last2 + 1))/
-                        (TABLE_ROW0(last2 + 2) - TABLE_ROW0(last2 + 1));
                     der_y *= der_u2;
-                    break;
                 }
+                break;
 
-                case AKIMA_C1:
-                    if (NULL != tableID->spline) {
-                        const double* c = tableID->spline[last2];
-                        const double u20 = TABLE_ROW0(last2 + 1);
-                        if (extrapolate2 == IN_TABLE) {
-                            u2 -= u20;
-                            der_y = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
-                        }
-                        else if (extrapolate2 == LEFT) {
-                            der_y = c[2];
-                        }
-                        else /* if (extrapolate2 == RIGHT) */ {
-                            const double u21 = TABLE_ROW0(last2 + 2);
-                            der_y = u21 - u20;
-                            der_y = (3*c[0]*der_y + 2*c[1])*der_y + c[2];
-                        }
-                        der_y *= der_u2;
-                    }
-                    break;
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                ModelicaError("Bivariate monotone C1 interpolation is "
+                    "not implemented\n");
+                return der_y;
 
-                case FRITSCH_BUTLAND_MONOTONE_C1:
-                case STEFFEN_MONOTONE_C1:
-                    ModelicaError("Bivariate monotone C1 interpolation is "
-                        "not implemented\n");
-                    return der_y;
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return der_y;
+        }
+    }
+    else if (shape == SHAPE_SINGLE_COLUMN) {
+        enum PointInterval extrapolate1 = IN_TABLE;
+        size_t last1;
 
-                default:
-                    ModelicaError("Unknown smoothness kind\n");
-                    return der_y;
-            }
+        if (u1 < TABLE_U1(1)) {
+            extrapolate1 = LEFT;
+            last1 = 0;
+        }
+        else if (u1 > TABLE_U1(nRow - 1)) {
+            extrapolate1 = RIGHT;
+            last1 = nRow - 3;
+        }
+        else {
+            last1 = findRowIndex(&TABLE_U1(1), nRow - 1, strideU1,
+                tableID->last1, u1);
+            tableID->last1 = last1;
         }
-        else if (nRow > 2 && nCol == 2) {
-            enum PointInterval extrapolate1 = IN_TABLE;
-            size_t last1;
 
-            if (u1 < TABLE_COL0(1)) {
-                extrapolate1 = LEFT;
-                last1 = 0;
-            }
-            else if (u1 > TABLE_COL0(nRow - 1)) {
-                extrapolate1 = RIGHT;
-                last1 = nRow - 3;
-            }
-            else {
-                last1 = findRowIndex(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1);
-                tableID->last1 = last1;
+        if (extrapolate1 != IN_TABLE) {
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+        }
+
+        switch (smoothness) {
+            case CONSTANT_SEGMENTS:
+                if (extrapolate1 == IN_TABLE) {
+                    break;
+                }
+                /* Fall through: linear extrapolation */
+            case LINEAR_SEGMENTS: {
+                der_y = DIV_WIDTH(TABLE2D_VALUE(last1 + 2, 1) - TABLE2D_VALUE(last1 + 1, 1),
+                    TABLE_U1(last1 + 1), TABLE_U1(last1 + 2),
+                    tableID->invWidth1[last1]);
+                der_y *= der_u1;
+                break;
             }
 
-            switch (tableID->smoothness) {
-                case CONSTANT_SEGMENTS:
+            case AKIMA_C1:
+                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                if (NULL != tableID->spline ||
+                    NULL != tableID->splineFloat) {
+                    double cFloat[15];
+                    const double* c = spline2DCoefficients(
+                        tableID->spline, tableID->splineFloat, last1,
+                        cFloat);
+                    const double u10 = TABLE_U1(last1 + 1);
                     if (extrapolate1 == IN_TABLE) {
-                        break;
+                        u1 -= u10;
+                        der_y = (3*c[0]*u1 + 2*c[1])*u1 + c[2];
+                    }
+                    else if (extrapolate1 == LEFT) {
+                        der_y = c[2];
+                    }
+                    else /* if (extrapolate1 == RIGHT) */ {
+                        const double u11 = TABLE_U1(last1 + 2);
+                        der_y = u11 - u10;
+                        der_y = (3*c[0]*der_y + 2*c[1])*der_y + c[2];
                     }
-                    /* Fall through: linear extrapolation */
-                case LINEAR_SEGMENTS: {
-                    der_y = (TABLE(last1 + 2, 1) - TABLE(last1 + 1, 1))/
-                        (TABLE_COL0(last1 + 2) - TABLE_COL0(last1 + 1));
                     der_y *= der_u1;
-                    break;
                 }
+                break;
 
-                case AKIMA_C1:
-                    if (NULL != tableID->spline) {
-                        const double* c = tableID->spline[last1];
-                        const double u10 = TABLE_COL0(last1 + 1);
-                        if (extrapolate1 == IN_TABLE) {
-                            u1 -= u10;
-                            der_y = (3*c[0]*u1 + 2*c[1])*u1 + c[2];
-                        }
-                        else if (extrapolate1 == LEFT) {
-                            der_y = c[2];
-                        }
-                        else /* if (extrapolate1 == RIGHT) */ {
-                            const double u11 = TABLE_COL0(last1 + 2);
-                            der_y = u11 - u10;
-                            der_y = (3*c[0]*der_y + 2*c[1])*der_y + c[2];
-                        }
-                        der_y *= der_u1;
-                    }
-                    break;
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                ModelicaError("Bivariate monotone C1 interpolation is "
+                    "not implemented\n");
+                return der_y;
 
-                case FRITSCH_BUTLAND_MONOTONE_C1:
-                case STEFFEN_MONOTONE_C1:
-                    ModelicaError("Bivariate monotone C1 interpolation is "
-                        "not implemented\n");
-                    return der_y;
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return der_y;
+        }
+    }
+    else if (shape == SHAPE_GENERAL) {
+        enum PointInterval extrapolate1 = IN_TABLE;
+        enum PointInterval extrapolate2 = IN_TABLE;
+        size_t last1, last2;
+
+        if (u1 < TABLE_U1(1)) {
+            extrapolate1 = LEFT;
+            last1 = 0;
+        }
+        else if (u1 > TABLE_U1(nRow - 1)) {
+            extrapolate1 = RIGHT;
+            last1 = nRow - 3;
+        }
+        else {
+            last1 = findRowIndex(&TABLE_U1(1), nRow - 1, strideU1,
+                tableID->last1, u1);
+            tableID->last1 = last1;
+        }
 
-                default:
-                    ModelicaError("Unknown smoothness kind\n");
-                    return der_y;
-            }
+        if (u2 < TABLE_U2(1)) {
+            extrapolate2 = LEFT;
+            last2 = 0;
+        }
+        else if (u2 > TABLE_U2(nCol - 1)) {
+            extrapolate2 = RIGHT;
+            last2 = nCol - 3;
+        }
+        else {
+            last2 = findColIndex(&TABLE_U2(1), nCol - 1,
+                tableID->last2, u2);
+            tableID->last2 = last2;
         }
-        else if (nRow > 2 && nCol > 2) {
-            enum PointInterval extrapolate1 = IN_TABLE;
-            enum PointInterval extrapolate2 = IN_TABLE;
-            size_t last1, last2;
 
-            if (u1 < TABLE_COL0(1)) {
-                extrapolate1 = LEFT;
-                last1 = 0;
-            }
-            else if (u1 > TABLE_COL0(nRow - 1)) {
-                extrapolate1 = RIGHT;
-                last1 = nRow - 3;
-            }
-            else {
-                last1 = findRowIndex(&TABLE(1, 0), nRow - 1, nCol,
-                    tableID->last1, u1);
-                tableID->last1 = last1;
-            }
+        if (extrapolate1 != IN_TABLE || extrapolate2 != IN_TABLE) {
+            MODELICA_PROFILE_COUNT(extrapolations, 1);
+        }
 
-            if (u2 < TABLE_ROW0(1)) {
-                extrapolate2 = LEFT;
-                last2 = 0;
-            }
-            else if (u2 > TABLE_ROW0(nCol - 1)) {
-                extrapolate2 = RIGHT;
-                last2 = nCol - 3;
-            }
-            else {
-                last2 = findColIndex(&TABLE(0, 1), nCol - 1,
-                    tableID->last2, u2);
-                tableID->last2 = last2;
-            }
-
-            switch (tableID->smoothness) {
-                case CONSTANT_SEGMENTS:
-                    if (extrapolate1 == IN_TABLE && extrapolate2 == IN_TABLE) {
-                        break;
-                    }
-                    /* Fall through: bilinear extrapolation */
-                case LINEAR_SEGMENTS: {
-                    const double u10 = TABLE_COL0(last1 + 1);
-                    const double u11 = TABLE_COL0(last1 + 2);
-                    const double u20 = TABLE_ROW0(last2 + 1);
-                    const double u21 = TABLE_ROW0(last2 + 2);
-                    const double y00 = TABLE(last1 + 1, last2 + 1);
-                    const double y01 = TABLE(last1 + 1, last2 + 2);
-                    const double y10 = TABLE(last1 + 2, last2 + 1);
-                    const double y11 = TABLE(last1 + 2, last2 + 2);
-                    der_y = (u21*(y10 - y00) + u20*(y01 - y11) +
-                        u2*(y00 - y01 - y10 + y11))*der_u1;
-                    der_y += (u11*(y01 - y00) + u10*(y10 - y11) +
-                        u1*(y00 - y01 - y10 + y11))*der_u2;
-                    der_y /= (u10 - u11);
-                    der_y /= (u20 - u21);
+        switch (smoothness) {
+            case CONSTANT_SEGMENTS:
+                if (extrapolate1 == IN_TABLE && extrapolate2 == IN_TABLE) {
                     break;
                 }
+                /* Fall through: bilinear extrapolation */
+            case LINEAR_SEGMENTS: {
+                const double u10 = TABLE_U1(last1 + 1);
+                const double u11 = TABLE_U1(last1 + 2);
+                const double u20 = TABLE_U2(last2 + 1);
+                const double u21 = TABLE_U2(last2 + 2);
+                const double y00 = TABLE2D_VALUE(last1 + 1, last2 + 1);
+                const double y01 = TABLE2D_VALUE(last1 + 1, last2 + 2);
+                const double y10 = TABLE2D_VALUE(last1 + 2, last2 + 1);
+                const double y11 = TABLE2D_VALUE(last1 + 2, last2 + 2);
+                der_y = (u21*(y10 - y00) + u20*(y01 - y11) +
+                    u2*(y00 - y01 - y10 + y11))*der_u1;
+                der_y += (u11*(y01 - y00) + u10*(y10 - y11) +
+                    u1*(y00 - y01 - y10 + y11))*der_u2;
+#if defined(TABLE_EXACT_DIVISION)
+                der_y /= (u10 - u11);
+                der_y /= (u20 - u21);
+#else
+                der_y *= tableID->invWidth1[last1]*tableID->invWidth2[last2];
+#endif
+                break;
+            }
 
-                case AKIMA_C1:
-                    if (NULL != tableID->spline) {
-                        const double* c = tableID->spline[
-                            IDX(last1, last2, nCol - 2)];
-                        if (extrapolate1 == IN_TABLE) {
+            case AKIMA_C1:
+                MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+                if (NULL != tableID->spline ||
+                    NULL != tableID->splineFloat ||
+                    NULL != tableID->akima) {
+                    double cFloat[15];
+                    const double* c = NULL != tableID->akima ?
+                        akimaGridCoefficients(tableID->akima, last1, last2) :
+                        spline2DCoefficients(tableID->spline,
+                        tableID->splineFloat, IDX(last1, last2, nCol - 2),
+                        cFloat);
+                    if (extrapolate1 == IN_TABLE) {
+                        double der_y1, der_y2;
+                        u1 -= TABLE_U1(last1 + 1);
+                        if (extrapolate2 == IN_TABLE) {
+                            double p1, p2, p3;
+                            double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                            u2 -= TABLE_U2(last2 + 1);
+                            p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
+                            p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
+                            p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
+                            dp1_u2 = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
+                            dp2_u2 = (3*c[4]*u2 + 2*c[5])*u2 + c[6];
+                            dp3_u2 = (3*c[8]*u2 + 2*c[9])*u2 + c[10];
+                            dp4_u2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
+                            der_y1 = (3*p1*u1 + 2*p2)*u1 + p3;
+                            der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
+                        }
+                        else if (extrapolate2 == LEFT) {
+                            u2 -= TABLE_U2(1);
+                            der_y1 = (3*c[3]*u1 + 2*c[7])*u1 + c[11];
+                            der_y1 += ((3*c[2]*u1 + 2*c[6])*u1 + c[10])*u2;
+                            der_y2 = ((c[2]*u1 + c[6])*u1 + c[10])*u1 + c[14];
+                        }
+                        else /* if (extrapolate2 == RIGHT) */ {
+                            const double v2 = TABLE_U2(nCol - 1) -
+                                TABLE_U2(nCol - 2);
+                            double p1, p2, p3;
+                            double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                            u2 -= TABLE_U2(nCol - 1);
+                            p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
+                            p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
+                            p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
+                            dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
+                            dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
+                            dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
+                            dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
+                            der_y1 = (3*p1*u1 + 2*p2)*u1 + p3;
+                            der_y1 += ((3*dp1_u2*u1 + 2*dp2_u2)*u1 + dp3_u2)*u2;
+                            der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
+                        }
+                        der_y = der_y1*der_u1 + der_y2*der_u2;
+                    }
+                    else if (extrapolate1 == LEFT) {
+                        u1 -= TABLE_U1(1);
+                        if (extrapolate2 == IN_TABLE) {
                             double der_y1, der_y2;
-                            u1 -= TABLE_COL0(last1 + 1);
-                            if (extrapolate2 == IN_TABLE) {
-                                double p1, p2, p3;
-                                double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                u2 -= TABLE_ROW0(last2 + 1);
-                                p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                dp1_u2 = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
-                                dp2_u2 = (3*c[4]*u2 + 2*c[5])*u2 + c[6];
-                                dp3_u2 = (3*c[8]*u2 + 2*c[9])*u2 + c[10];
-                                dp4_u2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
-                                der_y1 = (3*p1*u1 + 2*p2)*u1 + p3;
-                                der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
-                            }
-                            else if (extrapolate2 == LEFT) {
-                                u2 -= TABLE_ROW0(1);
-                                der_y1 = (3*c[3]*u1 + 2*c[7])*u1 + c[11];
-                                der_y1 += ((3*c[2]*u1 + 2*c[6])*u1 + c[10])*u2;
-                                der_y2 = ((c[2]*u1 + c[6])*u1 + c[10])*u1 + c[14];
-                            }
-                            else /* if (extrapolate2 == RIGHT) */ {
-                                const double v2 = TABLE_ROW0(nCol - 1) -
-                                    TABLE_ROW0(nCol - 2);
-                                double p1, p2, p3;
-                                double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                u2 -= TABLE_ROW0(nCol - 1);
-                                p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
-                                p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
-                                p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
-                                dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
-                                dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
-                                dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
-                                dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
-                                der_y1 = (3*p1*u1 + 2*p2)*u1 + p3;
-                                der_y1 += ((3*dp1_u2*u1 + 2*dp2_u2)*u1 + dp3_u2)*u2;
-                                der_y2 = ((dp1_u2*u1 + dp2_u2)*u1 + dp3_u2)*u1 + dp4_u2;
-                            }
+                            u2 -= TABLE_U2(last2 + 1);
+                            der_y1 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
+                            der_y2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
+                            der_y2 += ((3*c[8]*u2 + 2*c[9])*u2 + c[10])*u1;
                             der_y = der_y1*der_u1 + der_y2*der_u2;
                         }
-                        else if (extrapolate1 == LEFT) {
-                            u1 -= TABLE_COL0(1);
-                            if (extrapolate2 == IN_TABLE) {
-                                double der_y1, der_y2;
-                                u2 -= TABLE_ROW0(last2 + 1);
-                                der_y1 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                der_y2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
-                                der_y2 += ((3*c[8]*u2 + 2*c[9])*u2 + c[10])*u1;
-                                der_y = der_y1*der_u1 + der_y2*der_u2;
-                            }
-                            else if (extrapolate2 == LEFT) {
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(1);
-                                der_y1 = c[11];
-                                der_y2 = c[14];
-                                der_y12 = c[10];
-                                der_y = (der_y1 + der_y12*u2)*der_u1;
-                                der_y += (der_y2 + der_y12*u1)*der_u2;
-                            }
-                            else /* if (extrapolate2 == RIGHT) */ {
-                                const double v2 = TABLE_ROW0(nCol - 1) -
-                                    TABLE_ROW0(nCol - 2);
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(nCol - 1);
-                                der_y1 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
-                                der_y2 =(3*c[12]*v2 + 2*c[13])*v2 + c[14];
-                                der_y12 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
-                                der_y = (der_y1 + der_y12*u2)*der_u1;
-                                der_y += (der_y2 + der_y12*u1)*der_u2;
-                            }
+                        else if (extrapolate2 == LEFT) {
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(1);
+                            der_y1 = c[11];
+                            der_y2 = c[14];
+                            der_y12 = c[10];
+                            der_y = (der_y1 + der_y12*u2)*der_u1;
+                            der_y += (der_y2 + der_y12*u1)*der_u2;
                         }
-                        else /* if (extrapolate1 == RIGHT) */ {
-                            const double v1 = TABLE_COL0(nRow - 1) -
-                                TABLE_COL0(nRow - 2);
-                            u1 -= TABLE_COL0(nRow - 1);
-                            if (extrapolate2 == IN_TABLE) {
-                                double p1, p2, p3;
-                                double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                double der_y1, der_y2;
-                                u2 -= TABLE_ROW0(last2 + 1);
-                                p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
-                                p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
-                                p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
-                                dp1_u2 = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
-                                dp2_u2 = (3*c[4]*u2 + 2*c[5])*u2 + c[6];
-                                dp3_u2 = (3*c[8]*u2 + 2*c[9])*u2 + c[10];
-                                dp4_u2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
-                                der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
-                                der_y2 = ((dp1_u2*v1 + dp2_u2)*v1 + dp3_u2)*v1 + dp4_u2;
-                                der_y2 += ((3*dp1_u2*v1 + 2*dp2_u2)*v1 + dp3_u2)*u1;
-                                der_y = der_y1*der_u1 + der_y2*der_u2;
-                            }
-                            else if (extrapolate2 == LEFT) {
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(1);
-                                der_y1 = (3*c[3]*v1 + 2*c[7])*v1 + c[11];
-                                der_y2 = ((c[2]*v1 + c[6])*v1 + c[10])*v1 + c[14];
-                                der_y12 = (3*c[2]*v1 + 2*c[6])*v1 + c[10];
-                                der_y = (der_y1 + der_y12*u2)*der_u1;
-                                der_y += (der_y2 + der_y12*u1)*der_u2;
-                            }
-                            else /* if (extrapolate2 == RIGHT) */ {
-                                const double v2 = TABLE_ROW0(nCol - 1) -
-                                    TABLE_ROW0(nCol - 2);
-                                double p1, p2, p3;
-                                double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
-                                double der_y1, der_y2, der_y12;
-                                u2 -= TABLE_ROW0(nCol - 1);
-                                p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
-                                p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
-                                p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
-                                dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
-                                dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
-                                dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
-                                dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
-                                der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
-                                der_y2 = ((dp1_u2*v1 + dp2_u2)*v1 + dp3_u2)*v1 + dp4_u2;
-                                der_y12 = (3*dp1_u2*v1 + 2*dp2_u2)*v1 + dp3_u2;
-                                der_y = (der_y1 + der_y12*u2)*der_u1;
-                                der_y += (der_y2 + der_y12*u1)*der_u2;
-                            }
+                        else /* if (extrapolate2 == RIGHT) */ {
+                            const double v2 = TABLE_U2(nCol - 1) -
+                                TABLE_U2(nCol - 2);
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(nCol - 1);
+                            der_y1 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
+                            der_y2 =(3*c[12]*v2 + 2*c[13])*v2 + c[14];
+                            der_y12 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
+                            der_y = (der_y1 + der_y12*u2)*der_u1;
+                            der_y += (der_y2 + der_y12*u1)*der_u2;
                         }
                     }
-                    break;
+                    else /* if (extrapolate1 == RIGHT) */ {
+                        const double v1 = TABLE_U1(nRow - 1) -
+                            TABLE_U1(nRow - 2);
+                        u1 -= TABLE_U1(nRow - 1);
+                        if (extrapolate2 == IN_TABLE) {
+                            double p1, p2, p3;
+                            double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                            double der_y1, der_y2;
+                            u2 -= TABLE_U2(last2 + 1);
+                            p1 = ((c[0]*u2 + c[1])*u2 + c[2])*u2 + c[3];
+                            p2 = ((c[4]*u2 + c[5])*u2 + c[6])*u2 + c[7];
+                            p3 = ((c[8]*u2 + c[9])*u2 + c[10])*u2 + c[11];
+                            dp1_u2 = (3*c[0]*u2 + 2*c[1])*u2 + c[2];
+                            dp2_u2 = (3*c[4]*u2 + 2*c[5])*u2 + c[6];
+                            dp3_u2 = (3*c[8]*u2 + 2*c[9])*u2 + c[10];
+                            dp4_u2 = (3*c[12]*u2 + 2*c[13])*u2 + c[14];
+                            der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
+                            der_y2 = ((dp1_u2*v1 + dp2_u2)*v1 + dp3_u2)*v1 + dp4_u2;
+                            der_y2 += ((3*dp1_u2*v1 + 2*dp2_u2)*v1 + dp3_u2)*u1;
+                            der_y = der_y1*der_u1 + der_y2*der_u2;
+                        }
+                        else if (extrapolate2 == LEFT) {
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(1);
+                            der_y1 = (3*c[3]*v1 + 2*c[7])*v1 + c[11];
+                            der_y2 = ((c[2]*v1 + c[6])*v1 + c[10])*v1 + c[14];
+                            der_y12 = (3*c[2]*v1 + 2*c[6])*v1 + c[10];
+                            der_y = (der_y1 + der_y12*u2)*der_u1;
+                            der_y += (der_y2 + der_y12*u1)*der_u2;
+                        }
+                        else /* if (extrapolate2 == RIGHT) */ {
+                            const double v2 = TABLE_U2(nCol - 1) -
+                                TABLE_U2(nCol - 2);
+                            double p1, p2, p3;
+                            double dp1_u2, dp2_u2, dp3_u2, dp4_u2;
+                            double der_y1, der_y2, der_y12;
+                            u2 -= TABLE_U2(nCol - 1);
+                            p1 = ((c[0]*v2 + c[1])*v2 + c[2])*v2 + c[3];
+                            p2 = ((c[4]*v2 + c[5])*v2 + c[6])*v2 + c[7];
+                            p3 = ((c[8]*v2 + c[9])*v2 + c[10])*v2 + c[11];
+                            dp1_u2 = (3*c[0]*v2 + 2*c[1])*v2 + c[2];
+                            dp2_u2 = (3*c[4]*v2 + 2*c[5])*v2 + c[6];
+                            dp3_u2 = (3*c[8]*v2 + 2*c[9])*v2 + c[10];
+                            dp4_u2 = (3*c[12]*v2 + 2*c[13])*v2 + c[14];
+                            der_y1 = (3*p1*v1 + 2*p2)*v1 + p3;
+                            der_y2 = ((dp1_u2*v1 + dp2_u2)*v1 + dp3_u2)*v1 + dp4_u2;
+                            der_y12 = (3*dp1_u2*v1 + 2*dp2_u2)*v1 + dp3_u2;
+                            der_y = (der_y1 + der_y12*u2)*der_u1;
+                            der_y += (der_y2 + der_y12*u1)*der_u2;
+                        }
+                    }
+                }
+                break;
 
-                case FRITSCH_BUTLAND_MONOTONE_C1:
-                case STEFFEN_MONOTONE_C1:
-                    ModelicaError("Bivariate monotone C1 interpolation is "
-                        "not implemented\n");
-                    return der_y;
+            case FRITSCH_BUTLAND_MONOTONE_C1:
+            case STEFFEN_MONOTONE_C1:
+                ModelicaError("Bivariate monotone C1 interpolation is "
+                    "not implemented\n");
+                return der_y;
 
-                default:
-                    ModelicaError("Unknown smoothness kind\n");
-                    return der_y;
-            }
+            default:
+                ModelicaError("Unknown smoothness kind\n");
+                return der_y;
         }
     }
     return der_y;
 }
 
-/* ----- Internal functions ----- */
+/* Evaluation kernels of CombiTable2D: The evaluation functions are
+   instantiated for each combination of table shape and smoothness kind such
+   that the compiler can remove the dispatch on these (at evaluation time
+   constant) table properties */
+#define COMBITABLE2D_KERNELS(shape, smooth) \
+static double combiTable2DValue_##shape##_##smooth(CombiTable2D* tableID, \
+    double u1, double u2) { \
+    return combiTable2DValue(tableID, u1, u2, shape, smooth); \
+} \
+static double combiTable2DDerValue_##shape##_##smooth(CombiTable2D* tableID, \
+    double u1, double u2, double der_u1, double der_u2) { \
+    return combiTable2DDerValue(tableID, u1, u2, der_u1, der_u2, shape, \
+        smooth); \
+} \
+static double combiTable2DValueAndDer_##shape##_##smooth( \
+    CombiTable2D* tableID, double u1, double u2, double* der_y1, \
+    double* der_y2) { \
+    const double y = combiTable2DValue(tableID, u1, u2, shape, smooth); \
+    *der_y1 = combiTable2DDerValue(tableID, u1, u2, 1., 0., shape, smooth); \
+    *der_y2 = combiTable2DDerValue(tableID, u1, u2, 0., 1., shape, smooth); \
+    return y; \
+}
 
-static int isNearlyEqual(double x, double y) {
-    const double fx = fabs(x);
-    const double fy = fabs(y);
-    double cmp = fx > fy ? fx : fy;
-    if (cmp < _EPSILON) {
-        cmp = _EPSILON;
-    }
-    cmp *= _EPSILON;
-    return fabs(y - x) < cmp;
+#define COMBITABLE2D_KERNEL_ROW(prefix, shape) { \
+    prefix##_##shape##_LINEAR_SEGMENTS, \
+    prefix##_##shape##_CONSTANT_SEGMENTS, \
+    prefix##_##shape##_AKIMA_C1 \
 }
 
-static size_t findRowIndex(const double* table, size_t nRow, size_t nCol,
-                           size_t last, double x) {
-    size_t i0 = 0;
-    size_t i1 = nRow - 1;
-    if (x < TABLE_COL0(last)) {
-        i1 = last;
+#define COMBITABLE2D_KERNELS_SMOOTHNESS(shape) \
+    COMBITABLE2D_KERNELS(shape, LINEAR_SEGMENTS) \
+    COMBITABLE2D_KERNELS(shape, CONSTANT_SEGMENTS) \
+    COMBITABLE2D_KERNELS(shape, AKIMA_C1)
+
+COMBITABLE2D_KERNELS_SMOOTHNESS(SHAPE_GENERAL)
+COMBITABLE2D_KERNELS_SMOOTHNESS(SHAPE_SINGLE_ROW)
+COMBITABLE2D_KERNELS_SMOOTHNESS(SHAPE_SINGLE_COLUMN)
+COMBITABLE2D_KERNELS(SHAPE_SINGLE_VALUE, LINEAR_SEGMENTS)
+
+static enum TableShape combiTable2DShape(const CombiTable2D* tableID) {
+    if (tableID->nRow == 2 && tableID->nCol == 2) {
+        return SHAPE_SINGLE_VALUE;
     }
-    else if (x >= TABLE_COL0(last + 1)) {
-        i0 = last;
+    else if (tableID->nRow == 2 && tableID->nCol > 2) {
+        return SHAPE_SINGLE_ROW;
     }
-    else {
-        return last;
+    else if (tableID->nRow > 2 && tableID->nCol == 2) {
+        return SHAPE_SINGLE_COLUMN;
     }
-
-    /* Binary search */
-    while (i1 > i0 + 1) {
-        const size_t i = (i0 + i1)/2;
-        if (x < TABLE_COL0(i)) {
-            i1 = i;
-        }
-        else {
-            i0 = i;
-        }
+    else if (tableID->nRow > 2 && tableID->nCol > 2) {
+        return SHAPE_GENERAL;
     }
-    return i0;
+    return SHAPE_NONE;
 }
 
-static size_t findColIndex(_In_ const double* table, size_t nCol, size_t last,
-                           double x) {
-    size_t i0 = 0;
-    size_t i1 = nCol - 1;
-    if (x < TABLE_ROW0(last)) {
-        i1 = last;
+/* Fallback kernels for unknown or unsupported smoothness kinds (which are
+   reported at evaluation time) */
+static double combiTable2DValue_generic(CombiTable2D* tableID, double u1,
+                                        double u2) {
+    return combiTable2DValue(tableID, u1, u2, combiTable2DShape(tableID),
+        tableID->smoothness);
+}
+
+static double combiTable2DDerValue_generic(CombiTable2D* tableID, double u1,
+                                           double u2, double der_u1,
+                                           double der_u2) {
+    return combiTable2DDerValue(tableID, u1, u2, der_u1, der_u2,
+        combiTable2DShape(tableID), tableID->smoothness);
+}
+
+static double combiTable2DValueAndDer_generic(CombiTable2D* tableID,
+                                              double u1, double u2,
+                                              double* der_y1,
+                                              double* der_y2) {
+    const double y = combiTable2DValue_generic(tableID, u1, u2);
+    *der_y1 = combiTable2DDerValue_generic(tableID, u1, u2, 1., 0.);
+    *der_y2 = combiTable2DDerValue_generic(tableID, u1, u2, 0., 1.);
+    return y;
+}
+
+static void selectCombiTable2DKernels(CombiTable2D* tableID) {
+    static CombiTable2DValue const valueKernels[3][3] = {
+        COMBITABLE2D_KERNEL_ROW(combiTable2DValue, SHAPE_GENERAL),
+        COMBITABLE2D_KERNEL_ROW(combiTable2DValue, SHAPE_SINGLE_ROW),
+        COMBITABLE2D_KERNEL_ROW(combiTable2DValue, SHAPE_SINGLE_COLUMN)
+    };
+    static CombiTable2DDerValue const derValueKernels[3][3] = {
+        COMBITABLE2D_KERNEL_ROW(combiTable2DDerValue, SHAPE_GENERAL),
+        COMBITABLE2D_KERNEL_ROW(combiTable2DDerValue, SHAPE_SINGLE_ROW),
+        COMBITABLE2D_KERNEL_ROW(combiTable2DDerValue, SHAPE_SINGLE_COLUMN)
+    };
+    static CombiTable2DValueAndDer const valueAndDerKernels[3][3] = {
+        COMBITABLE2D_KERNEL_ROW(combiTable2DValueAndDer, SHAPE_GENERAL),
+        COMBITABLE2D_KERNEL_ROW(combiTable2DValueAndDer, SHAPE_SINGLE_ROW),
+        COMBITABLE2D_KERNEL_ROW(combiTable2DValueAndDer, SHAPE_SINGLE_COLUMN)
+    };
+    const enum TableShape shape = combiTable2DShape(tableID);
+    int j = -1;
+
+    switch (tableID->smoothness) {
+        case LINEAR_SEGMENTS:
+            j = 0;
+            break;
+        case CONSTANT_SEGMENTS:
+            j = 1;
+            break;
+        case AKIMA_C1:
+            j = 2;
+            break;
+        default:
+            break;
     }
-    else if (x >= TABLE_ROW0(last + 1)) {
-        i0 = last;
+
+    if (shape == SHAPE_SINGLE_VALUE) {
+        tableID->getValue =
+            combiTable2DValue_SHAPE_SINGLE_VALUE_LINEAR_SEGMENTS;
+        tableID->getDerValue =
+            combiTable2DDerValue_SHAPE_SINGLE_VALUE_LINEAR_SEGMENTS;
+        tableID->getValueAndDer =
+            combiTable2DValueAndDer_SHAPE_SINGLE_VALUE_LINEAR_SEGMENTS;
+    }
+    else if (shape != SHAPE_NONE && j >= 0) {
+        tableID->getValue = valueKernels[(int)shape][j];
+        tableID->getDerValue = derValueKernels[(int)shape][j];
+        tableID->getValueAndDer = valueAndDerKernels[(int)shape][j];
     }
     else {
-        return last;
+        tableID->getValue = combiTable2DValue_generic;
+        tableID->getDerValue = combiTable2DDerValue_generic;
+        tableID->getValueAndDer = combiTable2DValueAndDer_generic;
     }
+}
 
-    /* Binary search */
-    while (i1 > i0 + 1) {
-        const size_t i = (i0 + i1)/2;
-        if (x < TABLE_ROW0(i)) {
-            i1 = i;
-        }
-        else {
-            i0 = i;
-        }
+double ModelicaStandardTables_CombiTable2D_getValue(void* _tableID, double u1,
+                                                    double u2) {
+    double y = 0.;
+    CombiTable2D* tableID = (CombiTable2D*)_tableID;
+    if (NULL != tableID && NULL != tableID->table) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTable2D_getValue,
+            y = tableID->getValue(tableID, u1, u2));
     }
-    return i0;
+    return y;
 }
 
-/* ----- Internal check functions ----- */
+double ModelicaStandardTables_CombiTable2D_getDerValue(void* _tableID, double u1,
+                                                       double u2, double der_u1,
+                                                       double der_u2) {
+    double der_y = 0.;
+    CombiTable2D* tableID = (CombiTable2D*)_tableID;
+    if (NULL != tableID && NULL != tableID->table) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTable2D_getDerValue,
+            der_y = tableID->getDerValue(tableID, u1, u2, der_u1, der_u2));
+    }
+    return der_y;
+}
 
-static int isValidName(_In_z_ const char* name) {
-    int isValid = 0;
-    if (name != NULL) {
-        if (strcmp(name, "NoName") != 0) {
-            size_t i;
-            size_t len = strlen(name);
-            for (i = 0; i < len; i++) {
-                if (name[i] != ' ') {
-                    isValid = 1;
-                    break;
-                }
-            }
-        }
+double ModelicaStandardTables_CombiTable2D_getValueAndDer(void* _tableID,
+                                                          double u1, double u2,
+                                                          double* der_y1,
+                                                          double* der_y2) {
+    double y = 0.;
+    CombiTable2D* tableID = (CombiTable2D*)_tableID;
+    *der_y1 = 0.;
+    *der_y2 = 0.;
+    if (NULL != tableID && NULL != tableID->table) {
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTable2D_getValueAndDer,
+            y = tableID->getValueAndDer(tableID, u1, u2, der_y1, der_y2));
     }
-    return isValid;
+    return y;
 }
 
-static int isValidCombiTimeTable(const CombiTimeTable* tableID) {
-    int isValid = 1;
+void* ModelicaStandardTables_CombiTableND_init(_In_z_ const char* tableName,
+                                               _In_z_ const char* fileName,
+                                               _In_ double* table,
+                                               size_t nTable, size_t nDim,
+                                               int smoothness,
+                                               int extrapolation) {
+    MODELICA_PROFILE_BEGIN();
+    CombiTableND* tableID = (CombiTableND*)calloc(1, sizeof(CombiTableND));
     if (tableID != NULL) {
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const char* tableName;
-        const char* tableDummyName = "NoName";
-        size_t iCol;
-
-        if (tableID->source == TABLESOURCE_MODEL) {
-            tableName = tableDummyName;
-        }
-        else {
-            tableName = tableID->tableName;
-        }
-
-        /* Check dimensions */
-        if (nRow < 1 || nCol < 2) {
-            ModelicaFormatError(
-                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
-                "dimensions for time interpolation.\n", tableName,
-                (unsigned long)nRow, (unsigned long)nCol);
-            isValid = 0;
-            return isValid;
-        }
-
-        /* Check column indices */
-        for (iCol = 0; iCol < tableID->nCols; ++iCol) {
-            const size_t col = (size_t)tableID->cols[iCol];
-            if (col < 1 || col > tableID->nCol) {
-                ModelicaFormatError("The column index %d is out of range "
-                    "for table matrix \"%s(%lu,%lu)\".\n", tableID->cols[iCol],
-                    tableName, (unsigned long)nRow, (unsigned long)nCol);
-            }
-        }
+        tableID->nDim = nDim;
+        tableID->storage = tableStorage(STORAGE_DEFAULT);
+        tableID->smoothness = (enum Smoothness)smoothness;
+        tableID->extrapolation = (enum Extrapolation)extrapolation;
+        tableID->source = getTableSource(tableName, fileName);
 
-        if (tableID->table != NULL && nRow > 1) {
-            const double* table = tableID->table;
-            /* Check period */
-            if (tableID->extrapolation == PERIODIC) {
-                const double tMin = TABLE_ROW0(0);
-                const double tMax = TABLE_COL0(nRow - 1);
-                const double T = tMax - tMin;
-                if (T <= 0) {
-                    ModelicaFormatError(
-                        "Table matrix \"%s\" does not have a positive period/cylce "
-                        "time for time interpolation with periodic "
-                        "extrapolation.\n", tableName);
-                    isValid = 0;
-                    return isValid;
+        switch (tableID->source) {
+            case TABLESOURCE_FILE:
+                tableID->tableName = (char*)malloc(
+                    (strlen(tableName) + 1)*sizeof(char));
+                if (tableID->tableName != NULL) {
+                    strcpy(tableID->tableName, tableName);
                 }
-            }
+                else {
+                    free(tableID);
+                    ModelicaError("Memory allocation error\n");
+                    return NULL;
+                }
+                tableID->fileName = (char*)malloc((strlen(fileName) + 1)*sizeof(char));
+                if (tableID->fileName != NULL) {
+                    strcpy(tableID->fileName, fileName);
+                }
+                else {
+                    free(tableID->tableName);
+                    free(tableID);
+                    ModelicaError("Memory allocation error\n");
+                    return NULL;
+                }
+                break;
 
-            /* Check, whether first column values are monotonically or strictly
-               increasing */
-            if (tableID->smoothness == AKIMA_C1 ||
-                tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
-                tableID->smoothness == STEFFEN_MONOTONE_C1) {
-                size_t i;
-                for (i = 0; i < nRow - 1; i++) {
-                    double t0 = TABLE_COL0(i);
-                    double t1 = TABLE_COL0(i + 1);
-                    if (t0 >= t1) {
-                        ModelicaFormatError(
-                            "The values of the first column of table \"%s(%lu,%lu)\" "
-                            "are not strictly increasing because %s(%lu,1) (=%lf) "
-                            ">= %s(%lu,1) (=%lf).\n", tableName, (unsigned long)nRow,
-                            (unsigned long)nCol, tableName, (unsigned long)i + 1, t0,
-                            tableName, (unsigned long)i + 2, t1);
-                        isValid = 0;
-                        return isValid;
+            case TABLESOURCE_MODEL:
+                /* The table vector is always copied to the tiled value
+                   block, hence it is neither kept nor shared */
+                if (isValidCombiTableND((const CombiTableND*)tableID,
+                    "NoName", table, 1, nTable)) {
+                    if (!tableNDInit(tableID, table)) {
+                        free(tableID);
+                        ModelicaError("Memory allocation error\n");
+                        return NULL;
                     }
                 }
-            }
-            else {
-                size_t i;
-                for (i = 0; i < nRow - 1; i++) {
-                    double t0 = TABLE_COL0(i);
-                    double t1 = TABLE_COL0(i + 1);
-                    if (t0 > t1) {
-                        ModelicaFormatError(
-                            "The values of the first column of table \"%s(%lu,%lu)\" "
-                            "are not monotonically increasing because %s(%lu,1) "
-                            "(=%lf) > %s(%lu,1) (=%lf).\n", tableName,
-                            (unsigned long)nRow, (unsigned long)nCol, tableName,
-                            (unsigned long)i + 1, t0, tableName, (unsigned long)i +
-                            2, t1);
-                        isValid = 0;
-                        return isValid;
+                break;
+
+            case TABLESOURCE_FUNCTION: {
+                int colWise;
+                int dim[MAX_TABLE_DIMENSIONS];
+                double* tableFunction = NULL;
+                if (usertab((char*)tableName, 3 /* N-D-interpolation */, dim,
+                    &colWise, &tableFunction) == 0) {
+                    /* The table vector is stored row-wise and column-wise
+                       alike */
+                    if (isValidCombiTableND((const CombiTableND*)tableID,
+                        tableName, tableFunction, (size_t)dim[0],
+                        (size_t)dim[1])) {
+                        if (!tableNDInit(tableID, tableFunction)) {
+                            free(tableID);
+                            ModelicaError("Memory allocation error\n");
+                            return NULL;
+                        }
                     }
                 }
+                break;
             }
-        }
-    }
 
-    return isValid;
-}
+            case TABLESOURCE_FUNCTION_TRANSPOSE:
+                /* Should not be possible to get here */
+                break;
 
-static int isValidCombiTable1D(const CombiTable1D* tableID) {
-    int isValid = 1;
+            default:
+                free(tableID);
+                ModelicaError("Table source error\n");
+                return NULL;
+        }
+        selectCombiTableNDKernels(tableID);
+    }
+    else {
+        ModelicaError("Memory allocation error\n");
+    }
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTableND_init);
+    return (void*)tableID;
+}
+
+void ModelicaStandardTables_CombiTableND_close(void* _tableID) {
+    CombiTableND* tableID = (CombiTableND*)_tableID;
     if (tableID != NULL) {
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const char* tableName;
-        const char* tableDummyName = "NoName";
-        size_t iCol;
+        if (tableID->table != NULL && tableID->source == TABLESOURCE_FILE) {
+#if defined(TABLE_SHARE) && !defined(NO_FILE_SYSTEM)
+            if (tableID->tableName != NULL && tableID->fileName != NULL) {
+                char* key = tableShareKey(tableID->tableName,
+                    tableID->fileName, NULL, 0);
+                if (key != NULL) {
+                    TableShare *iter;
+                    MUTEX_LOCK();
+                    HASH_FIND_STR(tableShare, key, iter);
+                    if (iter != NULL) {
+                        /* Share hit */
+                        if (--iter->refCount == 0) {
+                            free(iter->table);
+                            free(iter->key);
+                            HASH_DEL(tableShare, iter);
+                            free(iter);
+                        }
+                    }
+                    MUTEX_UNLOCK();
+                    free(key);
+                }
+            }
+            else {
+                /* Should not be possible to get here */
+                free(tableID->table);
+            }
+#else
+            free(tableID->table);
+#endif
+            tableID->table = NULL;
+        }
+        if (tableID->tableName != NULL) {
+            free(tableID->tableName);
+            tableID->tableName = NULL;
+        }
+        if (tableID->fileName != NULL) {
+            free(tableID->fileName);
+            tableID->fileName = NULL;
+        }
+        tableNDClose(tableID);
+        free(tableID);
+    }
+}
 
-        if (tableID->source == TABLESOURCE_MODEL) {
-            tableName = tableDummyName;
+double ModelicaStandardTables_CombiTableND_read(void* _tableID, int force,
+                                                int verbose) {
+    MODELICA_PROFILE_BEGIN();
+#if !defined(NO_FILE_SYSTEM)
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    if (tableID != NULL && tableID->source == TABLESOURCE_FILE) {
+        if (force && tableID->table != NULL &&
+            ModelicaIO_isTableFileUnchanged(tableID->fileName,
+            &tableID->fileState)) {
+            /* Table file is unchanged since the last read */
+        }
+        else if (force || tableID->table == NULL) {
+            ModelicaIOLoadEvent event;
+            const unsigned long long start = ModelicaProfile_now();
+            unsigned long long initStart;
+            double* prevTable = tableID->table;
+            tableID->table = readTable(tableID->tableName,
+                tableID->fileName, &tableID->nRow, &tableID->nCol, NULL, 0,
+                (const double*)prevTable, &tableID->fileState, verbose, force,
+                &event);
+#if !defined(TABLE_SHARE)
+            free(prevTable);
+#endif
+            if (tableID->table == NULL) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTableND_read);
+                return 0.; /* Error */
+            }
+            if (!isValidCombiTableND((const CombiTableND*)tableID,
+                tableID->tableName, tableID->table, tableID->nRow,
+                tableID->nCol)) {
+                MODELICA_PROFILE_END(ModelicaStandardTables_CombiTableND_read);
+                return 0.; /* Error */
+            }
+            initStart = ModelicaProfile_now();
+            if (!tableNDInit(tableID, tableID->table)) {
+                ModelicaError("Memory allocation error\n");
+                return 0.; /* Error */
+            }
+            event.splineTime = 1e-9*(double)(ModelicaProfile_now() - initStart);
+            selectCombiTableNDKernels(tableID);
+            event.totalTime = 1e-9*(double)(ModelicaProfile_now() - start);
+            ModelicaIO_reportLoadEvent(&event);
+        }
+    }
+#endif
+    MODELICA_PROFILE_END(ModelicaStandardTables_CombiTableND_read);
+    return 1.; /* Success */
+}
+
+static TABLE_ALWAYS_INLINE double combiTableNDValue(CombiTableND* tableID,
+                                                    const double* u,
+                                                    const double* der_u,
+                                                    enum Smoothness smoothness) {
+    double w[MAX_TABLE_ND_DIMENSIONS][4];
+    double dw[MAX_TABLE_ND_DIMENSIONS][4];
+    size_t offset[MAX_TABLE_ND_DIMENSIONS][4];
+    size_t nw[MAX_TABLE_ND_DIMENSIONS];
+    size_t q[MAX_TABLE_ND_DIMENSIONS];
+    double pw[MAX_TABLE_ND_DIMENSIONS + 1];
+    double pd[MAX_TABLE_ND_DIMENSIONS + 1];
+    size_t pi[MAX_TABLE_ND_DIMENSIONS + 1];
+    const double* values = tableID->values;
+    const float* valuesFloat = tableID->valuesFloat;
+    const size_t nDim = tableID->nDim;
+    double y = 0.;
+    double der_y = 0.;
+    size_t k;
+    size_t k0 = 0;
+    size_t last;
+
+    /* Interpolation stencil and weights per axis */
+    for (k = 0; k < nDim; k++) {
+        TableNDAxis* axis = &tableID->axis[k];
+        const size_t i0 = tableNDWeights(axis, u[k], smoothness,
+            tableID->extrapolation, w[k], dw[k], &nw[k]);
+        size_t j;
+        if (nw[k] == 0) {
+            return 0.; /* Error */
+        }
+        for (j = 0; j < nw[k]; j++) {
+            offset[k][j] = axis->offset[i0 + j];
+            if (NULL != der_u) {
+                dw[k][j] *= der_u[k];
+            }
+        }
+        q[k] = 0;
+    }
+    if (smoothness == AKIMA_C1) {
+        MODELICA_PROFILE_COUNT(splineEvaluations, 1);
+    }
+
+    /* Sum of the weighted values over the tensor product of the stencils:
+       The products of the weights (and of their derivatives) and the
+       offsets of the first k axes are kept for k = 0, ..., nDim - 1, such
+       that only the ones of the axes with a changed grid point are updated.
+       The stencil of the last axis, which is contiguous within a tile, is
+       summed up in the inner loop. */
+    last = nDim - 1;
+    pw[0] = 1.;
+    pd[0] = 0.;
+    pi[0] = 0;
+    for (;;) {
+        double s = 0.;
+        double ds = 0.;
+        size_t j;
+        for (k = k0; k < last; k++) {
+            const double wk = w[k][q[k]];
+            if (NULL != der_u) {
+                pd[k + 1] = pd[k]*wk + pw[k]*dw[k][q[k]];
+            }
+            pw[k + 1] = pw[k]*wk;
+            pi[k + 1] = pi[k] + offset[k][q[k]];
+        }
+        for (j = 0; j < nw[last]; j++) {
+            const double v = TABLEND_VALUE(pi[last] + offset[last][j]);
+            s += w[last][j]*v;
+            if (NULL != der_u) {
+                ds += dw[last][j]*v;
+            }
+        }
+        y += pw[last]*s;
+        if (NULL != der_u) {
+            der_y += pd[last]*s + pw[last]*ds;
+        }
+        /* Next grid point of the stencil of the first nDim - 1 axes (the
+           last of them varies fastest) */
+        k = last;
+        while (k > 0 && ++q[k - 1] == nw[k - 1]) {
+            q[k - 1] = 0;
+            k--;
+        }
+        if (k == 0) {
+            break;
+        }
+        k0 = k - 1;
+    }
+    return NULL != der_u ? der_y : y;
+}
+
+/* Evaluation kernels, specialized for the smoothness kind */
+#define COMBITABLEND_KERNELS(smooth) \
+static double combiTableNDValue_##smooth(CombiTableND* tableID, \
+    const double* u) { \
+    return combiTableNDValue(tableID, u, NULL, smooth); \
+} \
+static double combiTableNDDerValue_##smooth(CombiTableND* tableID, \
+    const double* u, const double* der_u) { \
+    return combiTableNDValue(tableID, u, der_u, smooth); \
+}
+
+COMBITABLEND_KERNELS(LINEAR_SEGMENTS)
+COMBITABLEND_KERNELS(CONSTANT_SEGMENTS)
+COMBITABLEND_KERNELS(AKIMA_C1)
+
+/* Fallback kernels for unknown or unsupported smoothness kinds (which are
+   reported at evaluation time) */
+static double combiTableNDValue_generic(CombiTableND* tableID,
+                                        const double* u) {
+    return combiTableNDValue(tableID, u, NULL, tableID->smoothness);
+}
+
+static double combiTableNDDerValue_generic(CombiTableND* tableID,
+                                           const double* u,
+                                           const double* der_u) {
+    return combiTableNDValue(tableID, u, der_u, tableID->smoothness);
+}
+
+static void selectCombiTableNDKernels(CombiTableND* tableID) {
+    switch (tableID->smoothness) {
+        case LINEAR_SEGMENTS:
+            tableID->getValue = combiTableNDValue_LINEAR_SEGMENTS;
+            tableID->getDerValue = combiTableNDDerValue_LINEAR_SEGMENTS;
+            break;
+
+        case CONSTANT_SEGMENTS:
+            tableID->getValue = combiTableNDValue_CONSTANT_SEGMENTS;
+            tableID->getDerValue = combiTableNDDerValue_CONSTANT_SEGMENTS;
+            break;
+
+        case AKIMA_C1:
+            tableID->getValue = combiTableNDValue_AKIMA_C1;
+            tableID->getDerValue = combiTableNDDerValue_AKIMA_C1;
+            break;
+
+        default:
+            tableID->getValue = combiTableNDValue_generic;
+            tableID->getDerValue = combiTableNDDerValue_generic;
+            break;
+    }
+}
+
+double ModelicaStandardTables_CombiTableND_getValue(void* _tableID,
+                                                    _In_ const double* u,
+                                                    size_t nu) {
+    double y = 0.;
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    if (NULL != tableID && NULL != tableID->axis) {
+        if (nu != tableID->nDim) {
+            ModelicaFormatError("The number of inputs (=%lu) is not equal to "
+                "the number of dimensions (=%lu) of the N-D table.\n",
+                (unsigned long)nu, (unsigned long)tableID->nDim);
+            return y;
+        }
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTableND_getValue,
+            y = tableID->getValue(tableID, u));
+    }
+    return y;
+}
+
+double ModelicaStandardTables_CombiTableND_getDerValue(void* _tableID,
+                                                       _In_ const double* u,
+                                                       size_t nu,
+                                                       _In_ const double* der_u) {
+    double der_y = 0.;
+    CombiTableND* tableID = (CombiTableND*)_tableID;
+    if (NULL != tableID && NULL != tableID->axis) {
+        if (nu != tableID->nDim) {
+            ModelicaFormatError("The number of inputs (=%lu) is not equal to "
+                "the number of dimensions (=%lu) of the N-D table.\n",
+                (unsigned long)nu, (unsigned long)tableID->nDim);
+            return der_y;
+        }
+        MODELICA_PROFILE_CALL(ModelicaStandardTables_CombiTableND_getDerValue,
+            der_y = tableID->getDerValue(tableID, u, der_u));
+    }
+    return der_y;
+}
+
+int ModelicaStandardTables_SharedTable2D_getValue(_In_z_ const char* tableName,
+                                                  _In_z_ const char* validName,
+                                                  double u1, double u2,
+                                                  _Out_ double* y) {
+    MODELICA_PROFILE_BEGIN();
+    int status;
+    SharedTable2D* entry = sharedTable2DGet(tableName, validName, &status);
+    *y = 0.;
+    if (NULL != entry) {
+        if (sharedTable2DIsValid(entry, u1, u2)) {
+            *y = entry->table->getValue(entry->table, u1, u2);
         }
         else {
-            tableName = tableID->tableName;
+            status = 0;
         }
+    }
+    MODELICA_PROFILE_END(ModelicaStandardTables_SharedTable2D_getValue);
+    return status;
+}
 
-        /* Check dimensions */
-        if (nRow < 1 || nCol < 2) {
-            ModelicaFormatError(
-                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
-                "dimensions for 1D-interpolation.\n", tableName,
-                (unsigned long)nRow, (unsigned long)nCol);
-            isValid = 0;
-            return isValid;
+int ModelicaStandardTables_SharedTable2D_getValueAndDer(_In_z_ const char* tableName,
+                                                        _In_z_ const char* validName,
+                                                        double u1, double u2,
+                                                        _Out_ double* y,
+                                                        _Out_ double* der_y1,
+                                                        _Out_ double* der_y2) {
+    MODELICA_PROFILE_BEGIN();
+    int status;
+    SharedTable2D* entry = sharedTable2DGet(tableName, validName, &status);
+    *y = 0.;
+    *der_y1 = 0.;
+    *der_y2 = 0.;
+    if (NULL != entry) {
+        if (sharedTable2DIsValid(entry, u1, u2)) {
+            *y = entry->table->getValueAndDer(entry->table, u1, u2, der_y1,
+                der_y2);
+        }
+        else {
+            status = 0;
+        }
+    }
+    MODELICA_PROFILE_END(ModelicaStandardTables_SharedTable2D_getValueAndDer);
+    return status;
+}
+
+int ModelicaStandardTables_SharedTable2D_setTables(_In_z_ const char* tableName,
+                                                   _In_z_ const char* validName,
+                                                   _In_ const double* table,
+                                                   size_t nRow, size_t nColumn,
+                                                   _In_ const double* valid,
+                                                   size_t nRowValid,
+                                                   size_t nColumnValid) {
+    MODELICA_PROFILE_BEGIN();
+    enum SharedTableState state = SHAREDTABLE_UNAVAILABLE;
+    int success = 1;
+    SharedTable2D* entry;
+
+    MUTEX_LOCK();
+    entry = sharedTable2DFind(tableName, validName);
+    if (NULL != entry) {
+        state = entry->state;
+        if (SHAREDTABLE_NEW == state) {
+            /* Claim the entry: It remains unavailable if the initialization
+               fails, also with ModelicaError */
+            entry->state = SHAREDTABLE_UNAVAILABLE;
+        }
+    }
+    MUTEX_UNLOCK();
+    if (NULL == entry) {
+        ModelicaError("Memory allocation error\n");
+        return 0;
+    }
+
+    if (SHAREDTABLE_NEW == state) {
+        /* Release lock since the initialization may fail with ModelicaError */
+        success = ('\0' == validName[0] ||
+            (nRowValid == nRow && nColumnValid == nColumn)) &&
+            sharedTable2DInit(entry, table, nRow, nColumn,
+            '\0' != validName[0] ? valid : NULL);
+        if (success) {
+            MUTEX_LOCK();
+            entry->state = SHAREDTABLE_LOADED;
+            MUTEX_UNLOCK();
+        }
+    }
+    MODELICA_PROFILE_END(ModelicaStandardTables_SharedTable2D_setTables);
+    return success;
+}
+
+/* ----- Internal functions ----- */
+
+static int isNearlyEqual(double x, double y) {
+    const double fx = fabs(x);
+    const double fy = fabs(y);
+    double cmp = fx > fy ? fx : fy;
+    if (cmp < _EPSILON) {
+        cmp = _EPSILON;
+    }
+    cmp *= _EPSILON;
+    return fabs(y - x) < cmp;
+}
+
+static size_t findRowIndex(const double* table, size_t nRow, size_t nCol,
+                           size_t last, double x) {
+    size_t i0 = 0;
+    size_t i1 = nRow - 1;
+    size_t steps = 0;
+    if (x < TABLE_COL0(last)) {
+        i1 = last;
+    }
+    else if (x >= TABLE_COL0(last + 1)) {
+        i0 = last;
+    }
+    else {
+        MODELICA_PROFILE_COUNT(searches, 1);
+        MODELICA_PROFILE_COUNT(searchHintHits, 1);
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + TABLE_SEARCH_TAIL) {
+        const size_t i = (i0 + i1)/2;
+        if (x < TABLE_COL0(i)) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+        steps++;
+    }
+    i0 += countNotAbove(&TABLE_COL0(i0 + 1), i1 - i0 - 1, nCol, x);
+    MODELICA_PROFILE_COUNT(searches, 1);
+    MODELICA_PROFILE_COUNT(binarySearches, 1);
+    MODELICA_PROFILE_COUNT(binarySearchSteps, steps);
+    return i0;
+}
+
+static size_t findColIndex(_In_ const double* table, size_t nCol, size_t last,
+                           double x) {
+    size_t i0 = 0;
+    size_t i1 = nCol - 1;
+    size_t steps = 0;
+    if (x < TABLE_ROW0(last)) {
+        i1 = last;
+    }
+    else if (x >= TABLE_ROW0(last + 1)) {
+        i0 = last;
+    }
+    else {
+        MODELICA_PROFILE_COUNT(searches, 1);
+        MODELICA_PROFILE_COUNT(searchHintHits, 1);
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + TABLE_SEARCH_TAIL) {
+        const size_t i = (i0 + i1)/2;
+        if (x < TABLE_ROW0(i)) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+        steps++;
+    }
+    i0 += countNotAbove(&TABLE_ROW0(i0 + 1), i1 - i0 - 1, 1, x);
+    MODELICA_PROFILE_COUNT(searches, 1);
+    MODELICA_PROFILE_COUNT(binarySearches, 1);
+    MODELICA_PROFILE_COUNT(binarySearchSteps, steps);
+    return i0;
+}
+
+static size_t findInverseRowIndex(_In_ const CombiTable1D* tableID, size_t col,
+                                  int sign, size_t last, double y) {
+    const double* table = tableID->table;
+    const size_t nCol = tableID->nCol;
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = tableID->nCol - 1;
+    size_t i0 = 0;
+    size_t i1 = tableID->nRow - 1;
+    size_t steps = 0;
+    if (sign*y < sign*TABLE_VALUE(last, col)) {
+        i1 = last;
+    }
+    else if (sign*y >= sign*TABLE_VALUE(last + 1, col)) {
+        i0 = last;
+    }
+    else {
+        MODELICA_PROFILE_COUNT(searches, 1);
+        MODELICA_PROFILE_COUNT(searchHintHits, 1);
+        return last;
+    }
+
+    /* Binary search */
+    while (i1 > i0 + 1) {
+        const size_t i = (i0 + i1)/2;
+        if (sign*y < sign*TABLE_VALUE(i, col)) {
+            i1 = i;
+        }
+        else {
+            i0 = i;
+        }
+        steps++;
+    }
+    MODELICA_PROFILE_COUNT(searches, 1);
+    MODELICA_PROFILE_COUNT(binarySearches, 1);
+    MODELICA_PROFILE_COUNT(binarySearchSteps, steps);
+    return i0;
+}
+
+static size_t countEventRows(_In_ const size_t* eventRows, size_t nEventRows,
+                             size_t row) {
+    size_t i0 = 0;
+    size_t i1 = nEventRows;
+    while (i1 > i0) {
+        const size_t i = i0 + (i1 - i0)/2;
+        if (eventRows[i] <= row) {
+            i0 = i + 1;
+        }
+        else {
+            i1 = i;
+        }
+    }
+    return i0;
+}
+
+static size_t findEventInterval(_In_ const CombiTimeTable* tableID, size_t k0,
+                                size_t k1, double offset1, double offset2,
+                                double t) {
+    const double* table = tableID->table;
+    const size_t nCol = ABSCISSA_STRIDE(tableID);
+    if (k0 < k1 &&
+        TABLE_COL0(tableID->intervals[k0 - 1][1]) + offset1 + offset2 < t) {
+        k0++;
+        while (k1 > k0) {
+            const size_t k = k0 + (k1 - k0)/2;
+            if (TABLE_COL0(tableID->intervals[k - 1][1]) + offset1 +
+                offset2 < t) {
+                k0 = k + 1;
+            }
+            else {
+                k1 = k;
+            }
+        }
+    }
+    return k0;
+}
+
+static double periodicShift(double x, double xMin, double xMax) {
+    const double T = xMax - xMin;
+    int i;
+    if (x < xMin) {
+        /* fmod is exact. Shift by one period less than required and do the
+           last step(s) as the repeated addition would do. */
+        x = fmod(x, T);
+        x += (ceil((xMin - x)/T) - 1)*T;
+        for (i = 0; i < 3 && x < xMin; i++) {
+            x += T;
+        }
+    }
+    else if (x > xMax) {
+        x = fmod(x, T);
+        x += (floor((xMax - x)/T) + 1)*T;
+        for (i = 0; i < 3 && x > xMax; i++) {
+            x -= T;
+        }
+    }
+    return x;
+}
+
+static double* invWidthInit(_In_ const double* x, size_t n, size_t stride) {
+    double* invWidth = (double*)malloc((n > 1 ? n - 1 : 1)*sizeof(double));
+    if (invWidth != NULL) {
+        size_t i;
+        for (i = 0; i + 1 < n; i++) {
+            const double dx = x[(i + 1)*stride] - x[i*stride];
+            invWidth[i] = dx != 0 ? 1/dx : 0;
+        }
+    }
+    return invWidth;
+}
+
+#if !defined(NO_FILE_SYSTEM)
+static double* invWidthExtend(_In_ double* invWidth, _In_ const double* x,
+                              size_t nKept, size_t n, size_t stride) {
+    double* tmp = (double*)realloc(invWidth,
+        (n > 1 ? n - 1 : 1)*sizeof(double));
+    if (tmp != NULL) {
+        size_t i;
+        for (i = nKept > 0 ? nKept - 1 : 0; i + 1 < n; i++) {
+            const double dx = x[(i + 1)*stride] - x[i*stride];
+            tmp[i] = dx != 0 ? 1/dx : 0;
+        }
+    }
+    else {
+        free(invWidth);
+    }
+    return tmp;
+}
+#endif
+
+/* ----- Internal check functions ----- */
+
+static size_t findNonIncreasing_generic(_In_ const double* x, size_t n,
+                                        size_t stride, int strict) {
+    size_t i;
+    if (strict) {
+        for (i = 0; i + 1 < n; i++) {
+            if (x[i*stride] >= x[(i + 1)*stride]) {
+                return i;
+            }
+        }
+    }
+    else {
+        for (i = 0; i + 1 < n; i++) {
+            if (x[i*stride] > x[(i + 1)*stride]) {
+                return i;
+            }
+        }
+    }
+    return n > 0 ? n - 1 : 0;
+}
+
+static size_t countNotAbove_generic(_In_ const double* x, size_t n,
+                                    size_t stride, double xi) {
+    size_t count = 0;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        count += !(xi < x[i*stride]) ? 1 : 0;
+    }
+    return count;
+}
+
+#if defined(MODELICA_CPU_X86)
+/* The SIMD variants only locate the first block of values with a violation
+   and leave the exact index to the generic variant. Ordered comparisons
+   are used, such that NaN values are ignored as in the generic variant. */
+
+MODELICA_CPU_TARGET("sse2")
+static size_t findNonIncreasing_sse2(_In_ const double* x, size_t n,
+                                     size_t stride, int strict) {
+    size_t i = 0;
+    for (; i + 3 <= n; i += 2) {
+        __m128d x0, x1;
+        int mask;
+        if (stride == 1) {
+            x0 = _mm_loadu_pd(x + i);
+            x1 = _mm_loadu_pd(x + i + 1);
+        }
+        else {
+            x0 = _mm_set_pd(x[(i + 1)*stride], x[i*stride]);
+            x1 = _mm_set_pd(x[(i + 2)*stride], x[(i + 1)*stride]);
+        }
+        mask = _mm_movemask_pd(strict ? _mm_cmpge_pd(x0, x1) : _mm_cmpgt_pd(x0, x1));
+        if (mask != 0) {
+            break;
+        }
+    }
+    return i + findNonIncreasing_generic(x + i*stride, n - i, stride, strict);
+}
+
+MODELICA_CPU_TARGET("avx2")
+static size_t findNonIncreasing_avx2(_In_ const double* x, size_t n,
+                                     size_t stride, int strict) {
+    size_t i = 0;
+    const __m256i idx0 = _mm256_mul_epu32(_mm256_setr_epi64x(0, 1, 2, 3),
+        _mm256_set1_epi64x((long long)stride));
+    const __m256i idx1 = _mm256_add_epi64(idx0, _mm256_set1_epi64x((long long)stride));
+    if (stride > 0xffffffffUL) {
+        return findNonIncreasing_generic(x, n, stride, strict);
+    }
+    for (; i + 5 <= n; i += 4) {
+        __m256d x0, x1;
+        int mask;
+        if (stride == 1) {
+            x0 = _mm256_loadu_pd(x + i);
+            x1 = _mm256_loadu_pd(x + i + 1);
+        }
+        else {
+            const double* xi = x + i*stride;
+            x0 = _mm256_i64gather_pd(xi, idx0, 8);
+            x1 = _mm256_i64gather_pd(xi, idx1, 8);
+        }
+        mask = _mm256_movemask_pd(strict ? _mm256_cmp_pd(x0, x1, _CMP_GE_OQ) :
+            _mm256_cmp_pd(x0, x1, _CMP_GT_OQ));
+        if (mask != 0) {
+            break;
+        }
+    }
+    return i + findNonIncreasing_generic(x + i*stride, n - i, stride, strict);
+}
+
+#if defined(MODELICA_CPU_X86_AVX512)
+MODELICA_CPU_TARGET("avx512f")
+static size_t findNonIncreasing_avx512(_In_ const double* x, size_t n,
+                                       size_t stride, int strict) {
+    size_t i = 0;
+    const __m512i idx0 = _mm512_mul_epu32(_mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm512_set1_epi64((long long)stride));
+    const __m512i idx1 = _mm512_add_epi64(idx0, _mm512_set1_epi64((long long)stride));
+    if (stride > 0xffffffffUL) {
+        return findNonIncreasing_generic(x, n, stride, strict);
+    }
+    for (; i + 9 <= n; i += 8) {
+        __m512d x0, x1;
+        __mmask8 mask;
+        if (stride == 1) {
+            x0 = _mm512_loadu_pd(x + i);
+            x1 = _mm512_loadu_pd(x + i + 1);
+        }
+        else {
+            const double* xi = x + i*stride;
+            x0 = _mm512_i64gather_pd(idx0, xi, 8);
+            x1 = _mm512_i64gather_pd(idx1, xi, 8);
+        }
+        mask = strict ? _mm512_cmp_pd_mask(x0, x1, _CMP_GE_OQ) :
+            _mm512_cmp_pd_mask(x0, x1, _CMP_GT_OQ);
+        if (mask != 0) {
+            break;
+        }
+    }
+    return i + findNonIncreasing_generic(x + i*stride, n - i, stride, strict);
+}
+#endif
+
+/* The SIMD variants of countNotAbove subtract the all-ones comparison masks
+   (unordered comparisons, i.e., a NaN xi is not above any value) from
+   integer lanes and leave the remainder to the generic variant */
+
+MODELICA_CPU_TARGET("sse2")
+static size_t countNotAbove_sse2(_In_ const double* x, size_t n,
+                                 size_t stride, double xi) {
+    const __m128d v = _mm_set1_pd(xi);
+    __m128i count = _mm_setzero_si128();
+    long long lanes[2];
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d x0 = stride == 1 ? _mm_loadu_pd(x + i) :
+            _mm_set_pd(x[(i + 1)*stride], x[i*stride]);
+        count = _mm_sub_epi64(count, _mm_castpd_si128(_mm_cmpnlt_pd(v, x0)));
+    }
+    _mm_storeu_si128((__m128i*)lanes, count);
+    return (size_t)(lanes[0] + lanes[1]) +
+        countNotAbove_generic(x + i*stride, n - i, stride, xi);
+}
+
+MODELICA_CPU_TARGET("avx2")
+static size_t countNotAbove_avx2(_In_ const double* x, size_t n,
+                                 size_t stride, double xi) {
+    const __m256d v = _mm256_set1_pd(xi);
+    __m256i count = _mm256_setzero_si256();
+    long long lanes[4];
+    size_t i = 0;
+    if (stride > 0xffffffffUL) {
+        return countNotAbove_generic(x, n, stride, xi);
+    }
+    if (stride == 1) {
+        for (; i + 4 <= n; i += 4) {
+            count = _mm256_sub_epi64(count, _mm256_castpd_si256(
+                _mm256_cmp_pd(v, _mm256_loadu_pd(x + i), _CMP_NLT_UQ)));
+        }
+    }
+    else {
+        const __m256i idx = _mm256_mul_epu32(_mm256_setr_epi64x(0, 1, 2, 3),
+            _mm256_set1_epi64x((long long)stride));
+        for (; i + 4 <= n; i += 4) {
+            count = _mm256_sub_epi64(count, _mm256_castpd_si256(
+                _mm256_cmp_pd(v, _mm256_i64gather_pd(x + i*stride, idx, 8),
+                _CMP_NLT_UQ)));
+        }
+    }
+    _mm256_storeu_si256((__m256i*)lanes, count);
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+        countNotAbove_generic(x + i*stride, n - i, stride, xi);
+}
+
+#if defined(MODELICA_CPU_X86_AVX512)
+MODELICA_CPU_TARGET("avx512f")
+static size_t countNotAbove_avx512(_In_ const double* x, size_t n,
+                                   size_t stride, double xi) {
+    const __m512d v = _mm512_set1_pd(xi);
+    const __m512i one = _mm512_set1_epi64(1);
+    __m512i count = _mm512_setzero_si512();
+    long long lanes[8];
+    size_t i = 0;
+    size_t k;
+    if (stride > 0xffffffffUL) {
+        return countNotAbove_generic(x, n, stride, xi);
+    }
+    if (stride == 1) {
+        for (; i + 8 <= n; i += 8) {
+            count = _mm512_mask_add_epi64(count, _mm512_cmp_pd_mask(v,
+                _mm512_loadu_pd(x + i), _CMP_NLT_UQ), count, one);
+        }
+    }
+    else {
+        const __m512i idx = _mm512_mul_epu32(
+            _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7),
+            _mm512_set1_epi64((long long)stride));
+        for (; i + 8 <= n; i += 8) {
+            count = _mm512_mask_add_epi64(count, _mm512_cmp_pd_mask(v,
+                _mm512_i64gather_pd(idx, x + i*stride, 8), _CMP_NLT_UQ),
+                count, one);
+        }
+    }
+    _mm512_storeu_si512((void*)lanes, count);
+    for (k = 1; k < 8; k++) {
+        lanes[0] += lanes[k];
+    }
+    return (size_t)lanes[0] +
+        countNotAbove_generic(x + i*stride, n - i, stride, xi);
+}
+#endif
+
+static size_t (* const countNotAboveVariants[MODELICA_CPU_LEVELS])(
+    const double*, size_t, size_t, double) = {
+    countNotAbove_generic,
+    countNotAbove_sse2,
+    countNotAbove_avx2,
+#if defined(MODELICA_CPU_X86_AVX512)
+    countNotAbove_avx512
+#else
+    countNotAbove_avx2
+#endif
+};
+
+static size_t (* const findNonIncreasingVariants[MODELICA_CPU_LEVELS])(
+    const double*, size_t, size_t, int) = {
+    findNonIncreasing_generic,
+    findNonIncreasing_sse2,
+    findNonIncreasing_avx2,
+#if defined(MODELICA_CPU_X86_AVX512)
+    findNonIncreasing_avx512
+#else
+    findNonIncreasing_avx2
+#endif
+};
+#endif
+
+static size_t (*findNonIncreasingKernel)(const double*, size_t, size_t, int) =
+    findNonIncreasing_generic;
+static size_t (*countNotAboveKernel)(const double*, size_t, size_t, double) =
+    countNotAbove_generic;
+
+#if defined(MODELICA_CPU_X86) && defined(G_HAS_CONSTRUCTORS)
+#ifdef G_DEFINE_CONSTRUCTOR_NEEDS_PRAGMA
+#pragma G_DEFINE_CONSTRUCTOR_PRAGMA_ARGS(selectKernels)
+#endif
+G_DEFINE_CONSTRUCTOR(selectKernels)
+static void selectKernels(void) {
+    const int level = ModelicaCPU_level();
+    findNonIncreasingKernel = findNonIncreasingVariants[level];
+    countNotAboveKernel = countNotAboveVariants[level];
+}
+#endif
+
+static size_t findNonIncreasing(_In_ const double* x, size_t n,
+                                size_t stride, int strict) {
+    return findNonIncreasingKernel(x, n, stride, strict);
+}
+
+static size_t countNotAbove(_In_ const double* x, size_t n, size_t stride,
+                            double xi) {
+    return countNotAboveKernel(x, n, stride, xi);
+}
+
+static int isValidName(_In_z_ const char* name) {
+    int isValid = 0;
+    if (name != NULL) {
+        if (strcmp(name, "NoName") != 0) {
+            size_t i;
+            size_t len = strlen(name);
+            for (i = 0; i < len; i++) {
+                if (name[i] != ' ') {
+                    isValid = 1;
+                    break;
+                }
+            }
+        }
+    }
+    return isValid;
+}
+
+static int isValidCombiTimeTable(const CombiTimeTable* tableID) {
+    int isValid = 1;
+    if (tableID != NULL) {
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->nCol;
+        const char* tableName;
+        const char* tableDummyName = "NoName";
+        size_t iCol;
+
+        if (tableID->source == TABLESOURCE_MODEL) {
+            tableName = tableDummyName;
+        }
+        else {
+            tableName = tableID->tableName;
+        }
+
+        /* Check dimensions */
+        if (nRow < 1 || nCol < 2) {
+            ModelicaFormatError(
+                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
+                "dimensions for time interpolation.\n", tableName,
+                (unsigned long)nRow, (unsigned long)nCol);
+            isValid = 0;
+            return isValid;
+        }
+
+        /* Check column indices */
+        for (iCol = 0; iCol < tableID->nCols; ++iCol) {
+            const size_t col = (size_t)tableID->cols[iCol];
+            if (col < 1 || col > tableID->nCol) {
+                ModelicaFormatError("The column index %d is out of range "
+                    "for table matrix \"%s(%lu,%lu)\".\n", tableID->cols[iCol],
+                    tableName, (unsigned long)nRow, (unsigned long)nCol);
+            }
+        }
+
+        if (tableID->table != NULL && nRow > 1) {
+            const double* table = tableID->table;
+            /* Check period */
+            if (tableID->extrapolation == PERIODIC) {
+                const double tMin = TABLE_ROW0(0);
+                const double tMax = TABLE_COL0(nRow - 1);
+                const double T = tMax - tMin;
+                if (T <= 0) {
+                    ModelicaFormatError(
+                        "Table matrix \"%s\" does not have a positive period/cylce "
+                        "time for time interpolation with periodic "
+                        "extrapolation.\n", tableName);
+                    isValid = 0;
+                    return isValid;
+                }
+            }
+
+            /* Check, whether first column values are monotonically or strictly
+               increasing */
+            if (tableID->smoothness == AKIMA_C1 ||
+                tableID->smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
+                tableID->smoothness == STEFFEN_MONOTONE_C1) {
+                const size_t i = findNonIncreasing(table, nRow, nCol, 1);
+                if (i < nRow - 1) {
+                    double t0 = TABLE_COL0(i);
+                    double t1 = TABLE_COL0(i + 1);
+                    ModelicaFormatError(
+                        "The values of the first column of table \"%s(%lu,%lu)\" "
+                        "are not strictly increasing because %s(%lu,1) (=%lf) "
+                        ">= %s(%lu,1) (=%lf).\n", tableName, (unsigned long)nRow,
+                        (unsigned long)nCol, tableName, (unsigned long)i + 1, t0,
+                        tableName, (unsigned long)i + 2, t1);
+                    isValid = 0;
+                    return isValid;
+                }
+            }
+            else {
+                const size_t i = findNonIncreasing(table, nRow, nCol, 0);
+                if (i < nRow - 1) {
+                    double t0 = TABLE_COL0(i);
+                    double t1 = TABLE_COL0(i + 1);
+                    ModelicaFormatError(
+                        "The values of the first column of table \"%s(%lu,%lu)\" "
+                        "are not monotonically increasing because %s(%lu,1) "
+                        "(=%lf) > %s(%lu,1) (=%lf).\n", tableName,
+                        (unsigned long)nRow, (unsigned long)nCol, tableName,
+                        (unsigned long)i + 1, t0, tableName, (unsigned long)i +
+                        2, t1);
+                    isValid = 0;
+                    return isValid;
+                }
+            }
+        }
+    }
+
+    return isValid;
+}
+
+static int isValidCombiTable1D(const CombiTable1D* tableID) {
+    int isValid = 1;
+    if (tableID != NULL) {
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->nCol;
+        const char* tableName;
+        const char* tableDummyName = "NoName";
+        size_t iCol;
+
+        if (tableID->source == TABLESOURCE_MODEL) {
+            tableName = tableDummyName;
+        }
+        else {
+            tableName = tableID->tableName;
+        }
+
+        /* Check dimensions */
+        if (nRow < 1 || nCol < 2) {
+            ModelicaFormatError(
+                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
+                "dimensions for 1D-interpolation.\n", tableName,
+                (unsigned long)nRow, (unsigned long)nCol);
+            isValid = 0;
+            return isValid;
+        }
+
+        /* Check column indices */
+        for (iCol = 0; iCol < tableID->nCols; ++iCol) {
+            const size_t col = (size_t)tableID->cols[iCol];
+            if (col < 1 || col > tableID->nCol) {
+                ModelicaFormatError("The column index %d is out of range "
+                    "for table matrix \"%s(%lu,%lu)\".\n", tableID->cols[iCol],
+                    tableName, (unsigned long)nRow, (unsigned long)nCol);
+            }
+        }
+
+        if (tableID->table != NULL) {
+            const double* table = tableID->table;
+            /* Check, whether first column values are strictly increasing */
+            const size_t i = findNonIncreasing(table, nRow, nCol, 1);
+            if (i < nRow - 1) {
+                double x0 = TABLE_COL0(i);
+                double x1 = TABLE_COL0(i + 1);
+                ModelicaFormatError(
+                    "The values of the first column of table \"%s(%lu,%lu)\" are "
+                    "not strictly increasing because %s(%lu,1) (=%lf) >= "
+                    "%s(%lu,1) (=%lf).\n", tableName, (unsigned long)nRow,
+                    (unsigned long)nCol, tableName, (unsigned long)i + 1, x0,
+                    tableName, (unsigned long)i + 2, x1);
+                isValid = 0;
+                return isValid;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+static int isValidCombiTable2D(const CombiTable2D* tableID) {
+    int isValid = 1;
+    if (tableID != NULL) {
+        const size_t nRow = tableID->nRow;
+        const size_t nCol = tableID->nCol;
+        const char* tableName;
+        const char* tableDummyName = "NoName";
+
+        if (tableID->source == TABLESOURCE_MODEL) {
+            tableName = tableDummyName;
+        }
+        else {
+            tableName = tableID->tableName;
+        }
+
+        /* Check dimensions */
+        if (nRow < 2 || nCol < 2) {
+            ModelicaFormatError(
+                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
+                "dimensions for 2D-interpolation.\n", tableName,
+                (unsigned long)nRow, (unsigned long)nCol);
+            isValid = 0;
+            return isValid;
+        }
+
+        if (tableID->table != NULL) {
+            const double* table = tableID->table;
+            size_t i;
+            /* Check, whether first column values are strictly increasing */
+            i = 1 + findNonIncreasing(&TABLE_COL0(1), nRow - 1, nCol, 1);
+            if (i < nRow - 1) {
+                double x0 = TABLE_COL0(i);
+                double x1 = TABLE_COL0(i + 1);
+                ModelicaFormatError(
+                    "The values of the first column of table \"%s(%lu,%lu)\" are "
+                    "not strictly increasing because %s(%lu,1) (=%lf) >= "
+                    "%s(%lu,1) (=%lf).\n", tableName, (unsigned long)nRow,
+                    (unsigned long)nCol, tableName, (unsigned long)i + 1,
+                    x0, tableName, (unsigned long)i + 2, x1);
+                isValid = 0;
+                return isValid;
+            }
+
+            /* Check, whether first row values are strictly increasing */
+            i = 1 + findNonIncreasing(&TABLE_ROW0(1), nCol - 1, 1, 1);
+            if (i < nCol - 1) {
+                double y0 = TABLE_ROW0(i);
+                double y1 = TABLE_ROW0(i + 1);
+                ModelicaFormatError(
+                    "The values of the first row of table \"%s(%lu,%lu)\" are "
+                    "not strictly increasing because %s(1,%lu) (=%lf) >= "
+                    "%s(1,%lu) (=%lf).\n", tableName, (unsigned long)nRow,
+                    (unsigned long)nCol, tableName, (unsigned long)i + 1,
+                    y0, tableName, (unsigned long)i + 2, y1);
+                isValid = 0;
+                return isValid;
+            }
+        }
+    }
+
+    return isValid;
+}
+
+static int isValidCombiTableND(_In_ const CombiTableND* tableID,
+                               _In_z_ const char* tableName,
+                               _In_ const double* table, size_t nRow,
+                               size_t nCol) {
+    const size_t nDim = tableID->nDim;
+    const size_t nTable = nRow*nCol;
+    size_t nGrid = 0;
+    size_t nValue = 1;
+    size_t pos;
+    size_t k;
+
+    /* Check dimensions */
+    if (nDim < 1 || nDim > MAX_TABLE_ND_DIMENSIONS) {
+        ModelicaFormatError(
+            "The number of inputs (=%lu) of table \"%s\" is not in the range "
+            "of 1 to %d for N-D-interpolation.\n", (unsigned long)nDim,
+            tableName, MAX_TABLE_ND_DIMENSIONS);
+        return 0;
+    }
+    if ((nRow != 1 && nCol != 1) || nTable < 1 + nDim) {
+        ModelicaFormatError(
+            "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
+            "dimensions for N-D-interpolation (a vector of at least %lu "
+            "numbers is required).\n", tableName, (unsigned long)nRow,
+            (unsigned long)nCol, (unsigned long)(1 + nDim));
+        return 0;
+    }
+    if (table[0] != (double)nDim) {
+        ModelicaFormatError(
+            "The number of dimensions %s[1] (=%lf) of table \"%s\" is not "
+            "equal to the number of inputs (=%lu).\n", tableName, table[0],
+            tableName, (unsigned long)nDim);
+        return 0;
+    }
+    for (k = 0; k < nDim; k++) {
+        const double n = table[1 + k];
+        if (!(n >= 1) || n != floor(n) || n > (double)nTable) {
+            ModelicaFormatError(
+                "The number of grid points %s[%lu] (=%lf) of axis %lu of "
+                "table \"%s\" is not a positive integer less than the size "
+                "of the table.\n", tableName, (unsigned long)(2 + k), n,
+                (unsigned long)(1 + k), tableName);
+            return 0;
+        }
+        nGrid += (size_t)n;
+        if (nValue > nTable/(size_t)n) {
+            /* Too many values (and avoid the overflow of nValue) */
+            nValue = nTable + 1;
+            break;
+        }
+        nValue *= (size_t)n;
+    }
+    if (nValue > nTable || 1 + nDim + nGrid + nValue != nTable) {
+        ModelicaFormatError(
+            "The size (=%lu) of table \"%s\" is not equal to the number 1 + "
+            "%lu + %lu + %lu of its dimensions, grid points and values.\n",
+            (unsigned long)nTable, tableName, (unsigned long)nDim,
+            (unsigned long)nGrid, (unsigned long)nValue);
+        return 0;
+    }
+
+    /* Check, whether the grid points are strictly increasing */
+    pos = 1 + nDim;
+    for (k = 0; k < nDim; k++) {
+        const size_t n = (size_t)table[1 + k];
+        if (n > 1) {
+            const size_t i = findNonIncreasing(&table[pos], n, 1, 1);
+            if (i < n - 1) {
+                ModelicaFormatError(
+                    "The grid points of axis %lu of table \"%s\" are not "
+                    "strictly increasing because %s[%lu] (=%lf) >= %s[%lu] "
+                    "(=%lf).\n", (unsigned long)(1 + k), tableName,
+                    tableName, (unsigned long)(pos + i + 1), table[pos + i],
+                    tableName, (unsigned long)(pos + i + 2),
+                    table[pos + i + 1]);
+                return 0;
+            }
+        }
+        pos += n;
+    }
+
+    return 1;
+}
+
+static enum TableSource getTableSource(_In_z_ const char *tableName,
+                                       _In_z_ const char *fileName) {
+    enum TableSource tableSource;
+    int tableNameGiven = isValidName(tableName);
+    int fileNameGiven = isValidName(fileName);
+
+    /* Determine in which way the table values are defined */
+    if (tableNameGiven == 0) {
+        /* No table name is given */
+        if (fileNameGiven != 0) {
+            ModelicaFormatError(
+                "The file name for a table (= \"%s\") is defined, "
+                "but not the corresponding table name.\n", fileName);
+        }
+        tableSource = TABLESOURCE_MODEL;
+    }
+    else {
+        /* A table name is given */
+#if defined(NO_FILE_SYSTEM)
+        if (fileNameGiven != 0) {
+            ModelicaFormatError(
+                "The file name (= \"%s\") for a table (= \"%s\") is defined. "
+                "Since Modelica is used in an environment where storage cannot "
+                "be allocated (#define NO_FILE_SYSTEM), tables cannot be read "
+                "from file.\n", fileName, tableName);
+        }
+        tableSource = TABLESOURCE_FUNCTION;
+#else
+        tableSource =
+            fileNameGiven == 0 ? TABLESOURCE_FUNCTION : TABLESOURCE_FILE;
+#endif
+    }
+    return tableSource;
+}
+
+/* ----- Internal univariate spline functions ---- */
+
+static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
+                                         size_t nCol, _In_ const int* cols,
+                                         size_t nCols) {
+  /* Reference:
+
+     Hiroshi Akima. A new method of interpolation and smooth curve fitting
+     based on local procedures. Journal of the ACM, 17(4), 589-602, Oct. 1970.
+     (http://dx.doi.org/10.1145/321607.321609)
+  */
+
+    CubicHermite1D* spline = NULL;
+    double* d; /* Divided differences */
+    size_t col;
+
+    /* Actually there is no need for consecutive memory */
+    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
+    if (spline == NULL) {
+        return NULL;
+    }
+
+    d = (double*)malloc((nRow + 3)*sizeof(double));
+    if (d == NULL) {
+        free(spline);
+        return NULL;
+    }
+
+    for (col = 0; col < nCols; col++) {
+        size_t i;
+        double c2;
+
+        /* Calculation of the divided differences */
+        for (i = 0; i < nRow - 1; i++) {
+            d[i + 2] =
+                (TABLE(i + 1, cols[col] - 1) - TABLE(i, cols[col] - 1))/
+                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+        }
+
+        /* Extrapolation using non-periodic boundary conditions */
+        d[0] = 3*d[2] - 2*d[3];
+        d[1] = 2*d[2] - d[3];
+        d[nRow + 1] = 2*d[nRow] - d[nRow - 1];
+        d[nRow + 2] = 3*d[nRow] - 2*d[nRow - 1];
+
+        /* Initialization of the left boundary slope */
+        c2 = fabs(d[3] - d[2]) + fabs(d[1] - d[0]);
+        if (c2 > 0) {
+            const double a = fabs(d[1] - d[0])/c2;
+            c2 = (1 - a)*d[1] + a*d[2];
+        }
+        else {
+            c2 = 0.5*d[1] + 0.5*d[2];
+        }
+
+        /* Calculation of the 3(4) coefficients per interval */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            double* c = spline[IDX(i, col, nCols)];
+
+            c[2] = c2;
+            c2 = fabs(d[i + 4] - d[i + 3]) + fabs(d[i + 2] - d[i + 1]);
+            if (c2 > 0) {
+                const double a = fabs(d[i + 2] - d[i + 1])/c2;
+                c2 = (1 - a)*d[i + 2] + a*d[i + 3];
+            }
+            else {
+                c2 = 0.5*d[i + 2] + 0.5*d[i + 3];
+            }
+            c[1] = (3*d[i + 2] - 2*c[2] - c2)/dx;
+            c[0] = (c[2] + c2 - 2*d[i + 2])/(dx*dx);
+            /* No need to store the absolute term y0 */
+            /* c[3] = TABLE(i, cols[col] - 1); */
+        }
+    }
+
+    free(d);
+    return spline;
+}
+
+static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
+                                                  size_t nRow, size_t nCol,
+                                                  _In_ const int* cols,
+                                                  size_t nCols) {
+  /* Reference:
+
+     Frederick N. Fritsch and Judy Butland. A method for constructing local
+     monotone piecewise cubic interpolants. SIAM Journal on Scientific and
+     Statistical Computing, 5(2), 300-304, June 1984.
+     (http://dx.doi.org/10.1137/0905021)
+  */
+
+    CubicHermite1D* spline = NULL;
+    double* d; /* Divided differences */
+    size_t col;
+
+    /* Actually there is no need for consecutive memory */
+    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
+    if (spline == NULL) {
+        return NULL;
+    }
+
+    d = (double*)malloc((nRow - 1)*sizeof(double));
+    if (d == NULL) {
+        free(spline);
+        return NULL;
+    }
+
+    for (col = 0; col < nCols; col++) {
+        size_t i;
+        double c2;
+
+        /* Calculation of the divided differences */
+        for (i = 0; i < nRow - 1; i++) {
+            d[i] =
+                (TABLE(i + 1, cols[col] - 1) - TABLE(i, cols[col] - 1))/
+                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+        }
+
+        /* Initialization of the left boundary slope */
+        c2 = d[0];
+
+        /* Calculation of the 3(4) coefficients per interval */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            double* c = spline[IDX(i, col, nCols)];
+
+            c[2] = c2;
+            if (i == nRow - 2) {
+                c2 = d[nRow - 2];
+            }
+            else if (d[i] == 0 || d[i + 1] == 0 ||
+                (d[i] < 0 && d[i + 1] > 0) || (d[i] > 0 && d[i + 1] < 0)) {
+                c2 = 0;
+            }
+            else {
+                const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
+                c2 = 3*(dx + dx_)/((dx + 2*dx_)/d[i] + (dx_ + 2*dx)/d[i + 1]);
+            }
+            c[1] = (3*d[i] - 2*c[2] - c2)/dx;
+            c[0] = (c[2] + c2 - 2*d[i])/(dx*dx);
+            /* No need to store the absolute term y0 */
+            /* c[3] = TABLE(i, cols[col] - 1); */
+        }
+    }
+
+    free(d);
+    return spline;
+}
+
+static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
+                                           size_t nRow, size_t nCol,
+                                           _In_ const int* cols,
+                                           size_t nCols) {
+  /* Reference:
+
+     Matthias Steffen. A simple method for monotonic interpolation in one
+     dimension. Astronomy and Astrophysic, 239, 443-450, August 1990.
+     (https://trac.modelica.org/Modelica/attachment/ticket/1814/1990_Astronomy_and_Astrophysic_239_443S.pdf)
+  */
+
+    CubicHermite1D* spline = NULL;
+    double* d; /* Divided differences */
+    size_t col;
+
+    /* Actually there is no need for consecutive memory */
+    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
+    if (spline == NULL) {
+        return NULL;
+    }
+
+    d = (double*)malloc((nRow - 1)*sizeof(double));
+    if (d == NULL) {
+        free(spline);
+        return NULL;
+    }
+
+    for (col = 0; col < nCols; col++) {
+        size_t i;
+        double c2;
+
+        /* Calculation of the divided differences */
+        for (i = 0; i < nRow - 1; i++) {
+            d[i] =
+                (TABLE(i + 1, cols[col] - 1) - TABLE(i, cols[col] - 1))/
+                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+        }
+
+        /* Initialization of the left boundary slope */
+        c2 = d[0];
+
+        /* Calculation of the 3(4) coefficients per interval */
+        for (i = 0; i < nRow - 1; i++) {
+            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
+            double* c = spline[IDX(i, col, nCols)];
+
+            c[2] = c2;
+            if (i == nRow - 2) {
+                c2 = d[nRow - 2];
+            }
+            else if (d[i] == 0 || d[i + 1] == 0 ||
+                (d[i] < 0 && d[i + 1] > 0) || (d[i] > 0 && d[i + 1] < 0)) {
+                c2 = 0;
+            }
+            else {
+                const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
+                double half_abs_c2, abs_di, abs_di1;
+                c2 = (d[i]*dx_ + d[i + 1]*dx)/(dx + dx_);
+                half_abs_c2 = 0.5*fabs(c2);
+                abs_di = fabs(d[i]);
+                abs_di1 = fabs(d[i + 1]);
+                if (half_abs_c2 > abs_di || half_abs_c2 > abs_di1) {
+                    const double two_a = d[i] > 0 ? 2 : -2;
+                    c2 = two_a*(abs_di < abs_di1 ? abs_di : abs_di1);
+                }
+            }
+            c[1] = (3*d[i] - 2*c[2] - c2)/dx;
+            c[0] = (c[2] + c2 - 2*d[i])/(dx*dx);
+            /* No need to store the absolute term y0 */
+            /* c[3] = TABLE(i, cols[col] - 1); */
+        }
+    }
+
+    free(d);
+    return spline;
+}
+
+static void spline1DClose(CubicHermite1D** spline) {
+    if (spline != NULL && *spline != NULL) {
+        free(*spline);
+        *spline = NULL;
+    }
+}
+
+#if !defined(NO_FILE_SYSTEM)
+static CubicHermite1D* spline1DExtend(_In_ CubicHermite1D* spline,
+                                      enum Smoothness smoothness,
+                                      _In_ const double* table, size_t nKept,
+                                      size_t nRow, size_t nCol,
+                                      _In_ const int* cols, size_t nCols) {
+    CubicHermite1D* (*splineInit)(const double*, size_t, size_t, const int*,
+        size_t) = smoothness == AKIMA_C1 ? akimaSpline1DInit :
+        (smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ?
+        fritschButlandSpline1DInit : steffenSpline1DInit);
+    /* The coefficients of interval i depend on the rows i - 2 to i + 3
+       (Akima) or i - 1 to i + 2 (Fritsch-Butland and Steffen) -> The
+       intervals before nKept - 3 are unchanged and the intervals from
+       nKept - 3 on are exactly recalculated on the rows from nKept - 5 on */
+    const size_t first = nKept >= 5 ? nKept - 3 : 0;
+    CubicHermite1D* window;
+    CubicHermite1D* tmp;
+
+    if (first == 0) {
+        free(spline);
+        return splineInit(table, nRow, nCol, cols, nCols);
+    }
+    window = splineInit(&table[(first - 2)*nCol], nRow - first + 2, nCol,
+        cols, nCols);
+    if (window == NULL) {
+        free(spline);
+        return NULL;
+    }
+    tmp = (CubicHermite1D*)realloc(spline,
+        (nRow - 1)*nCols*sizeof(CubicHermite1D));
+    if (tmp == NULL) {
+        free(window);
+        free(spline);
+        return NULL;
+    }
+    memcpy(&tmp[IDX(first, 0, nCols)], &window[IDX(2, 0, nCols)],
+        (nRow - 1 - first)*nCols*sizeof(CubicHermite1D));
+    free(window);
+    return tmp;
+}
+#endif
+
+static int* monotony1DInit(_In_ const CombiTable1D* tableID) {
+    const double* table = tableID->table;
+    const size_t nRow = tableID->nRow;
+    const size_t nCol = ABSCISSA_STRIDE(tableID);
+    const float* tableFloat = tableID->tableFloat;
+    const size_t nColFloat = tableID->nCol - 1;
+    int* monotony = (int*)calloc(tableID->nCols > 0 ? tableID->nCols : 1,
+        sizeof(int));
+    size_t j;
+
+    if (monotony == NULL) {
+        return NULL;
+    }
+    if (nRow < 2 || tableID->smoothness == CONSTANT_SEGMENTS) {
+        return monotony;
+    }
+    for (j = 0; j < tableID->nCols; j++) {
+        const size_t col = (size_t)tableID->cols[j] - 1;
+        const int sign = TABLE_VALUE(1, col) > TABLE_VALUE(0, col) ? 1 : -1;
+        size_t i;
+        for (i = 0; i < nRow - 1; i++) {
+            const double dy = TABLE_VALUE(i + 1, col) - TABLE_VALUE(i, col);
+            if (sign*dy <= 0.) {
+                break;
+            }
+            if (NULL != tableID->spline || NULL != tableID->splineFloat) {
+                /* Sign of the derivative at both interval ends and at the
+                   extremum of the derivative (if within the interval) */
+                double cFloat[3];
+                const double* c = spline1DCoefficients(tableID->spline,
+                    tableID->splineFloat, IDX(i, j, tableID->nCols), cFloat);
+                const double h = TABLE_COL0(i + 1) - TABLE_COL0(i);
+                const double tol = -_EPSILON*sign*dy/h;
+                if (sign*c[2] < 0. ||
+                    sign*((3*c[0]*h + 2*c[1])*h + c[2]) < 0.) {
+                    break;
+                }
+                if (c[0] != 0.) {
+                    const double v = -c[1]/(3*c[0]);
+                    if (v > 0. && v < h &&
+                        sign*((3*c[0]*v + 2*c[1])*v + c[2]) < tol) {
+                        break;
+                    }
+                }
+            }
+        }
+        monotony[j] = i == nRow - 1 ? sign : 0;
+    }
+    return monotony;
+}
+
+static double spline1DInverse(_In_ const double* c, double h, double dy) {
+    /* Enclosing interval [v0, v1] of the solution */
+    double v0 = 0.;
+    double v1 = h;
+    const double dyMax = ((c[0]*h + c[1])*h + c[2])*h;
+    const double tol = 4*DBL_EPSILON*fabs(dyMax);
+    double v = dyMax != 0. ? h*(dy/dyMax) : 0.5*h;
+    int k;
+
+    if (!(v >= v0 && v <= v1)) {
+        v = 0.5*h;
+    }
+    for (k = 0; k < 100; k++) {
+        const double f = ((c[0]*v + c[1])*v + c[2])*v - dy;
+        const double df = (3*c[0]*v + 2*c[1])*v + c[2];
+        const double d2f = 6*c[0]*v + 2*c[1];
+        double vNew;
+        if (fabs(f) <= tol) {
+            break;
+        }
+        /* The spline piece increases (dyMax > 0) or decreases */
+        if ((f < 0.) == (dyMax > 0.)) {
+            v0 = v;
+        }
+        else {
+            v1 = v;
+        }
+        /* Halley step, which converges faster than the Newton step if the
+           derivative is small at one end of the interval */
+        vNew = v - 2*f*df/(2*df*df - f*d2f);
+        if (!(vNew > v0 && vNew < v1)) {
+            /* Bisection */
+            vNew = v0 + 0.5*(v1 - v0);
+        }
+        if (v1 - v0 <= 4*DBL_EPSILON*h) {
+            v = vNew;
+            break;
+        }
+        v = vNew;
+    }
+    return v;
+}
+
+/* ----- Internal bivariate spline functions ---- */
+
+static void spline1DExtrapolateLeft(double x1, double x2, double x3, double x4,
+                                    double x5, double* y1, double* y2,
+                                    double y3, double y4, double y5) {
+    const double a = x4 - x5;
+    const double b = x3 - x4;
+    const double c = x2 - x3;
+
+    if (a == 0. || b == 0. || c == 0.) {
+        *y2 = y3;
+        *y1 = y3;
+    }
+    else {
+        const double d = x1 - x2;
+        const double e = y4 - y5;
+        const double f = y3 - y4;
+        *y2 = c*(2*f/b - e/a) + y3;
+        *y1 = *y2 + d*((*y2 - y3)/c + f/b - e/a);
+    }
+}
+
+static void spline1DExtrapolateRight(double x1, double x2, double x3, double x4,
+                                     double x5, double y1, double y2, double y3,
+                                     double* y4, double* y5) {
+    const double a = x2 - x1;
+    const double b = x3 - x2;
+    const double c = x4 - x3;
+
+    if (a == 0. || b == 0. || c == 0.) {
+        *y4 = y3;
+        *y5 = y3;
+    }
+    else {
+        const double d = x5 - x4;
+        const double e = y2 - y1;
+        const double f = y3 - y2;
+        *y4 = c*(2*f/b - e/a) + y3;
+        *y5 = *y4 + d*((*y4 - y3)/c + f/b - e/a);
+    }
+}
+
+static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
+                                    size_t nCol) {
+  /* Reference:
+
+     Hiroshi Akima. A method of bivariate interpolation and smooth surface
+     fitting based on local procedures. Communications of the ACM, 17(1), 18-20,
+     Jan. 1974. (http://dx.doi.org/10.1145/360767.360779)
+  */
+
+    CubicHermite2D* spline = NULL;
+    if (nRow == 2 /* && nCol > 3 */) {
+        CubicHermite1D* spline1D;
+        size_t j;
+        int cols = 2;
+
+        /* Need to transpose */
+        double* tableT = (double*)malloc(2*(nCol - 1)*sizeof(double));
+        if (tableT == NULL) {
+            return NULL;
+        }
+
+        spline = (CubicHermite2D*)malloc((nCol - 1)*sizeof(CubicHermite2D));
+        if (spline == NULL) {
+            free(tableT);
+            return NULL;
         }
 
-        /* Check column indices */
-        for (iCol = 0; iCol < tableID->nCols; ++iCol) {
-            const size_t col = (size_t)tableID->cols[iCol];
-            if (col < 1 || col > tableID->nCol) {
-                ModelicaFormatError("The column index %d is out of range "
-                    "for table matrix \"%s(%lu,%lu)\".\n", tableID->cols[iCol],
-                    tableName, (unsigned long)nRow, (unsigned long)nCol);
-            }
+        for (j = 1; j < nCol; j++) {
+            tableT[IDX(j - 1, 0, 2)] = TABLE_ROW0(j);
+            tableT[IDX(j - 1, 1, 2)] = TABLE(1, j);
         }
 
-        if (tableID->table != NULL) {
-            const double* table = tableID->table;
-            size_t i;
-            /* Check, whether first column values are strictly increasing */
-            for (i = 0; i < nRow - 1; i++) {
-                double x0 = TABLE_COL0(i);
-                double x1 = TABLE_COL0(i + 1);
-                if (x0 >= x1) {
-                    ModelicaFormatError(
-                        "The values of the first column of table \"%s(%lu,%lu)\" are "
-                        "not strictly increasing because %s(%lu,1) (=%lf) >= "
-                        "%s(%lu,1) (=%lf).\n", tableName, (unsigned long)nRow,
-                        (unsigned long)nCol, tableName, (unsigned long)i + 1, x0,
-                        tableName, (unsigned long)i + 2, x1);
-                    isValid = 0;
-                    return isValid;
-                }
-            }
+        spline1D = akimaSpline1DInit(tableT, nCol - 1, 2, &cols, 1);
+        free(tableT);
+        if (spline1D == NULL) {
+            free(spline);
+            return NULL;
+        }
+        /* Copy coefficients */
+        for (j = 0; j < nCol - 1; j++) {
+            const double* c1 = spline1D[j];
+            double* c2 = spline[j];
+            c2[0] = c1[0];
+            c2[1] = c1[1];
+            c2[2] = c1[2];
         }
+        spline1DClose(&spline1D);
     }
+    else if (/*nRow > 3 && */ nCol == 2) {
+        CubicHermite1D* spline1D;
+        size_t i;
+        int cols = 2;
 
-    return isValid;
-}
-
-static int isValidCombiTable2D(const CombiTable2D* tableID) {
-    int isValid = 1;
-    if (tableID != NULL) {
-        const size_t nRow = tableID->nRow;
-        const size_t nCol = tableID->nCol;
-        const char* tableName;
-        const char* tableDummyName = "NoName";
+        spline = (CubicHermite2D*)malloc((nRow - 1)*sizeof(CubicHermite2D));
+        if (spline == NULL) {
+            return NULL;
+        }
 
-        if (tableID->source == TABLESOURCE_MODEL) {
-            tableName = tableDummyName;
+        spline1D = akimaSpline1DInit(&table[2], nRow - 1, 2, &cols, 1);
+        if (spline1D == NULL) {
+            free(spline);
+            return NULL;
         }
-        else {
-            tableName = tableID->tableName;
+        /* Copy coefficients */
+        for (i = 0; i < nRow - 1; i++) {
+            const double* c1 = spline1D[i];
+            double* c2 = spline[i];
+            c2[0] = c1[0];
+            c2[1] = c1[1];
+            c2[2] = c1[2];
         }
-
-        /* Check dimensions */
-        if (nRow < 2 || nCol < 2) {
-            ModelicaFormatError(
-                "Table matrix \"%s(%lu,%lu)\" does not have appropriate "
-                "dimensions for 2D-interpolation.\n", tableName,
-                (unsigned long)nRow, (unsigned long)nCol);
-            isValid = 0;
-            return isValid;
+        spline1DClose(&spline1D);
+    }
+    else /* if (nRow > 2 && nCol > 2) */ {
+        /* Bands of at most 64 rows of grid cells limit the temporary
+           memory of the extended table and partial derivatives */
+        const size_t band = 64;
+        double* xy = spline2DExtendedGrid(table, nRow, nCol);
+        size_t i;
+        if (xy == NULL) {
+            return NULL;
         }
 
-        if (tableID->table != NULL) {
-            const double* table = tableID->table;
-            size_t i;
-            /* Check, whether first column values are strictly increasing */
-            for (i = 1; i < nRow - 1; i++) {
-                double x0 = TABLE_COL0(i);
-                double x1 = TABLE_COL0(i + 1);
-                if (x0 >= x1) {
-                    ModelicaFormatError(
-                        "The values of the first column of table \"%s(%lu,%lu)\" are "
-                        "not strictly increasing because %s(%lu,1) (=%lf) >= "
-                        "%s(%lu,1) (=%lf).\n", tableName, (unsigned long)nRow,
-                        (unsigned long)nCol, tableName, (unsigned long)i + 1,
-                        x0, tableName, (unsigned long)i + 2, x1);
-                    isValid = 0;
-                    return isValid;
-                }
-            }
+        /* Actually there is no need for consecutive memory */
+        spline = (CubicHermite2D*)malloc((nRow - 2)*(nCol - 2)*sizeof(CubicHermite2D));
+        if (spline == NULL) {
+            free(xy);
+            return NULL;
+        }
 
-            /* Check, whether first row values are strictly increasing */
-            for (i = 1; i < nCol - 1; i++) {
-                double y0 = TABLE_ROW0(i);
-                double y1 = TABLE_ROW0(i + 1);
-                if (y0 >= y1) {
-                    ModelicaFormatError(
-                        "The values of the first row of table \"%s(%lu,%lu)\" are "
-                        "not strictly increasing because %s(1,%lu) (=%lf) >= "
-                        "%s(1,%lu) (=%lf).\n", tableName, (unsigned long)nRow,
-                        (unsigned long)nCol, tableName, (unsigned long)i + 1,
-                        y0, tableName, (unsigned long)i + 2, y1);
-                    isValid = 0;
-                    return isValid;
-                }
+        for (i = 0; i < nRow - 2; i += band) {
+            const size_t i1 = nRow - 2 - i > band ? i + band : nRow - 2;
+            if (!spline2DTile(table, nRow, nCol, xy, &xy[nRow + 3], i, i1, 0,
+                nCol - 2, &spline[IDX(i, 0, nCol - 2)], nCol - 2)) {
+                free(spline);
+                free(xy);
+                return NULL;
             }
         }
+        free(xy);
     }
-
-    return isValid;
+    return spline;
 }
 
-static enum TableSource getTableSource(_In_z_ const char *tableName,
-                                       _In_z_ const char *fileName) {
-    enum TableSource tableSource;
-    int tableNameGiven = isValidName(tableName);
-    int fileNameGiven = isValidName(fileName);
+static void spline2DClose(CubicHermite2D** spline) {
+    if (spline != NULL && *spline != NULL) {
+        free(*spline);
+        *spline = NULL;
+    }
+}
 
-    /* Determine in which way the table values are defined */
-    if (tableNameGiven == 0) {
-        /* No table name is given */
-        if (fileNameGiven != 0) {
-            ModelicaFormatError(
-                "The file name for a table (= \"%s\") is defined, "
-                "but not the corresponding table name.\n", fileName);
-        }
-        tableSource = TABLESOURCE_MODEL;
+static double* spline2DExtendedGrid(_In_ const double* table, size_t nRow,
+                                    size_t nCol) {
+    double* x = (double*)malloc((nRow + nCol + 6)*sizeof(double));
+    double* y;
+    size_t i;
+    if (x == NULL) {
+        return NULL;
+    }
+    y = &x[nRow + 3];
+
+    /* Copy of x coordinates with extrapolated boundary coordinates */
+    if (nRow == 3) {
+        /* Linear extrapolation */
+        x[0] = 3*TABLE_COL0(1) - 2*TABLE_COL0(2);
+        x[1] = 2*TABLE_COL0(1) - TABLE_COL0(2);
+        x[2] = TABLE_COL0(1);
+        x[3] = TABLE_COL0(2);
+        x[4] = 2*TABLE_COL0(2) - TABLE_COL0(1);
+        x[5] = 3*TABLE_COL0(2) - 2*TABLE_COL0(1);
     }
     else {
-        /* A table name is given */
-#if defined(NO_FILE_SYSTEM)
-        if (fileNameGiven != 0) {
-            ModelicaFormatError(
-                "The file name (= \"%s\") for a table (= \"%s\") is defined. "
-                "Since Modelica is used in an environment where storage cannot "
-                "be allocated (#define NO_FILE_SYSTEM), tables cannot be read "
-                "from file.\n", fileName, tableName);
+        x[0] = 2*TABLE_COL0(1) - TABLE_COL0(3);
+        x[1] = TABLE_COL0(1) + TABLE_COL0(2) - TABLE_COL0(3);
+        for (i = 1; i < nRow; i++) {
+            x[i + 1] = TABLE_COL0(i);
         }
-        tableSource = TABLESOURCE_FUNCTION;
-#else
-        tableSource =
-            fileNameGiven == 0 ? TABLESOURCE_FUNCTION : TABLESOURCE_FILE;
-#endif
+        x[nRow + 1] = TABLE_COL0(nRow - 1) +
+            TABLE_COL0(nRow - 2) - TABLE_COL0(nRow - 3);
+        x[nRow + 2] = 2*TABLE_COL0(nRow - 1) - TABLE_COL0(nRow - 3);
     }
-    return tableSource;
+
+    /* Copy of y coordinates with extrapolated boundary coordinates */
+    if (nCol == 3) {
+        /* Linear extrapolation */
+        y[0] = 3*TABLE_ROW0(1) - 2*TABLE_ROW0(2);
+        y[1] = 2*TABLE_ROW0(1) - TABLE_ROW0(2);
+        y[2] = TABLE_ROW0(1);
+        y[3] = TABLE_ROW0(2);
+        y[4] = 2*TABLE_ROW0(2) - TABLE_ROW0(1);
+        y[5] = 3*TABLE_ROW0(2) - 2*TABLE_ROW0(1);
+    }
+    else {
+        y[0] = 2*TABLE_ROW0(1) - TABLE_ROW0(3);
+        y[1] = TABLE_ROW0(1) + TABLE_ROW0(2) - TABLE_ROW0(3);
+        memcpy(&y[2], &TABLE_ROW0(1), (nCol - 1)*sizeof(double));
+        y[nCol + 1] = TABLE_ROW0(nCol - 1) +
+            TABLE_ROW0(nCol - 2) - TABLE_ROW0(nCol - 3);
+        y[nCol + 2] = 2*TABLE_ROW0(nCol - 1) - TABLE_ROW0(nCol - 3);
+    }
+    return x;
 }
 
-/* ----- Internal univariate spline functions ---- */
+static void spline2DExtendedRow(_In_ const double* table, size_t nCol,
+                                _In_ const double* y, size_t i, size_t j0,
+                                size_t j1, _Out_ double* z) {
+    double left0 = 0.;
+    double left1 = 0.;
+    double right0 = 0.;
+    double right1 = 0.;
+    size_t j;
+
+    /* Extrapolate table data in y direction */
+    if (j0 < 2) {
+        if (nCol == 3) {
+            /* Linear extrapolation */
+            left0 = 3*TABLE(i, 1) - 2*TABLE(i, 2);
+            left1 = 2*TABLE(i, 1) - TABLE(i, 2);
+        }
+        else {
+            spline1DExtrapolateLeft(y[0], y[1], y[2], y[3], y[4], &left0,
+                &left1, TABLE(i, 1), TABLE(i, 2), TABLE(i, 3));
+        }
+    }
+    if (j1 > nCol + 1) {
+        if (nCol == 3) {
+            /* Linear extrapolation */
+            right0 = 2*TABLE(i, 2) - TABLE(i, 1);
+            right1 = 3*TABLE(i, 2) - 2*TABLE(i, 1);
+        }
+        else {
+            spline1DExtrapolateRight(y[nCol - 2], y[nCol - 1], y[nCol],
+                y[nCol + 1], y[nCol + 2], TABLE(i, nCol - 3),
+                TABLE(i, nCol - 2), TABLE(i, nCol - 1), &right0, &right1);
+        }
+    }
+    for (j = j0; j < j1; j++) {
+        if (j < 2) {
+            z[j - j0] = j == 0 ? left0 : left1;
+        }
+        else if (j <= nCol) {
+            z[j - j0] = TABLE(i, j - 1);
+        }
+        else {
+            z[j - j0] = j == nCol + 1 ? right0 : right1;
+        }
+    }
+}
 
-static CubicHermite1D* akimaSpline1DInit(_In_ const double* table, size_t nRow,
-                                         size_t nCol, _In_ const int* cols,
-                                         size_t nCols) {
+static int spline2DTile(_In_ const double* table, size_t nRow, size_t nCol,
+                        _In_ const double* x, _In_ const double* y, size_t i0,
+                        size_t i1, size_t j0, size_t j1,
+                        _Out_ CubicHermite2D* spline, size_t stride) {
   /* Reference:
 
-     Hiroshi Akima. A new method of interpolation and smooth curve fitting
-     based on local procedures. Journal of the ACM, 17(4), 589-602, Oct. 1970.
-     (http://dx.doi.org/10.1145/321607.321609)
+     Hiroshi Akima. A method of bivariate interpolation and smooth surface
+     fitting based on local procedures. Communications of the ACM, 17(1), 18-20,
+     Jan. 1974. (http://dx.doi.org/10.1145/360767.360779)
   */
 
-    CubicHermite1D* spline = NULL;
-    double* d; /* Divided differences */
-    size_t col;
-
-    /* Actually there is no need for consecutive memory */
-    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
-    if (spline == NULL) {
-        return NULL;
+    /* The partial derivatives at grid point (i, j) of the table (i.e., at
+       TABLE(i + 1, j + 1)) are calculated from the 5 x 5 values around row
+       i + 2 and column j + 2 of the table extended by two extrapolated rows
+       and columns on each side. The coefficients of grid cell (i, j) depend
+       on the partial derivatives at its four corners. Hence, rows
+       i0 <= i < i1 + 5 and columns j0 <= j < j1 + 5 of the extended table
+       are required. */
+#define TABLE_EX(i, j) tableEx[IDX((i) - i0, (j) - j0, w)]
+#define DERIV(a, i, j) a[IDX((i) - i0, (j) - j0, wd)]
+    const size_t h = i1 - i0 + 5;
+    const size_t w = j1 - j0 + 5;
+    const size_t wd = j1 - j0 + 1;
+    const size_t nd = (i1 - i0 + 1)*wd;
+    const size_t nBuffer = h*w + 3*w + 3*nd;
+    double buffer[SPLINE2D_TILE_BUFFER]; /* Work space of small tiles */
+    double* tableEx;
+    double* rows; /* Extended rows used for the extrapolation in x
+        direction */
+    double* dz_dx;
+    double* dz_dy;
+    double* d2z_dxdy;
+    int rowsSide = 0; /* -1/1: rows holds the first/last extended rows */
+    size_t i, j;
+
+    if (nBuffer <= SPLINE2D_TILE_BUFFER) {
+        tableEx = buffer;
     }
-
-    d = (double*)malloc((nRow + 3)*sizeof(double));
-    if (d == NULL) {
-        free(spline);
-        return NULL;
+    else {
+        tableEx = (double*)malloc(nBuffer*sizeof(double));
+        if (tableEx == NULL) {
+            return 0;
+        }
     }
-
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
-
-        /* Calculation of the divided differences */
-        for (i = 0; i < nRow - 1; i++) {
-            d[i + 2] =
-                (TABLE(i + 1, cols[col] - 1) - TABLE(i, cols[col] - 1))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+    rows = &tableEx[h*w];
+    dz_dx = &rows[3*w];
+    dz_dy = &dz_dx[nd];
+    d2z_dxdy = &dz_dy[nd];
+
+    /* Copy of table with extrapolated boundary values */
+    for (i = i0; i < i0 + h; i++) {
+        double* z = &TABLE_EX(i, j0);
+        if (i >= 2 && i <= nRow) {
+            /* Copy table row */
+            spline2DExtendedRow(table, nCol, y, i - 1, j0, j0 + w, z);
         }
-
-        /* Extrapolation using non-periodic boundary conditions */
-        d[0] = 3*d[2] - 2*d[3];
-        d[1] = 2*d[2] - d[3];
-        d[nRow + 1] = 2*d[nRow] - d[nRow - 1];
-        d[nRow + 2] = 3*d[nRow] - 2*d[nRow - 1];
-
-        /* Initialization of the left boundary slope */
-        c2 = fabs(d[3] - d[2]) + fabs(d[1] - d[0]);
-        if (c2 > 0) {
-            const double a = fabs(d[1] - d[0])/c2;
-            c2 = (1 - a)*d[1] + a*d[2];
+        else if (nRow == 3) {
+            /* Linear extrapolation in x direction */
+            if (rowsSide == 0) {
+                spline2DExtendedRow(table, nCol, y, 1, j0, j0 + w, rows);
+                spline2DExtendedRow(table, nCol, y, 2, j0, j0 + w, &rows[w]);
+                rowsSide = 1;
+            }
+            for (j = 0; j < w; j++) {
+                const double z2 = rows[j];
+                const double z3 = rows[w + j];
+                switch (i) {
+                    case 0:
+                        z[j] = 3*z2 - 2*z3;
+                        break;
+                    case 1:
+                        z[j] = 2*z2 - z3;
+                        break;
+                    case 4:
+                        z[j] = 2*z3 - z2;
+                        break;
+                    default:
+                        z[j] = 3*z3 - 2*z2;
+                        break;
+                }
+            }
+        }
+        else if (i < 2) {
+            /* Extrapolate table data in x direction */
+            if (rowsSide != -1) {
+                spline2DExtendedRow(table, nCol, y, 1, j0, j0 + w, rows);
+                spline2DExtendedRow(table, nCol, y, 2, j0, j0 + w, &rows[w]);
+                spline2DExtendedRow(table, nCol, y, 3, j0, j0 + w,
+                    &rows[2*w]);
+                rowsSide = -1;
+            }
+            for (j = 0; j < w; j++) {
+                double z0, z1;
+                spline1DExtrapolateLeft(x[0], x[1], x[2], x[3], x[4], &z0, &z1,
+                    rows[j], rows[w + j], rows[2*w + j]);
+                z[j] = i == 0 ? z0 : z1;
+            }
         }
         else {
-            c2 = 0.5*d[1] + 0.5*d[2];
+            /* Extrapolate table data in x direction */
+            if (rowsSide != 1) {
+                spline2DExtendedRow(table, nCol, y, nRow - 3, j0, j0 + w,
+                    rows);
+                spline2DExtendedRow(table, nCol, y, nRow - 2, j0, j0 + w,
+                    &rows[w]);
+                spline2DExtendedRow(table, nCol, y, nRow - 1, j0, j0 + w,
+                    &rows[2*w]);
+                rowsSide = 1;
+            }
+            for (j = 0; j < w; j++) {
+                double z3, z4;
+                spline1DExtrapolateRight(x[nRow - 2], x[nRow - 1], x[nRow],
+                    x[nRow + 1], x[nRow + 2], rows[j], rows[w + j],
+                    rows[2*w + j], &z3, &z4);
+                z[j] = i == nRow + 1 ? z3 : z4;
+            }
         }
+    }
 
-        /* Calculation of the 3(4) coefficients per interval */
-        for (i = 0; i < nRow - 1; i++) {
-            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
+    /* Calculation of the partial derivatives */
+    for (i = i0 + 2; i < i1 + 3; i++) {
+        for (j = j0 + 2; j < j1 + 3; j++) {
+            /* Divided differences */
+            double d31, d32, d33, d34, d22, d23, d42, d43;
+            /* Weights */
+            double wx2, wx3, wy2, wy3;
+
+            /* Partial derivatives in x direction */
+            d31 = (TABLE_EX(i - 1, j) - TABLE_EX(i - 2, j))/
+                (x[i - 1] - x[i - 2]); /* = c13 */
+            d32 = (TABLE_EX(i, j) - TABLE_EX(i - 1, j))/
+                (x[i] - x[i - 1]); /* = c23 */
+            d33 = (TABLE_EX(i + 1, j) - TABLE_EX(i, j))/
+                (x[i + 1] - x[i]); /* = c33 */
+            d34 = (TABLE_EX(i + 2, j) - TABLE_EX(i + 1, j))/
+                (x[i + 2] - x[i + 1]); /* = c43 */
+            if (d31 == d32 && d33 == d34) {
+                wx2 = 0.;
+                wx3 = 0.;
+                DERIV(dz_dx, i - 2, j - 2) = 0.5*d32 + 0.5*d33;
+            }
+            else {
+                wx2 = fabs(d34 - d33);
+                wx3 = fabs(d32 - d31);
+                DERIV(dz_dx, i - 2, j - 2) = (wx2*d32 + wx3*d33)/
+                    (wx2 + wx3);
+            }
 
-            c[2] = c2;
-            c2 = fabs(d[i + 4] - d[i + 3]) + fabs(d[i + 2] - d[i + 1]);
-            if (c2 > 0) {
-                const double a = fabs(d[i + 2] - d[i + 1])/c2;
-                c2 = (1 - a)*d[i + 2] + a*d[i + 3];
+            /* Partial derivatives in y direction */
+            d31 = (TABLE_EX(i, j - 1) - TABLE_EX(i, j - 2))/
+                (y[j - 1] - y[j - 2]);
+            d32 = (TABLE_EX(i, j) - TABLE_EX(i, j - 1))/
+                (y[j] - y[j - 1]);
+            d33 = (TABLE_EX(i, j + 1) - TABLE_EX(i, j))/
+                (y[j + 1] - y[j]);
+            d34 = (TABLE_EX(i, j + 2) - TABLE_EX(i, j + 1))/
+                (y[j + 2] - y[j + 1]);
+            if (d31 == d32 && d33 == d34) {
+                wy2 = 0.;
+                wy3 = 0.;
+                DERIV(dz_dy, i - 2, j - 2) = 0.5*d32 + 0.5*d33;
+            }
+            else {
+                wy2 = fabs(d34 - d33);
+                wy3 = fabs(d32 - d31);
+                DERIV(dz_dy, i - 2, j - 2) = (wy2*d32 + wy3*d33)/
+                    (wy2 + wy3);
+            }
+
+            /* Partial cross derivatives */
+            d22 = (TABLE_EX(i - 1, j) - TABLE_EX(i - 1, j - 1))/
+                (y[j] - y[j - 1]);
+            d23 = (TABLE_EX(i - 1, j + 1) - TABLE_EX(i - 1, j))/
+                (y[j + 1] - y[j]);
+            d42 = (TABLE_EX(i + 1, j) - TABLE_EX(i + 1, j - 1))/
+                (y[j] - y[j - 1]);
+            d43 = (TABLE_EX(i + 1, j + 1) - TABLE_EX(i + 1, j))/
+                (y[j + 1] - y[j]);
+            d22 = (d32 - d22)/(x[i] - x[i - 1]); /* = e22 */
+            d23 = (d33 - d23)/(x[i] - x[i - 1]); /* = e23 */
+            d32 = (d42 - d32)/(x[i + 1] - x[i]); /* = e32 */
+            d33 = (d43 - d33)/(x[i + 1] - x[i]); /* = e33 */
+            if (wx2 == 0. && wx3 == 0.) {
+                wx2 = 1.;
+                wx3 = 1.;
             }
-            else {
-                c2 = 0.5*d[i + 2] + 0.5*d[i + 3];
+            if (wy2 == 0. && wy3 == 0.) {
+                wy2 = 1.;
+                wy3 = 1.;
             }
-            c[1] = (3*d[i + 2] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i + 2])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
+            DERIV(d2z_dxdy, i - 2, j - 2) =
+                (wx2*(wy2*d22 + wy3*d23) + wx3*(wy2*d32 + wy3*d33))/
+                ((wx2 + wx3)*(wy2 + wy3));
         }
     }
 
-    free(d);
-    return spline;
+    /* Calculation of the 15(16) coefficients per grid */
+    for (i = i0; i < i1; i++) {
+        const double dx = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
+        const double dx_2 = dx*dx;
+        const double dx_3 = dx_2*dx;
+        for (j = j0; j < j1; j++) {
+            const double z00 = TABLE(i + 1, j + 1);
+            const double z01 = TABLE(i + 1, j + 2);
+            const double z10 = TABLE(i + 2, j + 1);
+            const double z11 = TABLE(i + 2, j + 2);
+            const double dy = TABLE_ROW0(j + 2) - TABLE_ROW0(j + 1);
+            const double dy_2 = dy*dy;
+            const double dy_3 = dy_2*dy;
+            double zx00, zx01, zx10, zx11;
+            double zy00, zy01, zy10, zy11;
+            double zxy00, zxy01, zxy10, zxy11;
+            double t1, t2, t3, t4, t5, t6, t7, t8, t9;
+            double t10, t11, t12, t13, t14;
+            double* c = spline[IDX(i - i0, j - j0, stride)];
+
+            c[11] = DERIV(dz_dx, i, j);
+            zx00 = c[11]*dx;
+            zx01 = DERIV(dz_dx, i, j + 1)*dx;
+            zx10 = DERIV(dz_dx, i + 1, j)*dx;
+            zx11 = DERIV(dz_dx, i + 1, j + 1)*dx;
+            c[14] = DERIV(dz_dy, i, j);
+            zy00 = c[14]*dy;
+            zy01 = DERIV(dz_dy, i, j + 1)*dy;
+            zy10 = DERIV(dz_dy, i + 1, j)*dy;
+            zy11 = DERIV(dz_dy, i + 1, j + 1)*dy;
+            c[10] = DERIV(d2z_dxdy, i, j);
+            zxy00 = c[10]*dx*dy;
+            zxy01 = DERIV(d2z_dxdy, i, j + 1)*dx*dy;
+            zxy10 = DERIV(d2z_dxdy, i + 1, j)*dx*dy;
+            zxy11 = DERIV(d2z_dxdy, i + 1, j + 1)*dx*dy;
+            t1 = z00 - z10;
+            t2 = zx00 + zx10;
+            t3 = zy00 - zy10;
+            t4 = zy11 - zy01;
+            t5 = zxy00 + zxy10;
+            t6 = zxy11 + zxy01;
+            t7 = 2*zx00 + zx10;
+            t8 = 2*zxy00 + zxy10;
+            t9 = zxy11 + 2*zxy01;
+            t10 = zx00 - zx01;
+            t11 = z00 - z01;
+            t12 = t1 + (z11 - z01);
+            t13 = t3 - t4;
+            t4 = 2*t3 - t4;
+            t14 = 2*t12 + (t2 - (zx11 + zx01));
+            t12 = 3*t12 + (t7 - (zx11 + 2*zx01));
+            c[0] = (2*t14 + (2*t13 + (t5 + t6)))/(dx_3*dy_3);
+            c[1] = -(3*t14 + (2*t4 + (2*t5 + t6)))/(dx_3*dy_2);
+            c[2] = (2*t3 + t5)/(dx_3*dy);
+            c[3] = (2*t1 + t2)/dx_3;
+            c[4] = -(2*t12 + (3*t13 + (t8 + t9)))/(dx_2*dy_3);
+            c[5] = (3*t12 + (3*t4 + (2*t8 + t9)))/(dx_2*dy_2);
+            c[6] = -(3*t3 + t8)/(dx_2*dy);
+            c[7] = -(3*t1 + t7)/dx_2;
+            c[8] = (2*t10 + (zxy00 + zxy01))/(dx*dy_3);
+            c[9] = -(3*t10 + (2*zxy00 + zxy01))/(dx*dy_2);
+            c[12] = (2*t11 + (zy00 + zy01))/dy_3;
+            c[13] = -(3*t11 + (2*zy00 + zy01))/dy_2;
+            /* No need to store the absolute term z00 */
+            /* c[15] = z00; */
+        }
+    }
+
+    if (tableEx != buffer) {
+        free(tableEx);
+    }
+    return 1;
+#undef DERIV
+#undef TABLE_EX
 }
 
-static CubicHermite1D* fritschButlandSpline1DInit(_In_ const double* table,
-                                                  size_t nRow, size_t nCol,
-                                                  _In_ const int* cols,
-                                                  size_t nCols) {
-  /* Reference:
+/* ----- Internal functions of the Akima spline coefficient cache ---- */
 
-     Frederick N. Fritsch and Judy Butland. A method for constructing local
-     monotone piecewise cubic interpolants. SIAM Journal on Scientific and
-     Statistical Computing, 5(2), 300-304, June 1984.
-     (http://dx.doi.org/10.1137/0905021)
-  */
+static size_t akimaCacheBudget(void) {
+#if defined(TABLE_SHARE)
+    const char* env = getenv("MODELICA_TABLE_AKIMA_CACHE");
+    if (NULL != env && '\0' != env[0]) {
+        char* end;
+        double budget = strtod(env, &end);
+        switch (*end) {
+            case 'k':
+            case 'K':
+                budget *= 1024.;
+                break;
+            case 'm':
+            case 'M':
+                budget *= 1024.*1024.;
+                break;
+            case 'g':
+            case 'G':
+                budget *= 1024.*1024.*1024.;
+                break;
+            default:
+                break;
+        }
+        if (!(budget > 0.)) {
+            return 0;
+        }
+        return budget < (double)(size_t)-1 ? (size_t)budget : (size_t)-1;
+    }
+    return (size_t)(TABLE_AKIMA_CACHE);
+#else
+    return 0;
+#endif
+}
 
-    CubicHermite1D* spline = NULL;
-    double* d; /* Divided differences */
-    size_t col;
+static int isAkimaGrid2D(_In_ const CombiTable2D* tableID) {
+    return tableID->nRow > 2 && tableID->nCol > 2;
+}
 
-    /* Actually there is no need for consecutive memory */
-    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
-    if (spline == NULL) {
+static AkimaGrid* akimaGridNew(_In_ const double* table, size_t nRow,
+                               size_t nCol) {
+    const size_t nTile1 = (nRow - 2 + TABLE_AKIMA_TILE - 1)/TABLE_AKIMA_TILE;
+    const size_t nTile2 = (nCol - 2 + TABLE_AKIMA_TILE - 1)/TABLE_AKIMA_TILE;
+    const size_t budget = akimaCacheBudget();
+    AkimaGrid* grid = (AkimaGrid*)calloc(1, sizeof(AkimaGrid));
+    if (grid == NULL) {
         return NULL;
     }
-
-    d = (double*)malloc((nRow - 1)*sizeof(double));
-    if (d == NULL) {
-        free(spline);
+    grid->table = table;
+    grid->nRow = nRow;
+    grid->nCol = nCol;
+    grid->nTile2 = nTile2;
+    grid->lastCell = (size_t)-1;
+    grid->xy = spline2DExtendedGrid(table, nRow, nCol);
+    grid->tiles = (AkimaTile**)calloc(nTile1*nTile2, sizeof(AkimaTile*));
+    if (grid->xy == NULL || grid->tiles == NULL) {
+        free(grid->xy);
+        free(grid->tiles);
+        free(grid);
         return NULL;
     }
+    if (budget > 0) {
+        /* The budget of the last initialized table applies */
+        MUTEX_LOCK();
+        akimaCacheLimit = budget;
+        MUTEX_UNLOCK();
+    }
+    return grid;
+}
 
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
-
-        /* Calculation of the divided differences */
-        for (i = 0; i < nRow - 1; i++) {
-            d[i] =
-                (TABLE(i + 1, cols[col] - 1) - TABLE(i, cols[col] - 1))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
-        }
-
-        /* Initialization of the left boundary slope */
-        c2 = d[0];
+static void akimaCacheUnlink(_Inout_ AkimaTile* tile) {
+    if (NULL != tile->prev) {
+        tile->prev->next = tile->next;
+    }
+    else {
+        akimaCacheFirst = tile->next;
+    }
+    if (NULL != tile->next) {
+        tile->next->prev = tile->prev;
+    }
+    else {
+        akimaCacheLast = tile->prev;
+    }
+    tile->prev = NULL;
+    tile->next = NULL;
+}
 
-        /* Calculation of the 3(4) coefficients per interval */
-        for (i = 0; i < nRow - 1; i++) {
-            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
+static void akimaCacheRemove(_Inout_ AkimaTile* tile) {
+    akimaCacheUnlink(tile);
+    akimaCacheSize -= tile->size;
+    tile->grid->tiles[tile->index] = NULL;
+    free(tile);
+}
 
-            c[2] = c2;
-            if (i == nRow - 2) {
-                c2 = d[nRow - 2];
+static void akimaGridClose(_Inout_ AkimaGrid** grid) {
+    if (NULL != *grid) {
+        const size_t nTile = ((*grid)->nRow - 2 + TABLE_AKIMA_TILE - 1)/
+            TABLE_AKIMA_TILE*(*grid)->nTile2;
+        size_t k;
+        MUTEX_LOCK();
+        for (k = 0; k < nTile; k++) {
+            if (NULL != (*grid)->tiles[k]) {
+                akimaCacheRemove((*grid)->tiles[k]);
             }
-            else if (d[i] == 0 || d[i + 1] == 0 ||
-                (d[i] < 0 && d[i + 1] > 0) || (d[i] > 0 && d[i + 1] < 0)) {
-                c2 = 0;
+        }
+        MUTEX_UNLOCK();
+        free((*grid)->tiles);
+        free((*grid)->xy);
+        free(*grid);
+        *grid = NULL;
+    }
+}
+
+static const double* akimaGridCoefficients(_Inout_ AkimaGrid* grid, size_t i,
+                                           size_t j) {
+    const size_t cell = IDX(i, j, grid->nCol - 2);
+    if (cell != grid->lastCell) {
+        const size_t i0 = i/TABLE_AKIMA_TILE*TABLE_AKIMA_TILE;
+        const size_t j0 = j/TABLE_AKIMA_TILE*TABLE_AKIMA_TILE;
+        const size_t index = IDX(i/TABLE_AKIMA_TILE, j/TABLE_AKIMA_TILE,
+            grid->nTile2);
+        AkimaTile* tile;
+        MUTEX_LOCK();
+        tile = grid->tiles[index];
+        if (NULL == tile) {
+            /* Calculate the tile */
+            const size_t nRow = grid->nRow;
+            const size_t i1 = nRow - 2 - i0 > TABLE_AKIMA_TILE ?
+                i0 + TABLE_AKIMA_TILE : nRow - 2;
+            const size_t j1 = grid->nCol - 2 - j0 > TABLE_AKIMA_TILE ?
+                j0 + TABLE_AKIMA_TILE : grid->nCol - 2;
+            const size_t size = sizeof(AkimaTile) +
+                (i1 - i0)*(j1 - j0)*sizeof(CubicHermite2D);
+            if (akimaCacheSize + size > akimaCacheLimit &&
+                NULL != akimaCacheLast && akimaCacheLast->size == size) {
+                /* Reuse the least recently used tile */
+                tile = akimaCacheLast;
+                akimaCacheUnlink(tile);
+                akimaCacheSize -= size;
+                tile->grid->tiles[tile->index] = NULL;
             }
             else {
-                const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
-                c2 = 3*(dx + dx_)/((dx + 2*dx_)/d[i] + (dx_ + 2*dx)/d[i + 1]);
+                tile = (AkimaTile*)malloc(size);
+            }
+            if (NULL != tile) {
+                /* The coefficients follow the tile */
+                tile->spline = (CubicHermite2D*)(tile + 1);
+                if (!spline2DTile(grid->table, nRow, grid->nCol, grid->xy,
+                    &grid->xy[nRow + 3], i0, i1, j0, j1, tile->spline,
+                    j1 - j0)) {
+                    free(tile);
+                    tile = NULL;
+                }
+            }
+            if (NULL == tile) {
+                MUTEX_UNLOCK();
+                ModelicaError("Memory allocation error\n");
+                return grid->coefficients;
+            }
+            MODELICA_PROFILE_COUNT(splineTiles, 1);
+            tile->prev = NULL;
+            tile->next = NULL;
+            tile->grid = grid;
+            tile->index = index;
+            tile->width = j1 - j0;
+            tile->size = size;
+            grid->tiles[index] = tile;
+            akimaCacheSize += tile->size;
+            /* Discard the least recently used tiles (except the new one) */
+            while (akimaCacheSize > akimaCacheLimit && NULL != akimaCacheLast) {
+                akimaCacheRemove(akimaCacheLast);
             }
-            c[1] = (3*d[i] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
         }
+        else {
+            akimaCacheUnlink(tile);
+        }
+        /* Insert as most recently used tile */
+        tile->next = akimaCacheFirst;
+        if (NULL != akimaCacheFirst) {
+            akimaCacheFirst->prev = tile;
+        }
+        else {
+            akimaCacheLast = tile;
+        }
+        akimaCacheFirst = tile;
+        memcpy(grid->coefficients, tile->spline[IDX(i - i0, j - j0,
+            tile->width)], sizeof(CubicHermite2D));
+        grid->lastCell = cell;
+        MUTEX_UNLOCK();
     }
-
-    free(d);
-    return spline;
+    return grid->coefficients;
 }
 
-static CubicHermite1D* steffenSpline1DInit(_In_ const double* table,
-                                           size_t nRow, size_t nCol,
-                                           _In_ const int* cols,
-                                           size_t nCols) {
-  /* Reference:
-
-     Matthias Steffen. A simple method for monotonic interpolation in one
-     dimension. Astronomy and Astrophysic, 239, 443-450, August 1990.
-     (https://trac.modelica.org/Modelica/attachment/ticket/1814/1990_Astronomy_and_Astrophysic_239_443S.pdf)
-  */
-
-    CubicHermite1D* spline = NULL;
-    double* d; /* Divided differences */
-    size_t col;
-
-    /* Actually there is no need for consecutive memory */
-    spline = (CubicHermite1D*)malloc((nRow - 1)*nCols*sizeof(CubicHermite1D));
-    if (spline == NULL) {
-        return NULL;
+/* ----- Internal N-D table functions ---- */
+
+static int tableNDInit(_Inout_ CombiTableND* tableID,
+                       _In_ const double* table) {
+    const size_t nDim = tableID->nDim;
+    const double* src;
+    size_t edge[MAX_TABLE_ND_DIMENSIONS];
+    size_t nTile[MAX_TABLE_ND_DIMENSIONS];
+    size_t index[MAX_TABLE_ND_DIMENSIONS];
+    size_t nGrid = 0;
+    size_t nValue = 1;
+    size_t nBlock = 1;
+    size_t tileSize = 1;
+    size_t tileStride;
+    size_t stride;
+    size_t start;
+    size_t i;
+    size_t k;
+
+    tableNDClose(tableID);
+
+    /* The value block is divided into tiles of edge[0] x ... x
+       edge[nDim - 1] grid points. The tiles and the values within a tile
+       are stored in row-major order (last axis varies fastest). An axis of
+       less than 2*TABLE_ND_TILE grid points is not divided, the last tile of
+       a divided axis is padded. */
+    for (k = 0; k < nDim; k++) {
+        const size_t n = (size_t)table[1 + k];
+        edge[k] = n < 2*TABLE_ND_TILE ? n : TABLE_ND_TILE;
+        nTile[k] = (n + edge[k] - 1)/edge[k];
+        nGrid += n;
+        nValue *= n;
+        nBlock *= nTile[k]*edge[k];
+        tileSize *= edge[k];
     }
-
-    d = (double*)malloc((nRow - 1)*sizeof(double));
-    if (d == NULL) {
-        free(spline);
-        return NULL;
+    tableID->axis = (TableNDAxis*)calloc(nDim, sizeof(TableNDAxis));
+    tableID->axes = (double*)malloc(nGrid*sizeof(double));
+    tableID->invWidth = (double*)malloc(nGrid*sizeof(double));
+    tableID->offset = (size_t*)malloc(nGrid*sizeof(size_t));
+    tableID->values = (double*)calloc(nBlock, sizeof(double));
+    if (tableID->smoothness == AKIMA_C1) {
+        tableID->slope = (double*)malloc(3*nGrid*sizeof(double));
     }
-
-    for (col = 0; col < nCols; col++) {
-        size_t i;
-        double c2;
-
-        /* Calculation of the divided differences */
-        for (i = 0; i < nRow - 1; i++) {
-            d[i] =
-                (TABLE(i + 1, cols[col] - 1) - TABLE(i, cols[col] - 1))/
-                (TABLE_COL0(i + 1) - TABLE_COL0(i));
+    if (NULL == tableID->axis || NULL == tableID->axes ||
+        NULL == tableID->invWidth || NULL == tableID->offset ||
+        NULL == tableID->values ||
+        (tableID->smoothness == AKIMA_C1 && NULL == tableID->slope)) {
+        tableNDClose(tableID);
+        return 0;
+    }
+    memcpy(tableID->axes, &table[1 + nDim], nGrid*sizeof(double));
+
+    tileStride = tileSize;
+    stride = 1;
+    start = nGrid;
+    for (k = nDim; k-- > 0;) {
+        TableNDAxis* axis = &tableID->axis[k];
+        const size_t n = (size_t)table[1 + k];
+        const double* x = &tableID->axes[start - n];
+        double* invWidth = &tableID->invWidth[start - n];
+        size_t* offset = &tableID->offset[start - n];
+        start -= n;
+        axis->n = n;
+        axis->x = x;
+        axis->invWidth = invWidth;
+        axis->offset = offset;
+        for (i = 0; i < n; i++) {
+            offset[i] = (i/edge[k])*tileStride + (i % edge[k])*stride;
         }
+        for (i = 0; i + 1 < n; i++) {
+            invWidth[i] = 1/(x[i + 1] - x[i]);
+        }
+        if (NULL != tableID->slope && n > 2) {
+            /* Weights c of the slope at x[i], the derivative of the parabola
+               through the grid points x[i0], x[i0 + 1] and x[i0 + 2], where
+               i0 = i - 1 at an inner grid point (i.e., the slope of the
+               Catmull-Rom spline on an equidistant grid) and i0 = 0 or
+               n - 3 at the first or last grid point:
+               dy/dx(x[i]) = c[0]*y[i0] + c[1]*y[i0 + 1] + c[2]*y[i0 + 2] */
+            double* c = &tableID->slope[3*start];
+            axis->slope = c;
+            for (i = 0; i < n; i++, c += 3) {
+                const size_t i0 = i == 0 ? 0 : (i + 1 == n ? n - 3 : i - 1);
+                const double h0 = x[i0 + 1] - x[i0];
+                const double h1 = x[i0 + 2] - x[i0 + 1];
+                const double h = h0 + h1;
+                if (i == 0) {
+                    c[0] = -(2*h0 + h1)/(h0*h);
+                    c[2] = -h0/(h1*h);
+                }
+                else if (i + 1 == n) {
+                    c[0] = h1/(h0*h);
+                    c[2] = (2*h1 + h0)/(h1*h);
+                }
+                else {
+                    c[0] = -h1/(h0*h);
+                    c[2] = h0/(h1*h);
+                }
+                /* The slope of constant values is zero */
+                c[1] = -(c[0] + c[2]);
+            }
+        }
+        tileStride *= nTile[k];
+        stride *= edge[k];
+    }
 
-        /* Initialization of the left boundary slope */
-        c2 = d[0];
-
-        /* Calculation of the 3(4) coefficients per interval */
-        for (i = 0; i < nRow - 1; i++) {
-            const double dx = TABLE_COL0(i + 1) - TABLE_COL0(i);
-            double* c = spline[IDX(i, col, nCols)];
-
-            c[2] = c2;
-            if (i == nRow - 2) {
-                c2 = d[nRow - 2];
+    /* Copy the values to the tiled value block */
+    src = &table[1 + nDim + nGrid];
+    memset(index, 0, sizeof(index));
+    for (i = 0; i < nValue; i++) {
+        size_t pos = 0;
+        for (k = 0; k < nDim; k++) {
+            pos += tableID->axis[k].offset[index[k]];
+        }
+        tableID->values[pos] = src[i];
+        for (k = nDim; k-- > 0;) {
+            if (++index[k] < tableID->axis[k].n) {
+                break;
             }
-            else if (d[i] == 0 || d[i + 1] == 0 ||
-                (d[i] < 0 && d[i + 1] > 0) || (d[i] > 0 && d[i + 1] < 0)) {
-                c2 = 0;
+            index[k] = 0;
+        }
+    }
+    if (tableID->storage == STORAGE_FLOAT) {
+        float* y = (float*)malloc(nBlock*sizeof(float));
+        if (NULL != y) {
+            if (toFloat(y, (const double*)tableID->values, nBlock)) {
+                free(tableID->values);
+                tableID->values = NULL;
+                tableID->valuesFloat = y;
             }
             else {
-                const double dx_ = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
-                double half_abs_c2, abs_di, abs_di1;
-                c2 = (d[i]*dx_ + d[i + 1]*dx)/(dx + dx_);
-                half_abs_c2 = 0.5*fabs(c2);
-                abs_di = fabs(d[i]);
-                abs_di1 = fabs(d[i + 1]);
-                if (half_abs_c2 > abs_di || half_abs_c2 > abs_di1) {
-                    const double two_a = d[i] > 0 ? 2 : -2;
-                    c2 = two_a*(abs_di < abs_di1 ? abs_di : abs_di1);
-                }
+                free(y);
             }
-            c[1] = (3*d[i] - 2*c[2] - c2)/dx;
-            c[0] = (c[2] + c2 - 2*d[i])/(dx*dx);
-            /* No need to store the absolute term y0 */
-            /* c[3] = TABLE(i, cols[col] - 1); */
         }
     }
+    return 1;
+}
 
-    free(d);
-    return spline;
+static void tableNDClose(_Inout_ CombiTableND* tableID) {
+    free(tableID->axis);
+    tableID->axis = NULL;
+    free(tableID->axes);
+    tableID->axes = NULL;
+    free(tableID->invWidth);
+    tableID->invWidth = NULL;
+    free(tableID->slope);
+    tableID->slope = NULL;
+    free(tableID->offset);
+    tableID->offset = NULL;
+    free(tableID->values);
+    tableID->values = NULL;
+    free(tableID->valuesFloat);
+    tableID->valuesFloat = NULL;
 }
 
-static void spline1DClose(CubicHermite1D** spline) {
-    if (spline != NULL && *spline != NULL) {
-        free(*spline);
-        *spline = NULL;
-    }
+static TABLE_ALWAYS_INLINE void tableNDAddSlope(_In_ const TableNDAxis* axis,
+                                                size_t i, size_t i0,
+                                                double scale,
+                                                _Inout_ double* w) {
+    const size_t n = axis->n;
+    const size_t j = (i == 0 ? 0 : (i + 1 == n ? n - 3 : i - 1)) - i0;
+    const double* c = &axis->slope[3*i];
+    w[j] += scale*c[0];
+    w[j + 1] += scale*c[1];
+    w[j + 2] += scale*c[2];
 }
 
-/* ----- Internal bivariate spline functions ---- */
+static TABLE_ALWAYS_INLINE size_t tableNDWeights(
+    _Inout_ TableNDAxis* axis, double u, enum Smoothness smoothness,
+    enum Extrapolation extrapolation, _Out_ double* w, _Out_ double* dw,
+    _Out_ size_t* nw) {
+    const size_t n = axis->n;
+    const double* x = axis->x;
+    enum PointInterval extrapolate = IN_TABLE;
+    size_t i;
 
-static void spline1DExtrapolateLeft(double x1, double x2, double x3, double x4,
-                                    double x5, double* y1, double* y2,
-                                    double y3, double y4, double y5) {
-    const double a = x4 - x5;
-    const double b = x3 - x4;
-    const double c = x2 - x3;
+    if (n == 1) {
+        /* Single grid point */
+        w[0] = 1.;
+        dw[0] = 0.;
+        *nw = 1;
+        return 0;
+    }
 
-    if (a == 0. || b == 0. || c == 0.) {
-        *y2 = y3;
-        *y1 = y3;
+    /* Periodic extrapolation */
+    if (extrapolation == PERIODIC) {
+        u = periodicShift(u, x[0], x[n - 1]);
+        i = findColIndex(x, n, axis->last, u);
+        axis->last = i;
+    }
+    else if (u < x[0]) {
+        extrapolate = LEFT;
+        i = 0;
+    }
+    else if (u > x[n - 1]) {
+        extrapolate = RIGHT;
+        i = n - 2;
     }
     else {
-        const double d = x1 - x2;
-        const double e = y4 - y5;
-        const double f = y3 - y4;
-        *y2 = c*(2*f/b - e/a) + y3;
-        *y1 = *y2 + d*((*y2 - y3)/c + f/b - e/a);
+        i = findColIndex(x, n, axis->last, u);
+        axis->last = i;
     }
-}
 
-static void spline1DExtrapolateRight(double x1, double x2, double x3, double x4,
-                                     double x5, double y1, double y2, double y3,
-                                     double* y4, double* y5) {
-    const double a = x2 - x1;
-    const double b = x3 - x2;
-    const double c = x4 - x3;
+    if (extrapolate != IN_TABLE) {
+        /* Extrapolation */
+        MODELICA_PROFILE_COUNT(extrapolations, 1);
+        switch (extrapolation) {
+            case LAST_TWO_POINTS:
+                break;
 
-    if (a == 0. || b == 0. || c == 0.) {
-        *y4 = y3;
-        *y5 = y3;
-    }
-    else {
-        const double d = x5 - x4;
-        const double e = y2 - y1;
-        const double f = y3 - y2;
-        *y4 = c*(2*f/b - e/a) + y3;
-        *y5 = *y4 + d*((*y4 - y3)/c + f/b - e/a);
+            case HOLD_LAST_POINT:
+                w[0] = 1.;
+                dw[0] = 0.;
+                *nw = 1;
+                return extrapolate == RIGHT ? n - 1 : 0;
+
+            case NO_EXTRAPOLATION:
+                ModelicaError("Extrapolation error\n");
+                *nw = 0;
+                return 0;
+
+            default:
+                ModelicaError("Unknown extrapolation kind\n");
+                *nw = 0;
+                return 0;
+        }
     }
-}
 
-static CubicHermite2D* spline2DInit(_In_ const double* table, size_t nRow,
-                                    size_t nCol) {
-  /* Reference:
+    switch (smoothness) {
+        case LINEAR_SEGMENTS:
+            break;
 
-     Hiroshi Akima. A method of bivariate interpolation and smooth surface
-     fitting based on local procedures. Communications of the ACM, 17(1), 18-20,
-     Jan. 1974. (http://dx.doi.org/10.1145/360767.360779)
-  */
+        case CONSTANT_SEGMENTS:
+            if (extrapolate == IN_TABLE) {
+                if (u >= x[i + 1]) {
+                    i += 1;
+                }
+                w[0] = 1.;
+                dw[0] = 0.;
+                *nw = 1;
+                return i;
+            }
+            /* Linear extrapolation */
+            break;
+
+        case AKIMA_C1:
+            if (n > 2) {
+                /* Cubic Hermite interpolation with the slopes of tableNDInit
+                   or linear extrapolation with the slope at the first or
+                   last grid point */
+                size_t i0 = i > 0 ? i - 1 : 0;
+                if (i0 + 4 > n) {
+                    i0 = n > 4 ? n - 4 : 0;
+                }
+                *nw = n > 4 ? 4 : n;
+                w[0] = w[1] = w[2] = w[3] = 0.;
+                dw[0] = dw[1] = dw[2] = dw[3] = 0.;
+                if (extrapolate == IN_TABLE) {
+                    const double h = x[i + 1] - x[i];
+                    const double t = DIV_WIDTH(u - x[i], x[i], x[i + 1],
+                        axis->invWidth[i]);
+                    const double dt = DIV_WIDTH(1., x[i], x[i + 1],
+                        axis->invWidth[i]);
+                    w[i - i0] = (1 + 2*t)*(1 - t)*(1 - t);
+                    w[i + 1 - i0] = t*t*(3 - 2*t);
+                    dw[i - i0] = 6*t*(t - 1)*dt;
+                    dw[i + 1 - i0] = -dw[i - i0];
+                    tableNDAddSlope(axis, i, i0, h*t*(1 - t)*(1 - t), w);
+                    tableNDAddSlope(axis, i + 1, i0, h*t*t*(t - 1), w);
+                    tableNDAddSlope(axis, i, i0, (1 - t)*(1 - 3*t), dw);
+                    tableNDAddSlope(axis, i + 1, i0, t*(3*t - 2), dw);
+                }
+                else {
+                    const size_t j = extrapolate == LEFT ? 0 : n - 1;
+                    w[j - i0] = 1.;
+                    tableNDAddSlope(axis, j, i0, u - x[j], w);
+                    tableNDAddSlope(axis, j, i0, 1., dw);
+                }
+                return i0;
+            }
+            /* Linear interpolation of two grid points */
+            break;
 
-#define TABLE_EX(i, j) tableEx[IDX(i, j, nCol + 3)]
-    CubicHermite2D* spline = NULL;
-    if (nRow == 2 /* && nCol > 3 */) {
-        CubicHermite1D* spline1D;
-        size_t j;
-        int cols = 2;
+        default:
+            ModelicaError("Unknown smoothness kind\n");
+            *nw = 0;
+            return 0;
+    }
+
+    /* Linear interpolation or extrapolation */
+    {
+        const double t = DIV_WIDTH(u - x[i], x[i], x[i + 1],
+            axis->invWidth[i]);
+        const double dt = DIV_WIDTH(1., x[i], x[i + 1], axis->invWidth[i]);
+        w[0] = 1 - t;
+        w[1] = t;
+        dw[0] = -dt;
+        dw[1] = dt;
+        *nw = 2;
+    }
+    return i;
+}
 
-        /* Need to transpose */
-        double* tableT = (double*)malloc(2*(nCol - 1)*sizeof(double));
-        if (tableT == NULL) {
-            return NULL;
-        }
+/* ----- Internal shared 2D table functions ---- */
 
-        spline = (CubicHermite2D*)malloc((nCol - 1)*sizeof(CubicHermite2D));
-        if (spline == NULL) {
-            free(tableT);
-            return NULL;
-        }
+static SharedTable2D* sharedTable2DFind(_In_z_ const char* tableName,
+                                        _In_z_ const char* validName) {
+    SharedTable2D* entry;
 
-        for (j = 1; j < nCol; j++) {
-            tableT[IDX(j - 1, 0, 2)] = TABLE_ROW0(j);
-            tableT[IDX(j - 1, 1, 2)] = TABLE(1, j);
+    for (entry = sharedTable2D; NULL != entry; entry = entry->next) {
+        if (0 == strcmp(entry->tableName, tableName) &&
+            0 == strcmp(entry->validName, validName)) {
+            return entry;
         }
-
-        spline1D = akimaSpline1DInit(tableT, nCol - 1, 2, &cols, 1);
-        free(tableT);
-        if (spline1D == NULL) {
-            free(spline);
+    }
+    /* Registry miss -> Insert new entry, the two names share one
+       allocation */
+    entry = (SharedTable2D*)calloc(1, sizeof(SharedTable2D));
+    if (NULL != entry) {
+        entry->tableName = (char*)malloc(strlen(tableName) +
+            strlen(validName) + 2);
+        if (NULL == entry->tableName) {
+            free(entry);
             return NULL;
         }
-        /* Copy coefficients */
-        for (j = 0; j < nCol - 1; j++) {
-            const double* c1 = spline1D[j];
-            double* c2 = spline[j];
-            c2[0] = c1[0];
-            c2[1] = c1[1];
-            c2[2] = c1[2];
-        }
-        spline1DClose(&spline1D);
+        entry->validName = entry->tableName + strlen(tableName) + 1;
+        strcpy(entry->tableName, tableName);
+        strcpy(entry->validName, validName);
+        entry->state = SHAREDTABLE_NEW;
+        entry->next = sharedTable2D;
+        sharedTable2D = entry;
     }
-    else if (/*nRow > 3 && */ nCol == 2) {
-        CubicHermite1D* spline1D;
-        size_t i;
-        int cols = 2;
+    return entry;
+}
 
-        spline = (CubicHermite2D*)malloc((nRow - 1)*sizeof(CubicHermite2D));
-        if (spline == NULL) {
-            return NULL;
-        }
+static SharedTable2D* sharedTable2DGet(_In_z_ const char* tableName,
+                                       _In_z_ const char* validName,
+                                       _Out_ int* status) {
+    SharedTable2D* entry;
+    enum SharedTableState state = SHAREDTABLE_UNAVAILABLE;
 
-        spline1D = akimaSpline1DInit(&table[2], nRow - 1, 2, &cols, 1);
-        if (spline1D == NULL) {
-            free(spline);
-            return NULL;
-        }
-        /* Copy coefficients */
-        for (i = 0; i < nRow - 1; i++) {
-            const double* c1 = spline1D[i];
-            double* c2 = spline[i];
-            c2[0] = c1[0];
-            c2[1] = c1[1];
-            c2[2] = c1[2];
-        }
-        spline1DClose(&spline1D);
+    MUTEX_LOCK();
+    entry = sharedTable2DFind(tableName, validName);
+    if (NULL != entry) {
+        state = entry->state;
+    }
+    MUTEX_UNLOCK();
+    if (NULL == entry) {
+        *status = 0;
+        ModelicaError("Memory allocation error\n");
+        return NULL;
     }
-    else /* if (nRow > 2 && nCol > 2) */ {
-        size_t i, j;
-        double* dz_dx;
-        double* dz_dy;
-        double* d2z_dxdy;
-        double* tableEx;
-        double* x;
-        double* y;
 
-        /* This is not the most memory efficient implementation since the table
-           memory is temporarily doubled for the sake of a clean calculation of
-           the partial derivatives without special consideration of the boundary
-           regions.
-        */
+    /* The tables of a loaded entry are not changed anymore */
+    *status = SHAREDTABLE_LOADED == state ? 1 :
+        (SHAREDTABLE_NEW == state ? -1 : 0);
+    return SHAREDTABLE_LOADED == state ? entry : NULL;
+}
 
-        /* Copy of x coordinates with extrapolated boundary coordinates */
-        x = (double*)malloc((nRow + 3)*sizeof(double));
-        if (x == NULL) {
-            return NULL;
-        }
-        if (nRow == 3) {
-            /* Linear extrapolation */
-            x[0] = 3*TABLE_COL0(1) - 2*TABLE_COL0(2);
-            x[1] = 2*TABLE_COL0(1) - TABLE_COL0(2);
-            x[2] = TABLE_COL0(1);
-            x[3] = TABLE_COL0(2);
-            x[4] = 2*TABLE_COL0(2) - TABLE_COL0(1);
-            x[5] = 3*TABLE_COL0(2) - 2*TABLE_COL0(1);
+static int sharedTable2DInit(_Inout_ SharedTable2D* entry,
+                             _In_ const double* table, size_t nRow,
+                             size_t nCol, const double* valid) {
+    double* values;
+    size_t i;
+
+    /* Check the table before the initialization, which would fail with
+       ModelicaError otherwise */
+    if (nRow < 2 || nCol < 2 ||
+        findNonIncreasing(&table[nCol], nRow - 1, nCol, 1) < nRow - 2 ||
+        findNonIncreasing(&table[1], nCol - 1, 1, 1) < nCol - 2) {
+        return 0;
+    }
+    if (NULL != valid) {
+        /* The table of validity must have the same grid */
+        for (i = 1; i < nRow; i++) {
+            if (valid[i*nCol] != table[i*nCol]) {
+                return 0;
+            }
         }
-        else {
-            x[0] = 2*TABLE_COL0(1) - TABLE_COL0(3);
-            x[1] = TABLE_COL0(1) + TABLE_COL0(2) - TABLE_COL0(3);
-            for (i = 1; i < nRow; i++) {
-                x[i + 1] = TABLE_COL0(i);
+        for (i = 1; i < nCol; i++) {
+            if (valid[i] != table[i]) {
+                return 0;
             }
-            x[nRow + 1] = TABLE_COL0(nRow - 1) +
-                TABLE_COL0(nRow - 2) - TABLE_COL0(nRow - 3);
-            x[nRow + 2] = 2*TABLE_COL0(nRow - 1) - TABLE_COL0(nRow - 3);
         }
+    }
 
-        /* Copy of y coordinates with extrapolated boundary coordinates */
-        y = (double*)malloc((nCol + 3)*sizeof(double));
-        if (y == NULL) {
-            free(x);
-            return NULL;
-        }
-        if (nCol == 3) {
-            /* Linear extrapolation */
-            y[0] = 3*TABLE_ROW0(1) - 2*TABLE_ROW0(2);
-            y[1] = 2*TABLE_ROW0(1) - TABLE_ROW0(2);
-            y[2] = TABLE_ROW0(1);
-            y[3] = TABLE_ROW0(2);
-            y[4] = 2*TABLE_ROW0(2) - TABLE_ROW0(1);
-            y[5] = 3*TABLE_ROW0(2) - 2*TABLE_ROW0(1);
-        }
-        else {
-            y[0] = 2*TABLE_ROW0(1) - TABLE_ROW0(3);
-            y[1] = TABLE_ROW0(1) + TABLE_ROW0(2) - TABLE_ROW0(3);
-            memcpy(&y[2], &TABLE_ROW0(1), (nCol - 1)*sizeof(double));
-            y[nCol + 1] = TABLE_ROW0(nCol - 1) +
-                TABLE_ROW0(nCol - 2) - TABLE_ROW0(nCol - 3);
-            y[nCol + 2] = 2*TABLE_ROW0(nCol - 1) - TABLE_ROW0(nCol - 3);
+#if defined(NO_TABLE_COPY)
+    /* The tables refer to the values, which are only valid during the call
+       of ModelicaStandardTables_SharedTable2D_setTables */
+    values = (double*)malloc((NULL != valid ? 2 : 1)*nRow*nCol*
+        sizeof(double));
+    if (NULL == values) {
+        ModelicaError("Memory allocation error\n");
+        return 0;
+    }
+    memcpy(values, table, nRow*nCol*sizeof(double));
+    if (NULL != valid) {
+        memcpy(&values[nRow*nCol], valid, nRow*nCol*sizeof(double));
+    }
+    entry->values = values;
+#else
+    values = (double*)table;
+#endif
+    entry->table = (CombiTable2D*)ModelicaStandardTables_CombiTable2D_init2(
+        "NoName", "NoName", values, nRow, nCol, AKIMA_C1, STORAGE_DEFAULT);
+    if (NULL != valid) {
+#if defined(NO_TABLE_COPY)
+        values = &values[nRow*nCol];
+#else
+        values = (double*)valid;
+#endif
+        entry->valid = (CombiTable2D*)ModelicaStandardTables_CombiTable2D_init2(
+            "NoName", "NoName", values, nRow, nCol, LINEAR_SEGMENTS,
+            STORAGE_DEFAULT);
+    }
+    entry->u1Min = table[nCol];
+    entry->u1Max = table[(nRow - 1)*nCol];
+    entry->u2Min = table[1];
+    entry->u2Max = table[nCol - 1];
+    return 1;
+}
+
+static int sharedTable2DIsValid(_In_ SharedTable2D* entry, double u1,
+                                double u2) {
+    /* The negated comparisons are also true for NaN */
+    if (!(u1 >= entry->u1Min && u1 <= entry->u1Max &&
+        u2 >= entry->u2Min && u2 <= entry->u2Max)) {
+        return 0;
+    }
+    /* The bilinear interpolation of the validity is 1 only if all table
+       values of the grid cell of (u1, u2) are valid */
+    return NULL == entry->valid ||
+        entry->valid->getValue(entry->valid, u1, u2) >= 1. - _EPSILON;
+}
+
+/* ----- Internal storage precision functions ---- */
+
+static TABLE_ALWAYS_INLINE const double* spline1DCoefficients(
+    const CubicHermite1D* spline, const CubicHermite1DFloat* splineFloat,
+    size_t k, _Out_ double* buffer) {
+    if (NULL != splineFloat) {
+        const float* c = splineFloat[k];
+        buffer[0] = c[0];
+        buffer[1] = c[1];
+        buffer[2] = c[2];
+        return buffer;
+    }
+    return spline[k];
+}
+
+static TABLE_ALWAYS_INLINE const double* spline2DCoefficients(
+    const CubicHermite2D* spline, const CubicHermite2DFloat* splineFloat,
+    size_t k, _Out_ double* buffer) {
+    if (NULL != splineFloat) {
+        const float* c = splineFloat[k];
+        size_t i;
+        for (i = 0; i < 15; i++) {
+            buffer[i] = c[i];
         }
+        return buffer;
+    }
+    return spline[k];
+}
 
-        /* Copy of table with extrapolated boundary values */
-        tableEx = (double*)malloc((nRow + 3)*(nCol + 3)*sizeof(double));
-        if (tableEx == NULL) {
-            free(y);
-            free(x);
-            return NULL;
+static enum TableStorage tableStorage(int storage) {
+    if (storage == STORAGE_DOUBLE || storage == STORAGE_FLOAT) {
+        return (enum TableStorage)storage;
+    }
+    else {
+        const char* env = getenv("MODELICA_TABLE_FLOAT");
+        if (NULL != env && '\0' != env[0] && 0 != strcmp(env, "0")) {
+            return STORAGE_FLOAT;
         }
-        for (i = 1; i < nRow; i++) {
-            /* Copy table row */
-            memcpy(&TABLE_EX(i + 1, 2), &TABLE(i, 1), (nCol - 1)*sizeof(double));
+    }
+    return STORAGE_DOUBLE;
+}
+
+static int isOwnedTable(enum TableSource source) {
+    switch (source) {
+#if !defined(NO_TABLE_COPY)
+        case TABLESOURCE_MODEL:
+#endif
+#if !defined(TABLE_SHARE) || defined(NO_FILE_SYSTEM)
+        case TABLESOURCE_FILE:
+#endif
+        case TABLESOURCE_FUNCTION_TRANSPOSE:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+static int toFloat(_Out_ float* y, _In_ const double* x, size_t n) {
+    size_t i;
+    for (i = 0; i < n; i++) {
+        if (fabs(x[i]) > FLT_MAX && fabs(x[i]) <= DBL_MAX) {
+            return 0;
         }
-        if (nCol == 3) {
-            /* Linear extrapolation in y direction */
-            for (i = 1; i < nRow; i++) {
-                TABLE_EX(i + 1, 0) = 3*TABLE(i, 1) - 2*TABLE(i, 2);
-                TABLE_EX(i + 1, 1) = 2*TABLE(i, 1) - TABLE(i, 2);
-                TABLE_EX(i + 1, 4) = 2*TABLE(i, 2) - TABLE(i, 1);
-                TABLE_EX(i + 1, 5) = 3*TABLE(i, 2) - 2*TABLE(i, 1);
+        y[i] = (float)x[i];
+    }
+    return 1;
+}
+
+static void compactTable1D(_Inout_ double** table, size_t nRow, size_t nCol,
+                           const int* cols, size_t nCols,
+                           enum TableSource source, _Inout_ float** tableFloat,
+                           _Inout_ CubicHermite1D** spline,
+                           _Inout_ CubicHermite1DFloat** splineFloat) {
+    if (NULL != *spline && NULL == *splineFloat) {
+        const size_t n = 3*(nRow - 1)*nCols;
+        float* c = (float*)malloc(n*sizeof(float));
+        if (NULL != c) {
+            if (toFloat(c, (const double*)*spline, n)) {
+                *splineFloat = (CubicHermite1DFloat*)c;
+                spline1DClose(spline);
             }
-        }
-        else {
-            for (i = 1; i < nRow; i++) {
-                /* Extrapolate table data in y direction */
-                spline1DExtrapolateLeft(y[0], y[1], y[2], y[3], y[4],
-                    &TABLE_EX(i + 1, 0), &TABLE_EX(i + 1, 1), TABLE_EX(i + 1, 2),
-                    TABLE_EX(i + 1, 3), TABLE_EX(i + 1, 4));
-                spline1DExtrapolateRight(y[nCol - 2], y[nCol - 1], y[nCol],
-                    y[nCol + 1], y[nCol + 2], TABLE_EX(i + 1, nCol - 2),
-                    TABLE_EX(i + 1, nCol - 1), TABLE_EX(i + 1, nCol),
-                    &TABLE_EX(i + 1, nCol + 1), &TABLE_EX(i + 1, nCol + 2));
-            }
-        }
-        if (nRow == 3) {
-            /* Linear extrapolation in x direction */
-            for (j = 0; j < nCol + 3; j++) {
-                TABLE_EX(0, j) = 3*TABLE_EX(2, j) - 2*TABLE_EX(3, j);
-                TABLE_EX(1, j) = 2*TABLE_EX(2, j) - TABLE_EX(3, j);
-                TABLE_EX(4, j) = 2*TABLE_EX(3, j) - TABLE_EX(2, j);
-                TABLE_EX(5, j) = 3*TABLE_EX(3, j) - 2*TABLE_EX(2, j);
+            else {
+                free(c);
             }
         }
-        else {
-            for (j = 0; j < nCol + 3; j++) {
-                /* Extrapolate table data in x direction */
-                spline1DExtrapolateLeft(x[0], x[1], x[2], x[3], x[4],
-                    &TABLE_EX(0, j), &TABLE_EX(1, j), TABLE_EX(2, j),
-                    TABLE_EX(3, j), TABLE_EX(4, j));
-                spline1DExtrapolateRight(x[nRow - 2], x[nRow - 1], x[nRow],
-                    x[nRow + 1], x[nRow + 2], TABLE_EX(nRow - 2, j),
-                    TABLE_EX(nRow - 1, j), TABLE_EX(nRow, j),
-                    &TABLE_EX(nRow + 1, j), &TABLE_EX(nRow + 2, j));
+    }
+    if (NULL != *table && NULL == *tableFloat && nCol > 1 &&
+        isOwnedTable(source)) {
+        float* y;
+        double* x;
+        size_t i;
+        for (i = 0; i < nCols; i++) {
+            if (cols[i] < 2) {
+                /* The first column is interpolated as well */
+                return;
             }
         }
-
-        dz_dx = (double*)malloc((nRow - 1)*(nCol - 1)*sizeof(double));
-        if (dz_dx == NULL) {
-            free(tableEx);
-            free(y);
-            free(x);
-            return NULL;
-        }
-
-        dz_dy = (double*)malloc((nRow - 1)*(nCol - 1)*sizeof(double));
-        if (dz_dy == NULL) {
-            free(dz_dx);
-            free(tableEx);
+        y = (float*)malloc(nRow*(nCol - 1)*sizeof(float));
+        x = (double*)malloc(nRow*sizeof(double));
+        if (NULL == y || NULL == x) {
             free(y);
             free(x);
-            return NULL;
+            return;
         }
-
-        d2z_dxdy = (double*)malloc((nRow - 1)*(nCol - 1)*sizeof(double));
-        if (d2z_dxdy == NULL) {
-            free(dz_dy);
-            free(dz_dx);
-            free(tableEx);
-            free(y);
-            free(x);
-            return NULL;
+        for (i = 0; i < nRow; i++) {
+            x[i] = (*table)[IDX(i, 0, nCol)];
+            if (!toFloat(&y[IDX(i, 0, nCol - 1)], &(*table)[IDX(i, 1, nCol)],
+                nCol - 1)) {
+                free(y);
+                free(x);
+                return;
+            }
         }
+        free(*table);
+        *table = x;
+        *tableFloat = y;
+    }
+}
 
-        /* Calculation of the partial derivatives */
-        for (i = 2; i < nRow + 1; i++) {
-            for (j = 2; j < nCol + 1; j++) {
-                /* Divided differences */
-                double d31, d32, d33, d34, d22, d23, d42, d43;
-                /* Weights */
-                double wx2, wx3, wy2, wy3;
-
-                /* Partial derivatives in x direction */
-                d31 = (TABLE_EX(i - 1, j) - TABLE_EX(i - 2, j))/
-                    (x[i - 1] - x[i - 2]); /* = c13 */
-                d32 = (TABLE_EX(i, j) - TABLE_EX(i - 1, j))/
-                    (x[i] - x[i - 1]); /* = c23 */
-                d33 = (TABLE_EX(i + 1, j) - TABLE_EX(i, j))/
-                    (x[i + 1] - x[i]); /* = c33 */
-                d34 = (TABLE_EX(i + 2, j) - TABLE_EX(i + 1, j))/
-                    (x[i + 2] - x[i + 1]); /* = c43 */
-                if (d31 == d32 && d33 == d34) {
-                    wx2 = 0.;
-                    wx3 = 0.;
-                    dz_dx[IDX(i - 2, j - 2, nCol - 1)] = 0.5*d32 + 0.5*d33;
-                }
-                else {
-                    wx2 = fabs(d34 - d33);
-                    wx3 = fabs(d32 - d31);
-                    dz_dx[IDX(i - 2, j - 2, nCol - 1)] = (wx2*d32 + wx3*d33)/
-                        (wx2 + wx3);
-                }
-
-                /* Partial derivatives in y direction */
-                d31 = (TABLE_EX(i, j - 1) - TABLE_EX(i, j - 2))/
-                    (y[j - 1] - y[j - 2]);
-                d32 = (TABLE_EX(i, j) - TABLE_EX(i, j - 1))/
-                    (y[j] - y[j - 1]);
-                d33 = (TABLE_EX(i, j + 1) - TABLE_EX(i, j))/
-                    (y[j + 1] - y[j]);
-                d34 = (TABLE_EX(i, j + 2) - TABLE_EX(i, j + 1))/
-                    (y[j + 2] - y[j + 1]);
-                if (d31 == d32 && d33 == d34) {
-                    wy2 = 0.;
-                    wy3 = 0.;
-                    dz_dy[IDX(i - 2, j - 2, nCol - 1)] = 0.5*d32 + 0.5*d33;
-                }
-                else {
-                    wy2 = fabs(d34 - d33);
-                    wy3 = fabs(d32 - d31);
-                    dz_dy[IDX(i - 2, j - 2, nCol - 1)] = (wy2*d32 + wy3*d33)/
-                        (wy2 + wy3);
-                }
-
-                /* Partial cross derivatives */
-                d22 = (TABLE_EX(i - 1, j) - TABLE_EX(i - 1, j - 1))/
-                    (y[j] - y[j - 1]);
-                d23 = (TABLE_EX(i - 1, j + 1) - TABLE_EX(i - 1, j))/
-                    (y[j + 1] - y[j]);
-                d42 = (TABLE_EX(i + 1, j) - TABLE_EX(i + 1, j - 1))/
-                    (y[j] - y[j - 1]);
-                d43 = (TABLE_EX(i + 1, j + 1) - TABLE_EX(i + 1, j))/
-                    (y[j + 1] - y[j]);
-                d22 = (d32 - d22)/(x[i] - x[i - 1]); /* = e22 */
-                d23 = (d33 - d23)/(x[i] - x[i - 1]); /* = e23 */
-                d32 = (d42 - d32)/(x[i + 1] - x[i]); /* = e32 */
-                d33 = (d43 - d33)/(x[i + 1] - x[i]); /* = e33 */
-                if (wx2 == 0. && wx3 == 0.) {
-                    wx2 = 1.;
-                    wx3 = 1.;
-                }
-                if (wy2 == 0. && wy3 == 0.) {
-                    wy2 = 1.;
-                    wy3 = 1.;
+static void compactTable2D(_Inout_ double** table, size_t nRow, size_t nCol,
+                           enum TableSource source, _Inout_ float** tableFloat,
+                           _Inout_ double** tableU2,
+                           _Inout_ CubicHermite2D** spline,
+                           _Inout_ CubicHermite2DFloat** splineFloat) {
+    if (NULL != *spline && NULL == *splineFloat) {
+        /* See spline2DInit for the number of grids, only the first 3
+           coefficients are used if the table has a single row or column */
+        const size_t n = nRow == 2 ? nCol - 1 : (nCol == 2 ? nRow - 1 :
+            (nRow - 2)*(nCol - 2));
+        const size_t m = (nRow == 2 || nCol == 2) ? 3 : 15;
+        CubicHermite2DFloat* c = (CubicHermite2DFloat*)calloc(n,
+            sizeof(CubicHermite2DFloat));
+        if (NULL != c) {
+            size_t k;
+            for (k = 0; k < n; k++) {
+                if (!toFloat(c[k], (*spline)[k], m)) {
+                    break;
                 }
-                d2z_dxdy[IDX(i - 2, j - 2, nCol - 1)] =
-                    (wx2*(wy2*d22 + wy3*d23) + wx3*(wy2*d32 + wy3*d33))/
-                    ((wx2 + wx3)*(wy2 + wy3));
+            }
+            if (k == n) {
+                *splineFloat = c;
+                spline2DClose(spline);
+            }
+            else {
+                free(c);
             }
         }
-
-        free(tableEx);
-        free(y);
-        free(x);
-
-        /* Actually there is no need for consecutive memory */
-        spline = (CubicHermite2D*)malloc((nRow - 2)*(nCol - 2)*sizeof(CubicHermite2D));
-        if (spline == NULL) {
-            free(dz_dx);
-            free(dz_dy);
-            free(d2z_dxdy);
-            return NULL;
-        }
-
-        /* Calculation of the 15(16) coefficients per grid */
-        for (i = 0; i < nRow - 2; i++) {
-            const double dx = TABLE_COL0(i + 2) - TABLE_COL0(i + 1);
-            const double dx_2 = dx*dx;
-            const double dx_3 = dx_2*dx;
-            for (j = 0; j < nCol - 2; j++) {
-                const double z00 = TABLE(i + 1, j + 1);
-                const double z01 = TABLE(i + 1, j + 2);
-                const double z10 = TABLE(i + 2, j + 1);
-                const double z11 = TABLE(i + 2, j + 2);
-                const double dy = TABLE_ROW0(j + 2) - TABLE_ROW0(j + 1);
-                const double dy_2 = dy*dy;
-                const double dy_3 = dy_2*dy;
-                double zx00, zx01, zx10, zx11;
-                double zy00, zy01, zy10, zy11;
-                double zxy00, zxy01, zxy10, zxy11;
-                double t1, t2, t3, t4, t5, t6, t7, t8, t9;
-                double t10, t11, t12, t13, t14;
-                double* c = spline[IDX(i, j, nCol - 2)];
-
-                c[11] = dz_dx[IDX(i, j, nCol - 1)];
-                zx00 = c[11]*dx;
-                zx01 = dz_dx[IDX(i, j + 1, nCol - 1)]*dx;
-                zx10 = dz_dx[IDX(i + 1, j, nCol - 1)]*dx;
-                zx11 = dz_dx[IDX(i + 1, j + 1, nCol - 1)]*dx;
-                c[14] = dz_dy[IDX(i, j, nCol - 1)];
-                zy00 = c[14]*dy;
-                zy01 = dz_dy[IDX(i, j + 1, nCol - 1)]*dy;
-                zy10 = dz_dy[IDX(i + 1, j, nCol - 1)]*dy;
-                zy11 = dz_dy[IDX(i + 1, j + 1, nCol - 1)]*dy;
-                c[10] = d2z_dxdy[IDX(i, j, nCol - 1)];
-                zxy00 = c[10]*dx*dy;
-                zxy01 = d2z_dxdy[IDX(i, j + 1, nCol - 1)]*dx*dy;
-                zxy10 = d2z_dxdy[IDX(i + 1, j, nCol - 1)]*dx*dy;
-                zxy11 = d2z_dxdy[IDX(i + 1, j + 1, nCol - 1)]*dx*dy;
-                t1 = z00 - z10;
-                t2 = zx00 + zx10;
-                t3 = zy00 - zy10;
-                t4 = zy11 - zy01;
-                t5 = zxy00 + zxy10;
-                t6 = zxy11 + zxy01;
-                t7 = 2*zx00 + zx10;
-                t8 = 2*zxy00 + zxy10;
-                t9 = zxy11 + 2*zxy01;
-                t10 = zx00 - zx01;
-                t11 = z00 - z01;
-                t12 = t1 + (z11 - z01);
-                t13 = t3 - t4;
-                t4 = 2*t3 - t4;
-                t14 = 2*t12 + (t2 - (zx11 + zx01));
-                t12 = 3*t12 + (t7 - (zx11 + 2*zx01));
-                c[0] = (2*t14 + (2*t13 + (t5 + t6)))/(dx_3*dy_3);
-                c[1] = -(3*t14 + (2*t4 + (2*t5 + t6)))/(dx_3*dy_2);
-                c[2] = (2*t3 + t5)/(dx_3*dy);
-                c[3] = (2*t1 + t2)/dx_3;
-                c[4] = -(2*t12 + (3*t13 + (t8 + t9)))/(dx_2*dy_3);
-                c[5] = (3*t12 + (3*t4 + (2*t8 + t9)))/(dx_2*dy_2);
-                c[6] = -(3*t3 + t8)/(dx_2*dy);
-                c[7] = -(3*t1 + t7)/dx_2;
-                c[8] = (2*t10 + (zxy00 + zxy01))/(dx*dy_3);
-                c[9] = -(3*t10 + (2*zxy00 + zxy01))/(dx*dy_2);
-                c[12] = (2*t11 + (zy00 + zy01))/dy_3;
-                c[13] = -(3*t11 + (2*zy00 + zy01))/dy_2;
-                /* No need to store the absolute term z00 */
-                /* c[15] = z00; */
-            }
-        }
-
-        free(dz_dx);
-        free(dz_dy);
-        free(d2z_dxdy);
     }
-    return spline;
-#undef TABLE_EX
-}
-
-static void spline2DClose(CubicHermite2D** spline) {
-    if (spline != NULL && *spline != NULL) {
-        free(*spline);
-        *spline = NULL;
+    if (NULL != *table && NULL == *tableFloat && isOwnedTable(source)) {
+        float* y = (float*)malloc((nRow - 1)*(nCol - 1)*sizeof(float));
+        double* x1 = (double*)malloc(nRow*sizeof(double));
+        double* x2 = (double*)malloc(nCol*sizeof(double));
+        size_t i;
+        if (NULL == y || NULL == x1 || NULL == x2) {
+            free(y);
+            free(x1);
+            free(x2);
+            return;
+        }
+        memcpy(x2, *table, nCol*sizeof(double));
+        x1[0] = (*table)[0];
+        for (i = 1; i < nRow; i++) {
+            x1[i] = (*table)[IDX(i, 0, nCol)];
+            if (!toFloat(&y[IDX(i - 1, 0, nCol - 1)],
+                &(*table)[IDX(i, 1, nCol)], nCol - 1)) {
+                free(y);
+                free(x1);
+                free(x2);
+                return;
+            }
+        }
+        free(*table);
+        *table = x1;
+        *tableU2 = x2;
+        *tableFloat = y;
     }
 }
 
@@ -4290,12 +8443,207 @@ static void transpose(_Inout_ double* table, size_t nRow, size_t nCol) {
     }
 }
 
+/* ----- Internal content share functions ---- */
+
+#if defined(TABLE_CONTENT_SHARE)
+#define HASH_WORD(h, w) { \
+    (h) ^= (w); \
+    (h) *= 0x9E3779B97F4A7C15ULL; \
+    (h) ^= (h) >> 29; \
+}
+
+static enum Smoothness contentSmoothness(int dim, enum Smoothness smoothness) {
+    if (smoothness == AKIMA_C1 || (dim == 1 &&
+        (smoothness == FRITSCH_BUTLAND_MONOTONE_C1 ||
+        smoothness == STEFFEN_MONOTONE_C1))) {
+        return smoothness;
+    }
+    return LINEAR_SEGMENTS;
+}
+
+static unsigned long long contentHash(_In_ const double* table, size_t nRow,
+                                      size_t nCol, const int* cols,
+                                      size_t nCols, int dim,
+                                      enum Smoothness smoothness,
+                                      enum TableStorage storage) {
+    unsigned long long h = 0;
+    size_t i;
+    HASH_WORD(h, (unsigned long long)dim);
+    HASH_WORD(h, (unsigned long long)contentSmoothness(dim, smoothness));
+    HASH_WORD(h, (unsigned long long)storage);
+    HASH_WORD(h, (unsigned long long)nRow);
+    HASH_WORD(h, (unsigned long long)nCol);
+    HASH_WORD(h, (unsigned long long)nCols);
+    for (i = 0; i < nCols; i++) {
+        HASH_WORD(h, (unsigned long long)(unsigned int)cols[i]);
+    }
+    for (i = 0; i < nRow*nCol; i++) {
+        /* Bit pattern of the value */
+        unsigned long long w = 0;
+        memcpy(&w, &table[i], sizeof(double));
+        HASH_WORD(h, w);
+    }
+    /* Finalization (splitmix64) */
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+#undef HASH_WORD
+
+static int contentMatches(_In_ const ContentShare* share,
+                          _In_ const double* table, size_t nRow, size_t nCol,
+                          const int* cols, size_t nCols, int dim,
+                          enum Smoothness smoothness,
+                          enum TableStorage storage) {
+    size_t i;
+    size_t j;
+    if (share->dim != dim || share->nRow != nRow || share->nCol != nCol ||
+        share->nCols != nCols || share->storage != storage ||
+        share->smoothness != contentSmoothness(dim, smoothness)) {
+        return 0;
+    }
+    if (nCols > 0 && memcmp(share->cols, cols, nCols*sizeof(int)) != 0) {
+        return 0;
+    }
+    if (NULL == share->tableFloat) {
+        return memcmp(share->table, table, nRow*nCol*sizeof(double)) == 0;
+    }
+    /* First column (and first row) in double precision */
+    for (i = 0; i < nRow; i++) {
+        if (memcmp(&share->table[i], &table[IDX(i, 0, nCol)],
+            sizeof(double)) != 0) {
+            return 0;
+        }
+    }
+    if (dim == 2 && memcmp(share->tableU2, table, nCol*sizeof(double)) != 0) {
+        return 0;
+    }
+    /* Remaining values in single precision */
+    for (i = dim == 2 ? 1 : 0; i < nRow; i++) {
+        const float* y = &share->tableFloat[IDX(i - (dim == 2 ? 1 : 0), 0,
+            nCol - 1)];
+        for (j = 1; j < nCol; j++) {
+            const float x = (float)table[IDX(i, j, nCol)];
+            if (memcmp(&x, &y[j - 1], sizeof(float)) != 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static ContentShare* contentShareAcquire(unsigned long long key,
+                                         _In_ const double* table, size_t nRow,
+                                         size_t nCol, const int* cols,
+                                         size_t nCols, int dim,
+                                         enum Smoothness smoothness,
+                                         enum TableStorage storage) {
+    ContentShare* share;
+    MUTEX_LOCK();
+    HASH_FIND(hh, contentShare, &key, sizeof(unsigned long long), share);
+    if (share != NULL) {
+        if (contentMatches(share, table, nRow, nCol, cols, nCols, dim,
+            smoothness, storage)) {
+            /* Share hit -> Increment reference counter */
+            share->refCount++;
+        }
+        else {
+            /* Hash collision */
+            share = NULL;
+        }
+    }
+    MUTEX_UNLOCK();
+    return share;
+}
+
+static ContentShare* contentShareNew(unsigned long long key, size_t nRow,
+                                     size_t nCol, const int* cols,
+                                     size_t nCols, int dim,
+                                     enum Smoothness smoothness,
+                                     enum TableStorage storage) {
+    ContentShare* share = (ContentShare*)calloc(1, sizeof(ContentShare));
+    if (share != NULL) {
+        if (nCols > 0) {
+            share->cols = (int*)malloc(nCols*sizeof(int));
+            if (share->cols == NULL) {
+                free(share);
+                return NULL;
+            }
+            memcpy(share->cols, cols, nCols*sizeof(int));
+        }
+        share->key = key;
+        share->refCount = 1;
+        share->dim = dim;
+        share->nRow = nRow;
+        share->nCol = nCol;
+        share->nCols = nCols;
+        share->smoothness = contentSmoothness(dim, smoothness);
+        share->storage = storage;
+    }
+    return share;
+}
+
+static ContentShare* contentShareInsert(_Inout_ ContentShare* share) {
+#define uthash_fatal(msg) do { \
+    MUTEX_UNLOCK(); \
+    ModelicaFormatMessage("Error in uthash: %s\n" \
+        "Hash table for content share may be left in corrupt state.\n", msg); \
+    return share; \
+} while (0)
+    ContentShare* iter;
+    MUTEX_LOCK();
+    HASH_FIND(hh, contentShare, &share->key, sizeof(unsigned long long), iter);
+    if (iter == NULL) {
+        HASH_ADD(hh, contentShare, key, sizeof(unsigned long long), share);
+    }
+    MUTEX_UNLOCK();
+    if (iter != NULL) {
+        /* Key already exists -> Table is not shared */
+        free(share->cols);
+        free(share);
+        share = NULL;
+    }
+    return share;
+#undef uthash_fatal
+}
+
+static void contentShareRelease(_Inout_ ContentShare* share) {
+    int last;
+    MUTEX_LOCK();
+    last = --share->refCount == 0;
+    if (last) {
+        HASH_DEL(contentShare, share);
+    }
+    MUTEX_UNLOCK();
+    if (last) {
+        free(share->table);
+        free(share->tableFloat);
+        free(share->tableU2);
+        spline1DClose(&share->spline1D);
+        free(share->spline1DFloat);
+        spline2DClose(&share->spline2D);
+        free(share->spline2DFloat);
+        free(share->invWidth1);
+        free(share->invWidth2);
+        free(share->cols);
+        free(share);
+    }
+}
+#endif
+
 /* ----- Internal I/O functions ----- */
 
 #if !defined(NO_FILE_SYSTEM)
 static double* readTable(_In_z_ const char* tableName, _In_z_ const char* fileName,
-                         _Inout_ size_t* nRow, _Inout_ size_t* nCol, int verbose,
-                         int force) {
+                         _Inout_ size_t* nRow, _Inout_ size_t* nCol,
+                         const size_t* columns, size_t nColumns,
+                         const double* prevTable,
+                         _Inout_ ModelicaIOTableState* state, int verbose,
+                         int force, _Out_ ModelicaIOLoadEvent* event) {
 #if defined(TABLE_SHARE)
 #define uthash_fatal(msg) do { \
     MUTEX_UNLOCK(); \
@@ -4305,16 +8653,19 @@ static double* readTable(_In_z_ const char* tableName, _In_z_ const char* fileNa
 } while (0)
 #endif
     double* table = NULL;
+#if !defined(TABLE_SHARE)
+    (void)force;
+#endif
+    memset(event, 0, sizeof(ModelicaIOLoadEvent));
+    event->fileName = fileName;
+    event->tableName = tableName;
+    event->shared = -1;
     if (tableName != NULL && fileName != NULL && nRow != NULL && nCol != NULL) {
 #if defined(TABLE_SHARE)
-        char* key = malloc((strlen(tableName) +
-            strlen(fileName) + 2)*sizeof(char));
+        char* key = tableShareKey(tableName, fileName, columns, nColumns);
         if (key != NULL) {
             int updateError = 0;
             TableShare *iter;
-            strcpy(key, tableName);
-            strcat(key, "|");
-            strcat(key, fileName);
             MUTEX_LOCK();
             HASH_FIND_STR(tableShare, key, iter);
             if (iter == NULL || force) {
@@ -4323,8 +8674,9 @@ static double* readTable(_In_z_ const char* tableName, _In_z_ const char* fileNa
                 */
                 MUTEX_UNLOCK();
 #endif
-                table = ModelicaIO_readRealTable(fileName, tableName,
-                    nRow, nCol, verbose);
+                table = ModelicaIO_readRealTableUpdate(fileName, tableName,
+                    nRow, nCol, columns, nColumns, prevTable, verbose, state,
+                    event);
                 if (table == NULL) {
 #if defined(TABLE_SHARE)
                     free(key);
@@ -4336,6 +8688,7 @@ static double* readTable(_In_z_ const char* tableName, _In_z_ const char* fileNa
                 MUTEX_LOCK();
                 HASH_FIND_STR(tableShare, key, iter);
             }
+            event->shared = NULL == iter || force ? 0 : 1;
             if (iter == NULL) {
                 /* Share miss -> Insert new table */
                 iter = malloc(sizeof(TableShare));
@@ -4387,12 +8740,94 @@ static double* readTable(_In_z_ const char* tableName, _In_z_ const char* fileNa
             }
         }
 #endif
+        event->nRow = *nRow;
+        event->nCol = *nCol;
     }
     return table;
 #if defined(TABLE_SHARE)
 #undef uthash_fatal
 #endif
 }
+
+static size_t* tableColumns(_Inout_ int* cols, size_t nCols,
+                            _Out_ size_t* nColumns) {
+    size_t* columns;
+    size_t i;
+    *nColumns = 0;
+    for (i = 0; i < nCols; i++) {
+        if (cols[i] < 1) {
+            /* Invalid column index (checked after the table is read) */
+            return NULL;
+        }
+    }
+    columns = (size_t*)malloc((nCols + 1)*sizeof(size_t));
+    if (columns == NULL) {
+        return NULL;
+    }
+    columns[0] = 1;
+    for (i = 0; i < nCols; i++) {
+        columns[i + 1] = (size_t)cols[i];
+    }
+    qsort(columns, nCols + 1, sizeof(size_t), compareSize);
+    /* Remove duplicate column indices */
+    *nColumns = 1;
+    for (i = 1; i < nCols + 1; i++) {
+        if (columns[i] != columns[*nColumns - 1]) {
+            columns[(*nColumns)++] = columns[i];
+        }
+    }
+    if (*nColumns < 2) {
+        /* A table with a single column is not valid */
+        free(columns);
+        *nColumns = 0;
+        return NULL;
+    }
+    /* Map column indices of table file to column indices of table */
+    for (i = 0; i < nCols; i++) {
+        size_t lo = 0;
+        size_t hi = *nColumns - 1;
+        while (lo < hi) {
+            const size_t mid = (lo + hi)/2;
+            if (columns[mid] < (size_t)cols[i]) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        cols[i] = (int)lo + 1;
+    }
+    return columns;
+}
+
+static int compareSize(const void* a, const void* b) {
+    const size_t x = *(const size_t*)a;
+    const size_t y = *(const size_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+#if defined(TABLE_SHARE)
+static char* tableShareKey(_In_z_ const char* tableName,
+                           _In_z_ const char* fileName,
+                           const size_t* columns, size_t nColumns) {
+    /* Each column index takes at most 20 digits and a separator */
+    char* key = (char*)malloc((strlen(tableName) + strlen(fileName) + 2 +
+        21*nColumns)*sizeof(char));
+    if (key != NULL) {
+        size_t len;
+        size_t i;
+        strcpy(key, tableName);
+        strcat(key, "|");
+        strcat(key, fileName);
+        len = strlen(key);
+        for (i = 0; i < nColumns; i++) {
+            len += (size_t)sprintf(&key[len], "%c%lu", i == 0 ? '|' : ',',
+                (unsigned long)columns[i]);
+        }
+    }
+    return key;
+}
+#endif
 #endif /* #if !defined(NO_FILE_SYSTEM) */
 
 #if defined(DUMMY_FUNCTION_USERTAB)
@@ -32,7 +32,10 @@
       Modelica.Blocks.Sources.CombiTimeTable
       Modelica.Blocks.Tables.CombiTable1D
       Modelica.Blocks.Tables.CombiTable1Ds
+      Modelica.Blocks.Tables.CombiTable1DInverse
       Modelica.Blocks.Tables.CombiTable2D
+      Modelica.Blocks.Tables.CombiTableND
+      Modelica.Media.Water.IF97_Utilities.Tabulated
 
    Release Notes:
       Feb. 25, 2017: by Thomas Beutlich, ESI ITI GmbH
@@ -62,7 +65,8 @@
    Tables may be linearly interpolated or the first derivative
    may be continuous. In the latter case, cubic Hermite splines with Akima slope
    approximation, Fritsch-Butland slope approximation (univariate only) or Steffen
-   slope approximation (univariate only) are used.
+   slope approximation (univariate only) are used (N-D tables: see
+   ModelicaStandardTables_CombiTableND_init).
 */
 
 #ifndef _MODELICASTANDARDTABLES_H_
@@ -88,6 +92,7 @@ extern "C" {
 #define _In_
 #define _In_z_
 #define _Inout_
+#define _Out_
 #endif
 
 void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
@@ -127,6 +132,32 @@ void* ModelicaStandardTables_CombiTimeTable_init(_In_z_ const char* tableName,
      <- RETURN: Pointer to internal memory of table structure
   */
 
+void* ModelicaStandardTables_CombiTimeTable_init2(_In_z_ const char* tableName,
+                                                  _In_z_ const char* fileName,
+                                                  _In_ double* table, size_t nRow,
+                                                  size_t nColumn,
+                                                  double startTime,
+                                                  _In_ int* columns,
+                                                  size_t nCols, int smoothness,
+                                                  int extrapolation,
+                                                  int storage) MODELICA_NONNULLATTR;
+  /* Same as ModelicaStandardTables_CombiTimeTable_init, but with storage
+     argument
+
+     -> storage: Storage precision of table values and spline coefficients
+                 = 0: default (= 2 if the environment variable
+                      MODELICA_TABLE_FLOAT is set to a value other than "0",
+                      else = 1)
+                 = 1: double
+                 = 2: single (float), the abscissa values are kept in
+                      double precision and the interpolation is computed in
+                      double precision. Table values passed to the _init
+                      function or read from a file without table sharing
+                      are converted, table values of shared or non-copied
+                      tables are kept in double precision.
+     <- RETURN: Pointer to internal memory of table structure
+  */
+
 void ModelicaStandardTables_CombiTimeTable_close(void* tableID);
   /* Close table and free allocated memory */
 
@@ -135,7 +166,10 @@ double ModelicaStandardTables_CombiTimeTable_read(void* tableID, int force,
   /* Read table from file
 
      -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTimeTable_init
-     -> force: Read only if forced or not yet read
+     -> force: Read only if forced or not yet read. A forced read is
+               skipped if the file is unchanged (same size and modification
+               time) and only parses the appended rows if rows were only
+               appended to the table of an ASCII text file.
      -> verbose: Print message that file is loading
      <- RETURN: = 1, if table was successfully read from file
   */
@@ -177,6 +211,26 @@ double ModelicaStandardTables_CombiTimeTable_getDerValue(void* tableID,
      <- RETURN: Derivative of ordinate value
   */
 
+double ModelicaStandardTables_CombiTimeTable_getValueAndDer(void* tableID,
+                                                            int icol,
+                                                            double t,
+                                                            double nextTimeEvent,
+                                                            double preNextTimeEvent,
+                                                            _Out_ double* der_y);
+  /* Interpolate in table and return the derivative with respect to time
+     in the same call. The results are identical to the ones of
+     ModelicaStandardTables_CombiTimeTable_getValue and
+     ModelicaStandardTables_CombiTimeTable_getDerValue with der_t = 1.
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTimeTable_init
+     -> icol: Index (1-based) of column to interpolate
+     -> t: Abscissa value (time)
+     -> nextTimeEvent: Next time event (found by ModelicaStandardTables_CombiTimeTable_nextTimeEvent)
+     -> preNextTimeEvent: Pre value of next time event
+     <- der_y: Derivative of ordinate value with respect to time
+     <- RETURN: Ordinate value
+  */
+
 double ModelicaStandardTables_CombiTimeTable_nextTimeEvent(void* tableID, double t);
   /* Return next time event in table
 
@@ -230,6 +284,31 @@ void* ModelicaStandardTables_CombiTable1D_init2(_In_z_ const char* tableName,
      <- RETURN: Pointer to internal memory of table structure
   */
 
+void* ModelicaStandardTables_CombiTable1D_init3(_In_z_ const char* tableName,
+                                                _In_z_ const char* fileName,
+                                                _In_ double* table, size_t nRow,
+                                                size_t nColumn,
+                                                _In_ int* columns,
+                                                size_t nCols, int smoothness,
+                                                int extrapolation,
+                                                int storage) MODELICA_NONNULLATTR;
+  /* Same as ModelicaStandardTables_CombiTable1D_init2, but with storage
+     argument
+
+     -> storage: Storage precision of table values and spline coefficients
+                 = 0: default (= 2 if the environment variable
+                      MODELICA_TABLE_FLOAT is set to a value other than "0",
+                      else = 1)
+                 = 1: double
+                 = 2: single (float), the abscissa values are kept in
+                      double precision and the interpolation is computed in
+                      double precision. Table values passed to the _init
+                      function or read from a file without table sharing
+                      are converted, table values of shared or non-copied
+                      tables are kept in double precision.
+     <- RETURN: Pointer to internal memory of table structure
+  */
+
 void ModelicaStandardTables_CombiTable1D_close(void* tableID);
   /* Close table and free allocated memory */
 
@@ -238,7 +317,10 @@ double ModelicaStandardTables_CombiTable1D_read(void* tableID, int force,
   /* Read table from file
 
      -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable1D_init
-     -> force: Read only if forced or not yet read
+     -> force: Read only if forced or not yet read. A forced read is
+               skipped if the file is unchanged (same size and modification
+               time) and only parses the appended rows if rows were only
+               appended to the table of an ASCII text file.
      -> verbose: Print message that file is loading
      <- RETURN: = 1, if table was successfully read from file
   */
@@ -270,6 +352,51 @@ double ModelicaStandardTables_CombiTable1D_getDerValue(void* tableID, int icol,
      <- RETURN: Derivative of ordinate value
   */
 
+double ModelicaStandardTables_CombiTable1D_getValueAndDer(void* tableID,
+                                                          int icol, double u,
+                                                          _Out_ double* der_y);
+  /* Interpolate in table and return the derivative with respect to the
+     abscissa value in the same call. The results are identical to the ones
+     of ModelicaStandardTables_CombiTable1D_getValue and
+     ModelicaStandardTables_CombiTable1D_getDerValue with der_u = 1.
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable1D_init
+     -> icol: Index (1-based) of column to interpolate
+     -> u: Abscissa value
+     <- der_y: Derivative of ordinate value with respect to u
+     <- RETURN: Ordinate value
+  */
+
+double ModelicaStandardTables_CombiTable1D_getInverseValue(void* tableID,
+                                                           int icol, double y);
+  /* Inverse interpolation in table: Return the abscissa value u with
+     ModelicaStandardTables_CombiTable1D_getValue(tableID, icol, u) = y.
+     The interpolation of the column needs to be strictly monotonic, which is
+     checked by the first call after the table is initialized or read. The
+     linear segments are inverted analytically, the cubic Hermite spline
+     pieces by safeguarded Halley iteration within the interval. Outside
+     of the range of the column values the inverse is only defined for
+     extrapolation = LastTwoPoints.
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable1D_init
+     -> icol: Index (1-based) of column to interpolate
+     -> y: Ordinate value
+     <- RETURN: Abscissa value
+  */
+
+double ModelicaStandardTables_CombiTable1D_getInverseDerValue(void* tableID,
+                                                              int icol,
+                                                              double y,
+                                                              double der_y);
+  /* Derivative of the inverse interpolation in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable1D_init
+     -> icol: Index (1-based) of column to interpolate
+     -> y: Ordinate value
+     -> der_y: Derivative of ordinate value
+     <- RETURN: Derivative of abscissa value
+  */
+
 void* ModelicaStandardTables_CombiTable2D_init(_In_z_ const char* tableName,
                                                _In_z_ const char* fileName,
                                                _In_ double* table, size_t nRow,
@@ -292,10 +419,39 @@ void* ModelicaStandardTables_CombiTable2D_init(_In_z_ const char* tableName,
      -> smoothness: Interpolation type
                     = 1: bilinear
                     = 2: continuous first derivative (by bivariate Akima splines)
+                         The spline coefficients are calculated at
+                         initialization or, if the environment variable
+                         MODELICA_TABLE_AKIMA_CACHE sets a cache budget
+                         (requires TABLE_SHARE), per tile of grid cells on
+                         first use with identical results.
                     = 3: bivariate constant
      <- RETURN: Pointer to internal memory of table structure
   */
 
+void* ModelicaStandardTables_CombiTable2D_init2(_In_z_ const char* tableName,
+                                                _In_z_ const char* fileName,
+                                                _In_ double* table, size_t nRow,
+                                                size_t nColumn, int smoothness,
+                                                int storage) MODELICA_NONNULLATTR;
+  /* Same as ModelicaStandardTables_CombiTable2D_init, but with storage
+     argument
+
+     -> storage: Storage precision of table values and spline coefficients
+                 = 0: default (= 2 if the environment variable
+                      MODELICA_TABLE_FLOAT is set to a value other than "0",
+                      else = 1)
+                 = 1: double
+                 = 2: single (float), the abscissa values are kept in
+                      double precision and the interpolation is computed in
+                      double precision. Table values passed to the _init
+                      function or read from a file without table sharing
+                      are converted, table values of shared or non-copied
+                      tables are kept in double precision. Spline
+                      coefficients calculated on first use are kept in
+                      double precision.
+     <- RETURN: Pointer to internal memory of table structure
+  */
+
 void ModelicaStandardTables_CombiTable2D_close(void* tableID);
   /* Close table and free allocated memory */
 
@@ -304,7 +460,10 @@ double ModelicaStandardTables_CombiTable2D_read(void* tableID, int force,
   /* Read table from file
 
      -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable2D_init
-     -> force: Read only if forced or not yet read
+     -> force: Read only if forced or not yet read. A forced read is
+               skipped if the file is unchanged (same size and modification
+               time) and only parses the appended rows if rows were only
+               appended to the table of an ASCII text file.
      -> verbose: Print message that file is loading
      <- RETURN: = 1, if table was successfully read from file
   */
@@ -332,6 +491,178 @@ double ModelicaStandardTables_CombiTable2D_getDerValue(void* tableID, double u1,
      <- RETURN: Derivative of interpolated value
   */
 
+double ModelicaStandardTables_CombiTable2D_getValueAndDer(void* tableID,
+                                                          double u1, double u2,
+                                                          _Out_ double* der_y1,
+                                                          _Out_ double* der_y2);
+  /* Interpolate in table and return both partial derivatives in the same
+     call. The results are identical to the ones of
+     ModelicaStandardTables_CombiTable2D_getValue and
+     ModelicaStandardTables_CombiTable2D_getDerValue with
+     (der_u1, der_u2) = (1, 0) and (0, 1), respectively.
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTable2D_init
+     -> u1: Value of first independent variable
+     -> u2: Value of second independent variable
+     <- der_y1: Partial derivative of interpolated value with respect to u1
+     <- der_y2: Partial derivative of interpolated value with respect to u2
+     <- RETURN: Interpolated value
+  */
+
+void* ModelicaStandardTables_CombiTableND_init(_In_z_ const char* tableName,
+                                               _In_z_ const char* fileName,
+                                               _In_ double* table,
+                                               size_t nTable, size_t nDim,
+                                               int smoothness,
+                                               int extrapolation) MODELICA_NONNULLATTR;
+  /* Initialize N-dim. table defined by a vector (or a matrix with a single
+     row or column) holding the number of dimensions, the number of grid
+     points per dimension, the grid points of the axes and the values on the
+     grid:
+       table = {N, n1, ..., nN, x1[1:n1], ..., xN[1:nN], v}
+     where N (= nDim) is the number of dimensions, nk the number of grid
+     points of axis k, xk the strictly increasing grid points of axis k and
+     v the n1*...*nN values v[i1, ..., iN] on the grid (the last index
+     varies fastest).
+     The values are copied to a value block stored in tiles of neighboring
+     grid points, such that the values of an interpolation are close in
+     memory. Hence, the table vector is neither kept (NO_TABLE_COPY) nor
+     shared by content (TABLE_SHARE). The table vector read from file is
+     shared by file and table name (TABLE_SHARE).
+
+     -> tableName: Name of table
+     -> fileName: Name of file
+     -> table: If tableName="NoName" or has only blanks AND
+               fileName ="NoName" or has only blanks, then
+               this pointer points to the table vector
+               in the Modelica environment.
+     -> nTable: Number of elements of table
+     -> nDim: Number of dimensions (inputs), 1 <= nDim <= 8
+     -> smoothness: Interpolation type
+                    = 1: multilinear
+                    = 2: continuous first derivative (by tensor product cubic
+                         Hermite splines with the slopes of the parabola
+                         through a grid point and its neighbors per axis,
+                         i.e., Catmull-Rom splines on equidistant grids)
+                    = 3: constant (value of the grid point below the input
+                         per axis)
+     -> extrapolation: Extrapolation type (per axis)
+                       = 1: hold the first/last value
+                       = 2: linear (by the first/last interval or, if
+                            smoothness = 2, by the slope at the first/last
+                            grid point)
+                       = 3: periodic
+                       = 4: no extrapolation
+     <- RETURN: Pointer to internal memory of table structure
+  */
+
+void ModelicaStandardTables_CombiTableND_close(void* tableID);
+  /* Close table and free allocated memory */
+
+double ModelicaStandardTables_CombiTableND_read(void* tableID, int force,
+                                                int verbose);
+  /* Read table from file
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableND_init
+     -> force: Read only if forced or not yet read. A forced read is
+               skipped if the file is unchanged (same size and modification
+               time).
+     -> verbose: Print message that file is loading
+     <- RETURN: = 1, if table was successfully read from file
+  */
+
+double ModelicaStandardTables_CombiTableND_getValue(void* tableID,
+                                                    _In_ const double* u,
+                                                    size_t nu);
+  /* Interpolate in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableND_init
+     -> u: Values of the independent variables
+     -> nu: Number of independent variables (= nDim)
+     <- RETURN : Interpolated value
+  */
+
+double ModelicaStandardTables_CombiTableND_getDerValue(void* tableID,
+                                                       _In_ const double* u,
+                                                       size_t nu,
+                                                       _In_ const double* der_u);
+  /* Interpolated derivative in table
+
+     -> tableID: Pointer to table defined with ModelicaStandardTables_CombiTableND_init
+     -> u: Values of the independent variables
+     -> nu: Number of independent variables (= nDim)
+     -> der_u: Derivative values of the independent variables
+     <- RETURN: Derivative of interpolated value
+  */
+
+int ModelicaStandardTables_SharedTable2D_getValue(_In_z_ const char* tableName,
+                                                  _In_z_ const char* validName,
+                                                  double u1, double u2,
+                                                  _Out_ double* y) MODELICA_NONNULLATTR;
+  /* Interpolate in a shared 2D table without a table object
+
+     The tables are kept until the end of the process in a registry shared
+     by all callers, where they are identified by the names tableName and
+     validName. Their values must be provided once by
+     ModelicaStandardTables_SharedTable2D_setTables. The value is
+     interpolated by Akima splines (see
+     ModelicaStandardTables_CombiTable2D_init, smoothness
+     CONTINUOUS_DERIVATIVE), but only if (u1, u2) is within the table range
+     (no extrapolation) and all values of the table of validity validName
+     (1: valid, 0: not valid) of its grid cell are valid. Otherwise, the
+     caller shall evaluate the value by other means.
+
+     -> tableName: Name of table of values
+     -> validName: Name of table of validity or "" if all values are valid
+     -> u1: Value of first independent variable
+     -> u2: Value of second independent variable
+     <- y: Interpolated value (0 if not interpolated)
+     <- RETURN: 1 if interpolated,
+                -1 if the table values are not yet provided,
+                0 otherwise
+  */
+
+int ModelicaStandardTables_SharedTable2D_getValueAndDer(_In_z_ const char* tableName,
+                                                        _In_z_ const char* validName,
+                                                        double u1, double u2,
+                                                        _Out_ double* y,
+                                                        _Out_ double* der_y1,
+                                                        _Out_ double* der_y2) MODELICA_NONNULLATTR;
+  /* Same as ModelicaStandardTables_SharedTable2D_getValue, but also
+     returns the partial derivatives of the interpolated value
+
+     <- der_y1: Partial derivative with respect to u1
+     <- der_y2: Partial derivative with respect to u2
+  */
+
+int ModelicaStandardTables_SharedTable2D_setTables(_In_z_ const char* tableName,
+                                                   _In_z_ const char* validName,
+                                                   _In_ const double* table,
+                                                   size_t nRow, size_t nColumn,
+                                                   _In_ const double* valid,
+                                                   size_t nRowValid,
+                                                   size_t nColumnValid) MODELICA_NONNULLATTR;
+  /* Provide the values of a shared 2D table (see
+     ModelicaStandardTables_SharedTable2D_getValue)
+
+     Only the values of the first call for tableName and validName are used
+     (and copied), later calls are ignored. If the values are not valid, the
+     table is not interpolated at all. While the values are initialized,
+     ModelicaStandardTables_SharedTable2D_getValue returns 0.
+
+     -> tableName: Name of table of values
+     -> validName: Name of table of validity or "" if all values are valid
+     -> table: Table values (first column: values of u1, first row: values
+               of u2, both strictly increasing)
+     -> nRow: Number of rows of table
+     -> nColumn: Number of columns of table
+     -> valid: Table of validity with the same first column and first row
+               as table (ignored if validName is "")
+     -> nRowValid: Number of rows of valid
+     -> nColumnValid: Number of columns of valid
+     <- RETURN: 0 if the values of the first call are not valid, 1 otherwise
+  */
+
 #if defined(__cplusplus)
 }
 #endif
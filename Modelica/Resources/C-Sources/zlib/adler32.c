@@ -59,6 +59,106 @@ local uLong adler32_combine_ OF((uLong adler1, uLong adler2, z_off64_t len2));
 #  define MOD63(a) a %= BASE
 #endif
 
+#ifdef Z_X86_SIMD
+#  include <immintrin.h>
+
+/* SIMD Adler-32: For a block of n bytes b[0..n-1] the sums are updated as
+     adler' = adler + sum(b[i]),
+     sum2'  = sum2 + n*adler + sum((n - i)*b[i]).
+   The byte sums are computed with PSADBW, the weighted sums with PMADDUBSW
+   using the taps n..1, and the n*adler term for later blocks of a chunk is
+   accumulated in v_ps. Chunks are at most NMAX bytes long, such that the
+   32-bit lanes cannot overflow before the modulo reduction (the bound of
+   NMAX covers exactly these sums). */
+
+Z_TARGET("ssse3")
+local unsigned adler32_hsum_sse(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (unsigned)_mm_cvtsi128_si32(v);
+}
+
+Z_TARGET("ssse3")
+local uLong adler32_ssse3(unsigned long adler, unsigned long sum2,
+                          const Bytef *buf, z_size_t len)
+{
+    const __m128i taps = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    while (len >= 16) {
+        z_size_t n = (len < NMAX ? len : NMAX) / 16;
+        __m128i v_ps = zero, v_s1 = zero, v_s2 = zero;
+
+        len -= n * 16;
+        sum2 += adler * (unsigned long)(n * 16);
+        do {
+            const __m128i bytes = _mm_loadu_si128((const __m128i *)buf);
+            v_ps = _mm_add_epi32(v_ps, v_s1);
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes, zero));
+            v_s2 = _mm_add_epi32(v_s2,
+                _mm_madd_epi16(_mm_maddubs_epi16(bytes, taps), ones));
+            buf += 16;
+        } while (--n);
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 4));
+        adler += adler32_hsum_sse(v_s1);
+        sum2 += adler32_hsum_sse(v_s2);
+        MOD(adler);
+        MOD(sum2);
+    }
+
+    if (len) {
+        while (len--) {
+            adler += *buf++;
+            sum2 += adler;
+        }
+        MOD(adler);
+        MOD(sum2);
+    }
+    return adler | (sum2 << 16);
+}
+
+Z_TARGET("avx2")
+local uLong adler32_avx2(unsigned long adler, unsigned long sum2,
+                         const Bytef *buf, z_size_t len)
+{
+    const __m256i taps = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                          24, 23, 22, 21, 20, 19, 18, 17,
+                                          16, 15, 14, 13, 12, 11, 10, 9,
+                                          8, 7, 6, 5, 4, 3, 2, 1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    while (len >= 32) {
+        z_size_t n = (len < NMAX ? len : NMAX) / 32;
+        __m256i v_ps = zero, v_s1 = zero, v_s2 = zero;
+
+        len -= n * 32;
+        sum2 += adler * (unsigned long)(n * 32);
+        do {
+            const __m256i bytes = _mm256_loadu_si256((const __m256i *)buf);
+            v_ps = _mm256_add_epi32(v_ps, v_s1);
+            v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(bytes, zero));
+            v_s2 = _mm256_add_epi32(v_s2,
+                _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, taps), ones));
+            buf += 32;
+        } while (--n);
+        v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+        adler += adler32_hsum_sse(_mm_add_epi32(_mm256_castsi256_si128(v_s1),
+            _mm256_extracti128_si256(v_s1, 1)));
+        sum2 += adler32_hsum_sse(_mm_add_epi32(_mm256_castsi256_si128(v_s2),
+            _mm256_extracti128_si256(v_s2, 1)));
+        MOD(adler);
+        MOD(sum2);
+    }
+
+    /* Remaining bytes (less than 32) */
+    return adler32_ssse3(adler, sum2, buf, len);
+}
+#endif /* Z_X86_SIMD */
+
 /* ========================================================================= */
 uLong ZEXPORT adler32_z(adler, buf, len)
     uLong adler;
@@ -99,6 +199,16 @@ uLong ZEXPORT adler32_z(adler, buf, len)
         return adler | (sum2 << 16);
     }
 
+#ifdef Z_X86_SIMD
+    if (len >= 64) {
+        unsigned features = z_cpu_features();
+        if (features & Z_CPU_AVX2)
+            return adler32_avx2(adler, sum2, buf, len);
+        if (features & Z_CPU_SSSE3)
+            return adler32_ssse3(adler, sum2, buf, len);
+    }
+#endif
+
     /* do length NMAX blocks -- requires just one modulo operation */
     while (len >= NMAX) {
         len -= NMAX;
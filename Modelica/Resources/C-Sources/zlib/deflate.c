@@ -1230,6 +1230,83 @@ local void lm_init (s)
  * OUT assertion: the match length is not greater than s->lookahead.
  */
 #ifndef ASMV
+#ifndef UNALIGNED_OK
+/* ===========================================================================
+ * Return the number of leading bytes (0..256) that are equal in the two
+ * strings of 256 bytes at scan and match. With SSE2 (always available on
+ * x86-64) 16 bytes are compared at once, on other 64-bit little endian
+ * targets 8 bytes, otherwise a single byte.
+ */
+#if defined(Z_X86_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+local unsigned compare256(scan, match)
+    const Bytef *scan;
+    const Bytef *match;
+{
+    unsigned len = 0;
+
+    do {
+        __m128i a = _mm_loadu_si128((const __m128i *)(scan + len));
+        __m128i b = _mm_loadu_si128((const __m128i *)(match + len));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        if (mask != 0xffff) {
+#ifdef _MSC_VER
+            unsigned long n;
+            _BitScanForward(&n, ~mask);
+            return len + (unsigned)n;
+#else
+            return len + (unsigned)__builtin_ctz(~mask);
+#endif
+        }
+        len += 16;
+    } while (len < 256);
+    return 256;
+}
+
+#elif defined(HAVE_MEMCPY) && defined(__GNUC__) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && \
+    defined(__SIZEOF_LONG_LONG__) && __SIZEOF_LONG_LONG__ == 8 && \
+    defined(__LP64__)
+
+local unsigned compare256(scan, match)
+    const Bytef *scan;
+    const Bytef *match;
+{
+    unsigned len = 0;
+
+    do {
+        unsigned long long a, b;
+        zmemcpy(&a, scan + len, 8);
+        zmemcpy(&b, match + len, 8);
+        if (a != b)
+            return len + ((unsigned)__builtin_ctzll(a ^ b) >> 3);
+        len += 8;
+    } while (len < 256);
+    return 256;
+}
+
+#else
+
+local unsigned compare256(scan, match)
+    const Bytef *scan;
+    const Bytef *match;
+{
+    unsigned len = 0;
+
+    do {
+        if (scan[len] != match[len]) return len;
+    } while (++len < 256);
+    return 256;
+}
+
+#endif
+#endif /* !UNALIGNED_OK */
+
 /* For 80x86 and 680x0, an optimized version will be provided in match.asm or
  * match.S. The code will be functionally equivalent.
  */
@@ -1259,7 +1336,6 @@ local uInt longest_match(s, cur_match)
     register ush scan_start = *(ushf*)scan;
     register ush scan_end   = *(ushf*)(scan+best_len-1);
 #else
-    register Bytef *strend = s->window + s->strstart + MAX_MATCH;
     register Byte scan_end1  = scan[best_len-1];
     register Byte scan_end   = scan[best_len];
 #endif
@@ -1338,23 +1414,14 @@ local uInt longest_match(s, cur_match)
          * are always equal when the other bytes match, given that
          * the hash keys are equal and that HASH_BITS >= 8.
          */
-        scan += 2, match++;
-        Assert(*scan == *match, "match[2]?");
+        Assert(scan[2] == match[1], "match[2]?");
 
-        /* We check for insufficient lookahead only every 8th comparison;
-         * the 256th check will be made at strstart+258.
+        /* Compare strstart+2 ... strstart+257 at once; a mismatch at
+         * strstart+258 would not change the length (MAX_MATCH).
          */
-        do {
-        } while (*++scan == *++match && *++scan == *++match &&
-                 *++scan == *++match && *++scan == *++match &&
-                 *++scan == *++match && *++scan == *++match &&
-                 *++scan == *++match && *++scan == *++match &&
-                 scan < strend);
-
-        Assert(scan <= s->window+(unsigned)(s->window_size-1), "wild scan");
+        len = 2 + (int)compare256(scan + 2, match + 1);
 
-        len = MAX_MATCH - (int)(strend - scan);
-        scan = strend - MAX_MATCH;
+        Assert(scan+len <= s->window+(unsigned)(s->window_size-1), "wild scan");
 
 #endif /* UNALIGNED_OK */
 
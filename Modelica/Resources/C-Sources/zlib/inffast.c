@@ -306,6 +306,267 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     return;
 }
 
+#ifdef INFLATE_FAST64
+
+typedef unsigned long long inf_word;    /* 64-bit bit buffer */
+
+/* Copy a match of len bytes from from = out - dist to out, where the source
+   and destination may overlap (dist < len). The copy is done in chunks of
+   16 or 8 bytes and may write up to 15 bytes beyond out + len. Returns
+   out + len. */
+local unsigned char FAR *chunk_copy(out, from, len, dist)
+unsigned char FAR *out;
+const unsigned char FAR *from;
+unsigned len;
+unsigned dist;
+{
+    unsigned char FAR *end = out + len;
+
+    if (dist >= 16) {
+        do {
+            zmemcpy(out, from, 16);
+            out += 16;
+            from += 16;
+        } while (out < end);
+    }
+    else if (dist >= 8) {
+        do {
+            zmemcpy(out, from, 8);
+            out += 8;
+            from += 8;
+        } while (out < end);
+    }
+    else if (dist == 1) {
+        memset(out, *from, len);
+    }
+    else {
+        /* Replicate the pattern byte-wise until a multiple of dist that is
+           at least 8 bytes lies behind out, then copy 8-byte chunks from
+           that (periodically identical) position. */
+        unsigned span = dist * ((8 + dist - 1) / dist);
+        unsigned n = span - dist;
+        if (n > len)
+            n = len;
+        len -= n;
+        while (n--)
+            *out++ = *from++;
+        from = out - span;
+        while (out < end) {
+            zmemcpy(out, from, 8);
+            out += 8;
+            from += 8;
+        }
+    }
+    return end;
+}
+
+/*
+   Same as inflate_fast(), but with the entry assumptions
+
+        strm->avail_in >= INFLATE_FAST64_HAVE
+        strm->avail_out >= INFLATE_FAST64_LEFT
+
+   The bit buffer is refilled once per length/distance pair (or literal) to
+   56..63 bits by an unaligned 64-bit load, which covers the maximum of 48
+   bits of a length/distance pair. The load may read up to seven bytes
+   beyond the last byte consumed, which are available as long as in < last.
+ */
+void ZLIB_INTERNAL inflate_fast64(strm, start)
+z_streamp strm;
+unsigned start;         /* inflate()'s starting value for strm->avail_out */
+{
+    struct inflate_state FAR *state;
+    z_const unsigned char FAR *in;      /* local strm->next_in */
+    z_const unsigned char FAR *last;    /* have enough input while in < last */
+    unsigned char FAR *out;     /* local strm->next_out */
+    unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
+    unsigned char FAR *end;     /* while out < end, enough space available */
+#ifdef INFLATE_STRICT
+    unsigned dmax;              /* maximum distance from zlib header */
+#endif
+    unsigned wsize;             /* window size or zero if not using window */
+    unsigned whave;             /* valid bytes in the window */
+    unsigned wnext;             /* window write index */
+    unsigned char FAR *window;  /* allocated sliding window, if wsize != 0 */
+    inf_word hold;              /* local strm->hold */
+    inf_word next;              /* next eight input bytes */
+    unsigned bits;              /* local strm->bits */
+    code const FAR *lcode;      /* local strm->lencode */
+    code const FAR *dcode;      /* local strm->distcode */
+    unsigned lmask;             /* mask for first level of length codes */
+    unsigned dmask;             /* mask for first level of distance codes */
+    code here;                  /* retrieved table entry */
+    unsigned op;                /* code bits, operation, extra bits, or */
+                                /*  window position, window bytes to copy */
+    unsigned len;               /* match length, unused bytes */
+    unsigned dist;              /* match distance */
+    unsigned char FAR *from;    /* where to copy match from */
+
+    /* copy state to local variables */
+    state = (struct inflate_state FAR *)strm->state;
+    in = strm->next_in;
+    last = in + (strm->avail_in - 7);
+    out = strm->next_out;
+    beg = out - (start - strm->avail_out);
+    end = out + (strm->avail_out - (INFLATE_FAST64_LEFT - 1));
+#ifdef INFLATE_STRICT
+    dmax = state->dmax;
+#endif
+    wsize = state->wsize;
+    whave = state->whave;
+    wnext = state->wnext;
+    window = state->window;
+    hold = state->hold;
+    bits = state->bits;
+    lcode = state->lencode;
+    dcode = state->distcode;
+    lmask = (1U << state->lenbits) - 1;
+    dmask = (1U << state->distbits) - 1;
+
+    /* decode literals and length/distances until end-of-block or not enough
+       input data or output space */
+    do {
+        zmemcpy(&next, in, 8);
+        hold |= next << bits;
+        in += 7 - (bits >> 3);
+        bits |= 56;
+        here = lcode[hold & lmask];
+      dolen:
+        op = (unsigned)(here.bits);
+        hold >>= op;
+        bits -= op;
+        op = (unsigned)(here.op);
+        if (op == 0) {                          /* literal */
+            Tracevv((stderr, here.val >= 0x20 && here.val < 0x7f ?
+                    "inflate:         literal '%c'\n" :
+                    "inflate:         literal 0x%02x\n", here.val));
+            *out++ = (unsigned char)(here.val);
+            /* at least 41 bits are left: decode a following literal
+               without refill */
+            here = lcode[hold & lmask];
+            if (here.op == 0) {
+                hold >>= here.bits;
+                bits -= here.bits;
+                Tracevv((stderr, here.val >= 0x20 && here.val < 0x7f ?
+                        "inflate:         literal '%c'\n" :
+                        "inflate:         literal 0x%02x\n", here.val));
+                *out++ = (unsigned char)(here.val);
+            }
+        }
+        else if (op & 16) {                     /* length base */
+            len = (unsigned)(here.val);
+            op &= 15;                           /* number of extra bits */
+            len += (unsigned)hold & ((1U << op) - 1);
+            hold >>= op;
+            bits -= op;
+            Tracevv((stderr, "inflate:         length %u\n", len));
+            here = dcode[hold & dmask];
+          dodist:
+            op = (unsigned)(here.bits);
+            hold >>= op;
+            bits -= op;
+            op = (unsigned)(here.op);
+            if (op & 16) {                      /* distance base */
+                dist = (unsigned)(here.val);
+                op &= 15;                       /* number of extra bits */
+                dist += (unsigned)hold & ((1U << op) - 1);
+#ifdef INFLATE_STRICT
+                if (dist > dmax) {
+                    strm->msg = (char *)"invalid distance too far back";
+                    state->mode = BAD;
+                    break;
+                }
+#endif
+                hold >>= op;
+                bits -= op;
+                Tracevv((stderr, "inflate:         distance %u\n", dist));
+                op = (unsigned)(out - beg);     /* max distance in output */
+                if (dist > op) {                /* see if copy from window */
+                    op = dist - op;             /* distance back in window */
+                    if (op > whave) {
+                        if (state->sane) {
+                            strm->msg =
+                                (char *)"invalid distance too far back";
+                            state->mode = BAD;
+                            break;
+                        }
+                    }
+                    /* the window does not overlap the output: copy exactly */
+                    from = window;
+                    if (wnext == 0) {           /* very common case */
+                        from += wsize - op;
+                    }
+                    else if (wnext < op) {      /* wrap around window */
+                        from += wsize + wnext - op;
+                        op -= wnext;
+                        if (op < len) {         /* some from end of window */
+                            zmemcpy(out, from, op);
+                            out += op;
+                            len -= op;
+                            from = window;
+                            op = wnext;
+                        }
+                    }
+                    else {                      /* contiguous in window */
+                        from += wnext - op;
+                    }
+                    if (op >= len) {            /* all from window */
+                        zmemcpy(out, from, len);
+                        out += len;
+                        continue;
+                    }
+                    zmemcpy(out, from, op);
+                    out += op;
+                    len -= op;                  /* rest from output */
+                }
+                out = chunk_copy(out, out - dist, len, dist);
+            }
+            else if ((op & 64) == 0) {          /* 2nd level distance code */
+                here = dcode[here.val + (hold & ((1U << op) - 1))];
+                goto dodist;
+            }
+            else {
+                strm->msg = (char *)"invalid distance code";
+                state->mode = BAD;
+                break;
+            }
+        }
+        else if ((op & 64) == 0) {              /* 2nd level length code */
+            here = lcode[here.val + (hold & ((1U << op) - 1))];
+            goto dolen;
+        }
+        else if (op & 32) {                     /* end-of-block */
+            Tracevv((stderr, "inflate:         end of block\n"));
+            state->mode = TYPE;
+            break;
+        }
+        else {
+            strm->msg = (char *)"invalid literal/length code";
+            state->mode = BAD;
+            break;
+        }
+    } while (in < last && out < end);
+
+    /* return unused bytes (the bits above bits in hold are not consumed) */
+    len = bits >> 3;
+    in -= len;
+    bits -= len << 3;
+    hold &= ((inf_word)1 << bits) - 1;
+
+    /* update state and return */
+    strm->next_in = in;
+    strm->next_out = out;
+    strm->avail_in = (unsigned)(in < last ? 7 + (last - in) : 7 - (in - last));
+    strm->avail_out = (unsigned)(out < end ?
+        (INFLATE_FAST64_LEFT - 1) + (end - out) :
+        (INFLATE_FAST64_LEFT - 1) - (out - end));
+    state->hold = (unsigned long)hold;
+    state->bits = bits;
+    return;
+}
+
+#endif /* INFLATE_FAST64 */
+
 /*
    inflate_fast() speedups that turned out slower (on a PowerPC G3 750CXe):
    - Using bit fields for code structure
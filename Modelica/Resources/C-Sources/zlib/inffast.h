@@ -9,3 +9,20 @@
  */
 
 void ZLIB_INTERNAL inflate_fast OF((z_streamp strm, unsigned start));
+
+/* inflate_fast64() is a variant of inflate_fast() for 64-bit little-endian
+   targets: the bit buffer is refilled with one unaligned 64-bit load per
+   code and matches are copied in 8 or 16 byte chunks. The chunks may write
+   up to 15 bytes past the end of a match (but never past the output space
+   given by avail_out), hence it is only used by inflate() and not by
+   inflateBack(), where the output space is the sliding window. Define
+   NO_INFLATE_FAST64 to disable it. */
+#if !defined(ASMINF) && !defined(NO_INFLATE_FAST64) && defined(HAVE_MEMCPY) && \
+    !defined(INFLATE_ALLOW_INVALID_DISTANCE_TOOFAR_ARRR) && \
+    (defined(__x86_64__) || defined(_M_X64) || defined(_M_ARM64) || \
+     (defined(__aarch64__) && !defined(__AARCH64EB__)))
+#  define INFLATE_FAST64
+#  define INFLATE_FAST64_HAVE 16          /* minimum strm->avail_in */
+#  define INFLATE_FAST64_LEFT (258 + 16)  /* minimum strm->avail_out */
+void ZLIB_INTERNAL inflate_fast64 OF((z_streamp strm, unsigned start));
+#endif
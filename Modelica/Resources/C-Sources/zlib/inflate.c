@@ -1044,6 +1044,11 @@ int flush;
         case LEN:
             if (have >= 6 && left >= 258) {
                 RESTORE();
+#ifdef INFLATE_FAST64
+                if (have >= INFLATE_FAST64_HAVE && left >= INFLATE_FAST64_LEFT)
+                    inflate_fast64(strm, out);
+                else
+#endif
                 inflate_fast(strm, out);
                 LOAD();
                 if (state->mode == TYPE)
@@ -24,6 +24,41 @@ z_const char * const z_errmsg[10] = {
 };
 
 
+#ifdef Z_X86_SIMD
+#  include "../ModelicaCPUDispatch.h"
+
+/* Return the Z_CPU_* flags of the instruction set extensions available to
+   the kernels. The CPU and the environment variable MODELICA_CPU_LEVEL are
+   queried by ModelicaCPUDispatch.h, such that zlib follows the level of the
+   kernels of the Modelica libraries: SSSE3, SSE4.1 and PCLMUL require a
+   level above "sse2" and AVX2 requires level "avx2". Concurrent first calls
+   compute the same value, hence no synchronization is needed. */
+unsigned ZLIB_INTERNAL z_cpu_features()
+{
+    static volatile int features = -1;
+    unsigned int r1[4], r7[4], xcr0;    /* cpuid leaves 1 and 7, XCR0 */
+    unsigned flags = 0;
+
+    if (features >= 0)
+        return (unsigned)features;
+
+    ModelicaCPU_cpuid(r1, r7, &xcr0);
+    if (ModelicaCPU_levelLimit() > MODELICA_CPU_SSE2) {
+        if (r1[2] & (1U << 9))
+            flags |= Z_CPU_SSSE3;
+        if (r1[2] & (1U << 19))
+            flags |= Z_CPU_SSE41;
+        if (r1[2] & (1U << 1))
+            flags |= Z_CPU_PCLMUL;
+        if (ModelicaCPU_level() >= MODELICA_CPU_AVX2)
+            flags |= Z_CPU_AVX2;
+    }
+
+    features = (int)flags;
+    return flags;
+}
+#endif /* Z_X86_SIMD */
+
 const char * ZEXPORT zlibVersion()
 {
     return ZLIB_VERSION;
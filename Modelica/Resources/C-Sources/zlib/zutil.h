@@ -264,6 +264,27 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
 #define ZFREE(strm, addr)  (*((strm)->zfree))((strm)->opaque, (voidpf)(addr))
 #define TRY_FREE(s, p) {if (p) ZFREE(s, p);}
 
+/* x86 SIMD kernels (adler32.c, crc32.c) selected at run time by CPU feature
+   detection. Define NO_SIMD to build the portable code only. */
+#if !defined(NO_SIMD) && !defined(Z_SOLO) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64)) && \
+    ((defined(__GNUC__) && !defined(__clang__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || \
+     (defined(__clang__) && __clang_major__ >= 4) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1700))
+#  define Z_X86_SIMD
+#  if defined(_MSC_VER)
+#    define Z_TARGET(isa)
+#  else
+#    define Z_TARGET(isa) __attribute__((target(isa)))
+#  endif
+#  define Z_CPU_SSSE3  0x01
+#  define Z_CPU_SSE41  0x02
+#  define Z_CPU_PCLMUL 0x04
+#  define Z_CPU_AVX2   0x08
+   unsigned ZLIB_INTERNAL z_cpu_features OF((void));
+#endif
+
 /* Reverse the bytes in a 32-bit value */
 #define ZSWAP32(q) ((((q) >> 24) & 0xff) + (((q) >> 8) & 0xff00) + \
                     (((q) & 0xff00) << 8) + (((q) & 0xff) << 24))